@@ -10,10 +10,13 @@ PUBLIC_HEADERS += \
 SOURCES += \
     client/qopcuaaddnodeitem.cpp \
     client/qopcuaaddreferenceitem.cpp \
+    client/qopcuaaddressspacecache.cpp \
+    client/qopcuaaddressspacecrawler.cpp \
     client/qopcuaapplicationdescription.cpp \
     client/qopcuaapplicationidentity.cpp \
     client/qopcuaapplicationrecorddatatype.cpp \
     client/qopcuaargument.cpp \
+    client/qopcuaattributecache.cpp \
     client/qopcuaattributeoperand.cpp \
     client/qopcuaauthenticationinformation.cpp \
     client/qopcuaaxisinformation.cpp \
@@ -21,12 +24,15 @@ SOURCES += \
     client/qopcuabinarydataencoding.cpp \
     client/qopcuabrowsepathtarget.cpp \
     client/qopcuabrowserequest.cpp \
+    client/qopcuacallmethoditem.cpp \
+    client/qopcuacallmethodresult.cpp \
     client/qopcuaclient.cpp \
     client/qopcuaclientimpl.cpp \
     client/qopcuaclientprivate.cpp \
     client/qopcuacomplexnumber.cpp \
     client/qopcuacontentfilterelement.cpp \
     client/qopcuacontentfilterelementresult.cpp \
+    client/qopcuadatachangequeue.cpp \
     client/qopcuadeletereferenceitem.cpp \
     client/qopcuadoublecomplexnumber.cpp \
     client/qopcuaelementoperand.cpp \
@@ -36,6 +42,9 @@ SOURCES += \
     client/qopcuaeventfilterresult.cpp \
     client/qopcuaexpandednodeid.cpp \
     client/qopcuaextensionobject.cpp \
+    client/qopcuahistorydata.cpp \
+    client/qopcuahistoryreadrequest.cpp \
+    client/qopcuahistoryreadresponse.cpp \
     client/qopcualiteraloperand.cpp \
     client/qopcualocalizedtext.cpp \
     client/qopcuamonitoringparameters.cpp \
@@ -44,6 +53,7 @@ SOURCES += \
     client/qopcuanodecreationattributes.cpp \
     client/qopcuanodeids.cpp \
     client/qopcuanodeimpl.cpp \
+    client/qopcuaoperationresult.cpp \
     client/qopcuapkiconfiguration.cpp \
     client/qopcuaqualifiedname.cpp \
     client/qopcuarange.cpp \
@@ -54,6 +64,7 @@ SOURCES += \
     client/qopcuasimpleattributeoperand.cpp \
     client/qopcuatype.cpp \
     client/qopcuausertokenpolicy.cpp \
+    client/qopcuavaluehistory.cpp \
     client/qopcuawriteitem.cpp \
     client/qopcuawriteresult.cpp \
     client/qopcuaxvalue.cpp \
@@ -61,22 +72,30 @@ SOURCES += \
 HEADERS += \
     client/qopcuaaddnodeitem.h \
     client/qopcuaaddreferenceitem.h \
+    client/qopcuaaddressspacecache_p.h \
+    client/qopcuaaddressspacecrawler.h \
+    client/qopcuaaddressspacecrawler_p.h \
     client/qopcuaapplicationdescription.h \
     client/qopcuaapplicationidentity.h \
     client/qopcuaapplicationrecorddatatype.h \
     client/qopcuaargument.h \
+    client/qopcuaattributecache_p.h \
     client/qopcuaattributeoperand.h \
+    client/qopcuaattributestorage_p.h \
     client/qopcuaauthenticationinformation.h \
     client/qopcuaaxisinformation.h \
     client/qopcuabackend_p.h \
     client/qopcuabinarydataencoding.h \
     client/qopcuabrowsepathtarget.h \
     client/qopcuabrowserequest.h \
+    client/qopcuacallmethoditem.h \
+    client/qopcuacallmethodresult.h \
     client/qopcuaclient_p.h \
     client/qopcuaclientimpl_p.h \
     client/qopcuacomplexnumber.h \
     client/qopcuacontentfilterelement.h \
     client/qopcuacontentfilterelementresult.h \
+    client/qopcuadatachangequeue_p.h \
     client/qopcuadeletereferenceitem.h \
     client/qopcuadoublecomplexnumber.h \
     client/qopcuaelementoperand.h \
@@ -86,16 +105,23 @@ HEADERS += \
     client/qopcuaeventfilterresult.h \
     client/qopcuaexpandednodeid.h \
     client/qopcuaextensionobject.h \
+    client/qopcuahistorydata.h \
+    client/qopcuahistoryreadrequest.h \
+    client/qopcuahistoryreadresponse.h \
+    client/qopcuahistoryreadresponse_p.h \
     client/qopcualiteraloperand.h \
     client/qopcualocalizedtext.h \
     client/qopcuamonitoringparameters.h \
     client/qopcuamonitoringparameters_p.h \
     client/qopcuamultidimensionalarray.h \
+    client/qopcuamultidimensionalarray_p.h \
     client/qopcuanode_p.h \
     client/qopcuanodecreationattributes.h \
     client/qopcuanodecreationattributes_p.h \
+    client/qopcuanodeidparser_p.h \
     client/qopcuanodeids.h \
     client/qopcuanodeimpl_p.h \
+    client/qopcuaoperationresult.h \
     client/qopcuapkiconfiguration.h \
     client/qopcuaqualifiedname.h \
     client/qopcuarange.h \
@@ -104,7 +130,9 @@ HEADERS += \
     client/qopcuareferencedescription.h \
     client/qopcuarelativepathelement.h \
     client/qopcuasimpleattributeoperand.h \
+    client/qopcuaslotmap_p.h \
     client/qopcuausertokenpolicy.h \
+    client/qopcuavaluehistory.h \
     client/qopcuawriteitem.h \
     client/qopcuawriteresult.h \
     client/qopcuaxvalue.h \
@@ -0,0 +1,689 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuaaddressspacecache_p.h"
+
+#include <QtOpcUa/qopcuaexpandednodeid.h>
+#include <QtOpcUa/qopcualocalizedtext.h>
+#include <QtOpcUa/qopcuaqualifiedname.h>
+#include <private/qopcuabackend_p.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qsavefile.h>
+
+#include <algorithm>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA)
+
+static const char fileMagic[8] = {'Q', 'O', 'P', 'C', 'U', 'A', 'A', 'S'};
+static const quint32 fileVersion = 1;
+static const QDataStream::Version streamVersion = QDataStream::Qt_5_15;
+
+// Type tags of the serialized values, independent from the meta type ids
+enum class ValueTag : quint8 {
+    Null,
+    Bool,
+    SByte,
+    Byte,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float,
+    Double,
+    String,
+    ByteArray,
+    DateTime,
+    LocalizedText,
+    QualifiedName,
+    List
+};
+
+static bool valueTag(const QVariant &value, ValueTag *tag)
+{
+    switch (value.userType()) {
+    case QMetaType::UnknownType:
+        *tag = ValueTag::Null; return true;
+    case QMetaType::Bool:
+        *tag = ValueTag::Bool; return true;
+    case QMetaType::SChar:
+        *tag = ValueTag::SByte; return true;
+    case QMetaType::UChar:
+        *tag = ValueTag::Byte; return true;
+    case QMetaType::Short:
+        *tag = ValueTag::Int16; return true;
+    case QMetaType::UShort:
+        *tag = ValueTag::UInt16; return true;
+    case QMetaType::Int:
+        *tag = ValueTag::Int32; return true;
+    case QMetaType::UInt:
+        *tag = ValueTag::UInt32; return true;
+    case QMetaType::LongLong:
+        *tag = ValueTag::Int64; return true;
+    case QMetaType::ULongLong:
+        *tag = ValueTag::UInt64; return true;
+    case QMetaType::Float:
+        *tag = ValueTag::Float; return true;
+    case QMetaType::Double:
+        *tag = ValueTag::Double; return true;
+    case QMetaType::QString:
+        *tag = ValueTag::String; return true;
+    case QMetaType::QByteArray:
+        *tag = ValueTag::ByteArray; return true;
+    case QMetaType::QDateTime:
+        *tag = ValueTag::DateTime; return true;
+    case QMetaType::QVariantList:
+        *tag = ValueTag::List; return true;
+    default:
+        break;
+    }
+
+    if (value.userType() == qMetaTypeId<QOpcUaLocalizedText>()) {
+        *tag = ValueTag::LocalizedText;
+        return true;
+    }
+    if (value.userType() == qMetaTypeId<QOpcUaQualifiedName>()) {
+        *tag = ValueTag::QualifiedName;
+        return true;
+    }
+
+    return false;
+}
+
+static bool isSerializable(const QVariant &value)
+{
+    ValueTag tag;
+    if (!valueTag(value, &tag))
+        return false;
+
+    if (tag == ValueTag::List) {
+        const QVariantList list = value.toList();
+        return std::all_of(list.constBegin(), list.constEnd(), isSerializable);
+    }
+
+    return true;
+}
+
+static void writeValue(QDataStream &stream, const QVariant &value)
+{
+    ValueTag tag = ValueTag::Null;
+    valueTag(value, &tag);
+    stream << static_cast<quint8>(tag);
+
+    switch (tag) {
+    case ValueTag::Null:
+        break;
+    case ValueTag::Bool:
+        stream << value.toBool(); break;
+    case ValueTag::SByte:
+        stream << value.value<qint8>(); break;
+    case ValueTag::Byte:
+        stream << value.value<quint8>(); break;
+    case ValueTag::Int16:
+        stream << value.value<qint16>(); break;
+    case ValueTag::UInt16:
+        stream << value.value<quint16>(); break;
+    case ValueTag::Int32:
+        stream << value.value<qint32>(); break;
+    case ValueTag::UInt32:
+        stream << value.value<quint32>(); break;
+    case ValueTag::Int64:
+        stream << value.value<qint64>(); break;
+    case ValueTag::UInt64:
+        stream << value.value<quint64>(); break;
+    case ValueTag::Float:
+        stream << value.toFloat(); break;
+    case ValueTag::Double:
+        stream << value.toDouble(); break;
+    case ValueTag::String:
+        stream << value.toString(); break;
+    case ValueTag::ByteArray:
+        stream << value.toByteArray(); break;
+    case ValueTag::DateTime:
+        stream << value.toDateTime(); break;
+    case ValueTag::LocalizedText: {
+        const auto text = value.value<QOpcUaLocalizedText>();
+        stream << text.locale() << text.text();
+        break;
+    }
+    case ValueTag::QualifiedName: {
+        const auto name = value.value<QOpcUaQualifiedName>();
+        stream << name.namespaceIndex() << name.name();
+        break;
+    }
+    case ValueTag::List: {
+        const QVariantList list = value.toList();
+        stream << static_cast<quint32>(list.size());
+        for (const auto &entry : list)
+            writeValue(stream, entry);
+        break;
+    }
+    }
+}
+
+template <typename T>
+static QVariant readScalar(QDataStream &stream)
+{
+    T value;
+    stream >> value;
+    return QVariant::fromValue(value);
+}
+
+static bool readValue(QDataStream &stream, QVariant *value)
+{
+    quint8 tag = 0;
+    stream >> tag;
+
+    switch (static_cast<ValueTag>(tag)) {
+    case ValueTag::Null:
+        *value = QVariant(); break;
+    case ValueTag::Bool:
+        *value = readScalar<bool>(stream); break;
+    case ValueTag::SByte:
+        *value = readScalar<qint8>(stream); break;
+    case ValueTag::Byte:
+        *value = readScalar<quint8>(stream); break;
+    case ValueTag::Int16:
+        *value = readScalar<qint16>(stream); break;
+    case ValueTag::UInt16:
+        *value = readScalar<quint16>(stream); break;
+    case ValueTag::Int32:
+        *value = readScalar<qint32>(stream); break;
+    case ValueTag::UInt32:
+        *value = readScalar<quint32>(stream); break;
+    case ValueTag::Int64:
+        *value = readScalar<qint64>(stream); break;
+    case ValueTag::UInt64:
+        *value = readScalar<quint64>(stream); break;
+    case ValueTag::Float:
+        *value = readScalar<float>(stream); break;
+    case ValueTag::Double:
+        *value = readScalar<double>(stream); break;
+    case ValueTag::String:
+        *value = readScalar<QString>(stream); break;
+    case ValueTag::ByteArray:
+        *value = readScalar<QByteArray>(stream); break;
+    case ValueTag::DateTime:
+        *value = readScalar<QDateTime>(stream); break;
+    case ValueTag::LocalizedText: {
+        QString locale, text;
+        stream >> locale >> text;
+        *value = QVariant::fromValue(QOpcUaLocalizedText(locale, text));
+        break;
+    }
+    case ValueTag::QualifiedName: {
+        quint16 namespaceIndex = 0;
+        QString name;
+        stream >> namespaceIndex >> name;
+        *value = QVariant::fromValue(QOpcUaQualifiedName(namespaceIndex, name));
+        break;
+    }
+    case ValueTag::List: {
+        quint32 size = 0;
+        stream >> size;
+        QVariantList list;
+        for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+            QVariant entry;
+            if (!readValue(stream, &entry))
+                return false;
+            list.push_back(entry);
+        }
+        *value = list;
+        break;
+    }
+    default:
+        return false;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+static void writeExpandedNodeId(QDataStream &stream, const QOpcUaExpandedNodeId &id)
+{
+    stream << id.serverIndex() << id.namespaceUri() << id.nodeId();
+}
+
+static QOpcUaExpandedNodeId readExpandedNodeId(QDataStream &stream)
+{
+    quint32 serverIndex = 0;
+    QString namespaceUri, nodeId;
+    stream >> serverIndex >> namespaceUri >> nodeId;
+    return QOpcUaExpandedNodeId(namespaceUri, nodeId, serverIndex);
+}
+
+static void writeReference(QDataStream &stream, const QOpcUaReferenceDescription &reference)
+{
+    stream << reference.refTypeId() << reference.isForwardReference();
+    writeExpandedNodeId(stream, reference.targetNodeId());
+    stream << reference.browseName().namespaceIndex() << reference.browseName().name();
+    stream << reference.displayName().locale() << reference.displayName().text();
+    stream << static_cast<qint32>(reference.nodeClass());
+    writeExpandedNodeId(stream, reference.typeDefinition());
+}
+
+static QOpcUaReferenceDescription readReference(QDataStream &stream)
+{
+    QOpcUaReferenceDescription reference;
+
+    QString refTypeId;
+    bool isForward = true;
+    stream >> refTypeId >> isForward;
+    reference.setRefTypeId(refTypeId);
+    reference.setIsForwardReference(isForward);
+    reference.setTargetNodeId(readExpandedNodeId(stream));
+
+    quint16 namespaceIndex = 0;
+    QString name, locale, text;
+    stream >> namespaceIndex >> name >> locale >> text;
+    reference.setBrowseName(QOpcUaQualifiedName(namespaceIndex, name));
+    reference.setDisplayName(QOpcUaLocalizedText(locale, text));
+
+    qint32 nodeClass = 0;
+    stream >> nodeClass;
+    reference.setNodeClass(static_cast<QOpcUa::NodeClass>(nodeClass));
+    reference.setTypeDefinition(readExpandedNodeId(stream));
+
+    return reference;
+}
+
+QOpcUaAddressSpaceCache::QOpcUaAddressSpaceCache(const QString &directory, const QString &applicationUri,
+                                                 const QStringList &namespaceArray)
+    : m_key(cacheKey(applicationUri, namespaceArray))
+{
+    QDir dir(directory);
+    if (!dir.mkpath(QStringLiteral(".")))
+        qCWarning(QT_OPCUA) << "Unable to create the address space cache directory" << directory;
+
+    m_fileName = dir.filePath(m_key + QLatin1String(".qopcuacache"));
+    map();
+}
+
+QOpcUaAddressSpaceCache::~QOpcUaAddressSpaceCache()
+{
+    flush();
+    unmap();
+}
+
+QOpcUa::NodeAttributes QOpcUaAddressSpaceCache::cacheableAttributes()
+{
+    // The value changes at runtime, the user specific attributes depend on the session
+    return QOpcUa::NodeAttribute::NodeId | QOpcUa::NodeAttribute::NodeClass | QOpcUa::NodeAttribute::BrowseName |
+            QOpcUa::NodeAttribute::DisplayName | QOpcUa::NodeAttribute::Description | QOpcUa::NodeAttribute::WriteMask |
+            QOpcUa::NodeAttribute::IsAbstract | QOpcUa::NodeAttribute::Symmetric | QOpcUa::NodeAttribute::InverseName |
+            QOpcUa::NodeAttribute::ContainsNoLoops | QOpcUa::NodeAttribute::EventNotifier | QOpcUa::NodeAttribute::DataType |
+            QOpcUa::NodeAttribute::ValueRank | QOpcUa::NodeAttribute::ArrayDimensions | QOpcUa::NodeAttribute::AccessLevel |
+            QOpcUa::NodeAttribute::MinimumSamplingInterval | QOpcUa::NodeAttribute::Historizing | QOpcUa::NodeAttribute::Executable;
+}
+
+QString QOpcUaAddressSpaceCache::cacheKey(const QString &applicationUri, const QStringList &namespaceArray)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(applicationUri.toUtf8());
+    for (const auto &ns : namespaceArray) {
+        hash.addData("\n", 1);
+        hash.addData(ns.toUtf8());
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString QOpcUaAddressSpaceCache::key() const
+{
+    return m_key;
+}
+
+QString QOpcUaAddressSpaceCache::fileName() const
+{
+    return m_fileName;
+}
+
+bool QOpcUaAddressSpaceCache::attributes(const QString &nodeId, QOpcUa::NodeAttributes attributes, QVector<QOpcUaReadResult> *results)
+{
+    if (!attributes || (attributes & ~cacheableAttributes()))
+        return false;
+
+    const Entry *entry = findEntry(nodeId);
+    if (!entry)
+        return false;
+
+    QVector<QOpcUaReadResult> cached;
+    bool complete = true;
+
+    qt_forEachAttribute(attributes, [&](QOpcUa::NodeAttribute attribute) {
+        const auto it = entry->attributes.constFind(attribute);
+        if (it == entry->attributes.constEnd()) {
+            complete = false;
+            return;
+        }
+
+        QOpcUaReadResult result;
+        result.setNodeId(nodeId);
+        result.setAttribute(attribute);
+        result.setValue(it.value());
+        result.setStatusCode(QOpcUa::UaStatusCode::Good);
+        cached.push_back(result);
+    });
+
+    if (!complete)
+        return false;
+
+    *results = cached;
+    return true;
+}
+
+void QOpcUaAddressSpaceCache::insertAttributes(const QString &nodeId, const QVector<QOpcUaReadResult> &results)
+{
+    Entry *entry = nullptr;
+
+    for (const auto &result : results) {
+        if (result.statusCode() != QOpcUa::UaStatusCode::Good || !result.indexRange().isEmpty() ||
+                !(cacheableAttributes() & result.attribute()) || !isSerializable(result.value()))
+            continue;
+
+        if (!entry) {
+            entry = findEntry(nodeId);
+            if (!entry)
+                entry = &m_entries[nodeId];
+        }
+
+        entry->attributes.insert(result.attribute(), result.value());
+        m_dirty = true;
+    }
+}
+
+bool QOpcUaAddressSpaceCache::browseResult(const QString &nodeId, const QOpcUaBrowseRequest &request,
+                                           QVector<QOpcUaReferenceDescription> *references)
+{
+    const Entry *entry = findEntry(nodeId);
+    if (!entry)
+        return false;
+
+    const auto it = entry->browseResults.constFind(browseRequestKey(request));
+    if (it == entry->browseResults.constEnd())
+        return false;
+
+    *references = it.value();
+    return true;
+}
+
+void QOpcUaAddressSpaceCache::insertBrowseResult(const QString &nodeId, const QOpcUaBrowseRequest &request,
+                                                 const QVector<QOpcUaReferenceDescription> &references)
+{
+    Entry *entry = findEntry(nodeId);
+    if (!entry)
+        entry = &m_entries[nodeId];
+
+    entry->browseResults.insert(browseRequestKey(request), references);
+    m_dirty = true;
+}
+
+bool QOpcUaAddressSpaceCache::flush()
+{
+    if (!m_dirty)
+        return true;
+
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(QT_OPCUA) << "Unable to write the address space cache file" << m_fileName << file.errorString();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+    header.entryCount = 0;
+    header.indexOffset = 0;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    QVector<IndexEntry> index;
+    index.reserve(m_indexSize + m_entries.size());
+    quint64 offset = sizeof(header);
+
+    // Records of the current file which have not been loaded are copied without deserializing them.
+    // Index entries pointing outside of the records of a damaged file are dropped.
+    const quint64 recordsEnd = m_index ? reinterpret_cast<const uchar *>(m_index) - m_data : 0;
+    for (quint32 i = 0; i < m_indexSize; ++i) {
+        const IndexEntry &current = m_index[i];
+        if (current.offset < sizeof(FileHeader) || current.offset + current.size > recordsEnd)
+            continue;
+
+        const QByteArray record = QByteArray::fromRawData(reinterpret_cast<const char *>(m_data + current.offset), current.size);
+        QDataStream stream(record);
+        stream.setVersion(streamVersion);
+        QString nodeId;
+        stream >> nodeId;
+        if (stream.status() != QDataStream::Ok || m_entries.contains(nodeId))
+            continue;
+
+        file.write(record);
+        index.push_back({current.hash, current.size, offset});
+        offset += current.size;
+    }
+
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        QByteArray record;
+        QDataStream stream(&record, QIODevice::WriteOnly);
+        stream.setVersion(streamVersion);
+
+        stream << it.key();
+        stream << static_cast<quint32>(it->attributes.size());
+        for (auto attribute = it->attributes.constBegin(); attribute != it->attributes.constEnd(); ++attribute) {
+            stream << static_cast<quint32>(attribute.key());
+            writeValue(stream, attribute.value());
+        }
+        stream << static_cast<quint32>(it->browseResults.size());
+        for (auto result = it->browseResults.constBegin(); result != it->browseResults.constEnd(); ++result) {
+            stream << result.key() << static_cast<quint32>(result->size());
+            for (const auto &reference : result.value())
+                writeReference(stream, reference);
+        }
+
+        file.write(record);
+        index.push_back({nodeIdHash(it.key()), static_cast<quint32>(record.size()), offset});
+        offset += record.size();
+    }
+
+    // The index is aligned to allow direct access in the memory mapped file
+    const int padding = static_cast<int>((alignof(IndexEntry) - offset % alignof(IndexEntry)) % alignof(IndexEntry));
+    file.write(QByteArray(padding, '\0'));
+    offset += padding;
+
+    std::sort(index.begin(), index.end(), [](const IndexEntry &lhs, const IndexEntry &rhs) {
+        return lhs.hash < rhs.hash;
+    });
+    file.write(reinterpret_cast<const char *>(index.constData()), index.size() * sizeof(IndexEntry));
+
+    header.entryCount = index.size();
+    header.indexOffset = offset;
+    file.seek(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    // The file must not be mapped while it is replaced
+    unmap();
+    const bool success = file.commit();
+    if (success)
+        m_dirty = false;
+    else
+        qCWarning(QT_OPCUA) << "Unable to write the address space cache file" << m_fileName << file.errorString();
+    map();
+
+    return success;
+}
+
+void QOpcUaAddressSpaceCache::invalidate()
+{
+    unmap();
+    m_entries.clear();
+    m_dirty = false;
+    if (QFile::exists(m_fileName) && !QFile::remove(m_fileName))
+        qCWarning(QT_OPCUA) << "Unable to remove the address space cache file" << m_fileName;
+}
+
+QOpcUaAddressSpaceCache::Entry *QOpcUaAddressSpaceCache::findEntry(const QString &nodeId)
+{
+    auto it = m_entries.find(nodeId);
+    if (it != m_entries.end())
+        return &it.value();
+
+    Entry entry;
+    if (!loadEntry(nodeId, &entry))
+        return nullptr;
+
+    return &m_entries.insert(nodeId, entry).value();
+}
+
+bool QOpcUaAddressSpaceCache::loadEntry(const QString &nodeId, Entry *entry) const
+{
+    if (!m_index)
+        return false;
+
+    const quint32 hash = nodeIdHash(nodeId);
+    const quint64 recordsEnd = reinterpret_cast<const uchar *>(m_index) - m_data;
+    auto it = std::lower_bound(m_index, m_index + m_indexSize, hash, [](const IndexEntry &lhs, quint32 rhs) {
+        return lhs.hash < rhs;
+    });
+
+    for (; it != m_index + m_indexSize && it->hash == hash; ++it) {
+        if (it->offset < sizeof(FileHeader) || it->offset + it->size > recordsEnd)
+            return false;
+
+        const QByteArray record = QByteArray::fromRawData(reinterpret_cast<const char *>(m_data + it->offset), it->size);
+        QDataStream stream(record);
+        stream.setVersion(streamVersion);
+
+        QString storedNodeId;
+        stream >> storedNodeId;
+        if (storedNodeId != nodeId)
+            continue;
+
+        quint32 attributeCount = 0;
+        stream >> attributeCount;
+        for (quint32 i = 0; i < attributeCount && stream.status() == QDataStream::Ok; ++i) {
+            quint32 attribute = 0;
+            QVariant value;
+            stream >> attribute;
+            if (!readValue(stream, &value))
+                return false;
+            entry->attributes.insert(static_cast<QOpcUa::NodeAttribute>(attribute), value);
+        }
+
+        quint32 browseResultCount = 0;
+        stream >> browseResultCount;
+        for (quint32 i = 0; i < browseResultCount && stream.status() == QDataStream::Ok; ++i) {
+            QString requestKey;
+            quint32 referenceCount = 0;
+            stream >> requestKey >> referenceCount;
+            QVector<QOpcUaReferenceDescription> references;
+            for (quint32 j = 0; j < referenceCount && stream.status() == QDataStream::Ok; ++j)
+                references.push_back(readReference(stream));
+            entry->browseResults.insert(requestKey, references);
+        }
+
+        return stream.status() == QDataStream::Ok;
+    }
+
+    return false;
+}
+
+void QOpcUaAddressSpaceCache::map()
+{
+    m_file.setFileName(m_fileName);
+    if (!m_file.exists() || !m_file.open(QIODevice::ReadOnly))
+        return;
+
+    const qint64 size = m_file.size();
+    uchar *data = size >= static_cast<qint64>(sizeof(FileHeader)) ? m_file.map(0, size) : nullptr;
+    if (!data) {
+        m_file.close();
+        return;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const quint64 indexSize = static_cast<quint64>(header.entryCount) * sizeof(IndexEntry);
+    if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) || header.version != fileVersion ||
+            header.indexOffset < sizeof(FileHeader) || header.indexOffset % alignof(IndexEntry) ||
+            header.indexOffset > static_cast<quint64>(size) || indexSize > static_cast<quint64>(size) - header.indexOffset) {
+        qCWarning(QT_OPCUA) << "Ignoring invalid address space cache file" << m_fileName;
+        m_file.unmap(data);
+        m_file.close();
+        return;
+    }
+
+    m_data = data;
+    m_index = reinterpret_cast<const IndexEntry *>(data + header.indexOffset);
+    m_indexSize = header.entryCount;
+}
+
+void QOpcUaAddressSpaceCache::unmap()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+    m_data = nullptr;
+    m_index = nullptr;
+    m_indexSize = 0;
+    m_file.close();
+}
+
+quint32 QOpcUaAddressSpaceCache::nodeIdHash(const QString &nodeId)
+{
+    // FNV-1a, qHash() is not guaranteed to be stable across Qt versions
+    quint32 hash = 2166136261u;
+    for (const QChar c : nodeId) {
+        hash = (hash ^ c.unicode()) * 16777619u;
+    }
+    return hash;
+}
+
+QString QOpcUaAddressSpaceCache::browseRequestKey(const QOpcUaBrowseRequest &request)
+{
+    return QStringLiteral("%1;%2;%3;%4").arg(static_cast<quint32>(request.browseDirection()))
+            .arg(request.referenceTypeId())
+            .arg(request.includeSubtypes() ? 1 : 0)
+            .arg(static_cast<quint32>(request.nodeClassMask()));
+}
+
+QT_END_NAMESPACE
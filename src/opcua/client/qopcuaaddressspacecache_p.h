@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPCUAADDRESSSPACECACHE_P_H
+#define QOPCUAADDRESSSPACECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuabrowserequest.h>
+#include <QtOpcUa/qopcuareadresult.h>
+#include <QtOpcUa/qopcuareferencedescription.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qvariant.h>
+
+QT_BEGIN_NAMESPACE
+
+// Persistent cache for browse results and attributes which only change if the address space is modified.
+// The cache file contains the serialized entries followed by an index sorted by the hash of the node id.
+// It is memory mapped, entries are only deserialized when they are requested.
+class QOpcUaAddressSpaceCache
+{
+public:
+    QOpcUaAddressSpaceCache(const QString &directory, const QString &applicationUri, const QStringList &namespaceArray);
+    ~QOpcUaAddressSpaceCache();
+
+    static QOpcUa::NodeAttributes cacheableAttributes();
+    static QString cacheKey(const QString &applicationUri, const QStringList &namespaceArray);
+
+    QString key() const;
+    QString fileName() const;
+
+    bool attributes(const QString &nodeId, QOpcUa::NodeAttributes attributes, QVector<QOpcUaReadResult> *results);
+    void insertAttributes(const QString &nodeId, const QVector<QOpcUaReadResult> &results);
+
+    bool browseResult(const QString &nodeId, const QOpcUaBrowseRequest &request, QVector<QOpcUaReferenceDescription> *references);
+    void insertBrowseResult(const QString &nodeId, const QOpcUaBrowseRequest &request, const QVector<QOpcUaReferenceDescription> &references);
+
+    bool flush();
+    void invalidate();
+
+private:
+    struct Entry {
+        QHash<QOpcUa::NodeAttribute, QVariant> attributes;
+        QHash<QString, QVector<QOpcUaReferenceDescription>> browseResults; // Browse request key -> references
+    };
+
+    struct FileHeader {
+        char magic[8];
+        quint32 version;
+        quint32 entryCount;
+        quint64 indexOffset;
+    };
+
+    struct IndexEntry {
+        quint32 hash;
+        quint32 size;
+        quint64 offset;
+    };
+
+    Entry *findEntry(const QString &nodeId);
+    bool loadEntry(const QString &nodeId, Entry *entry) const;
+    void map();
+    void unmap();
+
+    static quint32 nodeIdHash(const QString &nodeId);
+    static QString browseRequestKey(const QOpcUaBrowseRequest &request);
+
+    QString m_key;
+    QString m_fileName;
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    const IndexEntry *m_index = nullptr;
+    quint32 m_indexSize = 0;
+
+    QHash<QString, Entry> m_entries; // Entries which have been loaded from the file or updated
+    bool m_dirty = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAADDRESSSPACECACHE_P_H
@@ -0,0 +1,598 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuaaddressspacecrawler.h"
+#include "qopcuaexpandednodeid.h"
+
+#include <private/qopcuaaddressspacecrawler_p.h>
+#include <private/qopcuabackend_p.h>
+#include <private/qopcuaclient_p.h>
+#include <private/qopcuaclientimpl_p.h>
+
+#include <QtCore/qloggingcategory.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA)
+
+/*!
+    \class QOpcUaAddressSpaceCrawler
+    \inmodule QtOpcUa
+    \since 5.15
+
+    \brief Walks the address space of a server and reports all nodes it discovers.
+
+    QOpcUaAddressSpaceCrawler visits the address space breadth-first, starting at a given node.
+    It uses the batched QOpcUaClient::browseNodes() and QOpcUaClient::readNodeAttributes()
+    functions. Several browse and read requests are kept in flight at the same time, which
+    makes the crawler much faster than browsing each node with QOpcUaNode.
+
+    Each node is browsed only once, even if it is the target of several references.
+    The discovered nodes are reported incrementally in the \l nodesDiscovered() signal.
+    If attributes to read have been set, the values are delivered in the \l attributesRead() signal.
+
+    \code
+    QOpcUaAddressSpaceCrawler crawler(client);
+    crawler.setNodeClassFilter(QOpcUa::NodeClass::Variable);
+    crawler.setAttributesToRead(QOpcUa::NodeAttribute::DataType | QOpcUa::NodeAttribute::Description);
+
+    QObject::connect(&crawler, &QOpcUaAddressSpaceCrawler::nodesDiscovered,
+                     [](QString parentNodeId, QVector<QOpcUaReferenceDescription> nodes) {
+        ...
+    });
+    QObject::connect(&crawler, &QOpcUaAddressSpaceCrawler::finished, [&crawler](QOpcUa::UaStatusCode statusCode) {
+        qDebug() << "Found" << crawler.discoveredNodeCount() << "nodes in" << crawler.elapsed() << "ms";
+    });
+
+    crawler.start(QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::ObjectsFolder));
+    \endcode
+
+    The crawler requires a backend which supports QOpcUaClient::browseNodes() and
+    QOpcUaClient::readNodeAttributesAsync(). Its requests are identified by their own request
+    handles and futures, the client can be used for other purposes while the crawler is running.
+    The results of the crawler's requests are not emitted in QOpcUaClient::browseNodesFinished()
+    and QOpcUaClient::readNodeAttributesFinished().
+*/
+
+/*!
+    \fn void QOpcUaAddressSpaceCrawler::nodesDiscovered(QString parentNodeId, QVector<QOpcUaReferenceDescription> nodes)
+
+    This signal is emitted after the node \a parentNodeId has been browsed. \a nodes contains the
+    references to the nodes which have not been seen before and which match the node class filter.
+*/
+
+/*!
+    \fn void QOpcUaAddressSpaceCrawler::attributesRead(QVector<QOpcUaReadResult> results)
+
+    This signal is emitted when a read request for the attributes of discovered nodes has finished.
+    \a results contains one entry for each attribute of each node.
+*/
+
+/*!
+    \fn void QOpcUaAddressSpaceCrawler::finished(QOpcUa::UaStatusCode statusCode)
+
+    This signal is emitted when the crawl has finished. \a statusCode is \c Good if all reachable
+    nodes have been visited. Nodes which could not be browsed are counted in \l failedNodeCount().
+*/
+
+/*!
+    Constructs a crawler which uses \a client to communicate with the server.
+    The client must be connected when \l start() is called.
+*/
+QOpcUaAddressSpaceCrawler::QOpcUaAddressSpaceCrawler(QOpcUaClient *client, QObject *parent)
+    : QObject(*(new QOpcUaAddressSpaceCrawlerPrivate(client)), parent)
+{
+}
+
+/*!
+    Destroys the crawler. A running crawl is aborted without emitting \l finished().
+*/
+QOpcUaAddressSpaceCrawler::~QOpcUaAddressSpaceCrawler()
+{
+}
+
+/*!
+    Returns the browse request which is used for browsing each node.
+
+    The default request follows hierarchical references and their subtypes in forward direction.
+*/
+QOpcUaBrowseRequest QOpcUaAddressSpaceCrawler::browseRequest() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_browseRequest;
+}
+
+/*!
+    Sets the browse request which is used for browsing each node to \a request.
+
+    The reference type and node class mask of the request restrict the nodes the crawler traverses.
+*/
+void QOpcUaAddressSpaceCrawler::setBrowseRequest(const QOpcUaBrowseRequest &request)
+{
+    Q_D(QOpcUaAddressSpaceCrawler);
+    d->m_browseRequest = request;
+}
+
+/*!
+    Returns the node classes of the nodes which are reported.
+*/
+QOpcUa::NodeClasses QOpcUaAddressSpaceCrawler::nodeClassFilter() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_nodeClassFilter;
+}
+
+/*!
+    Sets the node classes of the nodes which are reported and read to \a nodeClasses.
+    An empty filter reports nodes of all classes, which is the default.
+
+    Unlike the node class mask of the browse request, this filter does not prevent the
+    crawler from browsing the children of nodes which are not reported.
+*/
+void QOpcUaAddressSpaceCrawler::setNodeClassFilter(QOpcUa::NodeClasses nodeClasses)
+{
+    Q_D(QOpcUaAddressSpaceCrawler);
+    d->m_nodeClassFilter = nodeClasses;
+}
+
+/*!
+    Returns the attributes which are read for each reported node.
+*/
+QOpcUa::NodeAttributes QOpcUaAddressSpaceCrawler::attributesToRead() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_attributesToRead;
+}
+
+/*!
+    Sets the attributes which are read for each reported node to \a attributes.
+
+    By default, no attributes are read. The node id, browse name, display name, node class
+    and type definition are part of the reference descriptions and don't need to be read.
+*/
+void QOpcUaAddressSpaceCrawler::setAttributesToRead(QOpcUa::NodeAttributes attributes)
+{
+    Q_D(QOpcUaAddressSpaceCrawler);
+    d->m_attributesToRead = attributes;
+    d->m_attributeList.clear();
+    qt_forEachAttribute(attributes, [d](QOpcUa::NodeAttribute attribute) {
+        d->m_attributeList.push_back(attribute);
+    });
+}
+
+/*!
+    Returns the maximum number of browse and read requests which are in flight at the same time.
+*/
+int QOpcUaAddressSpaceCrawler::maxRequestsInFlight() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_maxRequestsInFlight;
+}
+
+/*!
+    Sets the maximum number of browse and read requests which are in flight at the same time to \a maxRequests.
+    The default value is 4.
+*/
+void QOpcUaAddressSpaceCrawler::setMaxRequestsInFlight(int maxRequests)
+{
+    Q_D(QOpcUaAddressSpaceCrawler);
+    d->m_maxRequestsInFlight = qMax(1, maxRequests);
+}
+
+/*!
+    Returns the maximum number of nodes which are browsed or read in one request.
+*/
+int QOpcUaAddressSpaceCrawler::batchSize() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_batchSize;
+}
+
+/*!
+    Sets the maximum number of nodes which are browsed or read in one request to \a batchSize.
+    The default value is 1000. The backend splits the requests further if the operation limits
+    of the server require it.
+*/
+void QOpcUaAddressSpaceCrawler::setBatchSize(int batchSize)
+{
+    Q_D(QOpcUaAddressSpaceCrawler);
+    d->m_batchSize = qMax(1, batchSize);
+}
+
+/*!
+    Starts crawling the address space at the node \a startNodeId.
+    The start node itself is browsed but not reported.
+
+    Returns \c true if the first browse request has been dispatched. The statistics of a previous crawl are reset.
+*/
+bool QOpcUaAddressSpaceCrawler::start(const QString &startNodeId)
+{
+    Q_D(QOpcUaAddressSpaceCrawler);
+
+    if (d->m_running || !d->m_client || d->m_client->state() != QOpcUaClient::Connected || startNodeId.isEmpty())
+        return false;
+
+    d->m_discoveredNodeCount = 0;
+    d->m_browsedNodeCount = 0;
+    d->m_duplicateReferenceCount = 0;
+    d->m_failedNodeCount = 0;
+    d->m_readResultCount = 0;
+    d->m_browseRequestCount = 0;
+    d->m_readRequestCount = 0;
+    d->m_elapsed = 0;
+
+    d->m_knownNodes.insert(startNodeId);
+    d->m_browseQueue.enqueue(startNodeId);
+
+    d->m_connections.push_back(QObject::connect(d->clientImpl(), &QOpcUaClientImpl::browseNodesFinished, this,
+                                                [d](quint64 requestHandle, QString nodeId, QVector<QOpcUaReferenceDescription> references,
+                                                    QOpcUa::UaStatusCode statusCode) {
+        d->handleBrowseNodesFinished(requestHandle, nodeId, references, statusCode);
+    }));
+    d->m_connections.push_back(QObject::connect(d->m_client, &QOpcUaClient::stateChanged, this,
+                                                [d](QOpcUaClient::ClientState state) {
+        d->handleStateChanged(state);
+    }));
+
+    d->m_running = true;
+    d->m_timer.start();
+
+    if (!d->sendBrowseRequest()) {
+        // The backend doesn't support browsing multiple nodes
+        d->finish(QOpcUa::UaStatusCode::BadNotSupported, false);
+        return false;
+    }
+
+    d->dispatchRequests();
+    return true;
+}
+
+/*!
+    Aborts the running crawl. No more requests are sent and the results of requests
+    in flight are discarded. \l finished() is emitted with \c BadRequestCancelledByClient.
+*/
+void QOpcUaAddressSpaceCrawler::abort()
+{
+    Q_D(QOpcUaAddressSpaceCrawler);
+    if (d->m_running)
+        d->finish(QOpcUa::UaStatusCode::BadRequestCancelledByClient);
+}
+
+/*!
+    Returns \c true if a crawl is in progress.
+*/
+bool QOpcUaAddressSpaceCrawler::isRunning() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_running;
+}
+
+/*!
+    Returns the number of distinct nodes which have been discovered, including the nodes
+    which did not match the node class filter.
+*/
+quint64 QOpcUaAddressSpaceCrawler::discoveredNodeCount() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_discoveredNodeCount;
+}
+
+/*!
+    Returns the number of nodes which have been browsed.
+*/
+quint64 QOpcUaAddressSpaceCrawler::browsedNodeCount() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_browsedNodeCount;
+}
+
+/*!
+    Returns the number of references which pointed to an already known node.
+*/
+quint64 QOpcUaAddressSpaceCrawler::duplicateReferenceCount() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_duplicateReferenceCount;
+}
+
+/*!
+    Returns the number of nodes for which the browse operation has failed.
+*/
+quint64 QOpcUaAddressSpaceCrawler::failedNodeCount() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_failedNodeCount;
+}
+
+/*!
+    Returns the number of attribute values which have been delivered in \l attributesRead().
+*/
+quint64 QOpcUaAddressSpaceCrawler::readResultCount() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_readResultCount;
+}
+
+/*!
+    Returns the number of batched browse requests which have been sent.
+*/
+quint64 QOpcUaAddressSpaceCrawler::browseRequestCount() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_browseRequestCount;
+}
+
+/*!
+    Returns the number of batched read requests which have been sent.
+*/
+quint64 QOpcUaAddressSpaceCrawler::readRequestCount() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_readRequestCount;
+}
+
+/*!
+    Returns the time in milliseconds since the start of the crawl or the duration of the last crawl.
+*/
+qint64 QOpcUaAddressSpaceCrawler::elapsed() const
+{
+    Q_D(const QOpcUaAddressSpaceCrawler);
+    return d->m_running ? d->m_timer.elapsed() : d->m_elapsed;
+}
+
+/*!
+    Returns the number of discovered nodes per second.
+*/
+double QOpcUaAddressSpaceCrawler::nodesPerSecond() const
+{
+    const qint64 milliseconds = elapsed();
+    return milliseconds > 0 ? discoveredNodeCount() * 1000.0 / milliseconds : 0.0;
+}
+
+QOpcUaAddressSpaceCrawlerPrivate::QOpcUaAddressSpaceCrawlerPrivate(QOpcUaClient *client)
+    : m_client(client)
+{
+    m_browseRequest.setReferenceTypeId(QOpcUa::ReferenceTypeId::HierarchicalReferences);
+    m_browseRequest.setIncludeSubtypes(true);
+}
+
+void QOpcUaAddressSpaceCrawlerPrivate::dispatchRequests()
+{
+    while (m_running && requestsInFlight() < m_maxRequestsInFlight) {
+        // Full read requests are sent first to keep the number of queued read items bounded
+        if (m_readQueue.size() >= m_batchSize) {
+            if (!sendReadRequest())
+                return;
+        } else if (!m_browseQueue.isEmpty()) {
+            if (!sendBrowseRequest())
+                return;
+        } else if (!m_readQueue.isEmpty() && m_pendingBrowseRequests.isEmpty()) {
+            // The last partial read request is sent when all nodes have been browsed
+            if (!sendReadRequest())
+                return;
+        } else {
+            break;
+        }
+    }
+
+    if (m_running && requestsInFlight() == 0)
+        finish(QOpcUa::UaStatusCode::Good);
+}
+
+bool QOpcUaAddressSpaceCrawlerPrivate::sendBrowseRequest()
+{
+    const int count = qMin(m_batchSize, m_browseQueue.size());
+
+    QStringList nodeIds;
+    nodeIds.reserve(count);
+    for (int i = 0; i < count; ++i)
+        nodeIds.push_back(m_browseQueue.dequeue());
+
+    // The results are identified by the request handle, results for the same node ids requested by others are ignored
+    const quint64 requestHandle = clientImpl()->dispatchBrowseNodes(nodeIds, m_browseRequest, 0);
+    if (!requestHandle) {
+        qCWarning(QT_OPCUA) << "Failed to dispatch browse request for" << count << "nodes";
+        if (m_browseRequestCount)
+            finish(QOpcUa::UaStatusCode::BadInternalError);
+        return false;
+    }
+
+    m_pendingBrowseRequests.insert(requestHandle, count);
+    ++m_browseRequestCount;
+    return true;
+}
+
+bool QOpcUaAddressSpaceCrawlerPrivate::sendReadRequest()
+{
+    Q_Q(QOpcUaAddressSpaceCrawler);
+
+    const int count = qMin(m_batchSize, m_readQueue.size());
+    const QVector<QOpcUaReadItem> items = m_readQueue.mid(0, count);
+    m_readQueue.remove(0, count);
+
+    const QFuture<QVector<QOpcUaReadResult>> future = m_client->readNodeAttributesAsync(items);
+    if (future.isCanceled()) {
+        qCWarning(QT_OPCUA) << "Failed to dispatch read request for" << count << "attributes";
+        finish(QOpcUa::UaStatusCode::BadInternalError);
+        return false;
+    }
+
+    // The future is finished by the response to this request only
+    auto watcher = new QFutureWatcher<QVector<QOpcUaReadResult>>(q);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, q, [this, watcher]() {
+        handleReadNodeAttributesFinished(watcher);
+    });
+    m_pendingReadRequests.insert(watcher, count);
+    watcher->setFuture(future);
+
+    ++m_readRequestCount;
+    return true;
+}
+
+void QOpcUaAddressSpaceCrawlerPrivate::finish(QOpcUa::UaStatusCode statusCode, bool emitFinished)
+{
+    Q_Q(QOpcUaAddressSpaceCrawler);
+
+    m_elapsed = m_timer.elapsed();
+    m_running = false;
+
+    for (const auto &connection : qAsConst(m_connections))
+        QObject::disconnect(connection);
+    m_connections.clear();
+
+    m_browseQueue.clear();
+    m_knownNodes.clear();
+    m_pendingBrowseRequests.clear();
+    m_readQueue.clear();
+
+    // The results of reads in flight are discarded
+    for (auto it = m_pendingReadRequests.constBegin(); it != m_pendingReadRequests.constEnd(); ++it) {
+        QObject::disconnect(it.key(), nullptr, q, nullptr);
+        it.key()->deleteLater();
+    }
+    m_pendingReadRequests.clear();
+
+    if (emitFinished)
+        emit q->finished(statusCode);
+}
+
+void QOpcUaAddressSpaceCrawlerPrivate::handleBrowseNodesFinished(quint64 requestHandle, const QString &nodeId,
+                                                                 const QVector<QOpcUaReferenceDescription> &references,
+                                                                 QOpcUa::UaStatusCode statusCode)
+{
+    Q_Q(QOpcUaAddressSpaceCrawler);
+
+    const auto request = m_pendingBrowseRequests.find(requestHandle);
+    if (request == m_pendingBrowseRequests.end())
+        return; // Not requested by the crawler
+
+    if (--request.value() == 0)
+        m_pendingBrowseRequests.erase(request);
+
+    ++m_browsedNodeCount;
+    if (statusCode != QOpcUa::UaStatusCode::Good) {
+        qCDebug(QT_OPCUA) << "Browsing" << nodeId << "failed:" << statusCode;
+        ++m_failedNodeCount;
+    }
+
+    QVector<QOpcUaReferenceDescription> discovered;
+
+    for (const auto &reference : references) {
+        const QString target = targetNodeId(reference);
+        if (target.isEmpty())
+            continue;
+
+        const int knownNodes = m_knownNodes.size();
+        m_knownNodes.insert(target);
+        if (m_knownNodes.size() == knownNodes) {
+            ++m_duplicateReferenceCount;
+            continue;
+        }
+
+        ++m_discoveredNodeCount;
+        m_browseQueue.enqueue(target);
+
+        if (m_nodeClassFilter && !(m_nodeClassFilter & reference.nodeClass()))
+            continue;
+
+        discovered.push_back(reference);
+        for (const auto attribute : qAsConst(m_attributeList))
+            m_readQueue.push_back(QOpcUaReadItem(target, attribute));
+    }
+
+    if (!discovered.isEmpty())
+        emit q->nodesDiscovered(nodeId, discovered);
+
+    // The signal handler might have aborted the crawl
+    dispatchRequests();
+}
+
+void QOpcUaAddressSpaceCrawlerPrivate::handleReadNodeAttributesFinished(QFutureWatcher<QVector<QOpcUaReadResult>> *watcher)
+{
+    Q_Q(QOpcUaAddressSpaceCrawler);
+
+    const int count = m_pendingReadRequests.take(watcher);
+    watcher->deleteLater();
+
+    // The future is canceled if the client has been destroyed
+    const QVector<QOpcUaReadResult> results = watcher->isCanceled() ? QVector<QOpcUaReadResult>() : watcher->result();
+
+    // A failed Read service delivers a result with the service result for each attribute
+    if (results.size() != count)
+        qCWarning(QT_OPCUA) << "Reading" << count << "attributes failed";
+
+    m_readResultCount += results.size();
+
+    if (!results.isEmpty())
+        emit q->attributesRead(results);
+
+    dispatchRequests();
+}
+
+void QOpcUaAddressSpaceCrawlerPrivate::handleStateChanged(QOpcUaClient::ClientState state)
+{
+    if (state == QOpcUaClient::Disconnected && m_running)
+        finish(QOpcUa::UaStatusCode::BadConnectionClosed);
+}
+
+QString QOpcUaAddressSpaceCrawlerPrivate::targetNodeId(const QOpcUaReferenceDescription &reference) const
+{
+    const QOpcUaExpandedNodeId target = reference.targetNodeId();
+
+    // Nodes on other servers are not crawled
+    if (target.serverIndex())
+        return QString();
+
+    if (target.namespaceUri().isEmpty())
+        return target.nodeId();
+
+    bool ok = false;
+    const QString nodeId = m_client->resolveExpandedNodeId(target, &ok);
+    return ok ? nodeId : QString();
+}
+
+int QOpcUaAddressSpaceCrawlerPrivate::requestsInFlight() const
+{
+    return m_pendingBrowseRequests.size() + m_pendingReadRequests.size();
+}
+
+QOpcUaClientImpl *QOpcUaAddressSpaceCrawlerPrivate::clientImpl() const
+{
+    return static_cast<QOpcUaClientPrivate *>(QObjectPrivate::get(m_client.data()))->m_impl.data();
+}
+
+QT_END_NAMESPACE
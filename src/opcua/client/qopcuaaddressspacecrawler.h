@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPCUAADDRESSSPACECRAWLER_H
+#define QOPCUAADDRESSSPACECRAWLER_H
+
+#include <QtOpcUa/qopcuatype.h>
+#include <QtOpcUa/qopcuabrowserequest.h>
+#include <QtOpcUa/qopcuareadresult.h>
+#include <QtOpcUa/qopcuareferencedescription.h>
+
+#include <QtCore/qobject.h>
+
+QT_BEGIN_NAMESPACE
+
+class QOpcUaClient;
+class QOpcUaAddressSpaceCrawlerPrivate;
+
+class Q_OPCUA_EXPORT QOpcUaAddressSpaceCrawler : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QOpcUaAddressSpaceCrawler)
+
+public:
+    explicit QOpcUaAddressSpaceCrawler(QOpcUaClient *client, QObject *parent = nullptr);
+    ~QOpcUaAddressSpaceCrawler();
+
+    QOpcUaBrowseRequest browseRequest() const;
+    void setBrowseRequest(const QOpcUaBrowseRequest &request);
+
+    QOpcUa::NodeClasses nodeClassFilter() const;
+    void setNodeClassFilter(QOpcUa::NodeClasses nodeClasses);
+
+    QOpcUa::NodeAttributes attributesToRead() const;
+    void setAttributesToRead(QOpcUa::NodeAttributes attributes);
+
+    int maxRequestsInFlight() const;
+    void setMaxRequestsInFlight(int maxRequests);
+
+    int batchSize() const;
+    void setBatchSize(int batchSize);
+
+    bool start(const QString &startNodeId);
+    void abort();
+    bool isRunning() const;
+
+    quint64 discoveredNodeCount() const;
+    quint64 browsedNodeCount() const;
+    quint64 duplicateReferenceCount() const;
+    quint64 failedNodeCount() const;
+    quint64 readResultCount() const;
+    quint64 browseRequestCount() const;
+    quint64 readRequestCount() const;
+    qint64 elapsed() const;
+    double nodesPerSecond() const;
+
+Q_SIGNALS:
+    void nodesDiscovered(QString parentNodeId, QVector<QOpcUaReferenceDescription> nodes);
+    void attributesRead(QVector<QOpcUaReadResult> results);
+    void finished(QOpcUa::UaStatusCode statusCode);
+
+private:
+    Q_DISABLE_COPY(QOpcUaAddressSpaceCrawler)
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAADDRESSSPACECRAWLER_H
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPCUAADDRESSSPACECRAWLER_P_H
+#define QOPCUAADDRESSSPACECRAWLER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaaddressspacecrawler.h>
+#include <QtOpcUa/qopcuaclient.h>
+#include <QtOpcUa/qopcuareaditem.h>
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfuturewatcher.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qset.h>
+#include <private/qobject_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QOpcUaClientImpl;
+
+class QOpcUaAddressSpaceCrawlerPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QOpcUaAddressSpaceCrawler)
+
+public:
+    QOpcUaAddressSpaceCrawlerPrivate(QOpcUaClient *client);
+
+    void dispatchRequests();
+    bool sendBrowseRequest();
+    bool sendReadRequest();
+    void finish(QOpcUa::UaStatusCode statusCode, bool emitFinished = true);
+
+    void handleBrowseNodesFinished(quint64 requestHandle, const QString &nodeId, const QVector<QOpcUaReferenceDescription> &references,
+                                   QOpcUa::UaStatusCode statusCode);
+    void handleReadNodeAttributesFinished(QFutureWatcher<QVector<QOpcUaReadResult>> *watcher);
+    void handleStateChanged(QOpcUaClient::ClientState state);
+
+    QString targetNodeId(const QOpcUaReferenceDescription &reference) const;
+    int requestsInFlight() const;
+    QOpcUaClientImpl *clientImpl() const;
+
+    QPointer<QOpcUaClient> m_client;
+    QVector<QMetaObject::Connection> m_connections;
+
+    QOpcUaBrowseRequest m_browseRequest;
+    QOpcUa::NodeClasses m_nodeClassFilter;
+    QOpcUa::NodeAttributes m_attributesToRead;
+    QVector<QOpcUa::NodeAttribute> m_attributeList;
+    int m_maxRequestsInFlight = 4;
+    int m_batchSize = 1000;
+
+    bool m_running = false;
+
+    QQueue<QString> m_browseQueue;
+    QSet<QString> m_knownNodes;
+    QHash<quint64, int> m_pendingBrowseRequests; // Request handle -> number of unfinished nodes
+
+    QVector<QOpcUaReadItem> m_readQueue;
+    QHash<QFutureWatcher<QVector<QOpcUaReadResult>> *, int> m_pendingReadRequests; // Watcher -> number of attributes
+
+    quint64 m_discoveredNodeCount = 0;
+    quint64 m_browsedNodeCount = 0;
+    quint64 m_duplicateReferenceCount = 0;
+    quint64 m_failedNodeCount = 0;
+    quint64 m_readResultCount = 0;
+    quint64 m_browseRequestCount = 0;
+    quint64 m_readRequestCount = 0;
+    QElapsedTimer m_timer;
+    qint64 m_elapsed = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAADDRESSSPACECRAWLER_P_H
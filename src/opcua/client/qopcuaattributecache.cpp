@@ -0,0 +1,200 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuaattributecache_p.h"
+
+#include <private/qopcuabackend_p.h>
+
+QT_BEGIN_NAMESPACE
+
+QOpcUaAttributeCache::QOpcUaAttributeCache(int maxNodes)
+    : m_nodes(qMax(0, maxNodes))
+{
+    m_clock.start();
+}
+
+void QOpcUaAttributeCache::setMaxNodes(int maxNodes)
+{
+    m_nodes.setMaxCost(qMax(0, maxNodes));
+}
+
+int QOpcUaAttributeCache::maxNodes() const
+{
+    return m_nodes.maxCost();
+}
+
+bool QOpcUaAttributeCache::isEnabled() const
+{
+    return m_nodes.maxCost() > 0;
+}
+
+bool QOpcUaAttributeCache::attributes(const QString &nodeId, QOpcUa::NodeAttributes attributes, double maxAge,
+                                      QVector<QOpcUaReadResult> *results)
+{
+    QVector<QOpcUaReadResult> found;
+    bool complete = isEnabled() && maxAge > 0;
+
+    int count = 0;
+    qt_forEachAttribute(attributes, [&](QOpcUa::NodeAttribute attribute) {
+        ++count;
+        if (!complete)
+            return;
+        const Value *value = freshValue(nodeId, attribute, maxAge);
+        if (value)
+            found.push_back(value->result);
+        else
+            complete = false;
+    });
+
+    if (!complete || !count) {
+        m_missCount += count;
+        return false;
+    }
+
+    m_hitCount += count;
+    *results = found;
+    return true;
+}
+
+bool QOpcUaAttributeCache::readItems(const QVector<QOpcUaReadItem> &items, double maxAge, QVector<QOpcUaReadResult> *results)
+{
+    QVector<QOpcUaReadResult> found;
+    bool complete = isEnabled() && maxAge > 0 && !items.isEmpty();
+
+    for (const auto &item : items) {
+        // Partial values are not cached
+        const Value *value = item.indexRange().isEmpty() ? freshValue(item.nodeId(), item.attribute(), maxAge) : nullptr;
+        if (!value) {
+            complete = false;
+            break;
+        }
+        QOpcUaReadResult result = value->result;
+        result.setNodeId(item.nodeId());
+        found.push_back(result);
+    }
+
+    if (!complete) {
+        m_missCount += items.size();
+        return false;
+    }
+
+    m_hitCount += items.size();
+    *results = found;
+    return true;
+}
+
+void QOpcUaAttributeCache::insert(const QString &nodeId, const QOpcUaReadResult &result)
+{
+    if (!isEnabled() || !result.indexRange().isEmpty() || result.statusCode() != QOpcUa::UaStatusCode::Good)
+        return;
+
+    Node *node = m_nodes.object(nodeId);
+    if (!node) {
+        node = new Node;
+        if (!m_nodes.insert(nodeId, node))
+            return;
+    }
+
+    Value &value = node->values[result.attribute()];
+    value.result = result;
+    value.received = m_clock.elapsed();
+}
+
+void QOpcUaAttributeCache::remove(const QString &nodeId, QOpcUa::NodeAttribute attribute)
+{
+    if (Node *node = m_nodes.object(nodeId))
+        node->values.remove(attribute);
+}
+
+void QOpcUaAttributeCache::setMonitoringInterval(const QString &nodeId, QOpcUa::NodeAttribute attribute, double interval)
+{
+    m_monitoringIntervals[nodeId].insert(attribute, qMax(0.0, interval));
+}
+
+void QOpcUaAttributeCache::clearMonitoringInterval(const QString &nodeId, QOpcUa::NodeAttribute attribute)
+{
+    auto it = m_monitoringIntervals.find(nodeId);
+    if (it == m_monitoringIntervals.end())
+        return;
+
+    it->remove(attribute);
+    if (it->isEmpty())
+        m_monitoringIntervals.erase(it);
+}
+
+void QOpcUaAttributeCache::clear()
+{
+    m_nodes.clear();
+    m_monitoringIntervals.clear();
+}
+
+quint64 QOpcUaAttributeCache::hitCount() const
+{
+    return m_hitCount;
+}
+
+quint64 QOpcUaAttributeCache::missCount() const
+{
+    return m_missCount;
+}
+
+const QOpcUaAttributeCache::Value *QOpcUaAttributeCache::freshValue(const QString &nodeId, QOpcUa::NodeAttribute attribute,
+                                                                     double maxAge)
+{
+    const Node *node = m_nodes.object(nodeId);
+    if (!node)
+        return nullptr;
+
+    const auto value = node->values.constFind(attribute);
+    if (value == node->values.constEnd())
+        return nullptr;
+
+    if (m_clock.elapsed() - value->received <= maxAge)
+        return &value.value();
+
+    // The data change notifications keep the value of a monitored attribute current
+    const auto intervals = m_monitoringIntervals.constFind(nodeId);
+    if (intervals != m_monitoringIntervals.constEnd()) {
+        const auto interval = intervals->constFind(attribute);
+        if (interval != intervals->constEnd() && *interval <= maxAge)
+            return &value.value();
+    }
+
+    return nullptr;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPCUAATTRIBUTECACHE_P_H
+#define QOPCUAATTRIBUTECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuareaditem.h>
+#include <QtOpcUa/qopcuareadresult.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qcache.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+
+QT_BEGIN_NAMESPACE
+
+// Client wide cache of attribute values which answers reads with a maximum age.
+// A value is fresh if it has been received less than maxAge milliseconds ago or if the attribute is
+// monitored with publishing and sampling intervals not exceeding maxAge.
+// The cache is bounded by the number of nodes, the least recently used nodes are dropped first.
+class QOpcUaAttributeCache
+{
+public:
+    explicit QOpcUaAttributeCache(int maxNodes = 0);
+
+    void setMaxNodes(int maxNodes);
+    int maxNodes() const;
+    bool isEnabled() const;
+
+    // Lookups succeed only if fresh values for all requested attributes are available
+    bool attributes(const QString &nodeId, QOpcUa::NodeAttributes attributes, double maxAge, QVector<QOpcUaReadResult> *results);
+    bool readItems(const QVector<QOpcUaReadItem> &items, double maxAge, QVector<QOpcUaReadResult> *results);
+
+    void insert(const QString &nodeId, const QOpcUaReadResult &result);
+    void remove(const QString &nodeId, QOpcUa::NodeAttribute attribute);
+    void setMonitoringInterval(const QString &nodeId, QOpcUa::NodeAttribute attribute, double interval);
+    void clearMonitoringInterval(const QString &nodeId, QOpcUa::NodeAttribute attribute);
+    void clear();
+
+    quint64 hitCount() const;
+    quint64 missCount() const;
+
+private:
+    struct Value {
+        QOpcUaReadResult result;
+        qint64 received = 0;
+    };
+
+    struct Node {
+        QHash<QOpcUa::NodeAttribute, Value> values;
+    };
+
+    const Value *freshValue(const QString &nodeId, QOpcUa::NodeAttribute attribute, double maxAge);
+
+    QCache<QString, Node> m_nodes;
+    QHash<QString, QHash<QOpcUa::NodeAttribute, double>> m_monitoringIntervals; // Kept separately, they must not be evicted
+    QElapsedTimer m_clock;
+    quint64 m_hitCount = 0;
+    quint64 m_missCount = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAATTRIBUTECACHE_P_H
@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAATTRIBUTESTORAGE_P_H
+#define QOPCUAATTRIBUTESTORAGE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+// Stores one value per node attribute without the per entry allocations of a QHash.
+// The attributes which have a value are tracked in a bit mask and the values are kept
+// in attribute order, the position of a value is the number of lower attributes present.
+// An empty storage does not allocate.
+template <typename T>
+class QOpcUaAttributeStorage
+{
+public:
+    bool isEmpty() const { return m_mask == 0; }
+    int size() const { return m_values.size(); }
+    QOpcUa::NodeAttributes attributes() const { return QOpcUa::NodeAttributes(QFlag(int(m_mask))); }
+
+    bool contains(QOpcUa::NodeAttribute attribute) const
+    {
+        return m_mask & bit(attribute);
+    }
+
+    const T *find(QOpcUa::NodeAttribute attribute) const
+    {
+        return contains(attribute) ? &m_values.at(index(attribute)) : nullptr;
+    }
+
+    T *find(QOpcUa::NodeAttribute attribute)
+    {
+        return contains(attribute) ? &m_values[index(attribute)] : nullptr;
+    }
+
+    T value(QOpcUa::NodeAttribute attribute, const T &defaultValue = T()) const
+    {
+        const T *entry = find(attribute);
+        return entry ? *entry : defaultValue;
+    }
+
+    // Values for anything but a single attribute are not stored, they are written to a scratch value
+    T &operator[](QOpcUa::NodeAttribute attribute)
+    {
+        if (!bit(attribute)) {
+            static thread_local T discarded;
+            discarded = T();
+            return discarded;
+        }
+        if (!contains(attribute)) {
+            m_values.insert(index(attribute), T());
+            m_mask |= bit(attribute);
+        }
+        return m_values[index(attribute)];
+    }
+
+    bool remove(QOpcUa::NodeAttribute attribute)
+    {
+        if (!contains(attribute))
+            return false;
+        m_values.remove(index(attribute));
+        m_mask &= ~bit(attribute);
+        return true;
+    }
+
+    void clear()
+    {
+        m_values.clear();
+        m_mask = 0;
+    }
+
+    // Calls f(attribute, value) for all stored values in attribute order
+    template <typename F>
+    void forEach(F f) const
+    {
+        quint32 remaining = m_mask;
+        for (const T &entry : m_values) {
+            const quint32 lowest = remaining & (~remaining + 1);
+            remaining &= ~lowest;
+            f(static_cast<QOpcUa::NodeAttribute>(lowest), entry);
+        }
+    }
+
+private:
+    // Returns 0 for None and for values combining several attributes, they are never contained
+    static quint32 bit(QOpcUa::NodeAttribute attribute)
+    {
+        return qPopulationCount(quint32(attribute)) == 1 ? quint32(attribute) : 0;
+    }
+
+    int index(QOpcUa::NodeAttribute attribute) const
+    {
+        return int(qPopulationCount(m_mask & (bit(attribute) - 1)));
+    }
+
+    quint32 m_mask = 0;
+    QVector<T> m_values;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAATTRIBUTESTORAGE_P_H
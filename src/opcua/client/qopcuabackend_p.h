@@ -50,6 +50,7 @@
 
 #include <QtOpcUa/qopcuaclient.h>
 #include <QtOpcUa/qopcuaendpointdescription.h>
+#include <QtOpcUa/qopcuahistorydata.h>
 #include <private/qopcuanodeimpl_p.h>
 
 #include <QtCore/qobject.h>
@@ -86,6 +87,8 @@ Q_SIGNALS:
     void methodCallFinished(quint64 handle, QString methodNodeId, QVariant result, QOpcUa::UaStatusCode statusCode);
 
     void dataChangeOccurred(quint64 handle, QOpcUaReadResult res);
+    void dataChangesOccurred(QVector<quint64> handles, QVector<QOpcUaReadResult> results);
+    void dataChangesAvailable();
     void eventOccurred(quint64 handle, QVariantList fields);
     void monitoringEnableDisable(quint64 handle, QOpcUa::NodeAttribute attr, bool subscribe, QOpcUaMonitoringParameters status);
     void monitoringStatusChanged(quint64 handle, QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items,
@@ -98,6 +101,15 @@ Q_SIGNALS:
     void findServersFinished(QVector<QOpcUaApplicationDescription> servers, QOpcUa::UaStatusCode statusCode, QUrl requestUrl);
     void readNodeAttributesFinished(QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult);
     void writeNodeAttributesFinished(QVector<QOpcUaWriteResult> results, QOpcUa::UaStatusCode serviceResult);
+    void valuesRead(quint64 requestHandle, QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult);
+    void valuesWritten(quint64 requestHandle, QVector<QOpcUaWriteResult> results, QOpcUa::UaStatusCode serviceResult);
+    void callMethodsFinished(quint64 requestHandle, QVector<QOpcUaCallMethodResult> results, QOpcUa::UaStatusCode serviceResult);
+    void browseNodesFinished(quint64 requestHandle, QString nodeId, QVector<QOpcUaReferenceDescription> references,
+                             QOpcUa::UaStatusCode statusCode);
+    void historyDataReceived(quint64 handle, QVector<QOpcUaHistoryData> data);
+    void historyReadFinished(quint64 handle, QOpcUa::UaStatusCode statusCode);
+    void registerNodesFinished(QStringList nodeIds, QStringList registeredNodeIds, QOpcUa::UaStatusCode statusCode);
+    void unregisterNodesFinished(QStringList nodeIds, QOpcUa::UaStatusCode statusCode);
 
     void addNodeFinished(QOpcUaExpandedNodeId requestedNodeId, QString assignedNodeId, QOpcUa::UaStatusCode statusCode);
     void deleteNodeFinished(QString nodeId, QOpcUa::UaStatusCode statusCode);
@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuacallmethoditem.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaCallMethodItem
+    \inmodule QtOpcUa
+    \since QtOpcUa 5.15
+    \brief This class stores the options for a single method call in a batch call operation.
+
+    A method call on an OPC UA server invokes a method of an object node with a list of input arguments.
+    This class contains the node ids of the object and the method and the input arguments for one call.
+
+    One or multiple objects of this class make up the request of a \l QOpcUaClient::callMethods() operation.
+
+    \sa QOpcUaClient::callMethods() QOpcUaCallMethodResult
+*/
+class QOpcUaCallMethodItemData : public QSharedData
+{
+public:
+    QString objectId;
+    QString methodId;
+    QVector<QOpcUa::TypedVariant> inputArguments;
+};
+
+QOpcUaCallMethodItem::QOpcUaCallMethodItem()
+    : data(new QOpcUaCallMethodItemData)
+{
+}
+
+/*!
+    Creates a new call method item from \a other.
+*/
+QOpcUaCallMethodItem::QOpcUaCallMethodItem(const QOpcUaCallMethodItem &other)
+    : data(other.data)
+{
+}
+
+/*!
+    Creates a call method item which calls the method \a methodId of the object \a objectId
+    with the input arguments \a inputArguments.
+*/
+QOpcUaCallMethodItem::QOpcUaCallMethodItem(const QString &objectId, const QString &methodId,
+                                           const QVector<QOpcUa::TypedVariant> &inputArguments)
+    : data(new QOpcUaCallMethodItemData)
+{
+    setObjectId(objectId);
+    setMethodId(methodId);
+    setInputArguments(inputArguments);
+}
+
+/*!
+    Sets the values from \a rhs in this call method item.
+*/
+QOpcUaCallMethodItem &QOpcUaCallMethodItem::operator=(const QOpcUaCallMethodItem &rhs)
+{
+    if (this != &rhs)
+        data.operator=(rhs.data);
+    return *this;
+}
+
+QOpcUaCallMethodItem::~QOpcUaCallMethodItem()
+{
+}
+
+/*!
+    Returns the node id of the object the method is called on.
+*/
+QString QOpcUaCallMethodItem::objectId() const
+{
+    return data->objectId;
+}
+
+/*!
+    Sets the node id of the object the method is called on to \a objectId.
+*/
+void QOpcUaCallMethodItem::setObjectId(const QString &objectId)
+{
+    data->objectId = objectId;
+}
+
+/*!
+    Returns the node id of the method to call.
+*/
+QString QOpcUaCallMethodItem::methodId() const
+{
+    return data->methodId;
+}
+
+/*!
+    Sets the node id of the method to call to \a methodId.
+*/
+void QOpcUaCallMethodItem::setMethodId(const QString &methodId)
+{
+    data->methodId = methodId;
+}
+
+/*!
+    Returns the input arguments of the method call.
+*/
+QVector<QOpcUa::TypedVariant> QOpcUaCallMethodItem::inputArguments() const
+{
+    return data->inputArguments;
+}
+
+/*!
+    Sets the input arguments of the method call to \a inputArguments.
+    The type information is used to convert the values to a SDK specific data type.
+*/
+void QOpcUaCallMethodItem::setInputArguments(const QVector<QOpcUa::TypedVariant> &inputArguments)
+{
+    data->inputArguments = inputArguments;
+}
+
+QT_END_NAMESPACE
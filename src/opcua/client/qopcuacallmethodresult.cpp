@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuacallmethodresult.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaCallMethodResult
+    \inmodule QtOpcUa
+    \since QtOpcUa 5.15
+    \brief This class stores the result of a single method call in a batch call operation.
+
+    For each method call, the server returns a status code, the output arguments of the method
+    and a status code for each input argument.
+
+    In addition to the values returned by the server, this class also contains the object id and the
+    method id from the request to enable a client to match the result with a request.
+
+    Objects of this class are returned in the \l QOpcUaClient::callMethodsFinished()
+    signal and contain the result of a method call that was part of a \l QOpcUaClient::callMethods()
+    request.
+
+    \sa QOpcUaClient::callMethods() QOpcUaClient::callMethodsFinished() QOpcUaCallMethodItem
+*/
+class QOpcUaCallMethodResultData : public QSharedData
+{
+public:
+    QString objectId;
+    QString methodId;
+    QVariantList outputArguments;
+    QVector<QOpcUa::UaStatusCode> inputArgumentResults;
+    QOpcUa::UaStatusCode statusCode {QOpcUa::UaStatusCode::Good};
+};
+
+QOpcUaCallMethodResult::QOpcUaCallMethodResult()
+    : data(new QOpcUaCallMethodResultData)
+{
+}
+
+/*!
+    Constructs a call method result from \a other.
+*/
+QOpcUaCallMethodResult::QOpcUaCallMethodResult(const QOpcUaCallMethodResult &other)
+    : data(other.data)
+{
+}
+
+/*!
+    Sets the values from \a rhs in this call method result.
+*/
+QOpcUaCallMethodResult &QOpcUaCallMethodResult::operator=(const QOpcUaCallMethodResult &rhs)
+{
+    if (this != &rhs)
+        data.operator=(rhs.data);
+    return *this;
+}
+
+QOpcUaCallMethodResult::~QOpcUaCallMethodResult()
+{
+}
+
+/*!
+    Returns the node id of the object the method was called on.
+*/
+QString QOpcUaCallMethodResult::objectId() const
+{
+    return data->objectId;
+}
+
+/*!
+    Sets the node id of the object the method was called on to \a objectId.
+*/
+void QOpcUaCallMethodResult::setObjectId(const QString &objectId)
+{
+    data->objectId = objectId;
+}
+
+/*!
+    Returns the node id of the called method.
+*/
+QString QOpcUaCallMethodResult::methodId() const
+{
+    return data->methodId;
+}
+
+/*!
+    Sets the node id of the called method to \a methodId.
+*/
+void QOpcUaCallMethodResult::setMethodId(const QString &methodId)
+{
+    data->methodId = methodId;
+}
+
+/*!
+    Returns the output arguments of the method call in the order defined by the method.
+*/
+QVariantList QOpcUaCallMethodResult::outputArguments() const
+{
+    return data->outputArguments;
+}
+
+/*!
+    Sets the output arguments of the method call to \a outputArguments.
+*/
+void QOpcUaCallMethodResult::setOutputArguments(const QVariantList &outputArguments)
+{
+    data->outputArguments = outputArguments;
+}
+
+/*!
+    Returns the status codes for the input arguments of the method call.
+
+    The list is empty if the server reported no problems with the input arguments.
+*/
+QVector<QOpcUa::UaStatusCode> QOpcUaCallMethodResult::inputArgumentResults() const
+{
+    return data->inputArgumentResults;
+}
+
+/*!
+    Sets the status codes for the input arguments of the method call to \a inputArgumentResults.
+*/
+void QOpcUaCallMethodResult::setInputArgumentResults(const QVector<QOpcUa::UaStatusCode> &inputArgumentResults)
+{
+    data->inputArgumentResults = inputArgumentResults;
+}
+
+/*!
+    Returns the status code of the method call.
+*/
+QOpcUa::UaStatusCode QOpcUaCallMethodResult::statusCode() const
+{
+    return data->statusCode;
+}
+
+/*!
+    Sets the status code of the method call to \a statusCode.
+*/
+void QOpcUaCallMethodResult::setStatusCode(QOpcUa::UaStatusCode statusCode)
+{
+    data->statusCode = statusCode;
+}
+
+QT_END_NAMESPACE
@@ -39,6 +39,8 @@
 #include "qopcuaexpandednodeid.h"
 #include "qopcuaqualifiedname.h"
 
+#include <private/qopcuaaddressspacecache_p.h>
+#include <private/qopcuaattributecache_p.h>
 #include <private/qopcuaclient_p.h>
 
 #include <QtCore/qloggingcategory.h>
@@ -239,11 +241,128 @@ Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA)
 
     The elements in \a results have the same order as the elements in the request. For each requested element,
     there is a value together with timestamps and the status code in \a results.
-    \a serviceResult contains the status code from the OPC UA Read service.
+    \a serviceResult contains the status code from the OPC UA Read service. If the request has been split
+    according to the operation limits of the server and one of the Read requests has failed, the entries
+    which have not been read have \a serviceResult as status code.
 
     \sa readNodeAttributes() QOpcUaReadResult QOpcUaReadItem
 */
 
+/*!
+    \fn void QOpcUaClient::browseNodesFinished(QString nodeId, QVector<QOpcUaReferenceDescription> references, QOpcUa::UaStatusCode statusCode)
+
+    This signal is emitted once for every node of a \l browseNodes() operation after all references
+    of the node with id \a nodeId have been received.
+
+    \a references contains the references of the node. \a statusCode contains the result of the
+    Browse service for the node. If \a statusCode is not good, \a references may contain the
+    references received before the error occurred.
+
+    \sa browseNodes()
+*/
+
+/*!
+    \fn void QOpcUaClient::registerNodesFinished(QStringList nodeIds, QStringList registeredNodeIds, QOpcUa::UaStatusCode statusCode)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after a \l registerNodes() operation has finished and after the registered nodes
+    have been restored on a new connection.
+
+    \a registeredNodeIds contains the ids the server has assigned to the nodes in \a nodeIds, in the same order.
+    \a statusCode contains the result of the RegisterNodes service. If \a statusCode is not good,
+    \a registeredNodeIds only contains the ids of the nodes which have been registered before the error occurred.
+
+    \sa registerNodes()
+*/
+
+/*!
+    \fn void QOpcUaClient::unregisterNodesFinished(QStringList nodeIds, QOpcUa::UaStatusCode statusCode)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after an \l unregisterNodes() operation for \a nodeIds has finished.
+    \a statusCode contains the result of the UnregisterNodes service, it is \c BadNothingToDo
+    if none of the nodes has been registered.
+
+    \sa unregisterNodes()
+*/
+
+/*!
+    \fn void QOpcUaClient::dataChangesOccurred(QVector<QOpcUaReadResult> results)
+    \since QtOpcUa 5.15
+
+    This signal is emitted for data change notifications received by the client.
+    The backend collects the notifications of all monitored items from one publish
+    response and delivers them to the client at once.
+
+    Each element in \a results contains the node id, the attribute, the value together
+    with the timestamps and the status code of one data change notification.
+    The \l QOpcUaNode::dataChangeOccurred() signals of the affected nodes are emitted
+    before this signal.
+
+    Applications which monitor a large number of items can use this signal to process
+    all changes in one place instead of connecting to the signals of every node.
+
+    Data changes for value handles are not part of \a results, they are delivered in \l valuesChanged().
+
+    \sa QOpcUaNode::dataChangeOccurred()
+*/
+
+/*!
+    \fn void QOpcUaClient::valuesRead(QVector<quint64> handles, QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after a \l readValues() operation for \a handles has finished.
+
+    \a results contains one element for each handle in the same order. If the Read service failed,
+    the status code of every element is set to \a serviceResult.
+
+    \sa readValues()
+*/
+
+/*!
+    \fn void QOpcUaClient::valuesWritten(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results, QOpcUa::UaStatusCode serviceResult)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after a \l writeValues() operation for \a handles has finished.
+
+    \a results contains the status code of the write for each handle in the same order.
+    If the Write service failed, every element is set to \a serviceResult.
+
+    \sa writeValues()
+*/
+
+/*!
+    \fn void QOpcUaClient::valuesChanged(QVector<quint64> handles, QVector<QOpcUaReadResult> values)
+    \since QtOpcUa 5.15
+
+    This signal is emitted for data change notifications of value handles monitored using \l enableValueMonitoring().
+
+    \a values contains the data change notification for the handle at the same position in \a handles.
+    A handle can occur more than once if the server has sent several notifications for it.
+
+    \sa enableValueMonitoring()
+*/
+
+/*!
+    \fn void QOpcUaClient::valueMonitoringEnabled(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after monitored items for \a handles have been created.
+    \a results contains the status code for each handle in the same order.
+
+    \sa enableValueMonitoring()
+*/
+
+/*!
+    \fn void QOpcUaClient::valueMonitoringDisabled(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after the monitored items for \a handles have been removed.
+    \a results contains the status code for each handle in the same order.
+
+    \sa disableValueMonitoring()
+*/
+
 /*!
     \fn void QOpcUaClient::writeNodeAttributesFinished(QVector<QOpcUaWriteResult> results, QOpcUa::UaStatusCode serviceResult)
 
@@ -253,13 +372,31 @@ Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA)
     They contain the value, timestamps and status code received from the server as well as the node id,
     attribute and index range from the write item. This facilitates matching the result with the request.
 
-    \a serviceResult is the status code from the the OPC UA Write service. If \a serviceResult is not
-    \l {QOpcUa::UaStatusCode} {Good}, the entries in \a results also have an invalid status code and must
-    not be used.
+    \a serviceResult is the status code from the the OPC UA Write service. If the request has been split
+    according to the operation limits of the server and one of the Write requests has failed, \a serviceResult
+    is the status code of the failed request. The entries in \a results then contain the status codes of the
+    writes which have already been answered by the server, the other entries have \a serviceResult as status code.
 
     \sa writeNodeAttributes() QOpcUaWriteResult
 */
 
+/*!
+    \fn void QOpcUaClient::callMethodsFinished(QVector<QOpcUaCallMethodResult> results, QOpcUa::UaStatusCode serviceResult)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after a \l callMethods() operation has finished.
+
+    \a results contains one entry for each method call of the request, in the same order.
+    Each entry contains the status code and the output arguments received from the server as well as the object id
+    and the method id from the call item.
+
+    \a serviceResult is the status code from the OPC UA Call service. If the request had to be split and one of
+    the Call service calls has failed, \a serviceResult is the status code of the failed call and the status code of
+    each method call which has not been answered by the server is set to \a serviceResult.
+
+    \sa callMethods() QOpcUaCallMethodResult
+*/
+
 /*!
     \fn void QOpcUaClient::addNodeFinished(QOpcUaExpandedNodeId requestedNodeId, QString assignedNodeId, QOpcUa::UaStatusCode statusCode)
 
@@ -769,12 +906,46 @@ bool QOpcUaClient::findServers(const QUrl &url, const QStringList &localeIds, co
     \sa QOpcUaReadItem readNodeAttributesFinished()
 */
 bool QOpcUaClient::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead)
+{
+    return readNodeAttributes(nodesToRead, 0);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts a read of multiple attributes on different nodes.
+
+    \a maxAge is the maximum age in milliseconds of a value the server may return instead of
+    reading the current value from the data source, see OPC-UA part 4, 5.10.2.
+    A value of \c 0 requests the current values.
+
+    If the attribute cache is enabled and holds values for all entries in \a nodesToRead which are
+    not older than \a maxAge, the request is answered from the cache without contacting the server.
+    The results are delivered asynchronously in the \l readNodeAttributesFinished() signal in both cases.
+    Entries with an index range are always read from the server.
+
+    Returns true if the asynchronous request has been successfully dispatched.
+
+    \sa setAttributeCacheSize()
+*/
+bool QOpcUaClient::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge)
 {
     if (state() != QOpcUaClient::Connected)
        return false;
 
     Q_D(QOpcUaClient);
-    return d->m_impl->readNodeAttributes(nodesToRead);
+
+    if (maxAge > 0 && d->m_attributeCache->isEnabled()) {
+        QVector<QOpcUaReadResult> results;
+        if (d->m_attributeCache->readItems(nodesToRead, maxAge, &results)) {
+            QMetaObject::invokeMethod(this, [this, results]() {
+                emit readNodeAttributesFinished(results, QOpcUa::UaStatusCode::Good);
+            }, Qt::QueuedConnection);
+            return true;
+        }
+    }
+
+    return d->m_impl->readNodeAttributes(nodesToRead, maxAge);
 }
 
 /*!
@@ -817,6 +988,440 @@ bool QOpcUaClient::writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWr
     return d->m_impl->writeNodeAttributes(nodesToWrite);
 }
 
+/*!
+    \since QtOpcUa 5.15
+
+    Starts a read of the attributes in \a nodesToRead like \l readNodeAttributes() and returns
+    a future for the results instead of emitting \l readNodeAttributesFinished().
+    \a maxAge and the attribute cache are handled like in \l readNodeAttributes().
+
+    The future contains one result for each entry in \a nodesToRead, in the same order.
+    If the Read service has failed, the status code of each result is set to the service result.
+    The future is canceled without a result if the request could not be dispatched, for example
+    because the client is not connected or the backend does not support futures.
+
+    The results are delivered by the event loop of the thread the client lives in, do not
+    block that thread in \l QFuture::waitForFinished(). Use a \l QFutureWatcher instead.
+    Many requests can be in flight at the same time, each future is finished by the response
+    to its own request.
+
+    This function is currently only supported by the open62541 backend.
+
+    \code
+    auto watcher = new QFutureWatcher<QVector<QOpcUaReadResult>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [watcher]() {
+        if (!watcher->isCanceled()) {
+            for (const auto &result : watcher->result())
+                qDebug() << result.nodeId() << result.value();
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(m_client->readNodeAttributesAsync({QOpcUaReadItem("ns=2;s=Demo.Static.Scalar.Double")}));
+    \endcode
+
+    \sa readNodeAttributes() writeNodeAttributesAsync() QOpcUaNode::readAttributesAsync()
+*/
+QFuture<QVector<QOpcUaReadResult>> QOpcUaClient::readNodeAttributesAsync(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge)
+{
+    if (state() != QOpcUaClient::Connected)
+        return QOpcUaClientImpl::canceledFuture<QVector<QOpcUaReadResult>>();
+
+    Q_D(QOpcUaClient);
+
+    if (maxAge > 0 && d->m_attributeCache->isEnabled()) {
+        QVector<QOpcUaReadResult> results;
+        if (d->m_attributeCache->readItems(nodesToRead, maxAge, &results))
+            return QOpcUaClientImpl::finishedFuture(results);
+    }
+
+    return d->m_impl->readFuture(nodesToRead, maxAge);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts a write of the values in \a nodesToWrite like \l writeNodeAttributes() and returns
+    a future for the results instead of emitting \l writeNodeAttributesFinished().
+
+    The future contains one result for each entry in \a nodesToWrite, in the same order.
+    If the Write service has failed, the status code of each result is set to the service result.
+    The future is canceled without a result if the request could not be dispatched.
+    See \l readNodeAttributesAsync() for how the future is finished.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa writeNodeAttributes() readNodeAttributesAsync() QOpcUaNode::writeAttributesAsync()
+*/
+QFuture<QVector<QOpcUaWriteResult>> QOpcUaClient::writeNodeAttributesAsync(const QVector<QOpcUaWriteItem> &nodesToWrite)
+{
+    if (state() != QOpcUaClient::Connected)
+        return QOpcUaClientImpl::canceledFuture<QVector<QOpcUaWriteResult>>();
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->writeFuture(nodesToWrite);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts calling multiple methods on different objects.
+    The object id, the method id and the input arguments can be specified for every entry in \a methodsToCall.
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+    The results are returned in the \l callMethodsFinished() signal.
+
+    Instead of one Call service request per method call like \l QOpcUaNode::callMethod(), the method calls
+    are sent using as few Call requests as the MaxNodesPerMethodCall operation limit of the server permits.
+    This reduces the number of round trips if many methods must be called, for example to write a parameter
+    set to a large number of devices.
+
+    The server may execute the method calls of one request in any order. If the calls depend on each other,
+    they must be made in separate requests.
+
+    This function is currently only supported by the open62541 backend.
+
+    \code
+    QVector<QOpcUaCallMethodItem> request;
+
+    for (const QString &deviceId : deviceIds) {
+        request.append(QOpcUaCallMethodItem(deviceId, "ns=2;s=SetParameter",
+                                            {QOpcUa::TypedVariant(42.0, QOpcUa::Types::Double)}));
+    }
+
+    m_client->callMethods(request);
+    \endcode
+
+    \sa QOpcUaCallMethodItem callMethodsFinished() callMethodsAsync()
+*/
+bool QOpcUaClient::callMethods(const QVector<QOpcUaCallMethodItem> &methodsToCall)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->callMethods(methodsToCall);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts the method calls in \a methodsToCall like \l callMethods() and returns
+    a future for the results instead of emitting \l callMethodsFinished().
+
+    The future contains one result for each entry in \a methodsToCall, in the same order.
+    The future is canceled without a result if the request could not be dispatched.
+    See \l readNodeAttributesAsync() for how the future is finished.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa callMethods() QOpcUaNode::callMethodAsync()
+*/
+QFuture<QVector<QOpcUaCallMethodResult>> QOpcUaClient::callMethodsAsync(const QVector<QOpcUaCallMethodItem> &methodsToCall)
+{
+    if (state() != QOpcUaClient::Connected)
+        return QOpcUaClientImpl::canceledFuture<QVector<QOpcUaCallMethodResult>>();
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->callMethodsFuture(methodsToCall);
+}
+
+/*!
+    Starts browsing the references of all nodes in \a nodeIds using the filter criteria in \a request.
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+
+    Instead of one Browse service call per node, the nodes are browsed using as few Browse requests
+    as the operation limits of the server permit. If the server returns continuation points for some of
+    the nodes, the remaining references of all these nodes are requested together in shared BrowseNext requests.
+
+    \a requestedMaxReferencesPerNode limits the number of references the server returns for each node in
+    a single response. The default value of 0 lets the server choose the limit.
+    As a server only holds a limited number of continuation points per session, nodes which do not
+    receive a continuation point are browsed again once the other nodes have been finished.
+
+    The results are delivered node by node in the \l browseNodesFinished() signal. The signals are emitted
+    in the order in which the browse operations of the nodes finish, which is not necessarily the order of \a nodeIds.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa browseNodesFinished() QOpcUaNode::browse()
+*/
+bool QOpcUaClient::browseNodes(const QStringList &nodeIds, const QOpcUaBrowseRequest &request, quint32 requestedMaxReferencesPerNode)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->browseNodes(nodeIds, request, requestedMaxReferencesPerNode);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts reading historical data of the nodes in \a request.
+
+    Returns a response which delivers the values, or \c nullptr if the request could not be dispatched.
+    The caller takes ownership of the response, destroying it aborts the history read.
+
+    The nodes are read using as few HistoryRead requests as the operation limits of the server permit.
+    Continuation points returned by the server are followed automatically and pages of different nodes
+    are requested concurrently. At most \l QOpcUaHistoryReadRequest::maxPagesInFlight() pages are requested from
+    the server or waiting to be processed by the receivers of \l QOpcUaHistoryReadResponse::dataReceived(),
+    so the memory needed for a long history read is bounded by the page size.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa QOpcUaHistoryReadRequest QOpcUaNode::readHistoryRaw()
+*/
+QOpcUaHistoryReadResponse *QOpcUaClient::readHistoryData(const QOpcUaHistoryReadRequest &request)
+{
+    if (state() != QOpcUaClient::Connected || request.nodeIds().isEmpty())
+        return nullptr;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->readHistoryData(request);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Registers the nodes in \a nodeIds with the server using the RegisterNodes service.
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+    The result is delivered in the \l registerNodesFinished() signal.
+
+    Registering tells the server that the nodes will be accessed repeatedly, a server can use this
+    to prepare a faster access path, for example by assigning numeric ids to nodes with long string identifiers.
+    After a node has been registered, the backend transparently uses the id assigned by the server in all
+    read, write and monitoring requests for the node. The original node ids are still used in all results.
+
+    Registrations are bound to the session. They are restored automatically if the client connects again,
+    \l registerNodesFinished() is emitted for the restored nodes in this case.
+    Registering a node which has already been registered updates the registration.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa unregisterNodes() registerNodesFinished() QOpcUaNode::registerNode()
+*/
+bool QOpcUaClient::registerNodes(const QStringList &nodeIds)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->registerNodes(nodeIds);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Unregisters the nodes in \a nodeIds which have been registered using \l registerNodes().
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+    The result is delivered in the \l unregisterNodesFinished() signal.
+
+    The nodes are no longer registered after this call, even if the UnregisterNodes service fails.
+    Nodes which have never been registered are ignored.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa registerNodes() unregisterNodesFinished()
+*/
+bool QOpcUaClient::unregisterNodes(const QStringList &nodeIds)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->unregisterNodes(nodeIds);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Registers a value handle for each element of \a items and returns the handles in the same order.
+    A value handle refers to the attribute and the index range of a node and can be used in
+    \l readValues(), \l writeValues() and \l enableValueMonitoring().
+
+    Value handles are a lightweight alternative to \l QOpcUaNode for applications which access a large
+    number of values: there is no object per value, all operations work on lists of handles and their results
+    are delivered in one signal per operation. Registering a handle does not contact the server,
+    the handles remain valid until they are unregistered or the client is destroyed.
+
+    The element for an item without a node id or attribute is \c 0, which is never a valid handle.
+
+    \sa unregisterValueHandles()
+*/
+QVector<quint64> QOpcUaClient::registerValueHandles(const QVector<QOpcUaReadItem> &items)
+{
+    Q_D(QOpcUaClient);
+    return d->m_impl->registerValueHandles(items);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Unregisters the value handles in \a handles. Monitoring is disabled for handles which are still monitored.
+    Results for the handles which arrive after this call are not delivered.
+
+    \sa registerValueHandles()
+*/
+void QOpcUaClient::unregisterValueHandles(const QVector<quint64> &handles)
+{
+    Q_D(QOpcUaClient);
+    d->m_impl->unregisterValueHandles(handles);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Reads the values of the value handles in \a handles using the Read service.
+    \a maxAge is passed to the server, see \l readNodeAttributes().
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+    The results are delivered in the \l valuesRead() signal.
+    Returns \c false if \a handles is empty or contains a handle which has not been registered.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa registerValueHandles() valuesRead()
+*/
+bool QOpcUaClient::readValues(const QVector<quint64> &handles, double maxAge)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->readValues(handles, maxAge);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Writes the values in \a values to the value handles in \a handles using the Write service.
+    \a values must contain one value and its type for each handle.
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+    The results are delivered in the \l valuesWritten() signal.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa registerValueHandles() valuesWritten()
+*/
+bool QOpcUaClient::writeValues(const QVector<quint64> &handles, const QVector<QOpcUa::TypedVariant> &values)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->writeValues(handles, values);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts monitoring the value handles in \a handles with the parameters \a settings.
+    The index range of each handle overrides the index range in \a settings.
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+    The results are delivered in the \l valueMonitoringEnabled() signal, data changes
+    are delivered in the \l valuesChanged() signal.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa disableValueMonitoring() valuesChanged()
+*/
+bool QOpcUaClient::enableValueMonitoring(const QVector<quint64> &handles, const QOpcUaMonitoringParameters &settings)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->enableValueMonitoring(handles, settings);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Stops monitoring the value handles in \a handles.
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+    The results are delivered in the \l valueMonitoringDisabled() signal.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa enableValueMonitoring()
+*/
+bool QOpcUaClient::disableValueMonitoring(const QVector<quint64> &handles)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    return d->m_impl->disableValueMonitoring(handles);
+}
+
+/*!
+    Starts monitoring the attributes \a attr of all nodes in \a nodes with the parameters \a settings.
+    All nodes must have been created by this client.
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+
+    Instead of one CreateMonitoredItems service call per node, the monitored items for all nodes are
+    created using as few service calls as possible. This considerably reduces the time needed to set up
+    monitoring for a large number of nodes.
+
+    The result for each monitored item is delivered by the \l QOpcUaNode::enableMonitoringFinished() signal
+    of the respective node, the node's \l QOpcUaNode::monitoringStatus() is updated as if
+    \l QOpcUaNode::enableMonitoring() had been called for every node.
+
+    \code
+    QVector<QOpcUaNode *> nodes;
+    for (const QString &nodeId : nodeIds)
+        nodes.push_back(m_client->node(nodeId));
+    m_client->enableMonitoring(nodes, QOpcUa::NodeAttribute::Value, QOpcUaMonitoringParameters(100));
+    \endcode
+
+    \sa disableMonitoring() QOpcUaNode::enableMonitoring()
+*/
+bool QOpcUaClient::enableMonitoring(const QVector<QOpcUaNode *> &nodes, QOpcUa::NodeAttributes attr,
+                                    const QOpcUaMonitoringParameters &settings)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    QVector<QOpcUaNodeImpl *> impls;
+    if (!d->nodeImplementations(nodes, &impls))
+        return false;
+
+    return d->m_impl->enableMonitoring(impls, attr, settings);
+}
+
+/*!
+    Stops monitoring the attributes \a attr of all nodes in \a nodes.
+    All nodes must have been created by this client.
+
+    Returns \c true if the asynchronous request has been successfully dispatched.
+
+    The monitored items are deleted using as few service calls as possible. The result for each
+    monitored item is delivered by the \l QOpcUaNode::disableMonitoringFinished() signal of the respective node.
+
+    \sa enableMonitoring() QOpcUaNode::disableMonitoring()
+*/
+bool QOpcUaClient::disableMonitoring(const QVector<QOpcUaNode *> &nodes, QOpcUa::NodeAttributes attr)
+{
+    if (state() != QOpcUaClient::Connected)
+        return false;
+
+    Q_D(QOpcUaClient);
+    QVector<QOpcUaNodeImpl *> impls;
+    if (!d->nodeImplementations(nodes, &impls))
+        return false;
+
+    return d->m_impl->disableMonitoring(impls, attr);
+}
+
 /*!
     Returns the name of the backend used by this instance of QOpcUaClient,
     e.g. "open62541".
@@ -883,6 +1488,173 @@ int QOpcUaClient::namespaceAutoupdateInterval() const
     return d->m_namespaceArrayUpdateInterval;
 }
 
+/*!
+    \since QtOpcUa 5.15
+
+    Enables the persistent address space cache and sets the directory where the cache files
+    are stored to \a directory. An empty string disables the cache, which is the default.
+
+    The cache stores browse results and the attributes of nodes which only change if the
+    information model of the server is modified, for example the display name, the data type
+    or the node class. The value attribute and the user specific access attributes are never cached.
+    \l QOpcUaNode::readAttributes() and \l QOpcUaNode::browse() are answered from the cache if
+    all requested data is available, the signals are emitted asynchronously in this case as well.
+
+    There is a separate cache file for each combination of the server's application URI and
+    namespace array. The cache becomes active after the namespace array has been read from the server
+    and is written to disk when the client disconnects. Model change events from the server
+    invalidate the cache. If the server's information model is modified without changing the namespace
+    array or emitting model change events, \l invalidateAddressSpaceCache() must be called.
+
+    \sa invalidateAddressSpaceCache()
+*/
+void QOpcUaClient::setAddressSpaceCacheDirectory(const QString &directory)
+{
+    Q_D(QOpcUaClient);
+    if (d->m_addressSpaceCacheDirectory == directory)
+        return;
+
+    d->m_addressSpaceCacheDirectory = directory;
+    d->resetAddressSpaceCache();
+    d->updateAddressSpaceCache();
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the directory of the address space cache files.
+
+    \sa setAddressSpaceCacheDirectory()
+*/
+QString QOpcUaClient::addressSpaceCacheDirectory() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_addressSpaceCacheDirectory;
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Discards the content of the address space cache for the current server and removes the cache file.
+
+    \sa setAddressSpaceCacheDirectory()
+*/
+void QOpcUaClient::invalidateAddressSpaceCache()
+{
+    Q_D(QOpcUaClient);
+    if (d->m_addressSpaceCache)
+        d->m_addressSpaceCache->invalidate();
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Enables the client side attribute cache and limits it to attribute values of \a maxNodes nodes.
+    If more nodes are cached, the least recently used nodes are evicted.
+    A value of \c 0 disables the cache and discards its content. The cache is disabled by default.
+
+    The cache is filled by reads and by data change notifications of monitored attributes.
+    It is used to answer reads with a non-zero maxAge, see \l QOpcUaNode::readAttributes() and
+    \l readNodeAttributes(). Writes through this client invalidate the affected entries,
+    the whole cache is discarded when the client disconnects.
+
+    \sa attributeCacheSize() clearAttributeCache()
+*/
+void QOpcUaClient::setAttributeCacheSize(int maxNodes)
+{
+    Q_D(QOpcUaClient);
+    d->m_attributeCache->setMaxNodes(maxNodes);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the maximum number of nodes in the attribute cache.
+
+    \sa setAttributeCacheSize()
+*/
+int QOpcUaClient::attributeCacheSize() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_attributeCache->maxNodes();
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Discards all values in the attribute cache.
+
+    \sa setAttributeCacheSize()
+*/
+void QOpcUaClient::clearAttributeCache()
+{
+    Q_D(QOpcUaClient);
+    d->m_attributeCache->clear();
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the number of attribute values which have been taken from the attribute cache
+    instead of being read from the server.
+
+    \sa attributeCacheMissCount() setAttributeCacheSize()
+*/
+quint64 QOpcUaClient::attributeCacheHitCount() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_attributeCache->hitCount();
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the number of attribute values requested with a non-zero maxAge which had to be
+    read from the server because the attribute cache held no sufficiently fresh value.
+
+    \sa attributeCacheHitCount() setAttributeCacheSize()
+*/
+quint64 QOpcUaClient::attributeCacheMissCount() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_attributeCache->missCount();
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the number of data change notifications which have been discarded because a newer
+    value for the same monitored attribute arrived before the notification was delivered.
+
+    Notifications are only conflated if the backend passes them to the client in a bounded
+    queue, see the \c dataChangeQueueCapacity backend property in \l QOpcUaProvider::createClient().
+    Otherwise, this function returns 0.
+
+    \sa dataChangesOccurred()
+*/
+quint64 QOpcUaClient::conflatedDataChangeCount() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_impl->conflatedDataChangeCount();
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the number of data change notifications which have been discarded because the bounded
+    queue of the backend had no free entry for the monitored attribute.
+
+    This happens if more attributes are monitored than the \c dataChangeQueueCapacity backend property
+    in \l QOpcUaProvider::createClient() permits. Otherwise, this function returns 0.
+
+    \sa conflatedDataChangeCount()
+*/
+quint64 QOpcUaClient::droppedDataChangeCount() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_impl->droppedDataChangeCount();
+}
+
 /*!
     Sets the authentication information of this client to \a authenticationInformation.
 
@@ -47,9 +47,13 @@
 #include <QtOpcUa/qopcuawriteresult.h>
 #include <QtOpcUa/qopcuaaddnodeitem.h>
 #include <QtOpcUa/qopcuaaddreferenceitem.h>
+#include <QtOpcUa/qopcuacallmethoditem.h>
+#include <QtOpcUa/qopcuacallmethodresult.h>
 #include <QtOpcUa/qopcuadeletereferenceitem.h>
 #include <QtOpcUa/qopcuaendpointdescription.h>
+#include <QtOpcUa/qopcuahistoryreadresponse.h>
 
+#include <QtCore/qfuture.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qurl.h>
 
@@ -115,8 +119,34 @@ public:
                      const QStringList &serverUris = QStringList());
 
     bool readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead);
+    bool readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge);
     bool writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite);
 
+    QFuture<QVector<QOpcUaReadResult>> readNodeAttributesAsync(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge = 0);
+    QFuture<QVector<QOpcUaWriteResult>> writeNodeAttributesAsync(const QVector<QOpcUaWriteItem> &nodesToWrite);
+
+    bool callMethods(const QVector<QOpcUaCallMethodItem> &methodsToCall);
+    QFuture<QVector<QOpcUaCallMethodResult>> callMethodsAsync(const QVector<QOpcUaCallMethodItem> &methodsToCall);
+
+    bool enableMonitoring(const QVector<QOpcUaNode *> &nodes, QOpcUa::NodeAttributes attr,
+                          const QOpcUaMonitoringParameters &settings);
+    bool disableMonitoring(const QVector<QOpcUaNode *> &nodes, QOpcUa::NodeAttributes attr);
+
+    bool browseNodes(const QStringList &nodeIds, const QOpcUaBrowseRequest &request = QOpcUaBrowseRequest(),
+                     quint32 requestedMaxReferencesPerNode = 0);
+
+    QOpcUaHistoryReadResponse *readHistoryData(const QOpcUaHistoryReadRequest &request);
+
+    bool registerNodes(const QStringList &nodeIds);
+    bool unregisterNodes(const QStringList &nodeIds);
+
+    QVector<quint64> registerValueHandles(const QVector<QOpcUaReadItem> &items);
+    void unregisterValueHandles(const QVector<quint64> &handles);
+    bool readValues(const QVector<quint64> &handles, double maxAge = 0);
+    bool writeValues(const QVector<quint64> &handles, const QVector<QOpcUa::TypedVariant> &values);
+    bool enableValueMonitoring(const QVector<quint64> &handles, const QOpcUaMonitoringParameters &settings);
+    bool disableValueMonitoring(const QVector<quint64> &handles);
+
     bool addNode(const QOpcUaAddNodeItem &nodeToAdd);
     bool deleteNode(const QString &nodeId, bool deleteTargetReferences = true);
 
@@ -135,6 +165,19 @@ public:
     void setNamespaceAutoupdateInterval(int interval);
     int namespaceAutoupdateInterval() const;
 
+    void setAddressSpaceCacheDirectory(const QString &directory);
+    QString addressSpaceCacheDirectory() const;
+    void invalidateAddressSpaceCache();
+
+    void setAttributeCacheSize(int maxNodes);
+    int attributeCacheSize() const;
+    void clearAttributeCache();
+    quint64 attributeCacheHitCount() const;
+    quint64 attributeCacheMissCount() const;
+
+    quint64 conflatedDataChangeCount() const;
+    quint64 droppedDataChangeCount() const;
+
     void setAuthenticationInformation(const QOpcUaAuthenticationInformation &authenticationInformation);
     const QOpcUaAuthenticationInformation &authenticationInformation() const;
 
@@ -153,6 +196,16 @@ Q_SIGNALS:
     void findServersFinished(QVector<QOpcUaApplicationDescription> servers, QOpcUa::UaStatusCode statusCode, QUrl requestUrl);
     void readNodeAttributesFinished(QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult);
     void writeNodeAttributesFinished(QVector<QOpcUaWriteResult> results, QOpcUa::UaStatusCode serviceResult);
+    void callMethodsFinished(QVector<QOpcUaCallMethodResult> results, QOpcUa::UaStatusCode serviceResult);
+    void browseNodesFinished(QString nodeId, QVector<QOpcUaReferenceDescription> references, QOpcUa::UaStatusCode statusCode);
+    void registerNodesFinished(QStringList nodeIds, QStringList registeredNodeIds, QOpcUa::UaStatusCode statusCode);
+    void unregisterNodesFinished(QStringList nodeIds, QOpcUa::UaStatusCode statusCode);
+    void dataChangesOccurred(QVector<QOpcUaReadResult> results);
+    void valuesRead(QVector<quint64> handles, QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult);
+    void valuesWritten(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results, QOpcUa::UaStatusCode serviceResult);
+    void valuesChanged(QVector<quint64> handles, QVector<QOpcUaReadResult> values);
+    void valueMonitoringEnabled(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results);
+    void valueMonitoringDisabled(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results);
     void addNodeFinished(QOpcUaExpandedNodeId requestedNodeId, QString assignedNodeId, QOpcUa::UaStatusCode statusCode);
     void deleteNodeFinished(QString nodeId, QOpcUa::UaStatusCode statusCode);
     void addReferenceFinished(QString sourceNodeId, QString referenceTypeId, QOpcUaExpandedNodeId targetNodeId, bool isForwardReference,
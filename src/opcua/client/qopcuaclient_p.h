@@ -60,6 +60,9 @@
 
 QT_BEGIN_NAMESPACE
 
+class QOpcUaAddressSpaceCache;
+class QOpcUaAttributeCache;
+
 class Q_OPCUA_EXPORT QOpcUaClientPrivate : public QObjectPrivate
 {
 public:
@@ -91,10 +94,24 @@ public:
     void setPkiConfiguration(const QOpcUaPkiConfiguration &config);
     QOpcUaPkiConfiguration pkiConfiguration() const;
 
+    bool nodeImplementations(const QVector<QOpcUaNode *> &nodes, QVector<QOpcUaNodeImpl *> *impls) const;
+
+    void updateAddressSpaceCache();
+    void resetAddressSpaceCache();
+    void handleModelChangeEvent(const QVariantList &eventFields);
+
+    void cacheReadResults(const QVector<QOpcUaReadResult> &results, QOpcUa::UaStatusCode serviceResult);
+    void invalidateWrittenAttributes(const QVector<QOpcUaWriteResult> &results);
+
+    QString m_addressSpaceCacheDirectory;
+    QScopedPointer<QOpcUaAddressSpaceCache> m_addressSpaceCache;
+    QScopedPointer<QOpcUaAttributeCache> m_attributeCache;
+
 private:
     Q_DECLARE_PUBLIC(QOpcUaClient)
     QStringList m_namespaceArray;
     QScopedPointer<QOpcUaNode> m_namespaceArrayNode;
+    QScopedPointer<QOpcUaNode> m_modelChangeNode;
     bool m_namespaceArrayAutoupdateEnabled;
     unsigned int m_namespaceArrayUpdateInterval;
     QOpcUaApplicationIdentity m_applicationIdentity;
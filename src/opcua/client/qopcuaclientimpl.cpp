@@ -36,6 +36,9 @@
 
 #include <private/qopcuabackend_p.h>
 #include <private/qopcuaclientimpl_p.h>
+#include <private/qopcuadatachangequeue_p.h>
+#include <private/qopcuahistoryreadresponse_p.h>
+#include <private/qopcuanode_p.h>
 #include <QtOpcUa/qopcuamonitoringparameters.h>
 #include "qopcuaclient_p.h"
 #include "qopcuaerrorstate.h"
@@ -45,39 +48,336 @@ QT_BEGIN_NAMESPACE
 QOpcUaClientImpl::QOpcUaClientImpl(QObject *parent)
     : QObject(parent)
     , m_client(nullptr)
-    , m_handleCounter(0)
+    , m_handles(NodeHandleTag)
+    , m_valueHandles(ValueHandleTag)
+    , m_valueRequests(ValueRequestTag)
+    , m_futureRequests(FutureRequestTag)
+    , m_valueMonitoringDeliveryPending(false)
+    , m_historyReadCounter(0)
+    , m_browseNodesCounter(0)
+    , m_backend(nullptr)
 {}
 
 QOpcUaClientImpl::~QOpcUaClientImpl()
-{}
+{
+    // The results of pending requests will never arrive, waiting for them must not block forever
+    m_futureRequests.forEach([](quint64, const QSharedPointer<QFutureInterfaceBase> &future) {
+        future->reportCanceled();
+        future->reportFinished();
+    });
+}
 
-bool QOpcUaClientImpl::registerNode(QPointer<QOpcUaNodeImpl> obj)
+bool QOpcUaClientImpl::registerNode(QOpcUaNodeImpl *obj)
 {
-    if (m_handles.count() == (std::numeric_limits<int>::max)())
+    const quint64 handle = m_handles.insert(obj);
+    if (!handle)
         return false;
 
-    while (true) {
-        ++m_handleCounter;
+    obj->setHandle(handle);
+    return true;
+}
+
+void QOpcUaClientImpl::unregisterNode(QOpcUaNodeImpl *obj)
+{
+    m_handles.remove(obj->handle());
+}
+
+bool QOpcUaClientImpl::enableMonitoring(const QVector<QOpcUaNodeImpl *> &nodes, QOpcUa::NodeAttributes attr,
+                                        const QOpcUaMonitoringParameters &settings)
+{
+    // Backends without support for bulk requests create the monitored items node by node
+    bool success = true;
+    for (QOpcUaNodeImpl *node : nodes)
+        success = node->enableMonitoring(attr, settings) && success;
+    return success;
+}
+
+bool QOpcUaClientImpl::disableMonitoring(const QVector<QOpcUaNodeImpl *> &nodes, QOpcUa::NodeAttributes attr)
+{
+    bool success = true;
+    for (QOpcUaNodeImpl *node : nodes)
+        success = node->disableMonitoring(attr) && success;
+    return success;
+}
+
+bool QOpcUaClientImpl::browseNodes(const QStringList &nodeIds, const QOpcUaBrowseRequest &request, quint32 requestedMaxReferencesPerNode)
+{
+    return startBrowseNodes(0, nodeIds, request, requestedMaxReferencesPerNode);
+}
+
+quint64 QOpcUaClientImpl::dispatchBrowseNodes(const QStringList &nodeIds, const QOpcUaBrowseRequest &request,
+                                              quint32 requestedMaxReferencesPerNode)
+{
+    const quint64 requestHandle = ++m_browseNodesCounter;
+    return startBrowseNodes(requestHandle, nodeIds, request, requestedMaxReferencesPerNode) ? requestHandle : 0;
+}
+
+bool QOpcUaClientImpl::startBrowseNodes(quint64 requestHandle, const QStringList &nodeIds, const QOpcUaBrowseRequest &request,
+                                        quint32 requestedMaxReferencesPerNode)
+{
+    Q_UNUSED(requestHandle);
+    Q_UNUSED(nodeIds);
+    Q_UNUSED(request);
+    Q_UNUSED(requestedMaxReferencesPerNode);
+    return false;
+}
 
-        if (!m_handles.contains(m_handleCounter)) {
-            obj->setHandle(m_handleCounter);
-            m_handles[m_handleCounter] = obj;
-            return true;
+bool QOpcUaClientImpl::registerNodes(const QStringList &nodeIds)
+{
+    Q_UNUSED(nodeIds);
+    return false;
+}
+
+bool QOpcUaClientImpl::unregisterNodes(const QStringList &nodeIds)
+{
+    Q_UNUSED(nodeIds);
+    return false;
+}
+
+QOpcUaHistoryReadResponse *QOpcUaClientImpl::readHistoryData(const QOpcUaHistoryReadRequest &request)
+{
+    const quint64 handle = ++m_historyReadCounter;
+    QOpcUaHistoryReadResponse *response = new QOpcUaHistoryReadResponse(this, handle, request);
+    m_historyReads.insert(handle, response);
+
+    if (!startHistoryRead(handle, request)) {
+        m_historyReads.remove(handle);
+        delete response;
+        return nullptr;
+    }
+
+    return response;
+}
+
+void QOpcUaClientImpl::abortHistoryRead(quint64 handle)
+{
+    if (m_historyReads.remove(handle))
+        cancelHistoryRead(handle);
+}
+
+bool QOpcUaClientImpl::startHistoryRead(quint64 handle, const QOpcUaHistoryReadRequest &request)
+{
+    Q_UNUSED(handle);
+    Q_UNUSED(request);
+    return false;
+}
+
+void QOpcUaClientImpl::acknowledgeHistoryData(quint64 handle)
+{
+    Q_UNUSED(handle);
+}
+
+void QOpcUaClientImpl::cancelHistoryRead(quint64 handle)
+{
+    Q_UNUSED(handle);
+}
+
+QVector<quint64> QOpcUaClientImpl::registerValueHandles(const QVector<QOpcUaReadItem> &items)
+{
+    QVector<quint64> handles;
+    handles.reserve(items.size());
+
+    for (const auto &item : items) {
+        quint64 handle = 0;
+        if (!item.nodeId().isEmpty() && item.attribute() != QOpcUa::NodeAttribute::None) {
+            ValueHandle valueHandle;
+            valueHandle.nodeId = item.nodeId();
+            valueHandle.attribute = item.attribute();
+            valueHandle.indexRange = item.indexRange();
+            handle = m_valueHandles.insert(valueHandle);
         }
+        handles.push_back(handle);
     }
+
+    return handles;
 }
 
-void QOpcUaClientImpl::unregisterNode(QPointer<QOpcUaNodeImpl> obj)
+void QOpcUaClientImpl::unregisterValueHandles(const QVector<quint64> &handles)
 {
-    m_handles.remove(obj->handle());
+    QVector<quint64> monitored;
+    for (quint64 handle : handles) {
+        const ValueHandle *valueHandle = m_valueHandles.find(handle);
+        if (valueHandle && valueHandle->monitored)
+            monitored.push_back(handle);
+    }
+
+    // The monitored items are removed, their results are dropped together with the handles
+    if (!monitored.isEmpty())
+        disableValueMonitoring(monitored);
+
+    for (quint64 handle : handles)
+        m_valueHandles.remove(handle);
+}
+
+bool QOpcUaClientImpl::readValues(const QVector<quint64> &handles, double maxAge)
+{
+    if (handles.isEmpty())
+        return false;
+
+    QVector<QOpcUaReadItem> items;
+    items.reserve(handles.size());
+    for (quint64 handle : handles) {
+        const ValueHandle *valueHandle = m_valueHandles.find(handle);
+        if (!valueHandle)
+            return false;
+        items.push_back(QOpcUaReadItem(valueHandle->nodeId, valueHandle->attribute, valueHandle->indexRange));
+    }
+
+    const quint64 requestHandle = m_valueRequests.insert(handles);
+    if (!requestHandle)
+        return false;
+
+    if (!startValueRead(requestHandle, items, maxAge)) {
+        m_valueRequests.remove(requestHandle);
+        return false;
+    }
+
+    return true;
+}
+
+bool QOpcUaClientImpl::writeValues(const QVector<quint64> &handles, const QVector<QOpcUa::TypedVariant> &values)
+{
+    if (handles.isEmpty() || handles.size() != values.size())
+        return false;
+
+    QVector<QOpcUaWriteItem> items;
+    items.reserve(handles.size());
+    for (int i = 0; i < handles.size(); ++i) {
+        const ValueHandle *valueHandle = m_valueHandles.find(handles.at(i));
+        if (!valueHandle)
+            return false;
+        items.push_back(QOpcUaWriteItem(valueHandle->nodeId, valueHandle->attribute, values.at(i).first, values.at(i).second, valueHandle->indexRange));
+    }
+
+    const quint64 requestHandle = m_valueRequests.insert(handles);
+    if (!requestHandle)
+        return false;
+
+    if (!startValueWrite(requestHandle, items)) {
+        m_valueRequests.remove(requestHandle);
+        return false;
+    }
+
+    return true;
+}
+
+bool QOpcUaClientImpl::enableValueMonitoring(const QVector<quint64> &handles, const QOpcUaMonitoringParameters &settings)
+{
+    // Monitored items are created in one request per attribute and index range
+    struct Group {
+        QOpcUa::NodeAttribute attribute;
+        QString indexRange;
+        QVector<quint64> handles;
+        QStringList nodeIds;
+    };
+    QVector<Group> groups;
+
+    for (quint64 handle : handles) {
+        const ValueHandle *valueHandle = m_valueHandles.find(handle);
+        if (!valueHandle)
+            return false;
+
+        auto group = std::find_if(groups.begin(), groups.end(), [valueHandle](const Group &entry) {
+            return entry.attribute == valueHandle->attribute && entry.indexRange == valueHandle->indexRange;
+        });
+        if (group == groups.end())
+            group = groups.insert(groups.end(), {valueHandle->attribute, valueHandle->indexRange, {}, {}});
+        group->handles.push_back(handle);
+        group->nodeIds.push_back(valueHandle->nodeId);
+    }
+
+    if (groups.isEmpty())
+        return false;
+
+    bool success = true;
+    for (const auto &group : qAsConst(groups)) {
+        QOpcUaMonitoringParameters groupSettings = settings;
+        groupSettings.setIndexRange(group.indexRange);
+        success = startValueMonitoring(group.handles, group.nodeIds, group.attribute, groupSettings) && success;
+    }
+    return success;
+}
+
+bool QOpcUaClientImpl::disableValueMonitoring(const QVector<quint64> &handles)
+{
+    QHash<QOpcUa::NodeAttribute, QVector<quint64>> handlesPerAttribute;
+    for (quint64 handle : handles) {
+        const ValueHandle *valueHandle = m_valueHandles.find(handle);
+        if (!valueHandle)
+            return false;
+        handlesPerAttribute[valueHandle->attribute].push_back(handle);
+    }
+
+    if (handlesPerAttribute.isEmpty())
+        return false;
+
+    bool success = true;
+    for (auto it = handlesPerAttribute.constBegin(); it != handlesPerAttribute.constEnd(); ++it)
+        success = stopValueMonitoring(it.value(), it.key()) && success;
+    return success;
+}
+
+bool QOpcUaClientImpl::startValueRead(quint64 requestHandle, const QVector<QOpcUaReadItem> &items, double maxAge)
+{
+    Q_UNUSED(requestHandle);
+    Q_UNUSED(items);
+    Q_UNUSED(maxAge);
+    return false;
+}
+
+bool QOpcUaClientImpl::startValueWrite(quint64 requestHandle, const QVector<QOpcUaWriteItem> &items)
+{
+    Q_UNUSED(requestHandle);
+    Q_UNUSED(items);
+    return false;
+}
+
+bool QOpcUaClientImpl::startValueMonitoring(const QVector<quint64> &handles, const QStringList &nodeIds, QOpcUa::NodeAttribute attr,
+                                            const QOpcUaMonitoringParameters &settings)
+{
+    Q_UNUSED(handles);
+    Q_UNUSED(nodeIds);
+    Q_UNUSED(attr);
+    Q_UNUSED(settings);
+    return false;
+}
+
+bool QOpcUaClientImpl::stopValueMonitoring(const QVector<quint64> &handles, QOpcUa::NodeAttribute attr)
+{
+    Q_UNUSED(handles);
+    Q_UNUSED(attr);
+    return false;
+}
+
+void QOpcUaClientImpl::setDataChangeQueue(const QSharedPointer<QOpcUaDataChangeQueue> &queue)
+{
+    m_dataChangeQueue = queue;
+}
+
+quint64 QOpcUaClientImpl::conflatedDataChangeCount() const
+{
+    return m_dataChangeQueue ? m_dataChangeQueue->conflatedCount() : 0;
+}
+
+quint64 QOpcUaClientImpl::droppedDataChangeCount() const
+{
+    return m_dataChangeQueue ? m_dataChangeQueue->overflowCount() : 0;
+}
+
+QThread *QOpcUaClientImpl::backendThread() const
+{
+    return m_backend ? m_backend->thread() : nullptr;
 }
 
 void QOpcUaClientImpl::connectBackendWithClient(QOpcUaBackend *backend)
 {
+    m_backend = backend;
     connect(backend, &QOpcUaBackend::attributesRead, this, &QOpcUaClientImpl::handleAttributesRead);
     connect(backend, &QOpcUaBackend::stateAndOrErrorChanged, this, &QOpcUaClientImpl::stateAndOrErrorChanged);
     connect(backend, &QOpcUaBackend::attributeWritten, this, &QOpcUaClientImpl::handleAttributeWritten);
     connect(backend, &QOpcUaBackend::dataChangeOccurred, this, &QOpcUaClientImpl::handleDataChangeOccurred);
+    connect(backend, &QOpcUaBackend::dataChangesOccurred, this, &QOpcUaClientImpl::handleDataChangesOccurred);
+    connect(backend, &QOpcUaBackend::dataChangesAvailable, this, &QOpcUaClientImpl::handleDataChangesAvailable);
     connect(backend, &QOpcUaBackend::monitoringEnableDisable, this, &QOpcUaClientImpl::handleMonitoringEnableDisable);
     connect(backend, &QOpcUaBackend::monitoringStatusChanged, this, &QOpcUaClientImpl::handleMonitoringStatusChanged);
     connect(backend, &QOpcUaBackend::methodCallFinished, this, &QOpcUaClientImpl::handleMethodCallFinished);
@@ -88,77 +388,421 @@ void QOpcUaClientImpl::connectBackendWithClient(QOpcUaBackend *backend)
     connect(backend, &QOpcUaBackend::findServersFinished, this, &QOpcUaClientImpl::findServersFinished);
     connect(backend, &QOpcUaBackend::readNodeAttributesFinished, this, &QOpcUaClientImpl::readNodeAttributesFinished);
     connect(backend, &QOpcUaBackend::writeNodeAttributesFinished, this, &QOpcUaClientImpl::writeNodeAttributesFinished);
+    connect(backend, &QOpcUaBackend::browseNodesFinished, this, &QOpcUaClientImpl::browseNodesFinished);
+    connect(backend, &QOpcUaBackend::registerNodesFinished, this, &QOpcUaClientImpl::registerNodesFinished);
+    connect(backend, &QOpcUaBackend::unregisterNodesFinished, this, &QOpcUaClientImpl::unregisterNodesFinished);
     connect(backend, &QOpcUaBackend::addNodeFinished, this, &QOpcUaClientImpl::addNodeFinished);
     connect(backend, &QOpcUaBackend::deleteNodeFinished, this, &QOpcUaClientImpl::deleteNodeFinished);
     connect(backend, &QOpcUaBackend::addReferenceFinished, this, &QOpcUaClientImpl::addReferenceFinished);
     connect(backend, &QOpcUaBackend::deleteReferenceFinished, this, &QOpcUaClientImpl::deleteReferenceFinished);
+    connect(backend, &QOpcUaBackend::historyDataReceived, this, &QOpcUaClientImpl::handleHistoryDataReceived);
+    connect(backend, &QOpcUaBackend::historyReadFinished, this, &QOpcUaClientImpl::handleHistoryReadFinished);
+    connect(backend, &QOpcUaBackend::valuesRead, this, &QOpcUaClientImpl::handleValuesRead);
+    connect(backend, &QOpcUaBackend::valuesWritten, this, &QOpcUaClientImpl::handleValuesWritten);
+    connect(backend, &QOpcUaBackend::callMethodsFinished, this, &QOpcUaClientImpl::handleCallMethodsFinished);
     // This needs to be blocking queued because it is called from another thread, which needs to wait for a result.
     connect(backend, &QOpcUaBackend::connectError, this, &QOpcUaClientImpl::connectError, Qt::BlockingQueuedConnection);
     connect(backend, &QOpcUaBackend::passwordForPrivateKeyRequired, this, &QOpcUaClientImpl::passwordForPrivateKeyRequired, Qt::BlockingQueuedConnection);
 }
 
+template <typename T>
+QFuture<T> QOpcUaClientImpl::dispatchFuture(const std::function<bool(quint64)> &start)
+{
+    const auto future = QSharedPointer<QFutureInterface<T>>::create();
+    const quint64 requestHandle = m_futureRequests.insert(future);
+    if (!requestHandle)
+        return canceledFuture<T>();
+
+    future->reportStarted();
+
+    if (!start(requestHandle)) {
+        m_futureRequests.remove(requestHandle);
+        future->reportCanceled();
+        future->reportFinished();
+    }
+
+    return future->future();
+}
+
+template <typename T>
+QSharedPointer<QFutureInterface<T>> QOpcUaClientImpl::takeFuture(quint64 requestHandle)
+{
+    // Handles of nodes and of futures with another result type are rejected
+    const QSharedPointer<QFutureInterfaceBase> *entry = m_futureRequests.find(requestHandle);
+    if (!entry)
+        return QSharedPointer<QFutureInterface<T>>();
+
+    const auto future = entry->template dynamicCast<QFutureInterface<T>>();
+    if (future)
+        m_futureRequests.remove(requestHandle);
+    return future;
+}
+
+QFuture<QVector<QOpcUaReadResult>> QOpcUaClientImpl::readFuture(const QVector<QOpcUaReadItem> &items, double maxAge)
+{
+    return dispatchFuture<QVector<QOpcUaReadResult>>([&](quint64 requestHandle) {
+        return startValueRead(requestHandle, items, maxAge);
+    });
+}
+
+QFuture<QVector<QOpcUaWriteResult>> QOpcUaClientImpl::writeFuture(const QVector<QOpcUaWriteItem> &items)
+{
+    return dispatchFuture<QVector<QOpcUaWriteResult>>([&](quint64 requestHandle) {
+        return startValueWrite(requestHandle, items);
+    });
+}
+
+QFuture<QOpcUaOperationResult<QVector<QOpcUaReferenceDescription>>> QOpcUaClientImpl::browseFuture(const QString &nodeId,
+                                                                                                    const QOpcUaBrowseRequest &request)
+{
+    return dispatchFuture<QOpcUaOperationResult<QVector<QOpcUaReferenceDescription>>>([&](quint64 requestHandle) {
+        return startBrowse(requestHandle, nodeId, request);
+    });
+}
+
+QFuture<QOpcUaOperationResult<QVariant>> QOpcUaClientImpl::callMethodFuture(const QString &objectId, const QString &methodId,
+                                                                              const QVector<QOpcUa::TypedVariant> &args)
+{
+    return dispatchFuture<QOpcUaOperationResult<QVariant>>([&](quint64 requestHandle) {
+        return startMethodCall(requestHandle, objectId, methodId, args);
+    });
+}
+
+QFuture<QOpcUaOperationResult<QVector<QOpcUaBrowsePathTarget>>> QOpcUaClientImpl::resolveBrowsePathFuture(const QString &startNodeId,
+                                                                                                           const QVector<QOpcUaRelativePathElement> &path)
+{
+    return dispatchFuture<QOpcUaOperationResult<QVector<QOpcUaBrowsePathTarget>>>([&](quint64 requestHandle) {
+        return startResolveBrowsePath(requestHandle, startNodeId, path);
+    });
+}
+
+QFuture<QVector<QOpcUaCallMethodResult>> QOpcUaClientImpl::callMethodsFuture(const QVector<QOpcUaCallMethodItem> &methodsToCall)
+{
+    return dispatchFuture<QVector<QOpcUaCallMethodResult>>([&](quint64 requestHandle) {
+        return startMethodCalls(requestHandle, methodsToCall);
+    });
+}
+
+bool QOpcUaClientImpl::callMethods(const QVector<QOpcUaCallMethodItem> &methodsToCall)
+{
+    return startMethodCalls(0, methodsToCall);
+}
+
+bool QOpcUaClientImpl::startBrowse(quint64 requestHandle, const QString &nodeId, const QOpcUaBrowseRequest &request)
+{
+    Q_UNUSED(requestHandle);
+    Q_UNUSED(nodeId);
+    Q_UNUSED(request);
+    return false;
+}
+
+bool QOpcUaClientImpl::startMethodCall(quint64 requestHandle, const QString &objectId, const QString &methodId,
+                                       const QVector<QOpcUa::TypedVariant> &args)
+{
+    Q_UNUSED(requestHandle);
+    Q_UNUSED(objectId);
+    Q_UNUSED(methodId);
+    Q_UNUSED(args);
+    return false;
+}
+
+bool QOpcUaClientImpl::startResolveBrowsePath(quint64 requestHandle, const QString &startNodeId,
+                                              const QVector<QOpcUaRelativePathElement> &path)
+{
+    Q_UNUSED(requestHandle);
+    Q_UNUSED(startNodeId);
+    Q_UNUSED(path);
+    return false;
+}
+
+bool QOpcUaClientImpl::startMethodCalls(quint64 requestHandle, const QVector<QOpcUaCallMethodItem> &methodsToCall)
+{
+    Q_UNUSED(requestHandle);
+    Q_UNUSED(methodsToCall);
+    return false;
+}
+
+QOpcUaNodePrivate *QOpcUaClientImpl::nodeForHandle(quint64 handle) const
+{
+    QOpcUaNodeImpl *impl = m_handles.value(handle);
+    return impl ? impl->node() : nullptr;
+}
+
 void QOpcUaClientImpl::handleAttributesRead(quint64 handle, QVector<QOpcUaReadResult> attr, QOpcUa::UaStatusCode serviceResult)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->attributesRead(attr, serviceResult);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle))
+        node->handleAttributesRead(attr, serviceResult, true);
 }
 
 void QOpcUaClientImpl::handleAttributeWritten(quint64 handle, QOpcUa::NodeAttribute attr, const QVariant &value, QOpcUa::UaStatusCode statusCode)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->attributeWritten(attr, value, statusCode);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle))
+        node->handleAttributeWritten(attr, value, statusCode);
 }
 
 void QOpcUaClientImpl::handleDataChangeOccurred(quint64 handle, const QOpcUaReadResult &value)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->dataChangeOccurred(value.attribute(), value);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle)) {
+        node->handleDataChanges(value.attribute(), {value});
+        return;
+    }
+
+    const ValueHandle *valueHandle = m_valueHandles.find(handle);
+    if (valueHandle) {
+        QOpcUaReadResult result = value;
+        result.setNodeId(valueHandle->nodeId);
+        emit valuesChanged({handle}, {result});
+    }
+}
+
+void QOpcUaClientImpl::handleDataChangesOccurred(const QVector<quint64> &handles, QVector<QOpcUaReadResult> values)
+{
+    // All values for one monitored item are delivered to the node at once, in the order they were received
+    struct ItemValues {
+        quint64 handle;
+        QOpcUa::NodeAttribute attribute;
+        QVector<QOpcUaReadResult> values;
+    };
+    QVector<ItemValues> items;
+    QHash<QPair<quint64, QOpcUa::NodeAttribute>, int> itemIndex;
+
+    // Results for nodes which have been deleted in the meantime are dropped
+    int count = 0;
+    QVector<quint64> valueHandles;
+    QVector<QOpcUaReadResult> valueResults;
+    for (int i = 0; i < handles.size() && i < values.size(); ++i) {
+        QOpcUaNodeImpl *impl = m_handles.value(handles.at(i));
+        if (!impl) {
+            // Value handles are not passed to nodes and are delivered in their own signal
+            const ValueHandle *valueHandle = m_valueHandles.find(handles.at(i));
+            if (valueHandle) {
+                valueHandles.push_back(handles.at(i));
+                valueResults.push_back(values.at(i));
+                valueResults.last().setNodeId(valueHandle->nodeId);
+            }
+            continue;
+        }
+
+        if (count != i)
+            values[count] = values.at(i);
+        values[count].setNodeId(impl->nodeId());
+
+        const auto key = qMakePair(handles.at(i), values.at(count).attribute());
+        auto index = itemIndex.constFind(key);
+        if (index == itemIndex.constEnd()) {
+            index = itemIndex.insert(key, items.size());
+            items.push_back({key.first, key.second, {}});
+        }
+        items[index.value()].values.push_back(values.at(count));
+        ++count;
+    }
+
+    values.resize(count);
+
+    // A receiver may delete other nodes, the handle is looked up again for every item
+    for (const auto &item : qAsConst(items)) {
+        if (QOpcUaNodePrivate *node = nodeForHandle(item.handle))
+            node->handleDataChanges(item.attribute, item.values);
+    }
+
+    if (!values.isEmpty())
+        emit dataChangesOccurred(values);
+
+    if (!valueHandles.isEmpty())
+        emit valuesChanged(valueHandles, valueResults);
+}
+
+void QOpcUaClientImpl::handleDataChangesAvailable()
+{
+    if (!m_dataChangeQueue)
+        return;
+
+    QVector<quint64> handles;
+    QVector<QOpcUaReadResult> values;
+    if (m_dataChangeQueue->take(&handles, &values))
+        handleDataChangesOccurred(handles, values);
 }
 
 void QOpcUaClientImpl::handleMonitoringEnableDisable(quint64 handle, QOpcUa::NodeAttribute attr, bool subscribe, QOpcUaMonitoringParameters status)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->monitoringEnableDisable(attr, subscribe, status);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle))
+        node->handleMonitoringEnableDisable(attr, subscribe, status);
+    else
+        handleValueMonitoringResult(handle, subscribe, status.statusCode());
+}
+
+void QOpcUaClientImpl::handleValueMonitoringResult(quint64 handle, bool subscribe, QOpcUa::UaStatusCode statusCode)
+{
+    ValueHandle *valueHandle = m_valueHandles.find(handle);
+    if (!valueHandle)
+        return;
+
+    if (!subscribe)
+        valueHandle->monitored = false;
+    else if (statusCode == QOpcUa::UaStatusCode::Good)
+        valueHandle->monitored = true;
+
+    ValueMonitoringResults &pending = subscribe ? m_valueMonitoringEnabled : m_valueMonitoringDisabled;
+    pending.handles.push_back(handle);
+    pending.results.push_back(statusCode);
+
+    // The backend reports the items of a request one by one, they are collected until the events already queued have been processed
+    if (!m_valueMonitoringDeliveryPending) {
+        m_valueMonitoringDeliveryPending = true;
+        QMetaObject::invokeMethod(this, &QOpcUaClientImpl::deliverValueMonitoringResults, Qt::QueuedConnection);
+    }
+}
+
+void QOpcUaClientImpl::deliverValueMonitoringResults()
+{
+    m_valueMonitoringDeliveryPending = false;
+
+    const ValueMonitoringResults enabled = qExchange(m_valueMonitoringEnabled, {});
+    const ValueMonitoringResults disabled = qExchange(m_valueMonitoringDisabled, {});
+
+    if (!enabled.handles.isEmpty())
+        emit valueMonitoringEnabled(enabled.handles, enabled.results);
+    if (!disabled.handles.isEmpty())
+        emit valueMonitoringDisabled(disabled.handles, disabled.results);
 }
 
 void QOpcUaClientImpl::handleMonitoringStatusChanged(quint64 handle, QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items, QOpcUaMonitoringParameters param)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->monitoringStatusChanged(attr, items, param);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle))
+        node->handleMonitoringStatusChanged(attr, items, param);
 }
 
 void QOpcUaClientImpl::handleMethodCallFinished(quint64 handle, QString methodNodeId, QVariant result, QOpcUa::UaStatusCode statusCode)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->methodCallFinished(methodNodeId, result, statusCode);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle)) {
+        node->handleMethodCallFinished(methodNodeId, result, statusCode);
+    } else if (const auto future = takeFuture<QOpcUaOperationResult<QVariant>>(handle)) {
+        future->reportResult(QOpcUaOperationResult<QVariant>(result, statusCode));
+        future->reportFinished();
+    }
 }
 
 void QOpcUaClientImpl::handleBrowseFinished(quint64 handle, const QVector<QOpcUaReferenceDescription> &children, QOpcUa::UaStatusCode statusCode)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->browseFinished(children, statusCode);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle)) {
+        node->handleBrowseFinished(children, statusCode);
+    } else if (const auto future = takeFuture<QOpcUaOperationResult<QVector<QOpcUaReferenceDescription>>>(handle)) {
+        future->reportResult(QOpcUaOperationResult<QVector<QOpcUaReferenceDescription>>(children, statusCode));
+        future->reportFinished();
+    }
 }
 
 void QOpcUaClientImpl::handleResolveBrowsePathFinished(quint64 handle, QVector<QOpcUaBrowsePathTarget> targets,
                                                          QVector<QOpcUaRelativePathElement> path, QOpcUa::UaStatusCode status)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->resolveBrowsePathFinished(targets, path, status);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle)) {
+        node->handleResolveBrowsePathFinished(targets, path, status);
+    } else if (const auto future = takeFuture<QOpcUaOperationResult<QVector<QOpcUaBrowsePathTarget>>>(handle)) {
+        future->reportResult(QOpcUaOperationResult<QVector<QOpcUaBrowsePathTarget>>(targets, status));
+        future->reportFinished();
+    }
 }
 
 void QOpcUaClientImpl::handleNewEvent(quint64 handle, QVariantList eventFields)
 {
-    auto it = m_handles.constFind(handle);
-    if (it != m_handles.constEnd() && !it->isNull())
-        emit (*it)->eventOccurred(eventFields);
+    if (QOpcUaNodePrivate *node = nodeForHandle(handle))
+        node->handleEvent(eventFields);
+}
+
+void QOpcUaClientImpl::handleHistoryDataReceived(quint64 handle, const QVector<QOpcUaHistoryData> &data)
+{
+    auto it = m_historyReads.constFind(handle);
+    if (it == m_historyReads.constEnd())
+        return;
+
+    if (!it->isNull())
+        (*it)->d_func()->handleDataReceived(data);
+
+    // The backend requests the next pages after the receivers have processed this page.
+    // A response which has been aborted or destroyed by a receiver is no longer in the map.
+    if (m_historyReads.contains(handle))
+        acknowledgeHistoryData(handle);
+}
+
+void QOpcUaClientImpl::handleHistoryReadFinished(quint64 handle, QOpcUa::UaStatusCode statusCode)
+{
+    const QPointer<QOpcUaHistoryReadResponse> response = m_historyReads.take(handle);
+    if (response)
+        response->d_func()->handleFinished(statusCode);
+}
+
+void QOpcUaClientImpl::handleValuesRead(quint64 requestHandle, QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult)
+{
+    if (m_client)
+        static_cast<QOpcUaClientPrivate *>(QObjectPrivate::get(m_client))->cacheReadResults(results, serviceResult);
+
+    if (const auto future = takeFuture<QVector<QOpcUaReadResult>>(requestHandle)) {
+        future->reportResult(results);
+        future->reportFinished();
+        return;
+    }
+
+    const QVector<quint64> handles = m_valueRequests.take(requestHandle);
+    if (handles.isEmpty())
+        return;
+
+    // A failed service call returns no results, each handle gets the service result
+    if (results.size() != handles.size()) {
+        results.resize(handles.size());
+        for (int i = 0; i < handles.size(); ++i) {
+            const ValueHandle *valueHandle = m_valueHandles.find(handles.at(i));
+            if (valueHandle) {
+                results[i].setNodeId(valueHandle->nodeId);
+                results[i].setAttribute(valueHandle->attribute);
+                results[i].setIndexRange(valueHandle->indexRange);
+            }
+            results[i].setStatusCode(serviceResult != QOpcUa::UaStatusCode::Good ? serviceResult
+                                                                                 : QOpcUa::UaStatusCode::BadInternalError);
+        }
+    }
+
+    emit valuesRead(handles, results, serviceResult);
+}
+
+void QOpcUaClientImpl::handleValuesWritten(quint64 requestHandle, const QVector<QOpcUaWriteResult> &results, QOpcUa::UaStatusCode serviceResult)
+{
+    if (m_client)
+        static_cast<QOpcUaClientPrivate *>(QObjectPrivate::get(m_client))->invalidateWrittenAttributes(results);
+
+    if (const auto future = takeFuture<QVector<QOpcUaWriteResult>>(requestHandle)) {
+        future->reportResult(results);
+        future->reportFinished();
+        return;
+    }
+
+    const QVector<quint64> handles = m_valueRequests.take(requestHandle);
+    if (handles.isEmpty())
+        return;
+
+    QVector<QOpcUa::UaStatusCode> statusCodes;
+    statusCodes.reserve(handles.size());
+    for (int i = 0; i < handles.size(); ++i) {
+        if (i < results.size())
+            statusCodes.push_back(results.at(i).statusCode());
+        else
+            statusCodes.push_back(serviceResult != QOpcUa::UaStatusCode::Good ? serviceResult : QOpcUa::UaStatusCode::BadInternalError);
+    }
+
+    emit valuesWritten(handles, statusCodes, serviceResult);
+}
+
+void QOpcUaClientImpl::handleCallMethodsFinished(quint64 requestHandle, const QVector<QOpcUaCallMethodResult> &results,
+                                                 QOpcUa::UaStatusCode serviceResult)
+{
+    if (!requestHandle) {
+        emit callMethodsFinished(results, serviceResult);
+        return;
+    }
+
+    if (const auto future = takeFuture<QVector<QOpcUaCallMethodResult>>(requestHandle)) {
+        future->reportResult(results);
+        future->reportFinished();
+    }
 }
 
 QT_END_NAMESPACE
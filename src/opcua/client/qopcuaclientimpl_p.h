@@ -51,18 +51,30 @@
 #include <QtOpcUa/qopcuaclient.h>
 #include <QtOpcUa/qopcuaglobal.h>
 #include <QtOpcUa/qopcuaendpointdescription.h>
+#include <QtOpcUa/qopcuahistorydata.h>
+#include <QtOpcUa/qopcuahistoryreadrequest.h>
+#include <QtOpcUa/qopcuaoperationresult.h>
 #include <private/qopcuanodeimpl_p.h>
+#include <private/qopcuaslotmap_p.h>
 
+#include <QtCore/qfuture.h>
+#include <QtCore/qfutureinterface.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qpointer.h>
 #include <QtCore/qset.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
 class QOpcUaNode;
 class QOpcUaClient;
 class QOpcUaBackend;
+class QOpcUaDataChangeQueue;
+class QOpcUaHistoryReadResponse;
 class QOpcUaMonitoringParameters;
+class QOpcUaNodePrivate;
 
 class Q_OPCUA_EXPORT QOpcUaClientImpl : public QObject
 {
@@ -78,11 +90,65 @@ public:
     virtual QString backend() const = 0;
     virtual bool requestEndpoints(const QUrl &url) = 0;
     virtual bool findServers(const QUrl &url, const QStringList &localeIds, const QStringList &serverUris) = 0;
-    virtual bool readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead) = 0;
+    virtual bool readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge) = 0;
     virtual bool writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite) = 0;
 
-    bool registerNode(QPointer<QOpcUaNodeImpl> obj);
-    void unregisterNode(QPointer<QOpcUaNodeImpl> obj);
+    virtual bool enableMonitoring(const QVector<QOpcUaNodeImpl *> &nodes, QOpcUa::NodeAttributes attr,
+                                  const QOpcUaMonitoringParameters &settings);
+    virtual bool disableMonitoring(const QVector<QOpcUaNodeImpl *> &nodes, QOpcUa::NodeAttributes attr);
+
+    bool browseNodes(const QStringList &nodeIds, const QOpcUaBrowseRequest &request, quint32 requestedMaxReferencesPerNode);
+    // Returns the request handle which identifies the results in browseNodesFinished(), 0 if the request was not dispatched
+    quint64 dispatchBrowseNodes(const QStringList &nodeIds, const QOpcUaBrowseRequest &request, quint32 requestedMaxReferencesPerNode);
+
+    virtual bool registerNodes(const QStringList &nodeIds);
+    virtual bool unregisterNodes(const QStringList &nodeIds);
+
+    QOpcUaHistoryReadResponse *readHistoryData(const QOpcUaHistoryReadRequest &request);
+    void abortHistoryRead(quint64 handle);
+
+    QVector<quint64> registerValueHandles(const QVector<QOpcUaReadItem> &items);
+    void unregisterValueHandles(const QVector<quint64> &handles);
+    bool readValues(const QVector<quint64> &handles, double maxAge);
+    bool writeValues(const QVector<quint64> &handles, const QVector<QOpcUa::TypedVariant> &values);
+    bool enableValueMonitoring(const QVector<quint64> &handles, const QOpcUaMonitoringParameters &settings);
+    bool disableValueMonitoring(const QVector<quint64> &handles);
+
+    bool callMethods(const QVector<QOpcUaCallMethodItem> &methodsToCall);
+
+    // The futures are canceled if the request could not be dispatched
+    QFuture<QVector<QOpcUaReadResult>> readFuture(const QVector<QOpcUaReadItem> &items, double maxAge);
+    QFuture<QVector<QOpcUaWriteResult>> writeFuture(const QVector<QOpcUaWriteItem> &items);
+    QFuture<QOpcUaOperationResult<QVector<QOpcUaReferenceDescription>>> browseFuture(const QString &nodeId,
+                                                                                     const QOpcUaBrowseRequest &request);
+    QFuture<QOpcUaOperationResult<QVariant>> callMethodFuture(const QString &objectId, const QString &methodId,
+                                                               const QVector<QOpcUa::TypedVariant> &args);
+    QFuture<QOpcUaOperationResult<QVector<QOpcUaBrowsePathTarget>>> resolveBrowsePathFuture(const QString &startNodeId,
+                                                                                            const QVector<QOpcUaRelativePathElement> &path);
+    QFuture<QVector<QOpcUaCallMethodResult>> callMethodsFuture(const QVector<QOpcUaCallMethodItem> &methodsToCall);
+
+    template <typename T>
+    static QFuture<T> canceledFuture()
+    {
+        QFutureInterface<T> future;
+        future.reportStarted();
+        future.reportCanceled();
+        future.reportFinished();
+        return future.future();
+    }
+
+    template <typename T>
+    static QFuture<T> finishedFuture(const T &result)
+    {
+        QFutureInterface<T> future;
+        future.reportStarted();
+        future.reportResult(result);
+        future.reportFinished();
+        return future.future();
+    }
+
+    bool registerNode(QOpcUaNodeImpl *obj);
+    void unregisterNode(QOpcUaNodeImpl *obj);
 
     virtual bool addNode(const QOpcUaAddNodeItem &nodeToAdd) = 0;
     virtual bool deleteNode(const QString &nodeId, bool deleteTargetReferences) = 0;
@@ -92,15 +158,47 @@ public:
 
     void connectBackendWithClient(QOpcUaBackend *backend);
 
+    void setDataChangeQueue(const QSharedPointer<QOpcUaDataChangeQueue> &queue);
+    quint64 conflatedDataChangeCount() const;
+    quint64 droppedDataChangeCount() const;
+    QThread *backendThread() const;
+
     virtual QStringList supportedSecurityPolicies() const = 0;
     virtual QVector<QOpcUaUserTokenPolicy::TokenType> supportedUserTokenTypes() const = 0;
 
     QOpcUaClient *m_client;
 
+protected:
+    // History reads are identified by a handle, the backend waits for an acknowledgement of each page
+    virtual bool startHistoryRead(quint64 handle, const QOpcUaHistoryReadRequest &request);
+    virtual void acknowledgeHistoryData(quint64 handle);
+    virtual void cancelHistoryRead(quint64 handle);
+
+    // Reads and writes of value handles and futures are identified by a request handle, the results are in the order of the items
+    virtual bool startValueRead(quint64 requestHandle, const QVector<QOpcUaReadItem> &items, double maxAge);
+    virtual bool startValueWrite(quint64 requestHandle, const QVector<QOpcUaWriteItem> &items);
+    // Data changes of value handles are delivered like those of nodes, using the value handle
+    virtual bool startValueMonitoring(const QVector<quint64> &handles, const QStringList &nodeIds, QOpcUa::NodeAttribute attr,
+                                      const QOpcUaMonitoringParameters &settings);
+    virtual bool stopValueMonitoring(const QVector<quint64> &handles, QOpcUa::NodeAttribute attr);
+    // Requests for futures, the results are delivered like those of nodes, using the request handle
+    virtual bool startBrowse(quint64 requestHandle, const QString &nodeId, const QOpcUaBrowseRequest &request);
+    virtual bool startMethodCall(quint64 requestHandle, const QString &objectId, const QString &methodId,
+                                 const QVector<QOpcUa::TypedVariant> &args);
+    virtual bool startResolveBrowsePath(quint64 requestHandle, const QString &startNodeId,
+                                        const QVector<QOpcUaRelativePathElement> &path);
+    // Batch calls are split according to the operation limits of the server, the request handle is 0 for calls without a future
+    virtual bool startMethodCalls(quint64 requestHandle, const QVector<QOpcUaCallMethodItem> &methodsToCall);
+    // The request handle is 0 for batch browse requests of the public API
+    virtual bool startBrowseNodes(quint64 requestHandle, const QStringList &nodeIds, const QOpcUaBrowseRequest &request,
+                                  quint32 requestedMaxReferencesPerNode);
+
 private Q_SLOTS:
     void handleAttributesRead(quint64 handle, QVector<QOpcUaReadResult> attr, QOpcUa::UaStatusCode serviceResult);
     void handleAttributeWritten(quint64 handle, QOpcUa::NodeAttribute attr, const QVariant &value, QOpcUa::UaStatusCode statusCode);
     void handleDataChangeOccurred(quint64 handle, const QOpcUaReadResult &value);
+    void handleDataChangesOccurred(const QVector<quint64> &handles, QVector<QOpcUaReadResult> values);
+    void handleDataChangesAvailable();
     void handleMonitoringEnableDisable(quint64 handle, QOpcUa::NodeAttribute attr, bool subscribe, QOpcUaMonitoringParameters status);
     void handleMonitoringStatusChanged(quint64 handle, QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items,
                                  QOpcUaMonitoringParameters param);
@@ -112,6 +210,15 @@ private Q_SLOTS:
 
     void handleNewEvent(quint64 handle, QVariantList eventFields);
 
+    void handleHistoryDataReceived(quint64 handle, const QVector<QOpcUaHistoryData> &data);
+    void handleHistoryReadFinished(quint64 handle, QOpcUa::UaStatusCode statusCode);
+
+    void handleValuesRead(quint64 requestHandle, QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult);
+    void handleValuesWritten(quint64 requestHandle, const QVector<QOpcUaWriteResult> &results, QOpcUa::UaStatusCode serviceResult);
+    void handleCallMethodsFinished(quint64 requestHandle, const QVector<QOpcUaCallMethodResult> &results,
+                                   QOpcUa::UaStatusCode serviceResult);
+    void deliverValueMonitoringResults();
+
 signals:
     void connected();
     void disconnected();
@@ -121,6 +228,17 @@ signals:
     void findServersFinished(QVector<QOpcUaApplicationDescription> servers, QOpcUa::UaStatusCode statusCode, QUrl requestUrl);
     void readNodeAttributesFinished(QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult);
     void writeNodeAttributesFinished(QVector<QOpcUaWriteResult> results, QOpcUa::UaStatusCode serviceResult);
+    void callMethodsFinished(QVector<QOpcUaCallMethodResult> results, QOpcUa::UaStatusCode serviceResult);
+    void browseNodesFinished(quint64 requestHandle, QString nodeId, QVector<QOpcUaReferenceDescription> references,
+                             QOpcUa::UaStatusCode statusCode);
+    void registerNodesFinished(QStringList nodeIds, QStringList registeredNodeIds, QOpcUa::UaStatusCode statusCode);
+    void unregisterNodesFinished(QStringList nodeIds, QOpcUa::UaStatusCode statusCode);
+    void dataChangesOccurred(QVector<QOpcUaReadResult> results);
+    void valuesRead(QVector<quint64> handles, QVector<QOpcUaReadResult> results, QOpcUa::UaStatusCode serviceResult);
+    void valuesWritten(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results, QOpcUa::UaStatusCode serviceResult);
+    void valuesChanged(QVector<quint64> handles, QVector<QOpcUaReadResult> values);
+    void valueMonitoringEnabled(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results);
+    void valueMonitoringDisabled(QVector<quint64> handles, QVector<QOpcUa::UaStatusCode> results);
     void addNodeFinished(QOpcUaExpandedNodeId requestedNodeId, QString assignedNodeId, QOpcUa::UaStatusCode statusCode);
     void deleteNodeFinished(QString nodeId, QOpcUa::UaStatusCode statusCode);
     void addReferenceFinished(QString sourceNodeId, QString referenceTypeId, QOpcUaExpandedNodeId targetNodeId, bool isForwardReference,
@@ -132,14 +250,50 @@ signals:
 
 private:
     Q_DISABLE_COPY(QOpcUaClientImpl)
-    QHash<quint64, QPointer<QOpcUaNodeImpl>> m_handles;
-    quint64 m_handleCounter;
-};
+    QOpcUaNodePrivate *nodeForHandle(quint64 handle) const;
+    void handleValueMonitoringResult(quint64 handle, bool subscribe, QOpcUa::UaStatusCode statusCode);
 
-inline uint qHash(const QPointer<QOpcUaNodeImpl>& n)
-{
-    return ::qHash(n.data());
-}
+    template <typename T>
+    QSharedPointer<QFutureInterface<T>> takeFuture(quint64 requestHandle);
+    template <typename T>
+    QFuture<T> dispatchFuture(const std::function<bool(quint64)> &start);
+
+    // The tags keep the handles of the different maps apart, the backend uses all of them as opaque handles
+    enum HandleTag : quint32 {
+        NodeHandleTag = 0,
+        ValueHandleTag = 1,
+        ValueRequestTag = 2,
+        FutureRequestTag = 3
+    };
+
+    // Node implementations remove themselves from the map when they are destroyed
+    QOpcUaSlotMap<QOpcUaNodeImpl *> m_handles;
+
+    // Node id and attribute of a value handle, value handles share the handle space with nodes
+    struct ValueHandle {
+        QString nodeId;
+        QOpcUa::NodeAttribute attribute = QOpcUa::NodeAttribute::None;
+        QString indexRange;
+        bool monitored = false;
+    };
+    QOpcUaSlotMap<ValueHandle> m_valueHandles;
+    QOpcUaSlotMap<QVector<quint64>> m_valueRequests; // Request handle -> value handles
+    QOpcUaSlotMap<QSharedPointer<QFutureInterfaceBase>> m_futureRequests; // Canceled when the client is destroyed
+
+    // Monitoring results of value handles which arrive together are delivered in one signal
+    struct ValueMonitoringResults {
+        QVector<quint64> handles;
+        QVector<QOpcUa::UaStatusCode> results;
+    };
+    ValueMonitoringResults m_valueMonitoringEnabled;
+    ValueMonitoringResults m_valueMonitoringDisabled;
+    bool m_valueMonitoringDeliveryPending;
+    QSharedPointer<QOpcUaDataChangeQueue> m_dataChangeQueue;
+    QHash<quint64, QPointer<QOpcUaHistoryReadResponse>> m_historyReads;
+    quint64 m_historyReadCounter;
+    quint64 m_browseNodesCounter;
+    QOpcUaBackend *m_backend; // Owned by the implementation, lives in the backend thread
+};
 
 QT_END_NAMESPACE
 
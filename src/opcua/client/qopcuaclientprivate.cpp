@@ -34,7 +34,10 @@
 **
 ****************************************************************************/
 
+#include <private/qopcuaaddressspacecache_p.h>
+#include <private/qopcuaattributecache_p.h>
 #include <private/qopcuaclient_p.h>
+#include <private/qopcuanode_p.h>
 
 #include <QtCore/qloggingcategory.h>
 #include <QtOpcUa/qopcuaendpointdescription.h>
@@ -52,6 +55,7 @@ QOpcUaClientPrivate::QOpcUaClientPrivate(QOpcUaClientImpl *impl)
     , m_error(QOpcUaClient::NoError)
     , m_enableNamespaceArrayAutoupdate(false)
     , m_authenticationInformation(QOpcUaAuthenticationInformation())
+    , m_attributeCache(new QOpcUaAttributeCache)
     , m_namespaceArrayAutoupdateEnabled(false)
     , m_namespaceArrayUpdateInterval(1000)
 {
@@ -77,15 +81,69 @@ QOpcUaClientPrivate::QOpcUaClientPrivate(QOpcUaClientImpl *impl)
     });
 
     QObject::connect(m_impl.data(), &QOpcUaClientImpl::readNodeAttributesFinished, [this](const QVector<QOpcUaReadResult> &results, QOpcUa::UaStatusCode serviceResult) {
+        cacheReadResults(results, serviceResult);
         Q_Q(QOpcUaClient);
         emit q->readNodeAttributesFinished(results, serviceResult);
     });
 
     QObject::connect(m_impl.data(), &QOpcUaClientImpl::writeNodeAttributesFinished, [this](const QVector<QOpcUaWriteResult> &results, QOpcUa::UaStatusCode serviceResult) {
+        invalidateWrittenAttributes(results);
         Q_Q(QOpcUaClient);
         emit q->writeNodeAttributesFinished(results, serviceResult);
     });
 
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::callMethodsFinished, [this](const QVector<QOpcUaCallMethodResult> &results, QOpcUa::UaStatusCode serviceResult) {
+        Q_Q(QOpcUaClient);
+        emit q->callMethodsFinished(results, serviceResult);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::dataChangesOccurred, [this](const QVector<QOpcUaReadResult> &results) {
+        Q_Q(QOpcUaClient);
+        emit q->dataChangesOccurred(results);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::valuesRead, [this](const QVector<quint64> &handles, const QVector<QOpcUaReadResult> &results, QOpcUa::UaStatusCode serviceResult) {
+        Q_Q(QOpcUaClient);
+        emit q->valuesRead(handles, results, serviceResult);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::valuesWritten, [this](const QVector<quint64> &handles, const QVector<QOpcUa::UaStatusCode> &results, QOpcUa::UaStatusCode serviceResult) {
+        Q_Q(QOpcUaClient);
+        emit q->valuesWritten(handles, results, serviceResult);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::valuesChanged, [this](const QVector<quint64> &handles, const QVector<QOpcUaReadResult> &values) {
+        Q_Q(QOpcUaClient);
+        emit q->valuesChanged(handles, values);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::valueMonitoringEnabled, [this](const QVector<quint64> &handles, const QVector<QOpcUa::UaStatusCode> &results) {
+        Q_Q(QOpcUaClient);
+        emit q->valueMonitoringEnabled(handles, results);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::valueMonitoringDisabled, [this](const QVector<quint64> &handles, const QVector<QOpcUa::UaStatusCode> &results) {
+        Q_Q(QOpcUaClient);
+        emit q->valueMonitoringDisabled(handles, results);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::browseNodesFinished, [this](quint64 requestHandle, const QString &nodeId, const QVector<QOpcUaReferenceDescription> &references, QOpcUa::UaStatusCode statusCode) {
+        Q_Q(QOpcUaClient);
+        // Requests with a handle have been sent by the module itself, e.g. by QOpcUaAddressSpaceCrawler
+        if (!requestHandle)
+            emit q->browseNodesFinished(nodeId, references, statusCode);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::registerNodesFinished, [this](const QStringList &nodeIds, const QStringList &registeredNodeIds, QOpcUa::UaStatusCode statusCode) {
+        Q_Q(QOpcUaClient);
+        emit q->registerNodesFinished(nodeIds, registeredNodeIds, statusCode);
+    });
+
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::unregisterNodesFinished, [this](const QStringList &nodeIds, QOpcUa::UaStatusCode statusCode) {
+        Q_Q(QOpcUaClient);
+        emit q->unregisterNodesFinished(nodeIds, statusCode);
+    });
+
     QObject::connect(m_impl.data(), &QOpcUaClientImpl::addNodeFinished, [this](const QOpcUaExpandedNodeId &requestedNodeId, const QString &assignedNodeId, QOpcUa::UaStatusCode statusCode) {
         Q_Q(QOpcUaClient);
         emit q->addNodeFinished(requestedNodeId, assignedNodeId, statusCode);
@@ -190,6 +248,8 @@ void QOpcUaClientPrivate::setStateAndError(QOpcUaClient::ClientState state,
     // array if there is no active session. This could invalidate the cached namespaces table.
     if (state == QOpcUaClient::Disconnected) {
         m_namespaceArray.clear();
+        resetAddressSpaceCache();
+        m_attributeCache->clear();
     }
 }
 
@@ -231,6 +291,7 @@ void QOpcUaClientPrivate::namespaceArrayUpdated(QOpcUa::NodeAttributes attr)
 
     if (updatedNamespaceArray != m_namespaceArray) {
         m_namespaceArray = updatedNamespaceArray;
+        updateAddressSpaceCache();
         emit q->namespaceArrayChanged(m_namespaceArray);
     }
     emit q->namespaceArrayUpdated(m_namespaceArray);
@@ -276,6 +337,82 @@ void QOpcUaClientPrivate::setupNamespaceArrayMonitoring()
     }
 }
 
+void QOpcUaClientPrivate::updateAddressSpaceCache()
+{
+    Q_Q(QOpcUaClient);
+
+    if (m_addressSpaceCacheDirectory.isEmpty() || m_state != QOpcUaClient::Connected || m_namespaceArray.isEmpty()) {
+        resetAddressSpaceCache();
+        return;
+    }
+
+    // The cache is specific to the server application and its namespace array.
+    // A different namespace array most probably means that the server's information model has been redeployed.
+    const QString applicationUri = m_endpoint.server().applicationUri();
+    if (m_addressSpaceCache && m_addressSpaceCache->key() == QOpcUaAddressSpaceCache::cacheKey(applicationUri, m_namespaceArray))
+        return;
+
+    m_addressSpaceCache.reset(); // Writes the previous cache before a new one is opened
+    m_addressSpaceCache.reset(new QOpcUaAddressSpaceCache(m_addressSpaceCacheDirectory, applicationUri, m_namespaceArray));
+
+    if (m_modelChangeNode)
+        return;
+
+    // Model change events emitted by the server invalidate the cache
+    m_modelChangeNode.reset(m_impl->node(QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::Server)));
+    if (!m_modelChangeNode)
+        return;
+
+    QObject::connect(m_modelChangeNode.data(), &QOpcUaNode::eventOccurred, q, [this](QVariantList eventFields) {
+        handleModelChangeEvent(eventFields);
+    });
+
+    QOpcUaMonitoringParameters::EventFilter filter;
+    filter << QOpcUaSimpleAttributeOperand(QStringLiteral("EventType"));
+
+    QOpcUaMonitoringParameters options;
+    options.setSubscriptionType(QOpcUaMonitoringParameters::SubscriptionType::Exclusive);
+    options.setMaxKeepAliveCount((std::numeric_limits<quint32>::max)() - 1);
+    options.setPublishingInterval(m_namespaceArrayUpdateInterval);
+    options.setFilter(filter);
+    m_modelChangeNode->enableMonitoring(QOpcUa::NodeAttribute::EventNotifier, options);
+}
+
+void QOpcUaClientPrivate::resetAddressSpaceCache()
+{
+    m_modelChangeNode.reset();
+    m_addressSpaceCache.reset();
+}
+
+void QOpcUaClientPrivate::handleModelChangeEvent(const QVariantList &eventFields)
+{
+    const QString eventType = eventFields.value(0).toString();
+    if (eventType != QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::BaseModelChangeEventType) &&
+            eventType != QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::GeneralModelChangeEventType))
+        return;
+
+    if (m_addressSpaceCache) {
+        qCDebug(QT_OPCUA) << "The address space of the server has been modified, invalidating the address space cache";
+        m_addressSpaceCache->invalidate();
+    }
+}
+
+void QOpcUaClientPrivate::cacheReadResults(const QVector<QOpcUaReadResult> &results, QOpcUa::UaStatusCode serviceResult)
+{
+    if (serviceResult != QOpcUa::UaStatusCode::Good || !m_attributeCache->isEnabled())
+        return;
+
+    for (const auto &result : results)
+        m_attributeCache->insert(result.nodeId(), result);
+}
+
+void QOpcUaClientPrivate::invalidateWrittenAttributes(const QVector<QOpcUaWriteResult> &results)
+{
+    // The server may have modified the written values, they are read again on the next access
+    for (const auto &result : results)
+        m_attributeCache->remove(result.nodeId(), result.attribute());
+}
+
 void QOpcUaClientPrivate::setApplicationIdentity(const QOpcUaApplicationIdentity &identity)
 {
     m_applicationIdentity = identity;
@@ -296,4 +433,24 @@ QOpcUaPkiConfiguration QOpcUaClientPrivate::pkiConfiguration() const
     return m_pkiConfig;
 }
 
+bool QOpcUaClientPrivate::nodeImplementations(const QVector<QOpcUaNode *> &nodes, QVector<QOpcUaNodeImpl *> *impls) const
+{
+    Q_Q(const QOpcUaClient);
+
+    impls->reserve(nodes.size());
+    for (QOpcUaNode *node : nodes) {
+        if (!node)
+            return false;
+
+        const QOpcUaNodePrivate *nodePrivate = static_cast<const QOpcUaNodePrivate *>(QObjectPrivate::get(node));
+        if (nodePrivate->m_client != q || !nodePrivate->m_impl) {
+            qCWarning(QT_OPCUA) << "Node" << node->nodeId() << "has not been created by this client";
+            return false;
+        }
+        impls->push_back(nodePrivate->m_impl.data());
+    }
+
+    return true;
+}
+
 QT_END_NAMESPACE
@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuadatachangequeue_p.h"
+
+#include <QtCore/qmath.h>
+
+QT_BEGIN_NAMESPACE
+
+QOpcUaDataChangeQueue::QOpcUaDataChangeQueue(int capacity)
+    : m_capacity(static_cast<quint32>(qMax(1, capacity)))
+    , m_mask(qNextPowerOfTwo(m_capacity - 1) - 1)
+    , m_slots(new Slot[m_capacity])
+    , m_ring(new quint32[m_mask + 1])
+    , m_head(0)
+    , m_tail(0)
+    , m_notificationPending(0)
+    , m_conflated(0)
+    , m_overflowed(0)
+{
+    m_freeSlots.reserve(m_capacity);
+    for (quint32 i = m_capacity; i > 0; --i)
+        m_freeSlots.push_back(i - 1);
+}
+
+QOpcUaDataChangeQueue::~QOpcUaDataChangeQueue()
+{
+    delete[] m_slots;
+    delete[] m_ring;
+}
+
+int QOpcUaDataChangeQueue::capacity() const
+{
+    return static_cast<int>(m_capacity);
+}
+
+/*
+    Makes \a result the pending value of its attribute.
+    If there is no free slot for a new attribute, the slots of attributes for which
+    \a isMonitored returns false are reclaimed before the value is rejected.
+*/
+QOpcUaDataChangeQueue::PushResult QOpcUaDataChangeQueue::push(quint64 handle, const QOpcUaReadResult &result,
+                                                              const IsMonitored &isMonitored)
+{
+    const auto key = qMakePair(handle, result.attribute());
+    quint32 index = 0;
+
+    auto it = m_slotIndex.constFind(key);
+    if (it != m_slotIndex.constEnd()) {
+        index = it.value();
+    } else {
+        if (m_freeSlots.isEmpty() && isMonitored)
+            reclaimSlots(isMonitored);
+        if (m_freeSlots.isEmpty()) {
+            m_overflowed.fetchAndAddRelaxed(1);
+            return PushResult::Full;
+        }
+        index = m_freeSlots.takeLast();
+        m_slotIndex.insert(key, index);
+    }
+
+    // Publish the entry of the producer and take over the previously pending entry
+    Slot &slot = m_slots[index];
+    Entry &entry = slot.entries[slot.producerEntry];
+    entry.handle = handle;
+    entry.result = result;
+    const int previous = slot.pending.fetchAndStoreAcquireRelease(slot.producerEntry | PendingValue);
+    slot.producerEntry = previous & EntryMask;
+
+    // The consumer has not yet taken the previous value, the slot is still in the ring
+    if (previous & PendingValue) {
+        m_conflated.fetchAndAddRelaxed(1);
+        return PushResult::Conflated;
+    }
+
+    // A slot is only in the ring while it has a pending value, the ring can't overflow
+    const bool pushed = pushIndex(index);
+    Q_ASSERT(pushed);
+    Q_UNUSED(pushed);
+
+    return PushResult::Queued;
+}
+
+/*
+    Returns true if the consumer must be notified about new values.
+    There is at most one outstanding notification until the consumer calls take().
+*/
+bool QOpcUaDataChangeQueue::requestNotification()
+{
+    return m_notificationPending.testAndSetOrdered(0, 1);
+}
+
+/*
+    Returns the slots of attributes which are no longer monitored to the free list.
+    Slots with a pending value are kept until the consumer has taken the value.
+*/
+void QOpcUaDataChangeQueue::reclaimSlots(const IsMonitored &isMonitored)
+{
+    for (auto it = m_slotIndex.begin(); it != m_slotIndex.end();) {
+        if (!isMonitored(it.key().first, it.key().second)
+                && !(m_slots[it.value()].pending.loadAcquire() & PendingValue)) {
+            m_freeSlots.push_back(it.value());
+            it = m_slotIndex.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int QOpcUaDataChangeQueue::take(QVector<quint64> *handles, QVector<QOpcUaReadResult> *results)
+{
+    // Reset before draining, values pushed after this point cause a new notification
+    m_notificationPending.fetchAndStoreOrdered(0);
+
+    int count = 0;
+    quint32 index = 0;
+    while (popIndex(&index)) {
+        // Hand the entry of the consumer to the producer and take over the pending entry
+        Slot &slot = m_slots[index];
+        const int pending = slot.pending.fetchAndStoreAcquireRelease(slot.consumerEntry);
+        slot.consumerEntry = pending & EntryMask;
+        if (!(pending & PendingValue))
+            continue;
+        const Entry &entry = slot.entries[slot.consumerEntry];
+        handles->push_back(entry.handle);
+        results->push_back(entry.result);
+        ++count;
+    }
+
+    return count;
+}
+
+quint64 QOpcUaDataChangeQueue::conflatedCount() const
+{
+    return m_conflated.loadRelaxed();
+}
+
+/*
+    Returns the number of values which have been rejected because there was no free slot.
+*/
+quint64 QOpcUaDataChangeQueue::overflowCount() const
+{
+    return m_overflowed.loadRelaxed();
+}
+
+bool QOpcUaDataChangeQueue::pushIndex(quint32 index)
+{
+    const quint32 tail = m_tail.loadRelaxed();
+    if (tail - m_head.loadAcquire() > m_mask)
+        return false;
+
+    m_ring[tail & m_mask] = index;
+    m_tail.storeRelease(tail + 1);
+    return true;
+}
+
+bool QOpcUaDataChangeQueue::popIndex(quint32 *index)
+{
+    const quint32 head = m_head.loadRelaxed();
+    if (head == m_tail.loadAcquire())
+        return false;
+
+    *index = m_ring[head & m_mask];
+    m_head.storeRelease(head + 1);
+    return true;
+}
+
+QT_END_NAMESPACE
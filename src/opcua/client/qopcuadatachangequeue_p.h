@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPCUADATACHANGEQUEUE_P_H
+#define QOPCUADATACHANGEQUEUE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuareadresult.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qvector.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+// Bounded channel for data change notifications between one producer thread (the backend)
+// and one consumer thread (the client).
+// Every monitored attribute owns a slot which holds at most one pending value. A newer value
+// for the same attribute replaces the pending value, so the memory used by the queue is bounded
+// by the number of slots no matter how far the consumer falls behind.
+// The entries of a slot are allocated up front and triple buffered: the producer writes to its own
+// entry and swaps it with the pending entry, the consumer swaps the pending entry with its own entry.
+// The indices of slots with a pending value are passed to the consumer in a lock-free ring buffer.
+class Q_OPCUA_EXPORT QOpcUaDataChangeQueue
+{
+public:
+    enum class PushResult {
+        Queued,     // The value is pending in a slot which had no pending value
+        Conflated,  // The value has replaced a pending value
+        Full        // There is no free slot for the attribute
+    };
+
+    explicit QOpcUaDataChangeQueue(int capacity);
+    ~QOpcUaDataChangeQueue();
+
+    int capacity() const;
+
+    // Producer thread
+    using IsMonitored = std::function<bool(quint64, QOpcUa::NodeAttribute)>;
+    PushResult push(quint64 handle, const QOpcUaReadResult &result, const IsMonitored &isMonitored = nullptr);
+    bool requestNotification();
+    void reclaimSlots(const IsMonitored &isMonitored);
+
+    // Consumer thread
+    int take(QVector<quint64> *handles, QVector<QOpcUaReadResult> *results);
+
+    // Any thread
+    quint64 conflatedCount() const;
+    quint64 overflowCount() const;
+
+private:
+    Q_DISABLE_COPY(QOpcUaDataChangeQueue)
+
+    struct Entry {
+        quint64 handle = 0;
+        QOpcUaReadResult result;
+    };
+
+    struct Slot {
+        Entry entries[3];
+        QAtomicInt pending; // Index of the pending entry, ORed with PendingValue while it holds a new value
+        int producerEntry = 1; // Only accessed by the producer
+        int consumerEntry = 2; // Only accessed by the consumer
+    };
+
+    static constexpr int PendingValue = 4;
+    static constexpr int EntryMask = 3;
+
+    bool pushIndex(quint32 index);
+    bool popIndex(quint32 *index);
+
+    const quint32 m_capacity;
+    const quint32 m_mask;
+    Slot *m_slots;
+    quint32 *m_ring;
+
+    QAtomicInteger<quint32> m_head; // Only written by the consumer
+    QAtomicInteger<quint32> m_tail; // Only written by the producer
+    QAtomicInt m_notificationPending;
+
+    QAtomicInteger<quint64> m_conflated;
+    QAtomicInteger<quint64> m_overflowed;
+
+    // Only accessed by the producer
+    QHash<QPair<quint64, QOpcUa::NodeAttribute>, quint32> m_slotIndex;
+    QVector<quint32> m_freeSlots;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUADATACHANGEQUEUE_P_H
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuahistorydata.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaHistoryData
+    \inmodule QtOpcUa
+    \brief One page of historical values of a node.
+    \since QtOpcUa 5.15
+
+    A history read delivers the values of each node in pages. Every page contains the values
+    the server has returned in one response and the status code of the history read for the node.
+    The values of a node are delivered in the order of the pages, \l isLastPage() is true for
+    the last page of a node.
+
+    \sa QOpcUaHistoryReadResponse
+*/
+
+class QOpcUaHistoryDataData : public QSharedData
+{
+public:
+    QString nodeId;
+    QOpcUa::UaStatusCode statusCode {QOpcUa::UaStatusCode::Good};
+    QVector<QOpcUaReadResult> values;
+    bool lastPage {false};
+};
+
+QOpcUaHistoryData::QOpcUaHistoryData()
+    : data(new QOpcUaHistoryDataData)
+{
+}
+
+/*!
+    Constructs history data from \a other.
+*/
+QOpcUaHistoryData::QOpcUaHistoryData(const QOpcUaHistoryData &other)
+    : data(other.data)
+{
+}
+
+/*!
+    Sets the values from \a rhs in this history data.
+*/
+QOpcUaHistoryData &QOpcUaHistoryData::operator=(const QOpcUaHistoryData &rhs)
+{
+    if (this != &rhs)
+        data.operator=(rhs.data);
+    return *this;
+}
+
+QOpcUaHistoryData::~QOpcUaHistoryData()
+{
+}
+
+/*!
+    Returns the node id of the node the values belong to.
+*/
+QString QOpcUaHistoryData::nodeId() const
+{
+    return data->nodeId;
+}
+
+/*!
+    Sets the node id to \a nodeId.
+*/
+void QOpcUaHistoryData::setNodeId(const QString &nodeId)
+{
+    data->nodeId = nodeId;
+}
+
+/*!
+    Returns the status code of the history read for the node.
+
+    Good and uncertain status codes may be accompanied by values, a bad status code ends the history read for the node.
+*/
+QOpcUa::UaStatusCode QOpcUaHistoryData::statusCode() const
+{
+    return data->statusCode;
+}
+
+/*!
+    Sets the status code to \a statusCode.
+*/
+void QOpcUaHistoryData::setStatusCode(QOpcUa::UaStatusCode statusCode)
+{
+    data->statusCode = statusCode;
+}
+
+/*!
+    Returns the values of this page.
+
+    The value of each result is stored in \l QOpcUaReadResult::value(), the quality of the value is stored in
+    \l QOpcUaReadResult::statusCode().
+*/
+QVector<QOpcUaReadResult> QOpcUaHistoryData::values() const
+{
+    return data->values;
+}
+
+/*!
+    Sets the values to \a values.
+*/
+void QOpcUaHistoryData::setValues(const QVector<QOpcUaReadResult> &values)
+{
+    data->values = values;
+}
+
+/*!
+    Returns \c true if this is the last page of the node.
+*/
+bool QOpcUaHistoryData::isLastPage() const
+{
+    return data->lastPage;
+}
+
+/*!
+    Sets the last page flag to \a lastPage.
+*/
+void QOpcUaHistoryData::setLastPage(bool lastPage)
+{
+    data->lastPage = lastPage;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,314 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuahistoryreadrequest.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaHistoryReadRequest
+    \inmodule QtOpcUa
+    \brief Contains parameters for a call to the OPC UA HistoryRead service.
+    \since QtOpcUa 5.15
+
+    The request describes which historical values of a set of nodes are read. Depending on the
+    \l readType(), only a subset of the parameters is used:
+
+    \table
+        \header
+            \li Read type
+            \li Parameters
+        \row
+            \li Raw, Modified
+            \li \l startTime(), \l endTime(), \l numValuesPerNode(), \l returnBounds()
+        \row
+            \li Processed
+            \li \l startTime(), \l endTime(), \l processingInterval(), \l aggregateType()
+        \row
+            \li AtTime
+            \li \l requestedTimes(), \l useSimpleBounds()
+    \endtable
+
+    The server returns the values in pages and hands out a continuation point for each node which has
+    more values. The continuation points are followed automatically until all values have been read.
+    \l numValuesPerNode() limits the size of a page and thus the memory which is needed at once.
+
+    \sa QOpcUaClient::readHistoryData() QOpcUaHistoryReadResponse
+*/
+
+/*!
+    \enum QOpcUaHistoryReadRequest::ReadType
+
+    This enum specifies which kind of historical values are read.
+
+    \value Raw Read the values which have been stored for the time range.
+    \value Modified Read the values which have been replaced or deleted in the time range.
+    \value Processed Read values which have been computed by the server from the raw values using an aggregate.
+    \value AtTime Read the values at the requested times, interpolating if necessary.
+*/
+
+class QOpcUaHistoryReadRequestData : public QSharedData
+{
+public:
+    QOpcUaHistoryReadRequest::ReadType readType {QOpcUaHistoryReadRequest::ReadType::Raw};
+    QStringList nodeIds;
+    QDateTime startTime;
+    QDateTime endTime;
+    quint32 numValuesPerNode {0};
+    bool returnBounds {false};
+    double processingInterval {0};
+    QString aggregateType;
+    QVector<QDateTime> requestedTimes;
+    bool useSimpleBounds {true};
+    int maxPagesInFlight {4};
+};
+
+QOpcUaHistoryReadRequest::QOpcUaHistoryReadRequest()
+    : data(new QOpcUaHistoryReadRequestData)
+{
+}
+
+/*!
+    Creates a history read request from \a other.
+*/
+QOpcUaHistoryReadRequest::QOpcUaHistoryReadRequest(const QOpcUaHistoryReadRequest &other)
+    : data(other.data)
+{
+}
+
+/*!
+    Sets the values from \a rhs in this history read request.
+*/
+QOpcUaHistoryReadRequest &QOpcUaHistoryReadRequest::operator=(const QOpcUaHistoryReadRequest &rhs)
+{
+    if (this != &rhs)
+        data.operator=(rhs.data);
+    return *this;
+}
+
+QOpcUaHistoryReadRequest::~QOpcUaHistoryReadRequest()
+{
+}
+
+/*!
+    Returns the read type.
+
+    The default is \l {QOpcUaHistoryReadRequest::ReadType} {Raw}.
+*/
+QOpcUaHistoryReadRequest::ReadType QOpcUaHistoryReadRequest::readType() const
+{
+    return data->readType;
+}
+
+/*!
+    Sets the read type to \a readType.
+*/
+void QOpcUaHistoryReadRequest::setReadType(QOpcUaHistoryReadRequest::ReadType readType)
+{
+    data->readType = readType;
+}
+
+/*!
+    Returns the ids of the nodes to read.
+*/
+QStringList QOpcUaHistoryReadRequest::nodeIds() const
+{
+    return data->nodeIds;
+}
+
+/*!
+    Sets the ids of the nodes to read to \a nodeIds.
+*/
+void QOpcUaHistoryReadRequest::setNodeIds(const QStringList &nodeIds)
+{
+    data->nodeIds = nodeIds;
+}
+
+/*!
+    Returns the beginning of the time range.
+*/
+QDateTime QOpcUaHistoryReadRequest::startTime() const
+{
+    return data->startTime;
+}
+
+/*!
+    Sets the beginning of the time range to \a startTime.
+
+    If the start time is later than the end time, the values are returned in reverse order.
+*/
+void QOpcUaHistoryReadRequest::setStartTime(const QDateTime &startTime)
+{
+    data->startTime = startTime;
+}
+
+/*!
+    Returns the end of the time range.
+*/
+QDateTime QOpcUaHistoryReadRequest::endTime() const
+{
+    return data->endTime;
+}
+
+/*!
+    Sets the end of the time range to \a endTime.
+*/
+void QOpcUaHistoryReadRequest::setEndTime(const QDateTime &endTime)
+{
+    data->endTime = endTime;
+}
+
+/*!
+    Returns the maximum number of values per node in one page.
+*/
+quint32 QOpcUaHistoryReadRequest::numValuesPerNode() const
+{
+    return data->numValuesPerNode;
+}
+
+/*!
+    Sets the maximum number of values per node in one page to \a numValuesPerNode.
+
+    The default value \c 0 leaves the page size to the server, which may return all values of a node in one page.
+    Long time ranges should be read with a page size which fits into memory.
+*/
+void QOpcUaHistoryReadRequest::setNumValuesPerNode(quint32 numValuesPerNode)
+{
+    data->numValuesPerNode = numValuesPerNode;
+}
+
+/*!
+    Returns \c true if the bounding values of the time range are returned.
+*/
+bool QOpcUaHistoryReadRequest::returnBounds() const
+{
+    return data->returnBounds;
+}
+
+/*!
+    Sets the return of the bounding values to \a returnBounds.
+*/
+void QOpcUaHistoryReadRequest::setReturnBounds(bool returnBounds)
+{
+    data->returnBounds = returnBounds;
+}
+
+/*!
+    Returns the processing interval in milliseconds.
+*/
+double QOpcUaHistoryReadRequest::processingInterval() const
+{
+    return data->processingInterval;
+}
+
+/*!
+    Sets the interval in milliseconds for which the server computes one aggregated value to \a processingInterval.
+*/
+void QOpcUaHistoryReadRequest::setProcessingInterval(double processingInterval)
+{
+    data->processingInterval = processingInterval;
+}
+
+/*!
+    Returns the node id of the aggregate function.
+*/
+QString QOpcUaHistoryReadRequest::aggregateType() const
+{
+    return data->aggregateType;
+}
+
+/*!
+    Sets the node id of the aggregate function which is used for all nodes of a processed read to \a aggregateType.
+*/
+void QOpcUaHistoryReadRequest::setAggregateType(const QString &aggregateType)
+{
+    data->aggregateType = aggregateType;
+}
+
+/*!
+    Returns the timestamps of an at time read.
+*/
+QVector<QDateTime> QOpcUaHistoryReadRequest::requestedTimes() const
+{
+    return data->requestedTimes;
+}
+
+/*!
+    Sets the timestamps of an at time read to \a requestedTimes.
+*/
+void QOpcUaHistoryReadRequest::setRequestedTimes(const QVector<QDateTime> &requestedTimes)
+{
+    data->requestedTimes = requestedTimes;
+}
+
+/*!
+    Returns \c true if the server uses simple bounds for interpolating the values of an at time read.
+*/
+bool QOpcUaHistoryReadRequest::useSimpleBounds() const
+{
+    return data->useSimpleBounds;
+}
+
+/*!
+    Sets the use of simple bounds to \a useSimpleBounds. The default is \c true.
+*/
+void QOpcUaHistoryReadRequest::setUseSimpleBounds(bool useSimpleBounds)
+{
+    data->useSimpleBounds = useSimpleBounds;
+}
+
+/*!
+    Returns the maximum number of pages which are requested or delivered but not yet processed.
+*/
+int QOpcUaHistoryReadRequest::maxPagesInFlight() const
+{
+    return data->maxPagesInFlight;
+}
+
+/*!
+    Sets the maximum number of pages which are requested from the server or delivered to the receiver
+    but not yet processed to \a maxPagesInFlight. The default value is \c 4.
+
+    A page is one HistoryRead service call for a group of nodes. Further pages are only requested after
+    the receiver has processed the pages delivered before, which limits the memory used by a long read.
+*/
+void QOpcUaHistoryReadRequest::setMaxPagesInFlight(int maxPagesInFlight)
+{
+    data->maxPagesInFlight = qMax(1, maxPagesInFlight);
+}
+
+QT_END_NAMESPACE
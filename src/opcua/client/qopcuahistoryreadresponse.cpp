@@ -0,0 +1,183 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuahistoryreadresponse_p.h"
+#include <private/qopcuaclientimpl_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaHistoryReadResponse
+    \inmodule QtOpcUa
+    \brief Delivers the results of a history read while it is running.
+    \since QtOpcUa 5.15
+
+    A history read response is created by \l QOpcUaClient::readHistoryData(). The historical values are
+    streamed to the receiver page by page in the \l dataReceived() signal. Further pages are only requested
+    from the server after the receivers of the pages delivered before have returned, so a long time range
+    can be processed without holding all values in memory.
+
+    The response is owned by the caller. Destroying a response which has not finished aborts the history read.
+
+    \sa QOpcUaHistoryReadRequest QOpcUaHistoryData
+*/
+
+/*!
+    \fn void QOpcUaHistoryReadResponse::dataReceived(QVector<QOpcUaHistoryData> data)
+
+    This signal is emitted for each page received from the server. \a data contains one entry for each node
+    of the page. The values of a node are delivered in the order they have been returned by the server.
+
+    The next pages are requested after all receivers of this signal have returned. Connections to this signal
+    should be direct connections, a queued connection removes the limit on the number of pages in memory.
+*/
+
+/*!
+    \fn void QOpcUaHistoryReadResponse::finished(QOpcUa::UaStatusCode statusCode)
+
+    This signal is emitted after all pages of all nodes have been delivered or the history read has been aborted.
+    \a statusCode is \l {QOpcUa::UaStatusCode} {Good} if the service calls succeeded. The results of the
+    individual nodes are contained in \l QOpcUaHistoryData::statusCode().
+*/
+
+QOpcUaHistoryReadResponsePrivate::QOpcUaHistoryReadResponsePrivate(QOpcUaClientImpl *impl, quint64 handle,
+                                                                   const QOpcUaHistoryReadRequest &request)
+    : m_impl(impl)
+    , m_handle(handle)
+    , m_request(request)
+    , m_finished(false)
+    , m_statusCode(QOpcUa::UaStatusCode::Good)
+    , m_receivedValueCount(0)
+{
+}
+
+void QOpcUaHistoryReadResponsePrivate::handleDataReceived(const QVector<QOpcUaHistoryData> &data)
+{
+    Q_Q(QOpcUaHistoryReadResponse);
+
+    if (m_finished)
+        return;
+
+    for (const auto &entry : data)
+        m_receivedValueCount += entry.values().size();
+
+    emit q->dataReceived(data);
+}
+
+void QOpcUaHistoryReadResponsePrivate::handleFinished(QOpcUa::UaStatusCode statusCode)
+{
+    Q_Q(QOpcUaHistoryReadResponse);
+
+    if (m_finished)
+        return;
+
+    m_finished = true;
+    m_statusCode = statusCode;
+    emit q->finished(statusCode);
+}
+
+QOpcUaHistoryReadResponse::QOpcUaHistoryReadResponse(QOpcUaClientImpl *impl, quint64 handle, const QOpcUaHistoryReadRequest &request)
+    : QObject(*(new QOpcUaHistoryReadResponsePrivate(impl, handle, request)), nullptr)
+{
+}
+
+/*!
+    Destroys the response. A running history read is aborted.
+*/
+QOpcUaHistoryReadResponse::~QOpcUaHistoryReadResponse()
+{
+    Q_D(QOpcUaHistoryReadResponse);
+    if (!d->m_finished && d->m_impl)
+        d->m_impl->abortHistoryRead(d->m_handle);
+}
+
+/*!
+    Returns the request of this history read.
+*/
+QOpcUaHistoryReadRequest QOpcUaHistoryReadResponse::request() const
+{
+    Q_D(const QOpcUaHistoryReadResponse);
+    return d->m_request;
+}
+
+/*!
+    Returns \c true if \l finished() has been emitted.
+*/
+bool QOpcUaHistoryReadResponse::isFinished() const
+{
+    Q_D(const QOpcUaHistoryReadResponse);
+    return d->m_finished;
+}
+
+/*!
+    Returns the status code of the finished history read.
+*/
+QOpcUa::UaStatusCode QOpcUaHistoryReadResponse::statusCode() const
+{
+    Q_D(const QOpcUaHistoryReadResponse);
+    return d->m_statusCode;
+}
+
+/*!
+    Returns the number of values which have been delivered so far.
+*/
+quint64 QOpcUaHistoryReadResponse::receivedValueCount() const
+{
+    Q_D(const QOpcUaHistoryReadResponse);
+    return d->m_receivedValueCount;
+}
+
+/*!
+    Aborts the history read.
+
+    No more pages are delivered. The continuation points held by the server are released and
+    \l finished() is emitted with \l {QOpcUa::UaStatusCode} {BadRequestCancelledByClient}.
+*/
+void QOpcUaHistoryReadResponse::abort()
+{
+    Q_D(QOpcUaHistoryReadResponse);
+
+    if (d->m_finished)
+        return;
+
+    if (d->m_impl)
+        d->m_impl->abortHistoryRead(d->m_handle);
+
+    d->handleFinished(QOpcUa::UaStatusCode::BadRequestCancelledByClient);
+}
+
+QT_END_NAMESPACE
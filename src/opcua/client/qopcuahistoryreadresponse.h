@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPCUAHISTORYREADRESPONSE_H
+#define QOPCUAHISTORYREADRESPONSE_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuahistorydata.h>
+#include <QtOpcUa/qopcuahistoryreadrequest.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qobject.h>
+
+QT_BEGIN_NAMESPACE
+
+class QOpcUaClientImpl;
+class QOpcUaHistoryReadResponsePrivate;
+
+class Q_OPCUA_EXPORT QOpcUaHistoryReadResponse : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QOpcUaHistoryReadResponse)
+
+public:
+    ~QOpcUaHistoryReadResponse();
+
+    QOpcUaHistoryReadRequest request() const;
+
+    bool isFinished() const;
+    QOpcUa::UaStatusCode statusCode() const;
+    quint64 receivedValueCount() const;
+
+    void abort();
+
+Q_SIGNALS:
+    void dataReceived(QVector<QOpcUaHistoryData> data);
+    void finished(QOpcUa::UaStatusCode statusCode);
+
+private:
+    QOpcUaHistoryReadResponse(QOpcUaClientImpl *impl, quint64 handle, const QOpcUaHistoryReadRequest &request);
+
+    Q_DISABLE_COPY(QOpcUaHistoryReadResponse)
+    friend class QOpcUaClientImpl;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAHISTORYREADRESPONSE_H
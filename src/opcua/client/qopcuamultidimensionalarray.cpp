@@ -35,6 +35,10 @@
 ****************************************************************************/
 
 #include "qopcuamultidimensionalarray.h"
+#include <private/qopcuamultidimensionalarray_p.h>
+
+#include <cstdlib>
+#include <cstring>
 
 QT_BEGIN_NAMESPACE
 
@@ -62,15 +66,97 @@ QT_BEGIN_NAMESPACE
     This class manages arrays of Qt OPC UA types with associated array dimensions information.
     It is returned as value when a multidimensional array is received from the server. It can also
     be used as a write value or as parameter for filters and method calls.
+
+    Arrays of numeric and boolean values can use a typed storage instead of a \l QVariantList.
+    The elements are stored contiguously in row-major order and can be accessed using
+    \l constTypedData() and \l arrayIndex() without creating a \l QVariant for each element.
+    The open62541 backend returns multidimensional arrays of these types with typed storage.
+    \l valueArray() creates the \l QVariantList from the typed storage on demand.
 */
 
-class QOpcUaMultiDimensionalArrayData : public QSharedData
+QOpcUaMultiDimensionalArrayData::QOpcUaMultiDimensionalArrayData(const QOpcUaMultiDimensionalArrayData &other)
+    : QSharedData(other)
+    , value(other.value)
+    , arrayDimensions(other.arrayDimensions)
+    , expectedArrayLength(other.expectedArrayLength)
+    , elementType(other.elementType)
+    , typedElementCount(other.typedElementCount)
+{
+    if (other.typedBuffer && typedElementCount) {
+        const size_t size = static_cast<size_t>(typedElementCount) * elementSize();
+        typedBuffer = std::malloc(size);
+        if (typedBuffer) {
+            std::memcpy(typedBuffer, other.typedBuffer, size);
+            freeFunction = &std::free;
+        } else {
+            typedElementCount = 0;
+        }
+    }
+}
+
+QOpcUaMultiDimensionalArrayData::~QOpcUaMultiDimensionalArrayData()
+{
+    clearTypedBuffer();
+}
+
+void QOpcUaMultiDimensionalArrayData::setTypedBuffer(QMetaType::Type type, void *buffer, quint32 count,
+                                                     FreeFunction function)
+{
+    clearTypedBuffer();
+    value.clear();
+    elementType = type;
+    typedBuffer = buffer;
+    typedElementCount = buffer ? count : 0;
+    freeFunction = function;
+}
+
+void QOpcUaMultiDimensionalArrayData::clearTypedBuffer()
+{
+    if (typedBuffer && freeFunction)
+        freeFunction(typedBuffer);
+    elementType = QMetaType::UnknownType;
+    typedBuffer = nullptr;
+    typedElementCount = 0;
+    freeFunction = nullptr;
+}
+
+bool QOpcUaMultiDimensionalArrayPrivate::isTypedElementType(QMetaType::Type type)
+{
+    switch (type) {
+    case QMetaType::Bool:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QOpcUaMultiDimensionalArray QOpcUaMultiDimensionalArrayPrivate::fromTypedBuffer(QMetaType::Type elementType, void *buffer,
+                                                                                 quint32 elementCount,
+                                                                                 QOpcUaMultiDimensionalArrayData::FreeFunction freeFunction,
+                                                                                 const QVector<quint32> &arrayDimensions)
 {
-public:
-    QVariantList value;
-    QVector<quint32> arrayDimensions;
-    quint32 expectedArrayLength{0};
-};
+    QOpcUaMultiDimensionalArray result;
+    result.setArrayDimensions(arrayDimensions);
+
+    if (!isTypedElementType(elementType)) {
+        if (buffer && freeFunction)
+            freeFunction(buffer);
+        return result;
+    }
+
+    result.data->setTypedBuffer(elementType, buffer, elementCount, freeFunction);
+    return result;
+}
 
 QOpcUaMultiDimensionalArray::QOpcUaMultiDimensionalArray()
     : data(new QOpcUaMultiDimensionalArrayData)
@@ -119,6 +205,29 @@ QOpcUaMultiDimensionalArray::QOpcUaMultiDimensionalArray(const QVector<quint32>
     }
 }
 
+/*!
+    \since QtOpcUa 5.15
+
+    Creates a multidimensional array fitting \a arrayDimensions with typed storage for
+    elements of type \a elementType. All elements are initialized to zero.
+
+    Supported element types are \c bool, \c {signed char}, \c uchar, \c qint16, \c quint16,
+    \c qint32, \c quint32, \c qint64, \c quint64, \c float and \c double.
+    For other types, the array is created with a preallocated \l QVariantList.
+*/
+QOpcUaMultiDimensionalArray::QOpcUaMultiDimensionalArray(QMetaType::Type elementType, const QVector<quint32> &arrayDimensions)
+    : data(new QOpcUaMultiDimensionalArrayData)
+{
+    if (!QOpcUaMultiDimensionalArrayPrivate::isTypedElementType(elementType)) {
+        *this = QOpcUaMultiDimensionalArray(arrayDimensions);
+        return;
+    }
+
+    setArrayDimensions(arrayDimensions);
+    void *buffer = data->expectedArrayLength ? std::calloc(data->expectedArrayLength, QMetaType::sizeOf(elementType)) : nullptr;
+    data->setTypedBuffer(elementType, buffer, data->expectedArrayLength, &std::free);
+}
+
 QOpcUaMultiDimensionalArray::~QOpcUaMultiDimensionalArray()
 {
 }
@@ -147,8 +256,19 @@ void QOpcUaMultiDimensionalArray::setArrayDimensions(const QVector<quint32> &arr
 */
 bool QOpcUaMultiDimensionalArray::operator==(const QOpcUaMultiDimensionalArray &other) const
 {
-    return arrayDimensions() == other.arrayDimensions() &&
-            valueArray() == other.valueArray();
+    if (arrayDimensions() != other.arrayDimensions())
+        return false;
+
+    if (data->hasTypedStorage() && data->elementType == other.data->elementType) {
+        if (data->typedElementCount != other.data->typedElementCount)
+            return false;
+        if (data->elementType == QMetaType::Float || data->elementType == QMetaType::Double)
+            return valueArray() == other.valueArray(); // Floating point values must not be compared bitwise
+        return !data->typedElementCount
+                || std::memcmp(data->typedBuffer, other.data->typedBuffer, data->typedElementCount * data->elementSize()) == 0;
+    }
+
+    return valueArray() == other.valueArray();
 }
 
 /*!
@@ -161,28 +281,106 @@ QOpcUaMultiDimensionalArray::operator QVariant() const
 
 /*!
     Returns the value array of the multidimensional array.
+    For an array with typed storage, the list is created from the typed storage.
 */
 QVariantList QOpcUaMultiDimensionalArray::valueArray() const
 {
-    return data->value;
+    if (!data->hasTypedStorage())
+        return data->value;
+
+    QVariantList result;
+    result.reserve(static_cast<int>(data->typedElementCount));
+    for (quint32 i = 0; i < data->typedElementCount; ++i)
+        result.append(QVariant(data->elementType, data->element(i)));
+    return result;
 }
 
 /*!
     Returns a reference to the value array of the multidimensional array.
+    An array with typed storage is converted to a \l QVariantList first.
 */
 QVariantList &QOpcUaMultiDimensionalArray::valueArrayRef()
 {
+    if (data->hasTypedStorage()) {
+        const QVariantList values = valueArray();
+        data->clearTypedBuffer();
+        data->value = values;
+    }
     return data->value;
 }
 
 /*!
     Sets the value array of the multidimensional array to \a value.
+    The typed storage is released.
 */
 void QOpcUaMultiDimensionalArray::setValueArray(const QVariantList &value)
 {
+    data->clearTypedBuffer();
     data->value = value;
 }
 
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the strides of the dimensions of the multidimensional array.
+    The element at position n contains the distance in elements between two
+    consecutive indices of the n-th dimension in row-major order.
+*/
+QVector<quint32> QOpcUaMultiDimensionalArray::strides() const
+{
+    QVector<quint32> result(data->arrayDimensions.size());
+    quint32 stride = 1;
+    for (int i = data->arrayDimensions.size() - 1; i >= 0; --i) {
+        result[i] = stride;
+        stride *= data->arrayDimensions.at(i);
+    }
+    return result;
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns \c true if the elements are stored in a contiguous typed buffer instead of a \l QVariantList.
+*/
+bool QOpcUaMultiDimensionalArray::hasTypedStorage() const
+{
+    return data->hasTypedStorage();
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the type of the elements in the typed storage or \c QMetaType::UnknownType
+    if the array doesn't have typed storage.
+*/
+QMetaType::Type QOpcUaMultiDimensionalArray::elementType() const
+{
+    return data->elementType;
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns a pointer to the first element of the typed storage or \c nullptr if the
+    array doesn't have typed storage. The element for a set of indices is located at
+    the position returned by \l arrayIndex().
+*/
+const void *QOpcUaMultiDimensionalArray::constTypedData() const
+{
+    return data->typedBuffer;
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns a pointer to the first element of the typed storage which can be used to modify
+    the elements in place or \c nullptr if the array doesn't have typed storage.
+*/
+void *QOpcUaMultiDimensionalArray::typedData()
+{
+    return data->typedBuffer;
+}
+
 /*!
     Returns the array index in \l valueArray() of the element identified by \a indices.
     If \a indices is invalid for the array or if the array's dimensions don't match
@@ -192,12 +390,12 @@ int QOpcUaMultiDimensionalArray::arrayIndex(const QVector<quint32> &indices) con
 {
     // A QList can store INT_MAX values. Depending on the platform, this allows a size > UINT32_MAX
     if (data->expectedArrayLength > static_cast<quint64>((std::numeric_limits<int>::max)()) ||
-            static_cast<quint64>(data->value.size()) > (std::numeric_limits<quint32>::max)())
+            data->elementCount() > (std::numeric_limits<quint32>::max)())
         return -1;
 
     // Check number of dimensions and data size
     if (indices.size() != data->arrayDimensions.size() ||
-            data->expectedArrayLength != static_cast<quint32>(data->value.size()))
+            data->expectedArrayLength != data->elementCount())
         return -1; // Missing array dimensions or array dimensions don't fit the array
 
     quint32 index = 0;
@@ -229,6 +427,9 @@ QVariant QOpcUaMultiDimensionalArray::value(const QVector<quint32> &indices) con
     if (index < 0)
         return QVariant();
 
+    if (data->hasTypedStorage())
+        return QVariant(data->elementType, data->element(index));
+
     return data->value.at(index);
 }
 
@@ -243,6 +444,14 @@ bool QOpcUaMultiDimensionalArray::setValue(const QVector<quint32> &indices, cons
     if (index < 0)
         return false;
 
+    if (data->hasTypedStorage()) {
+        QVariant converted = value;
+        if (!converted.convert(data->elementType))
+            return false;
+        std::memcpy(data->element(index), converted.constData(), data->elementSize());
+        return true;
+    }
+
     data->value[index] = value;
     return true;
 }
@@ -252,8 +461,8 @@ bool QOpcUaMultiDimensionalArray::setValue(const QVector<quint32> &indices, cons
 */
 bool QOpcUaMultiDimensionalArray::isValid() const
 {
-    return static_cast<quint64>(data->value.size()) == data->expectedArrayLength &&
-            static_cast<quint64>(data->value.size()) <= (std::numeric_limits<quint32>::max)() &&
+    return data->elementCount() == data->expectedArrayLength &&
+            data->elementCount() <= (std::numeric_limits<quint32>::max)() &&
             static_cast<quint64>(data->arrayDimensions.size()) <= (std::numeric_limits<quint32>::max)();
 }
 
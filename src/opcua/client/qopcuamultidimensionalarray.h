@@ -45,6 +45,7 @@
 QT_BEGIN_NAMESPACE
 
 class QOpcUaMultiDimensionalArrayData;
+class QOpcUaMultiDimensionalArrayPrivate;
 class Q_OPCUA_EXPORT QOpcUaMultiDimensionalArray
 {
 public:
@@ -53,6 +54,7 @@ public:
     QOpcUaMultiDimensionalArray &operator=(const QOpcUaMultiDimensionalArray &rhs);
     QOpcUaMultiDimensionalArray(const QVariantList &valueArray, const QVector<quint32> &arrayDimensions);
     QOpcUaMultiDimensionalArray(const QVector<quint32> &arrayDimensions);
+    QOpcUaMultiDimensionalArray(QMetaType::Type elementType, const QVector<quint32> &arrayDimensions);
     ~QOpcUaMultiDimensionalArray();
 
     QVariantList valueArray() const;
@@ -67,12 +69,19 @@ public:
 
     QVector<quint32> arrayDimensions() const;
     void setArrayDimensions(const QVector<quint32> &arrayDimensions);
+    QVector<quint32> strides() const;
+
+    bool hasTypedStorage() const;
+    QMetaType::Type elementType() const;
+    const void *constTypedData() const;
+    void *typedData();
 
     bool operator==(const QOpcUaMultiDimensionalArray &other) const;
 
     operator QVariant() const;
 
 private:
+    friend class QOpcUaMultiDimensionalArrayPrivate;
     QSharedDataPointer<QOpcUaMultiDimensionalArrayData> data;
 };
 
@@ -0,0 +1,97 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAMULTIDIMENSIONALARRAY_P_H
+#define QOPCUAMULTIDIMENSIONALARRAY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuamultidimensionalarray.h>
+
+QT_BEGIN_NAMESPACE
+
+class QOpcUaMultiDimensionalArrayData : public QSharedData
+{
+public:
+    typedef void (*FreeFunction)(void *);
+
+    QOpcUaMultiDimensionalArrayData() = default;
+    QOpcUaMultiDimensionalArrayData(const QOpcUaMultiDimensionalArrayData &other);
+    ~QOpcUaMultiDimensionalArrayData();
+
+    bool hasTypedStorage() const { return elementType != QMetaType::UnknownType; }
+    quint64 elementCount() const { return hasTypedStorage() ? typedElementCount : static_cast<quint64>(value.size()); }
+    int elementSize() const { return QMetaType::sizeOf(elementType); }
+    char *element(quint64 index) const { return static_cast<char *>(typedBuffer) + index * elementSize(); }
+
+    void setTypedBuffer(QMetaType::Type type, void *buffer, quint32 count, FreeFunction function);
+    void clearTypedBuffer();
+
+    QVariantList value;
+    QVector<quint32> arrayDimensions;
+    quint32 expectedArrayLength{0};
+
+    // Contiguous row-major storage which is used instead of value for numeric element types
+    QMetaType::Type elementType{QMetaType::UnknownType};
+    void *typedBuffer{nullptr};
+    quint32 typedElementCount{0};
+    FreeFunction freeFunction{nullptr};
+};
+
+class Q_OPCUA_EXPORT QOpcUaMultiDimensionalArrayPrivate
+{
+public:
+    static bool isTypedElementType(QMetaType::Type type);
+
+    // Creates an array which takes ownership of buffer. buffer contains elementCount
+    // elements of elementType in row-major order and is released using freeFunction.
+    static QOpcUaMultiDimensionalArray fromTypedBuffer(QMetaType::Type elementType, void *buffer, quint32 elementCount,
+                                                       QOpcUaMultiDimensionalArrayData::FreeFunction freeFunction,
+                                                       const QVector<quint32> &arrayDimensions);
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAMULTIDIMENSIONALARRAY_P_H
@@ -36,12 +36,18 @@
 
 #include "qopcuaclient.h"
 #include "qopcuanode.h"
+#include <private/qopcuaaddressspacecache_p.h>
+#include <private/qopcuaattributecache_p.h>
+#include <private/qopcuabackend_p.h>
 #include <private/qopcuaclient_p.h>
 #include <private/qopcuaclientimpl_p.h>
 #include <private/qopcuanode_p.h>
 #include <private/qopcuanodeimpl_p.h>
 
 #include "qopcuarelativepathelement.h"
+#include "qopcuavaluehistory.h"
+
+#include <QtCore/qtimer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -186,6 +192,38 @@ QT_BEGIN_NAMESPACE
     \sa attribute() attributeError() serverTimestamp() sourceTimestamp()
 */
 
+/*!
+    \fn void QOpcUaNode::dataChangeAggregated(QOpcUa::NodeAttribute attr, QVariant minimum, QVariant maximum, QVariant last)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after \l dataChangeOccurred() if \l DeliveryAggregation::MinMaxLast has been
+    set for the attribute \a attr using \l setDeliveryThrottling().
+    \a minimum and \a maximum contain the smallest and the largest value of all data change notifications
+    received since the previous signal, \a last contains the most recent value.
+    For values which are not numeric scalars, \a minimum and \a maximum are invalid.
+
+    \sa setDeliveryThrottling()
+*/
+
+/*!
+    \fn void QOpcUaNode::dataChangesOccurred(QOpcUa::NodeAttribute attr, QVector<QOpcUaReadResult> values)
+    \since QtOpcUa 5.15
+
+    This signal is emitted after data change notifications for the attribute \a attr have been received.
+    \a values contains all values which have been received for the monitored item in one publish response
+    in the order they were sent by the server, each with its source timestamp, server timestamp and status code.
+
+    If the queue size of the monitored item is greater than 1, the server can send several values for an item
+    in one publish response. In contrast to \l dataChangeOccurred(), which is emitted for each value and
+    only leaves the most recent value in the attribute cache, this signal provides all of them at once.
+    It is emitted after the \l dataChangeOccurred() signals for the values and is not affected by
+    \l setDeliveryThrottling().
+
+    Backends which deliver each notification separately emit this signal with a single value.
+
+    \sa QOpcUaMonitoringParameters::setQueueSize() QOpcUaClient::dataChangesOccurred()
+*/
+
 /*!
     \fn void QOpcUaNode::enableMonitoringFinished(QOpcUa::NodeAttribute attr, QOpcUa::UaStatusCode statusCode)
 
@@ -300,7 +338,7 @@ bool QOpcUaNode::readAttributeRange(QOpcUa::NodeAttribute attribute, const QStri
     if (d->m_client.isNull() || d->m_client->state() != QOpcUaClient::Connected)
         return false;
 
-    return d->m_impl->readAttributes(QOpcUa::NodeAttributes() | attribute, indexRange);
+    return d->m_impl->readAttributes(QOpcUa::NodeAttributes() | attribute, indexRange, 0);
 }
 
 /*!
@@ -323,12 +361,60 @@ bool QOpcUaNode::readValueAttribute()
     Attribute values only contain valid information after the \l attributeRead signal has been emitted.
 */
 bool QOpcUaNode::readAttributes(QOpcUa::NodeAttributes attributes)
+{
+    return readAttributes(attributes, 0);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts an asynchronous read operation for the node attributes in \a attributes.
+
+    \a maxAge is the maximum age in milliseconds of a value the server may return instead of
+    reading the current value from the data source, see OPC-UA part 4, 5.10.2.
+    A value of \c 0 requests the current value.
+
+    If the attribute cache of the client is enabled and it holds values for all attributes which are
+    not older than \a maxAge, the read is answered from the cache without contacting the server.
+    Values of attributes with an active monitoring are considered fresh as long as the revised
+    sampling and publishing intervals do not exceed \a maxAge.
+
+    Returns \c true if the asynchronous call has been successfully dispatched.
+
+    Attribute values only contain valid information after the \l attributeRead signal has been emitted.
+
+    \sa QOpcUaClient::setAttributeCacheSize()
+*/
+bool QOpcUaNode::readAttributes(QOpcUa::NodeAttributes attributes, double maxAge)
 {
     Q_D(QOpcUaNode);
     if (d->m_client.isNull() || d->m_client->state() != QOpcUaClient::Connected)
         return false;
 
-    return d->m_impl->readAttributes(attributes, QString());
+    if (QOpcUaAddressSpaceCache *cache = d->addressSpaceCache()) {
+        QVector<QOpcUaReadResult> results;
+        if (cache->attributes(d->m_impl->nodeId(), attributes, &results)) {
+            // The signals are emitted asynchronously as if the attributes had been read from the server
+            QMetaObject::invokeMethod(this, [d, results]() {
+                d->handleAttributesRead(results, QOpcUa::UaStatusCode::Good, false);
+            }, Qt::QueuedConnection);
+            return true;
+        }
+    }
+
+    if (maxAge > 0) {
+        if (QOpcUaAttributeCache *cache = d->attributeCache()) {
+            QVector<QOpcUaReadResult> results;
+            if (cache->attributes(d->m_impl->nodeId(), attributes, maxAge, &results)) {
+                QMetaObject::invokeMethod(this, [d, results]() {
+                    d->handleAttributesRead(results, QOpcUa::UaStatusCode::Good, false);
+                }, Qt::QueuedConnection);
+                return true;
+            }
+        }
+    }
+
+    return d->m_impl->readAttributes(attributes, QString(), maxAge);
 }
 
 /*!
@@ -340,8 +426,8 @@ bool QOpcUaNode::readAttributes(QOpcUa::NodeAttributes attributes)
 QVariant QOpcUaNode::attribute(QOpcUa::NodeAttribute attribute) const
 {
     Q_D(const QOpcUaNode);
-    auto it = d->m_nodeAttributes.constFind(attribute);
-    if (it == d->m_nodeAttributes.constEnd())
+    const QOpcUaReadResult *it = d->m_nodeAttributes.find(attribute);
+    if (!it)
         return QVariant();
 
     return it->value();
@@ -376,8 +462,8 @@ QVariant QOpcUaNode::valueAttribute() const
 QOpcUa::UaStatusCode QOpcUaNode::attributeError(QOpcUa::NodeAttribute attribute) const
 {
     Q_D(const QOpcUaNode);
-    auto it = d->m_nodeAttributes.constFind(attribute);
-    if (it == d->m_nodeAttributes.constEnd())
+    const QOpcUaReadResult *it = d->m_nodeAttributes.find(attribute);
+    if (!it)
         return QOpcUa::UaStatusCode::BadNoEntryExists;
 
     return it->statusCode();
@@ -402,8 +488,8 @@ QOpcUa::UaStatusCode QOpcUaNode::valueAttributeError() const
 QDateTime QOpcUaNode::sourceTimestamp(QOpcUa::NodeAttribute attribute) const
 {
     Q_D(const QOpcUaNode);
-    auto it = d->m_nodeAttributes.constFind(attribute);
-    if (it == d->m_nodeAttributes.constEnd())
+    const QOpcUaReadResult *it = d->m_nodeAttributes.find(attribute);
+    if (!it)
         return QDateTime();
 
     return it->sourceTimestamp();
@@ -417,8 +503,8 @@ QDateTime QOpcUaNode::sourceTimestamp(QOpcUa::NodeAttribute attribute) const
 QDateTime QOpcUaNode::serverTimestamp(QOpcUa::NodeAttribute attribute) const
 {
     Q_D(const QOpcUaNode);
-    auto it = d->m_nodeAttributes.constFind(attribute);
-    if (it == d->m_nodeAttributes.constEnd())
+    const QOpcUaReadResult *it = d->m_nodeAttributes.find(attribute);
+    if (!it)
         return QDateTime();
 
     return it->serverTimestamp();
@@ -481,8 +567,8 @@ bool QOpcUaNode::modifyMonitoring(QOpcUa::NodeAttribute attr, QOpcUaMonitoringPa
 QOpcUaMonitoringParameters QOpcUaNode::monitoringStatus(QOpcUa::NodeAttribute attr)
 {
     Q_D(QOpcUaNode);
-    auto it = d->m_monitoringStatus.constFind(attr);
-    if (it == d->m_monitoringStatus.constEnd()) {
+    const QOpcUaMonitoringParameters *it = d->m_monitoringStatus.find(attr);
+    if (!it) {
         QOpcUaMonitoringParameters p;
         p.setStatusCode(QOpcUa::UaStatusCode::BadNoEntryExists);
         return p;
@@ -515,6 +601,134 @@ bool QOpcUaNode::modifyDataChangeFilter(QOpcUa::NodeAttribute attr, const QOpcUa
     return modifyMonitoring(attr, QOpcUaMonitoringParameters::Parameter::Filter, QVariant::fromValue(filter));
 }
 
+/*!
+    \enum QOpcUaNode::DeliveryAggregation
+    \since QtOpcUa 5.15
+
+    This enum specifies how data change notifications which are received faster than the
+    delivery interval set by \l setDeliveryThrottling() are combined.
+
+    \value LatestValue Only the most recent value is delivered.
+    \value MinMaxLast The most recent value is delivered and \l dataChangeAggregated() is emitted with
+           the minimum, the maximum and the most recent value received since the previous delivery.
+*/
+
+/*!
+    \since QtOpcUa 5.15
+
+    Limits the rate of \l dataChangeOccurred() and \l attributeUpdated() signals for data change notifications
+    of the attribute \a attr to one signal per \a minimumInterval milliseconds. A \a minimumInterval of 0
+    removes the limit.
+
+    The first notification after a quiet period is delivered immediately. Notifications received within
+    \a minimumInterval after a delivery are combined as specified by \a aggregation and delivered when
+    the interval has passed. The attribute cache of the node is always updated immediately.
+
+    The throttling is done by the client and doesn't change the monitored item or the subscription on the
+    server. This allows nodes which only need a few updates per second to share a subscription with
+    a short publishing interval. The setting is kept if monitoring is disabled and enabled again.
+
+    \sa deliveryInterval() deliveryAggregation() dataChangeAggregated()
+*/
+void QOpcUaNode::setDeliveryThrottling(QOpcUa::NodeAttribute attr, int minimumInterval, DeliveryAggregation aggregation)
+{
+    Q_D(QOpcUaNode);
+
+    if (minimumInterval <= 0) {
+        if (!d->m_extensions || !d->m_extensions->deliveryThrottles.contains(attr))
+            return;
+        d->deliverThrottledDataChange(attr);
+        const auto throttle = d->m_extensions->deliveryThrottles.take(attr);
+        delete throttle.timer;
+        return;
+    }
+
+    auto &throttle = d->extensions()->deliveryThrottles[attr];
+    throttle.interval = minimumInterval;
+    throttle.aggregation = aggregation;
+
+    if (!throttle.timer) {
+        throttle.timer = new QTimer(this);
+        throttle.timer->setSingleShot(true);
+        QObject::connect(throttle.timer, &QTimer::timeout, this, [d, attr]() {
+            d->deliverThrottledDataChange(attr);
+        });
+    }
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the minimum interval between data change signals for the attribute \a attr in milliseconds.
+    0 means that every data change notification is delivered.
+
+    \sa setDeliveryThrottling()
+*/
+int QOpcUaNode::deliveryInterval(QOpcUa::NodeAttribute attr) const
+{
+    Q_D(const QOpcUaNode);
+    return d->m_extensions ? d->m_extensions->deliveryThrottles.value(attr).interval : 0;
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns how data change notifications for the attribute \a attr are combined if they are received
+    faster than the delivery interval.
+
+    \sa setDeliveryThrottling()
+*/
+QOpcUaNode::DeliveryAggregation QOpcUaNode::deliveryAggregation(QOpcUa::NodeAttribute attr) const
+{
+    Q_D(const QOpcUaNode);
+    return d->m_extensions ? d->m_extensions->deliveryThrottles.value(attr).aggregation
+                           : DeliveryAggregation::LatestValue;
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Enables a client side history of up to \a capacity values for the monitored attribute \a attr.
+    Numeric values of all data change notifications for the attribute are appended to the history,
+    including values which are held back by \l setDeliveryThrottling().
+
+    Changing the capacity discards the previous history. A \a capacity of 0 removes the history.
+
+    \sa valueHistory()
+*/
+void QOpcUaNode::setValueHistoryCapacity(QOpcUa::NodeAttribute attr, int capacity)
+{
+    Q_D(QOpcUaNode);
+
+    if (capacity <= 0) {
+        if (d->m_extensions)
+            d->m_extensions->valueHistories.remove(attr);
+        return;
+    }
+
+    auto &histories = d->extensions()->valueHistories;
+    const auto it = histories.constFind(attr);
+    if (it != histories.constEnd() && (*it)->capacity() == capacity)
+        return;
+
+    histories.insert(attr, QSharedPointer<QOpcUaValueHistory>::create(capacity));
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Returns the value history of the attribute \a attr or \c nullptr if no history has been
+    enabled for the attribute. The returned pointer is valid until the capacity is changed
+    or the node is destroyed.
+
+    \sa setValueHistoryCapacity()
+*/
+const QOpcUaValueHistory *QOpcUaNode::valueHistory(QOpcUa::NodeAttribute attr) const
+{
+    Q_D(const QOpcUaNode);
+    return d->m_extensions ? d->m_extensions->valueHistories.value(attr).data() : nullptr;
+}
+
 /*!
     Writes \a value to the attribute given in \a attribute using the type information from \a type.
     Returns \c true if the asynchronous call has been successfully dispatched.
@@ -665,7 +879,7 @@ bool QOpcUaNode::browseChildren(QOpcUa::ReferenceTypeId referenceType, QOpcUa::N
     request.setNodeClassMask(nodeClassMask);
     request.setBrowseDirection(QOpcUaBrowseRequest::BrowseDirection::Forward);
     request.setIncludeSubtypes(true);
-    return d->m_impl->browse(request);
+    return browse(request);
 }
 
 /*!
@@ -781,7 +995,545 @@ bool QOpcUaNode::browse(const QOpcUaBrowseRequest &request)
   if (d->m_client.isNull() || d->m_client->state() != QOpcUaClient::Connected)
       return false;
 
-  return d->m_impl->browse(request);
+  if (QOpcUaAddressSpaceCache *cache = d->addressSpaceCache()) {
+      QVector<QOpcUaReferenceDescription> references;
+      if (cache->browseResult(d->m_impl->nodeId(), request, &references)) {
+          QMetaObject::invokeMethod(this, [this, references]() {
+              emit browseFinished(references, QOpcUa::UaStatusCode::Good);
+          }, Qt::QueuedConnection);
+          return true;
+      }
+  }
+
+  if (!d->m_impl->browse(request))
+      return false;
+
+  d->m_pendingBrowseRequests.push_back(request);
+  return true;
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts reading the raw historical values of this node between \a startTime and \a endTime.
+    \a numValuesPerNode limits the number of values in one page, \a returnBounds requests the bounding values
+    of the time range.
+
+    Returns the response which delivers the values, or \c nullptr if the request could not be dispatched.
+    The caller takes ownership of the response.
+
+    \sa QOpcUaClient::readHistoryData()
+*/
+QOpcUaHistoryReadResponse *QOpcUaNode::readHistoryRaw(const QDateTime &startTime, const QDateTime &endTime,
+                                                      quint32 numValuesPerNode, bool returnBounds)
+{
+    Q_D(QOpcUaNode);
+    if (d->m_client.isNull())
+        return nullptr;
+
+    QOpcUaHistoryReadRequest request;
+    request.setNodeIds({d->m_impl->nodeId()});
+    request.setStartTime(startTime);
+    request.setEndTime(endTime);
+    request.setNumValuesPerNode(numValuesPerNode);
+    request.setReturnBounds(returnBounds);
+    return d->m_client->readHistoryData(request);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Registers this node with the server to speed up repeated accesses.
+    Returns \c true if the asynchronous request has been successfully dispatched.
+
+    The result is delivered in the \l QOpcUaClient::registerNodesFinished() signal of the client.
+    The registration applies to all node objects and batch operations of the client which use the node id of this node.
+
+    \sa unregisterNode() QOpcUaClient::registerNodes()
+*/
+bool QOpcUaNode::registerNode()
+{
+    Q_D(QOpcUaNode);
+    if (d->m_client.isNull())
+        return false;
+
+    return d->m_client->registerNodes({d->m_impl->nodeId()});
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Unregisters this node. Returns \c true if the asynchronous request has been successfully dispatched.
+
+    The result is delivered in the \l QOpcUaClient::unregisterNodesFinished() signal of the client.
+
+    \sa registerNode() QOpcUaClient::unregisterNodes()
+*/
+bool QOpcUaNode::unregisterNode()
+{
+    Q_D(QOpcUaNode);
+    if (d->m_client.isNull())
+        return false;
+
+    return d->m_client->unregisterNodes({d->m_impl->nodeId()});
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts a read of \a attributes of this node and returns a future for the results.
+    \a maxAge is handled like in \l QOpcUaClient::readNodeAttributes().
+
+    The future contains one result for each attribute in \a attributes, in ascending order of the attributes.
+    Unlike \l readAttributes(), the results are not stored in the node and \l attributeRead() is not emitted.
+    The future is canceled without a result if the request could not be dispatched.
+
+    Futures are finished by the event loop of the thread of the client, see
+    \l QOpcUaClient::readNodeAttributesAsync() for details.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa readAttributes() QOpcUaClient::readNodeAttributesAsync()
+*/
+QFuture<QVector<QOpcUaReadResult>> QOpcUaNode::readAttributesAsync(QOpcUa::NodeAttributes attributes, double maxAge)
+{
+    Q_D(QOpcUaNode);
+    if (d->m_client.isNull())
+        return QOpcUaClientImpl::canceledFuture<QVector<QOpcUaReadResult>>();
+
+    QVector<QOpcUaReadItem> items;
+    qt_forEachAttribute(attributes, [&](QOpcUa::NodeAttribute attribute) {
+        items.push_back(QOpcUaReadItem(d->m_impl->nodeId(), attribute));
+    });
+
+    return d->m_client->readNodeAttributesAsync(items, maxAge);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts a write of the attributes in \a toWrite and returns a future for the results.
+    \a valueAttributeType is used as type of the Value attribute, the types of the other attributes are known.
+
+    The future contains one result for each attribute in \a toWrite, in the order of the map.
+    Unlike \l writeAttributes(), the node is not updated and \l attributeWritten() is not emitted.
+    The future is canceled without a result if the request could not be dispatched.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa writeAttributes() QOpcUaClient::writeNodeAttributesAsync()
+*/
+QFuture<QVector<QOpcUaWriteResult>> QOpcUaNode::writeAttributesAsync(const AttributeMap &toWrite, QOpcUa::Types valueAttributeType)
+{
+    Q_D(QOpcUaNode);
+    if (d->m_client.isNull())
+        return QOpcUaClientImpl::canceledFuture<QVector<QOpcUaWriteResult>>();
+
+    QVector<QOpcUaWriteItem> items;
+    items.reserve(toWrite.size());
+    for (auto it = toWrite.constBegin(); it != toWrite.constEnd(); ++it) {
+        const QOpcUa::Types type = it.key() == QOpcUa::NodeAttribute::Value ? valueAttributeType : QOpcUa::Types::Undefined;
+        items.push_back(QOpcUaWriteItem(d->m_impl->nodeId(), it.key(), it.value(), type));
+    }
+
+    return d->m_client->writeNodeAttributesAsync(items);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Starts a browse of the references of this node using the filter criteria in \a request
+    and returns a future for the references and the status code of the Browse service.
+
+    Unlike \l browse(), \l browseFinished() is not emitted.
+    The future is canceled without a result if the request could not be dispatched.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa browse()
+*/
+QFuture<QOpcUaOperationResult<QVector<QOpcUaReferenceDescription>>> QOpcUaNode::browseAsync(const QOpcUaBrowseRequest &request)
+{
+    using Result = QOpcUaOperationResult<QVector<QOpcUaReferenceDescription>>;
+
+    Q_D(QOpcUaNode);
+    QOpcUaClientImpl *impl = d->connectedClientImpl();
+    if (!impl)
+        return QOpcUaClientImpl::canceledFuture<Result>();
+
+    if (QOpcUaAddressSpaceCache *cache = d->addressSpaceCache()) {
+        QVector<QOpcUaReferenceDescription> references;
+        if (cache->browseResult(d->m_impl->nodeId(), request, &references))
+            return QOpcUaClientImpl::finishedFuture(Result(references, QOpcUa::UaStatusCode::Good));
+    }
+
+    return impl->browseFuture(d->m_impl->nodeId(), request);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Calls the method with the node id \a methodNodeId on this object node with the arguments \a args
+    and returns a future for the result and the status code of the call.
+
+    The value of the result is converted like in \l methodCallFinished().
+    Unlike \l callMethod(), \l methodCallFinished() is not emitted.
+    The future is canceled without a result if the request could not be dispatched.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa callMethod()
+*/
+QFuture<QOpcUaOperationResult<QVariant>> QOpcUaNode::callMethodAsync(const QString &methodNodeId, const QVector<QOpcUa::TypedVariant> &args)
+{
+    Q_D(QOpcUaNode);
+    QOpcUaClientImpl *impl = d->connectedClientImpl();
+    if (!impl)
+        return QOpcUaClientImpl::canceledFuture<QOpcUaOperationResult<QVariant>>();
+
+    return impl->callMethodFuture(d->m_impl->nodeId(), methodNodeId, args);
+}
+
+/*!
+    \since QtOpcUa 5.15
+
+    Resolves \a path starting at this node and returns a future for the targets and the status code
+    of the TranslateBrowsePathsToNodeIds service.
+
+    Unlike \l resolveBrowsePath(), \l resolveBrowsePathFinished() is not emitted.
+    The future is canceled without a result if the request could not be dispatched.
+
+    This function is currently only supported by the open62541 backend.
+
+    \sa resolveBrowsePath()
+*/
+QFuture<QOpcUaOperationResult<QVector<QOpcUaBrowsePathTarget>>> QOpcUaNode::resolveBrowsePathAsync(const QVector<QOpcUaRelativePathElement> &path)
+{
+    Q_D(QOpcUaNode);
+    QOpcUaClientImpl *impl = d->connectedClientImpl();
+    if (!impl)
+        return QOpcUaClientImpl::canceledFuture<QOpcUaOperationResult<QVector<QOpcUaBrowsePathTarget>>>();
+
+    return impl->resolveBrowsePathFuture(d->m_impl->nodeId(), path);
+}
+
+void QOpcUaNodePrivate::handleAttributesRead(const QVector<QOpcUaReadResult> &attr, QOpcUa::UaStatusCode serviceResult,
+                                             bool updateCache)
+{
+    Q_Q(QOpcUaNode);
+
+    if (updateCache && serviceResult == QOpcUa::UaStatusCode::Good) {
+        if (QOpcUaAddressSpaceCache *cache = addressSpaceCache())
+            cache->insertAttributes(m_impl->nodeId(), attr);
+        if (QOpcUaAttributeCache *cache = attributeCache()) {
+            for (const auto &entry : attr)
+                cache->insert(m_impl->nodeId(), entry);
+        }
+    }
+
+    QOpcUa::NodeAttributes updatedAttributes;
+
+    for (auto &entry : qAsConst(attr)) {
+        if (serviceResult == QOpcUa::UaStatusCode::Good)
+            m_nodeAttributes[entry.attribute()] = entry;
+        else {
+            QOpcUaReadResult temp = entry;
+            temp.setStatusCode(serviceResult);
+            temp.setValue(QVariant());
+            m_nodeAttributes[entry.attribute()] = temp;
+        }
+
+        updatedAttributes |= entry.attribute();
+        emit q->attributeUpdated(entry.attribute(), entry.value());
+    }
+
+    emit q->attributeRead(updatedAttributes);
+}
+
+void QOpcUaNodePrivate::handleAttributeWritten(QOpcUa::NodeAttribute attr, const QVariant &value, QOpcUa::UaStatusCode statusCode)
+{
+    Q_Q(QOpcUaNode);
+
+    m_nodeAttributes[attr].setStatusCode(statusCode);
+    invalidateCachedAttribute(attr);
+
+    if (statusCode == QOpcUa::UaStatusCode::Good) {
+        m_nodeAttributes[attr].setValue(value);
+        emit q->attributeUpdated(attr, value);
+    }
+
+    emit q->attributeWritten(attr, statusCode);
+}
+
+void QOpcUaNodePrivate::handleDataChanges(QOpcUa::NodeAttribute attr, const QVector<QOpcUaReadResult> &values)
+{
+    Q_Q(QOpcUaNode);
+
+    for (const auto &value : values)
+        handleDataChange(attr, value);
+    emit q->dataChangesOccurred(attr, values);
+}
+
+void QOpcUaNodePrivate::handleMonitoringEnableDisable(QOpcUa::NodeAttribute attr, bool subscribe,
+                                                      const QOpcUaMonitoringParameters &status)
+{
+    Q_Q(QOpcUaNode);
+
+    if (subscribe == true) {
+        if (status.statusCode() != QOpcUa::UaStatusCode::BadEntryExists) { // Don't overwrite a valid entry
+            m_monitoringStatus[attr] = status;
+            updateCachedMonitoring(attr);
+        }
+        emit q->enableMonitoringFinished(attr, status.statusCode());
+    }
+    else {
+        m_monitoringStatus.remove(attr);
+        updateCachedMonitoring(attr);
+        deliverThrottledDataChange(attr); // Don't hold back the last value
+        emit q->disableMonitoringFinished(attr, status.statusCode());
+    }
+}
+
+void QOpcUaNodePrivate::handleMonitoringStatusChanged(QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items,
+                                                      const QOpcUaMonitoringParameters &param)
+{
+    Q_Q(QOpcUaNode);
+
+    QOpcUaMonitoringParameters *it = m_monitoringStatus.find(attr);
+    if (param.statusCode() == QOpcUa::UaStatusCode::Good && it) {
+        if (items & QOpcUaMonitoringParameters::Parameter::PublishingEnabled)
+            it->setPublishingEnabled(param.isPublishingEnabled());
+        if (items & QOpcUaMonitoringParameters::Parameter::PublishingInterval)
+            it->setPublishingInterval(param.publishingInterval());
+        if (items & QOpcUaMonitoringParameters::Parameter::LifetimeCount)
+            it->setLifetimeCount(param.lifetimeCount());
+        if (items & QOpcUaMonitoringParameters::Parameter::MaxKeepAliveCount)
+            it->setMaxKeepAliveCount(param.maxKeepAliveCount());
+        if (items & QOpcUaMonitoringParameters::Parameter::MaxNotificationsPerPublish)
+            it->setMaxNotificationsPerPublish(param.maxNotificationsPerPublish());
+        if (items & QOpcUaMonitoringParameters::Parameter::Priority)
+            it->setPriority(param.priority());
+        if (items & QOpcUaMonitoringParameters::Parameter::SamplingInterval)
+            it->setSamplingInterval(param.samplingInterval());
+        if (items & QOpcUaMonitoringParameters::Parameter::Filter) {
+            if (param.filter().canConvert<QOpcUaMonitoringParameters::DataChangeFilter>())
+                it->setFilter(param.filter().value<QOpcUaMonitoringParameters::DataChangeFilter>());
+            else if (param.filter().canConvert<QOpcUaMonitoringParameters::EventFilter>())
+                it->setFilter(param.filter().value<QOpcUaMonitoringParameters::EventFilter>());
+            else if (param.filter().isNull())
+                it->clearFilter();
+            if (param.filterResult().canConvert<QOpcUaEventFilterResult>())
+                it->setFilterResult(param.filterResult().value<QOpcUaEventFilterResult>());
+            else if (param.filterResult().isNull())
+                it->clearFilterResult();
+        }
+        if (items & QOpcUaMonitoringParameters::Parameter::QueueSize)
+            it->setQueueSize(param.queueSize());
+        if (items & QOpcUaMonitoringParameters::Parameter::DiscardOldest)
+            it->setDiscardOldest(param.discardOldest());
+        if (items & QOpcUaMonitoringParameters::Parameter::MonitoringMode)
+            it->setMonitoringMode(param.monitoringMode());
+        updateCachedMonitoring(attr);
+    }
+
+    emit q->monitoringStatusChanged(attr, items, param.statusCode());
+}
+
+void QOpcUaNodePrivate::handleMethodCallFinished(const QString &methodNodeId, const QVariant &result, QOpcUa::UaStatusCode statusCode)
+{
+    Q_Q(QOpcUaNode);
+    emit q->methodCallFinished(methodNodeId, result, statusCode);
+}
+
+void QOpcUaNodePrivate::handleBrowseFinished(const QVector<QOpcUaReferenceDescription> &children, QOpcUa::UaStatusCode statusCode)
+{
+    Q_Q(QOpcUaNode);
+
+    // The result can only be assigned to its request if no other browse was in progress
+    if (m_pendingBrowseRequests.size() == 1 && statusCode == QOpcUa::UaStatusCode::Good) {
+        if (QOpcUaAddressSpaceCache *cache = addressSpaceCache())
+            cache->insertBrowseResult(m_impl->nodeId(), m_pendingBrowseRequests.constFirst(), children);
+    }
+    if (!m_pendingBrowseRequests.isEmpty())
+        m_pendingBrowseRequests.removeFirst();
+
+    emit q->browseFinished(children, statusCode);
+}
+
+void QOpcUaNodePrivate::handleResolveBrowsePathFinished(const QVector<QOpcUaBrowsePathTarget> &targets,
+                                                        const QVector<QOpcUaRelativePathElement> &path,
+                                                        QOpcUa::UaStatusCode statusCode)
+{
+    Q_Q(QOpcUaNode);
+    emit q->resolveBrowsePathFinished(targets, path, statusCode);
+}
+
+void QOpcUaNodePrivate::handleEvent(const QVariantList &eventFields)
+{
+    Q_Q(QOpcUaNode);
+    emit q->eventOccurred(eventFields);
+}
+
+QOpcUaAddressSpaceCache *QOpcUaNodePrivate::addressSpaceCache() const
+{
+    if (m_client.isNull())
+        return nullptr;
+
+    const auto client = static_cast<const QOpcUaClientPrivate *>(QObjectPrivate::get(m_client.data()));
+    return client->m_addressSpaceCache.data();
+}
+
+QOpcUaAttributeCache *QOpcUaNodePrivate::attributeCache() const
+{
+    if (m_client.isNull())
+        return nullptr;
+
+    const auto client = static_cast<const QOpcUaClientPrivate *>(QObjectPrivate::get(m_client.data()));
+    return client->m_attributeCache->isEnabled() ? client->m_attributeCache.data() : nullptr;
+}
+
+QOpcUaClientImpl *QOpcUaNodePrivate::connectedClientImpl() const
+{
+    if (m_client.isNull() || m_client->state() != QOpcUaClient::Connected)
+        return nullptr;
+
+    const auto client = static_cast<const QOpcUaClientPrivate *>(QObjectPrivate::get(m_client.data()));
+    return client->m_impl.data();
+}
+
+void QOpcUaNodePrivate::invalidateCachedAttribute(QOpcUa::NodeAttribute attr)
+{
+    if (QOpcUaAttributeCache *cache = attributeCache())
+        cache->remove(m_impl->nodeId(), attr);
+}
+
+void QOpcUaNodePrivate::updateCachedMonitoring(QOpcUa::NodeAttribute attr)
+{
+    // The monitoring interval is tracked even while the cache is disabled, it may be enabled later
+    if (m_client.isNull() || !m_impl || attr == QOpcUa::NodeAttribute::EventNotifier)
+        return;
+
+    const auto client = static_cast<const QOpcUaClientPrivate *>(QObjectPrivate::get(m_client.data()));
+    QOpcUaAttributeCache *cache = client->m_attributeCache.data();
+
+    // Only a reporting monitored item keeps the cached value current
+    const QOpcUaMonitoringParameters *status = m_monitoringStatus.find(attr);
+    if (!status || status->statusCode() != QOpcUa::UaStatusCode::Good
+            || !status->isPublishingEnabled()
+            || status->monitoringMode() != QOpcUaMonitoringParameters::MonitoringMode::Reporting) {
+        cache->clearMonitoringInterval(m_impl->nodeId(), attr);
+        return;
+    }
+
+    cache->setMonitoringInterval(m_impl->nodeId(), attr,
+                                 qMax(status->publishingInterval(), status->samplingInterval()));
+}
+
+static bool isNumericScalar(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void QOpcUaNodePrivate::handleDataChange(QOpcUa::NodeAttribute attr, const QOpcUaReadResult &value)
+{
+    Q_Q(QOpcUaNode);
+
+    m_nodeAttributes[attr] = value;
+
+    if (QOpcUaAttributeCache *cache = attributeCache())
+        cache->insert(m_impl->nodeId(), value);
+
+    if (!m_extensions) {
+        emit q->dataChangeOccurred(attr, value.value());
+        emit q->attributeUpdated(attr, value.value());
+        return;
+    }
+
+    auto history = m_extensions->valueHistories.constFind(attr);
+    if (history != m_extensions->valueHistories.constEnd())
+        (*history)->append(value);
+
+    auto throttle = m_extensions->deliveryThrottles.find(attr);
+    if (throttle == m_extensions->deliveryThrottles.end()) {
+        emit q->dataChangeOccurred(attr, value.value());
+        emit q->attributeUpdated(attr, value.value());
+        return;
+    }
+
+    throttle->pending = true;
+    throttle->last = value.value();
+
+    if (throttle->aggregation == QOpcUaNode::DeliveryAggregation::MinMaxLast && isNumericScalar(value.value())) {
+        const double current = value.value().toDouble();
+        if (!throttle->minimum.isValid() || current < throttle->minimum.toDouble())
+            throttle->minimum = value.value();
+        if (!throttle->maximum.isValid() || current > throttle->maximum.toDouble())
+            throttle->maximum = value.value();
+    }
+
+    // The value is delivered when the timer for the current interval expires
+    if (throttle->timer->isActive())
+        return;
+
+    const qint64 elapsed = throttle->lastDelivery.isValid() ? throttle->lastDelivery.elapsed() : throttle->interval;
+    if (elapsed >= throttle->interval)
+        deliverThrottledDataChange(attr);
+    else
+        throttle->timer->start(throttle->interval - elapsed);
+}
+
+QOpcUaNodePrivate::Extensions *QOpcUaNodePrivate::extensions()
+{
+    if (!m_extensions)
+        m_extensions.reset(new Extensions);
+    return m_extensions.data();
+}
+
+void QOpcUaNodePrivate::deliverThrottledDataChange(QOpcUa::NodeAttribute attr)
+{
+    if (!m_extensions)
+        return;
+
+    auto throttle = m_extensions->deliveryThrottles.find(attr);
+    if (throttle == m_extensions->deliveryThrottles.end())
+        return;
+
+    throttle->timer->stop();
+
+    if (!throttle->pending)
+        return;
+
+    throttle->pending = false;
+    throttle->lastDelivery.start();
+
+    // The slots connected to the signals may modify the throttling settings
+    const bool aggregated = throttle->aggregation == QOpcUaNode::DeliveryAggregation::MinMaxLast;
+    const QVariant last = qExchange(throttle->last, QVariant());
+    const QVariant minimum = qExchange(throttle->minimum, QVariant());
+    const QVariant maximum = qExchange(throttle->maximum, QVariant());
+
+    Q_Q(QOpcUaNode);
+    emit q->dataChangeOccurred(attr, last);
+    emit q->attributeUpdated(attr, last);
+    if (aggregated)
+        emit q->dataChangeAggregated(attr, minimum, maximum, last);
 }
 
 QDebug operator<<(QDebug dbg, const QOpcUaNode &node)
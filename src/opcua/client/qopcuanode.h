@@ -40,13 +40,17 @@
 #include <QtOpcUa/qopcuabrowserequest.h>
 #include <QtOpcUa/qopcuaglobal.h>
 #include <QtOpcUa/qopcuamonitoringparameters.h>
+#include <QtOpcUa/qopcuaoperationresult.h>
+#include <QtOpcUa/qopcuareadresult.h>
 #include <QtOpcUa/qopcuareferencedescription.h>
 #include <QtOpcUa/qopcuatype.h>
 #include <QtOpcUa/qopcuabrowsepathtarget.h>
 #include <QtOpcUa/qopcuarelativepathelement.h>
+#include <QtOpcUa/qopcuawriteresult.h>
 
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qfuture.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qobject.h>
 
@@ -55,6 +59,8 @@ QT_BEGIN_NAMESPACE
 class QOpcUaNodePrivate;
 class QOpcUaNodeImpl;
 class QOpcUaClient;
+class QOpcUaHistoryReadResponse;
+class QOpcUaValueHistory;
 
 class Q_OPCUA_EXPORT QOpcUaNode : public QObject
 {
@@ -63,6 +69,12 @@ class Q_OPCUA_EXPORT QOpcUaNode : public QObject
 public:
     Q_DECLARE_PRIVATE(QOpcUaNode)
 
+    enum class DeliveryAggregation {
+        LatestValue,
+        MinMaxLast
+    };
+    Q_ENUM(DeliveryAggregation)
+
     static Q_DECL_CONSTEXPR QOpcUa::NodeAttributes mandatoryBaseAttributes();
     static Q_DECL_CONSTEXPR QOpcUa::NodeAttributes allBaseAttributes();
     typedef QMap<QOpcUa::NodeAttribute, QVariant> AttributeMap;
@@ -71,6 +83,7 @@ public:
     virtual ~QOpcUaNode();
 
     bool readAttributes(QOpcUa::NodeAttributes attributes = mandatoryBaseAttributes());
+    bool readAttributes(QOpcUa::NodeAttributes attributes, double maxAge);
     bool readAttributeRange(QOpcUa::NodeAttribute attribute, const QString &indexRange);
     bool readValueAttribute();
     QVariant attribute(QOpcUa::NodeAttribute attribute) const;
@@ -92,6 +105,14 @@ public:
     bool modifyEventFilter(const QOpcUaMonitoringParameters::EventFilter &eventFilter);
     bool modifyDataChangeFilter(QOpcUa::NodeAttribute attr, const QOpcUaMonitoringParameters::DataChangeFilter &filter);
 
+    void setDeliveryThrottling(QOpcUa::NodeAttribute attr, int minimumInterval,
+                               DeliveryAggregation aggregation = DeliveryAggregation::LatestValue);
+    int deliveryInterval(QOpcUa::NodeAttribute attr) const;
+    DeliveryAggregation deliveryAggregation(QOpcUa::NodeAttribute attr) const;
+
+    void setValueHistoryCapacity(QOpcUa::NodeAttribute attr, int capacity);
+    const QOpcUaValueHistory *valueHistory(QOpcUa::NodeAttribute attr) const;
+
     bool browseChildren(QOpcUa::ReferenceTypeId referenceType = QOpcUa::ReferenceTypeId::HierarchicalReferences,
                         QOpcUa::NodeClasses nodeClassMask = QOpcUa::NodeClass::Undefined);
 
@@ -104,11 +125,28 @@ public:
 
     bool browse(const QOpcUaBrowseRequest &request);
 
+    QOpcUaHistoryReadResponse *readHistoryRaw(const QDateTime &startTime, const QDateTime &endTime,
+                                              quint32 numValuesPerNode = 0, bool returnBounds = false);
+
+    bool registerNode();
+    bool unregisterNode();
+
+    QFuture<QVector<QOpcUaReadResult>> readAttributesAsync(QOpcUa::NodeAttributes attributes = mandatoryBaseAttributes(),
+                                                           double maxAge = 0);
+    QFuture<QVector<QOpcUaWriteResult>> writeAttributesAsync(const AttributeMap &toWrite,
+                                                             QOpcUa::Types valueAttributeType = QOpcUa::Types::Undefined);
+    QFuture<QOpcUaOperationResult<QVector<QOpcUaReferenceDescription>>> browseAsync(const QOpcUaBrowseRequest &request);
+    QFuture<QOpcUaOperationResult<QVariant>> callMethodAsync(const QString &methodNodeId,
+                                                             const QVector<QOpcUa::TypedVariant> &args = QVector<QOpcUa::TypedVariant>());
+    QFuture<QOpcUaOperationResult<QVector<QOpcUaBrowsePathTarget>>> resolveBrowsePathAsync(const QVector<QOpcUaRelativePathElement> &path);
+
 Q_SIGNALS:
     void attributeRead(QOpcUa::NodeAttributes attributes);
     void attributeWritten(QOpcUa::NodeAttribute attribute, QOpcUa::UaStatusCode statusCode);
     void dataChangeOccurred(QOpcUa::NodeAttribute attr, QVariant value);
     void attributeUpdated(QOpcUa::NodeAttribute attr, QVariant value);
+    void dataChangeAggregated(QOpcUa::NodeAttribute attr, QVariant minimum, QVariant maximum, QVariant last);
+    void dataChangesOccurred(QOpcUa::NodeAttribute attr, QVector<QOpcUaReadResult> values);
     void eventOccurred(QVariantList eventFields);
 
     void monitoringStatusChanged(QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items,
@@ -51,15 +51,24 @@
 #include <QtOpcUa/qopcuaclient.h>
 #include <QtOpcUa/qopcuanode.h>
 #include <QtOpcUa/qopcuaeventfilterresult.h>
+#include <QtOpcUa/qopcuavaluehistory.h>
+#include <private/qopcuaattributestorage_p.h>
 #include <private/qopcuanodeimpl_p.h>
 
 #include <private/qobject_p.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qpointer.h>
 #include <QtCore/qscopedpointer.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qhash.h>
 
 QT_BEGIN_NAMESPACE
 
+class QOpcUaAddressSpaceCache;
+class QOpcUaAttributeCache;
+class QOpcUaClientImpl;
+class QTimer;
+
 class QOpcUaNodePrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QOpcUaNode)
@@ -69,180 +78,79 @@ public:
         : m_impl(impl)
         , m_client(client)
     {
-        m_attributesReadConnection = QObject::connect(impl, &QOpcUaNodeImpl::attributesRead,
-                [this](QVector<QOpcUaReadResult> attr, QOpcUa::UaStatusCode serviceResult)
-        {
-            QOpcUa::NodeAttributes updatedAttributes;
-            Q_Q(QOpcUaNode);
-
-            for (auto &entry : qAsConst(attr)) {
-                if (serviceResult == QOpcUa::UaStatusCode::Good)
-                    m_nodeAttributes[entry.attribute()] = entry;
-                else {
-                    QOpcUaReadResult temp = entry;
-                    temp.setStatusCode(serviceResult);
-                    temp.setValue(QVariant());
-                    m_nodeAttributes[entry.attribute()] = temp;
-                }
-
-                updatedAttributes |= entry.attribute();
-                emit q->attributeUpdated(entry.attribute(), entry.value());
-            }
-
-            emit q->attributeRead(updatedAttributes);
-        });
-
-        m_attributeWrittenConnection = QObject::connect(impl, &QOpcUaNodeImpl::attributeWritten,
-                [this](QOpcUa::NodeAttribute attr, QVariant value, QOpcUa::UaStatusCode statusCode)
-        {
-            m_nodeAttributes[attr].setStatusCode(statusCode);
-            Q_Q(QOpcUaNode);
-
-            if (statusCode == QOpcUa::UaStatusCode::Good) {
-                m_nodeAttributes[attr].setValue(value);
-                emit q->attributeUpdated(attr, value);
-            }
-
-            emit q->attributeWritten(attr, statusCode);
-        });
-
-        m_dataChangeOccurredConnection = QObject::connect(impl, &QOpcUaNodeImpl::dataChangeOccurred,
-                [this](QOpcUa::NodeAttribute attr, QOpcUaReadResult value)
-        {
-            this->m_nodeAttributes[attr] = value;
-            Q_Q(QOpcUaNode);
-            emit q->dataChangeOccurred(attr, value.value());
-            emit q->attributeUpdated(attr, value.value());
-        });
-
-        m_monitoringEnableDisableConnection = QObject::connect(impl, &QOpcUaNodeImpl::monitoringEnableDisable,
-                [this](QOpcUa::NodeAttribute attr, bool subscribe, QOpcUaMonitoringParameters status)
-        {
-            if (subscribe == true) {
-                if (status.statusCode() != QOpcUa::UaStatusCode::BadEntryExists) // Don't overwrite a valid entry
-                    m_monitoringStatus[attr] = status;
-                Q_Q(QOpcUaNode);
-                emit q->enableMonitoringFinished(attr, status.statusCode());
-            }
-            else {
-                m_monitoringStatus.remove(attr);
-                Q_Q(QOpcUaNode);
-                emit q->disableMonitoringFinished(attr, status.statusCode());
-            }
-        });
-
-        m_monitoringStatusChangedConnection = QObject::connect(impl, &QOpcUaNodeImpl::monitoringStatusChanged,
-                [this](QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items, QOpcUaMonitoringParameters param)
-        {
-            auto it = m_monitoringStatus.find(attr);
-            if (param.statusCode() == QOpcUa::UaStatusCode::Good && it != m_monitoringStatus.end()) {
-                if (items & QOpcUaMonitoringParameters::Parameter::PublishingEnabled)
-                    it->setPublishingEnabled(param.isPublishingEnabled());
-                if (items & QOpcUaMonitoringParameters::Parameter::PublishingInterval)
-                    it->setPublishingInterval(param.publishingInterval());
-                if (items & QOpcUaMonitoringParameters::Parameter::LifetimeCount)
-                    it->setLifetimeCount(param.lifetimeCount());
-                if (items & QOpcUaMonitoringParameters::Parameter::MaxKeepAliveCount)
-                    it->setMaxKeepAliveCount(param.maxKeepAliveCount());
-                if (items & QOpcUaMonitoringParameters::Parameter::MaxNotificationsPerPublish)
-                    it->setMaxNotificationsPerPublish(param.maxNotificationsPerPublish());
-                if (items & QOpcUaMonitoringParameters::Parameter::Priority)
-                    it->setPriority(param.priority());
-                if (items & QOpcUaMonitoringParameters::Parameter::SamplingInterval)
-                    it->setSamplingInterval(param.samplingInterval());
-                if (items & QOpcUaMonitoringParameters::Parameter::Filter) {
-                    if (param.filter().canConvert<QOpcUaMonitoringParameters::DataChangeFilter>())
-                        it->setFilter(param.filter().value<QOpcUaMonitoringParameters::DataChangeFilter>());
-                    else if (param.filter().canConvert<QOpcUaMonitoringParameters::EventFilter>())
-                        it->setFilter(param.filter().value<QOpcUaMonitoringParameters::EventFilter>());
-                    else if (param.filter().isNull())
-                        it->clearFilter();
-                    if (param.filterResult().canConvert<QOpcUaEventFilterResult>())
-                        it->setFilterResult(param.filterResult().value<QOpcUaEventFilterResult>());
-                    else if (param.filterResult().isNull())
-                        it->clearFilterResult();
-                }
-                if (items & QOpcUaMonitoringParameters::Parameter::QueueSize)
-                    it->setQueueSize(param.queueSize());
-                if (items & QOpcUaMonitoringParameters::Parameter::DiscardOldest)
-                    it->setDiscardOldest(param.discardOldest());
-                if (items & QOpcUaMonitoringParameters::Parameter::MonitoringMode)
-                    it->setMonitoringMode(param.monitoringMode());
-            }
-
-            Q_Q(QOpcUaNode);
-            emit q->monitoringStatusChanged(attr, items, param.statusCode());
-        });
-
-
-        m_methodCallFinishedConnection = QObject::connect(impl, &QOpcUaNodeImpl::methodCallFinished,
-            [this](QString methodNodeId, QVariant result, QOpcUa::UaStatusCode statusCode)
-        {
-            Q_Q(QOpcUaNode);
-            emit q->methodCallFinished(methodNodeId, result, statusCode);
-        });
-
-        m_browseFinishedConnection = QObject::connect(impl, &QOpcUaNodeImpl::browseFinished,
-                [this](QVector<QOpcUaReferenceDescription> children, QOpcUa::UaStatusCode statusCode)
-        {
-            Q_Q(QOpcUaNode);
-            emit q->browseFinished(children, statusCode);
-        });
-
-        m_resolveBrowsePathFinishedConnection = QObject::connect(impl, &QOpcUaNodeImpl::resolveBrowsePathFinished,
-                [this](QVector<QOpcUaBrowsePathTarget> targets, QVector<QOpcUaRelativePathElement> path,
-                                                                   QOpcUa::UaStatusCode statusCode)
-        {
-            Q_Q(QOpcUaNode);
-            emit q->resolveBrowsePathFinished(targets, path, statusCode);
-        });
-
-        m_eventOccurredConnection = QObject::connect(impl, &QOpcUaNodeImpl::eventOccurred,
-            [this](QVariantList eventFields)
-        {
-            Q_Q(QOpcUaNode);
-            emit q->eventOccurred(eventFields);
-        });
+        m_impl->setNode(this);
     }
 
     ~QOpcUaNodePrivate()
     {
-        QObject::disconnect(m_attributesReadConnection);
-        QObject::disconnect(m_attributeWrittenConnection);
-        QObject::disconnect(m_dataChangeOccurredConnection);
-        QObject::disconnect(m_monitoringEnableDisableConnection);
-        QObject::disconnect(m_monitoringStatusChangedConnection);
-        QObject::disconnect(m_methodCallFinishedConnection);
-        QObject::disconnect(m_browseFinishedConnection);
-        QObject::disconnect(m_resolveBrowsePathFinishedConnection);
-        QObject::disconnect(m_eventOccurredConnection);
+        if (m_impl)
+            m_impl->setNode(nullptr);
 
         // Disable remaining monitorings
         QOpcUa::NodeAttributes attr;
-        for (auto it = m_monitoringStatus.constBegin(); it != m_monitoringStatus.constEnd(); ++it) {
-            if (it->statusCode() == QOpcUa::UaStatusCode::Good)
-                attr |= it.key();
-        }
+        QVector<QOpcUa::NodeAttribute> monitoredAttributes;
+        m_monitoringStatus.forEach([&](QOpcUa::NodeAttribute attribute, const QOpcUaMonitoringParameters &status) {
+            if (status.statusCode() == QOpcUa::UaStatusCode::Good)
+                attr |= attribute;
+            monitoredAttributes.push_back(attribute);
+        });
+        m_monitoringStatus.clear();
+        for (const auto attribute : qAsConst(monitoredAttributes))
+            updateCachedMonitoring(attribute);
         if (attr != 0 && m_impl) {
             m_impl->disableMonitoring(attr);
         }
     }
 
+    // Called by QOpcUaClientImpl for results of the backend
+    void handleAttributesRead(const QVector<QOpcUaReadResult> &attr, QOpcUa::UaStatusCode serviceResult, bool updateCache);
+    void handleAttributeWritten(QOpcUa::NodeAttribute attr, const QVariant &value, QOpcUa::UaStatusCode statusCode);
+    void handleDataChanges(QOpcUa::NodeAttribute attr, const QVector<QOpcUaReadResult> &values);
+    void handleMonitoringEnableDisable(QOpcUa::NodeAttribute attr, bool subscribe, const QOpcUaMonitoringParameters &status);
+    void handleMonitoringStatusChanged(QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items,
+                                       const QOpcUaMonitoringParameters &param);
+    void handleMethodCallFinished(const QString &methodNodeId, const QVariant &result, QOpcUa::UaStatusCode statusCode);
+    void handleResolveBrowsePathFinished(const QVector<QOpcUaBrowsePathTarget> &targets,
+                                         const QVector<QOpcUaRelativePathElement> &path, QOpcUa::UaStatusCode statusCode);
+    void handleBrowseFinished(const QVector<QOpcUaReferenceDescription> &children, QOpcUa::UaStatusCode statusCode);
+    void handleEvent(const QVariantList &eventFields);
+
+    QOpcUaAddressSpaceCache *addressSpaceCache() const;
+    QOpcUaAttributeCache *attributeCache() const;
+    QOpcUaClientImpl *connectedClientImpl() const;
+    void invalidateCachedAttribute(QOpcUa::NodeAttribute attr);
+    void updateCachedMonitoring(QOpcUa::NodeAttribute attr);
+    void handleDataChange(QOpcUa::NodeAttribute attr, const QOpcUaReadResult &value);
+    void deliverThrottledDataChange(QOpcUa::NodeAttribute attr);
+
+    // Client side limit for the rate of data change signals of an attribute
+    struct DeliveryThrottle {
+        int interval = 0;
+        QOpcUaNode::DeliveryAggregation aggregation = QOpcUaNode::DeliveryAggregation::LatestValue;
+        QTimer *timer = nullptr;
+        QElapsedTimer lastDelivery;
+        bool pending = false;
+        QVariant last;
+        QVariant minimum;
+        QVariant maximum;
+    };
+
+    // State of the optional client side features. It is allocated when a feature is enabled
+    // for the first time, so a node which uses none of them pays for a single pointer.
+    struct Extensions {
+        QHash<QOpcUa::NodeAttribute, DeliveryThrottle> deliveryThrottles;
+        QHash<QOpcUa::NodeAttribute, QSharedPointer<QOpcUaValueHistory>> valueHistories;
+    };
+
+    Extensions *extensions();
+
     QScopedPointer<QOpcUaNodeImpl> m_impl;
     QPointer<QOpcUaClient> m_client;
 
-    QHash<QOpcUa::NodeAttribute, QOpcUaReadResult> m_nodeAttributes;
-    QHash<QOpcUa::NodeAttribute, QOpcUaMonitoringParameters> m_monitoringStatus;
-
-    QMetaObject::Connection m_attributesReadConnection;
-    QMetaObject::Connection m_attributeWrittenConnection;
-    QMetaObject::Connection m_dataChangeOccurredConnection;
-    QMetaObject::Connection m_monitoringEnableDisableConnection;
-    QMetaObject::Connection m_monitoringStatusChangedConnection;
-    QMetaObject::Connection m_methodCallFinishedConnection;
-    QMetaObject::Connection m_browseFinishedConnection;
-    QMetaObject::Connection m_resolveBrowsePathFinishedConnection;
-    QMetaObject::Connection m_eventOccurredConnection;
+    QOpcUaAttributeStorage<QOpcUaReadResult> m_nodeAttributes;
+    QOpcUaAttributeStorage<QOpcUaMonitoringParameters> m_monitoringStatus;
+    QVector<QOpcUaBrowseRequest> m_pendingBrowseRequests;
+    QScopedPointer<Extensions> m_extensions;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUANODEIDPARSER_P_H
+#define QOPCUANODEIDPARSER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qstringview.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+// Components of a node id string like "ns=1;s=MyString".
+// The identifier is not copied, it starts at identifierOffset of the parsed string.
+struct QOpcUaNodeIdComponents
+{
+    quint16 namespaceIndex = 0;
+    char identifierType = 0;
+    qsizetype identifierOffset = 0;
+};
+
+// Single pass replacement for splitting the string and matching the components with regular expressions.
+// The rules are the same as for QOpcUa::nodeIdStringSplit(): A first component which doesn't start
+// with "ns=" and a digit is ignored and namespace 0 is assumed.
+inline bool qt_opcuaParseNodeIdString(QStringView nodeId, QOpcUaNodeIdComponents *components)
+{
+    const qsizetype size = nodeId.size();
+    const QChar *data = nodeId.data();
+
+    qsizetype separator = -1;
+    for (qsizetype i = 0; i < size; ++i) {
+        if (data[i] == QLatin1Char(';')) {
+            if (separator >= 0)
+                return false; // More than two components
+            separator = i;
+        }
+    }
+
+    quint16 namespaceIndex = 0;
+
+    if (separator >= 4 && data[0] == QLatin1Char('n') && data[1] == QLatin1Char('s') && data[2] == QLatin1Char('=')
+            && data[3].unicode() >= '0' && data[3].unicode() <= '9') {
+        quint32 ns = 0;
+        qsizetype i = 3;
+        for (; i < separator && data[i].unicode() >= '0' && data[i].unicode() <= '9'; ++i) {
+            ns = ns * 10 + (data[i].unicode() - '0');
+            if (ns > (std::numeric_limits<quint16>::max)())
+                return false;
+        }
+        // Trailing whitespace is accepted like it is by QString::toUInt()
+        for (; i < separator; ++i) {
+            if (!data[i].isSpace())
+                return false;
+        }
+        namespaceIndex = static_cast<quint16>(ns);
+    }
+
+    const qsizetype identifierStart = separator + 1;
+    if (size - identifierStart < 3)
+        return false;
+
+    const ushort type = data[identifierStart].unicode();
+    if ((type != 'i' && type != 's' && type != 'g' && type != 'b') || data[identifierStart + 1] != QLatin1Char('='))
+        return false;
+
+    if (components) {
+        components->namespaceIndex = namespaceIndex;
+        components->identifierType = static_cast<char>(type);
+        components->identifierOffset = identifierStart + 2;
+    }
+
+    return true;
+}
+
+QT_END_NAMESPACE
+
+#endif // QOPCUANODEIDPARSER_P_H
@@ -39,7 +39,8 @@
 QT_BEGIN_NAMESPACE
 
 QOpcUaNodeImpl::QOpcUaNodeImpl()
-    : m_handle{0}
+    : m_node{nullptr}
+    , m_handle{0}
     , m_registered{false}
 {
 }
@@ -68,4 +69,14 @@ void QOpcUaNodeImpl::setRegistered(bool registered)
     m_registered = registered;
 }
 
+QOpcUaNodePrivate *QOpcUaNodeImpl::node() const
+{
+    return m_node;
+}
+
+void QOpcUaNodeImpl::setNode(QOpcUaNodePrivate *node)
+{
+    m_node = node;
+}
+
 QT_END_NAMESPACE
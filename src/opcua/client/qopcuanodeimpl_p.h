@@ -61,14 +61,17 @@
 
 QT_BEGIN_NAMESPACE
 
-class Q_OPCUA_EXPORT QOpcUaNodeImpl : public QObject
+class QOpcUaNodePrivate;
+
+// Backend part of a QOpcUaNode. This is not a QObject, results for the node are
+// passed from QOpcUaClientImpl directly to the QOpcUaNodePrivate set with setNode().
+class Q_OPCUA_EXPORT QOpcUaNodeImpl
 {
-    Q_OBJECT
 public:
     QOpcUaNodeImpl();
     virtual ~QOpcUaNodeImpl();
 
-    virtual bool readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange) = 0;
+    virtual bool readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange, double maxAge) = 0;
     virtual bool enableMonitoring(QOpcUa::NodeAttributes attr, const QOpcUaMonitoringParameters &settings) = 0;
     virtual bool disableMonitoring(QOpcUa::NodeAttributes attr) = 0;
     virtual bool browse(const QOpcUaBrowseRequest &request) = 0;
@@ -89,21 +92,12 @@ public:
     bool registered() const;
     void setRegistered(bool registered);
 
-Q_SIGNALS:
-    void attributesRead(QVector<QOpcUaReadResult> attr, QOpcUa::UaStatusCode serviceResult);
-    void attributeWritten(QOpcUa::NodeAttribute attr, QVariant value, QOpcUa::UaStatusCode statusCode);
-    void browseFinished(QVector<QOpcUaReferenceDescription> children, QOpcUa::UaStatusCode statusCode);
-
-    void dataChangeOccurred(QOpcUa::NodeAttribute attr, QOpcUaReadResult value);
-    void eventOccurred(QVariantList eventFields);
-    void monitoringEnableDisable(QOpcUa::NodeAttribute attr, bool subscribe, QOpcUaMonitoringParameters status);
-    void monitoringStatusChanged(QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items,
-                           QOpcUaMonitoringParameters param);
-    void methodCallFinished(QString methodNodeId, QVariant result, QOpcUa::UaStatusCode statusCode);
-    void resolveBrowsePathFinished(QVector<QOpcUaBrowsePathTarget> targets,
-                                     QVector<QOpcUaRelativePathElement> path, QOpcUa::UaStatusCode status);
+    QOpcUaNodePrivate *node() const;
+    void setNode(QOpcUaNodePrivate *node);
 
 private:
+    Q_DISABLE_COPY(QOpcUaNodeImpl)
+    QOpcUaNodePrivate *m_node;
     quint64 m_handle;
     bool m_registered;
 };
@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuaoperationresult.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaOperationResult
+    \inmodule QtOpcUa
+    \since QtOpcUa 5.15
+    \brief This class stores the result of an operation together with its status code.
+
+    Objects of this class are the results of the futures returned by the asynchronous
+    functions of \l QOpcUaNode and \l QOpcUaClient which would otherwise deliver a value
+    and a status code in a signal, for example \l QOpcUaNode::browseAsync().
+
+    \sa QOpcUaNode::browseAsync() QOpcUaNode::callMethodAsync() QOpcUaNode::resolveBrowsePathAsync()
+*/
+
+/*!
+    \fn template <typename T> QOpcUaOperationResult<T>::QOpcUaOperationResult()
+
+    Constructs an invalid result with status code \c BadNoData.
+*/
+
+/*!
+    \fn template <typename T> QOpcUaOperationResult<T>::QOpcUaOperationResult(const T &value, QOpcUa::UaStatusCode statusCode)
+
+    Constructs a result with \a value and \a statusCode.
+*/
+
+/*!
+    \fn template <typename T> const T &QOpcUaOperationResult<T>::value() const
+
+    Returns the value of the result. The value is only meaningful if \l isGood() is \c true,
+    unless noted otherwise by the function which produced the result.
+*/
+
+/*!
+    \fn template <typename T> QOpcUa::UaStatusCode QOpcUaOperationResult<T>::statusCode() const
+
+    Returns the status code of the operation.
+*/
+
+/*!
+    \fn template <typename T> bool QOpcUaOperationResult<T>::isGood() const
+
+    Returns \c true if the status code of the operation indicates success.
+*/
+
+QT_END_NAMESPACE
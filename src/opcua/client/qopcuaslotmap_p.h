@@ -0,0 +1,189 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPCUASLOTMAP_P_H
+#define QOPCUASLOTMAP_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaglobal.h>
+
+#include <QtCore/qvector.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+// Maps handles to values with constant time insertion, removal and lookup.
+// The values are kept in a dense array of slots, removed slots are chained in a free list
+// and reused by the next insertion.
+//
+// A handle contains the slot index in the lower 30 bits, a two bit tag which allows up to
+// four maps to share one handle space, and the generation of the slot in the upper 32 bits.
+// The generation of a slot is odd while it is in use and is incremented on every insertion
+// and removal, so a handle to a removed value never matches again until the generation
+// counter of its slot wraps around. Handle 0 is never returned.
+template <typename T>
+class QOpcUaSlotMap
+{
+public:
+    explicit QOpcUaSlotMap(quint32 tag = 0)
+        : m_tag(quint64(tag & 3) << TagShift)
+    {}
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    // Returns 0 if the map is full
+    quint64 insert(const T &value)
+    {
+        int index = m_freeHead;
+        if (index >= 0) {
+            m_freeHead = m_slots.at(index).nextFree;
+        } else {
+            if (m_slots.size() >= MaxSlots)
+                return 0;
+            index = m_slots.size();
+            m_slots.push_back(Slot());
+        }
+
+        Slot &slot = m_slots[index];
+        ++slot.generation;
+        slot.value = value;
+        ++m_size;
+        return (quint64(slot.generation) << 32) | m_tag | quint64(index + 1);
+    }
+
+    bool remove(quint64 handle)
+    {
+        const int index = slotIndex(handle);
+        if (index < 0)
+            return false;
+
+        Slot &slot = m_slots[index];
+        ++slot.generation;
+        slot.value = T();
+        slot.nextFree = m_freeHead;
+        m_freeHead = index;
+        --m_size;
+        return true;
+    }
+
+    T take(quint64 handle)
+    {
+        T *entry = find(handle);
+        if (!entry)
+            return T();
+        T value = std::move(*entry);
+        remove(handle);
+        return value;
+    }
+
+    bool contains(quint64 handle) const { return slotIndex(handle) >= 0; }
+
+    T *find(quint64 handle)
+    {
+        const int index = slotIndex(handle);
+        return index >= 0 ? &m_slots[index].value : nullptr;
+    }
+
+    const T *find(quint64 handle) const
+    {
+        const int index = slotIndex(handle);
+        return index >= 0 ? &m_slots.at(index).value : nullptr;
+    }
+
+    T value(quint64 handle, const T &defaultValue = T()) const
+    {
+        const T *entry = find(handle);
+        return entry ? *entry : defaultValue;
+    }
+
+    // Calls f(handle, value) for all values in slot order
+    template <typename F>
+    void forEach(F f) const
+    {
+        for (int i = 0; i < m_slots.size(); ++i) {
+            const Slot &slot = m_slots.at(i);
+            if (slot.generation & 1)
+                f((quint64(slot.generation) << 32) | m_tag | quint64(i + 1), slot.value);
+        }
+    }
+
+private:
+    static constexpr int TagShift = 30;
+    static constexpr quint64 IndexMask = (quint64(1) << TagShift) - 1;
+    static constexpr quint64 TagMask = quint64(3) << TagShift;
+    static constexpr int MaxSlots = int(IndexMask);
+
+    struct Slot {
+        T value = T();
+        quint32 generation = 0;
+        int nextFree = -1;
+    };
+
+    // Returns -1 for handles of removed values and handles which do not belong to this map
+    int slotIndex(quint64 handle) const
+    {
+        const quint32 generation = quint32(handle >> 32);
+        const int index = int(handle & IndexMask) - 1;
+
+        // An unused slot has an even generation, the comparison also rejects those
+        if ((handle & TagMask) != m_tag || uint(index) >= uint(m_slots.size())
+                || m_slots.at(index).generation != generation || !(generation & 1))
+            return -1;
+        return index;
+    }
+
+    QVector<Slot> m_slots;
+    int m_freeHead = -1;
+    int m_size = 0;
+    const quint64 m_tag;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUASLOTMAP_P_H
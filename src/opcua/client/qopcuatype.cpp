@@ -35,9 +35,9 @@
 ****************************************************************************/
 
 #include "qopcuatype.h"
+#include <private/qopcuanodeidparser_p.h>
 
 #include <QMetaEnum>
-#include <QRegularExpression>
 #include <QUuid>
 
 QT_BEGIN_NAMESPACE
@@ -665,33 +665,16 @@ QString QOpcUa::nodeIdFromReferenceType(QOpcUa::ReferenceTypeId referenceType)
 */
 bool QOpcUa::nodeIdStringSplit(const QString &nodeIdString, quint16 *nsIndex, QString *identifier, char *identifierType)
 {
-    quint16 namespaceIndex = 0;
-
-    QStringList components = nodeIdString.split(QLatin1String(";"));
-
-    if (components.size() > 2)
-        return false;
-
-    if (components.size() == 2 && components.at(0).contains(QRegularExpression(QLatin1String("^ns=[0-9]+")))) {
-        bool success = false;
-        uint ns = components.at(0).midRef(3).toString().toUInt(&success);
-        if (!success || ns > (std::numeric_limits<quint16>::max)())
-            return false;
-        namespaceIndex = ns;
-    }
-
-    if (components.last().size() < 3)
-        return false;
-
-    if (!components.last().contains(QRegularExpression(QLatin1String("^[isgb]="))))
+    QOpcUaNodeIdComponents components;
+    if (!qt_opcuaParseNodeIdString(nodeIdString, &components))
         return false;
 
     if (nsIndex)
-        *nsIndex = namespaceIndex;
+        *nsIndex = components.namespaceIndex;
     if (identifier)
-        *identifier = components.last().midRef(2).toString();
+        *identifier = nodeIdString.mid(components.identifierOffset);
     if (identifierType)
-        *identifierType = components.last().at(0).toLatin1();
+        *identifierType = components.identifierType;
 
     return true;
 }
@@ -0,0 +1,400 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopcuavaluehistory.h"
+
+#include <QtCore/qdatetime.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaValueHistory
+    \inmodule QtOpcUa
+    \since QtOpcUa 5.15
+
+    \brief QOpcUaValueHistory stores the most recent numeric values of a monitored attribute.
+
+    The history is a ring buffer with a fixed capacity. Timestamps and values are kept in two
+    separate contiguous arrays. If the history is full, the oldest value is overwritten.
+    Range queries and aggregates work on these arrays directly, the values are not converted
+    to QVariant.
+
+    Timestamps are milliseconds since the epoch. Values are stored in the order they have been appended.
+    The timestamps never decrease, which allows \l lowerBound(), \l range() and \l aggregate() to use
+    binary search. A value with a timestamp older than the most recent value is either stored with the
+    most recent timestamp or rejected, see \l append().
+
+    The history of a monitored attribute is enabled using \l QOpcUaNode::setValueHistoryCapacity()
+    and is filled with every data change notification received for the attribute.
+
+    \sa QOpcUaNode::valueHistory()
+*/
+
+/*!
+    \class QOpcUaValueHistory::Aggregate
+    \inmodule QtOpcUa
+
+    \brief The aggregated values in a range of a \l QOpcUaValueHistory.
+
+    \c count is the number of values in the range. \c minimum, \c maximum and \c average
+    are 0 if the range is empty.
+*/
+
+class QOpcUaValueHistoryPrivate
+{
+public:
+    explicit QOpcUaValueHistoryPrivate(int capacity)
+        : timestamps(capacity, 0)
+        , values(capacity, 0)
+    {}
+
+    int physicalIndex(int index) const
+    {
+        int physical = head + index;
+        if (physical >= timestamps.size())
+            physical -= timestamps.size();
+        return physical;
+    }
+
+    // Calls func with pointers to the contiguous parts of the logical range [first, first + count)
+    template <typename Func>
+    void forEachChunk(int first, int count, Func func) const
+    {
+        if (count <= 0)
+            return;
+
+        const int start = physicalIndex(first);
+        const int firstChunk = qMin(count, timestamps.size() - start);
+        func(timestamps.constData() + start, values.constData() + start, firstChunk);
+        if (firstChunk < count)
+            func(timestamps.constData(), values.constData(), count - firstChunk);
+    }
+
+    int upperBound(qint64 timestamp) const
+    {
+        int low = 0;
+        int high = size;
+        while (low < high) {
+            const int middle = low + (high - low) / 2;
+            if (timestamps.at(physicalIndex(middle)) <= timestamp)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    }
+
+    QVector<qint64> timestamps;
+    QVector<double> values;
+    int head = 0; // Physical index of the oldest value
+    int size = 0;
+    quint64 appended = 0;
+    quint64 skipped = 0;
+};
+
+static bool toNumericValue(const QVariant &value, double *result)
+{
+    switch (value.userType()) {
+    case QMetaType::Bool:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        *result = value.toDouble();
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*!
+    Constructs a history for up to \a capacity values. The memory for all values is allocated immediately.
+*/
+QOpcUaValueHistory::QOpcUaValueHistory(int capacity)
+    : d(new QOpcUaValueHistoryPrivate(qMax(1, capacity)))
+{
+}
+
+/*!
+    Destroys the history.
+*/
+QOpcUaValueHistory::~QOpcUaValueHistory()
+{
+}
+
+/*!
+    Returns the maximum number of values in the history.
+*/
+int QOpcUaValueHistory::capacity() const
+{
+    return d->timestamps.size();
+}
+
+/*!
+    Returns the number of values in the history.
+*/
+int QOpcUaValueHistory::size() const
+{
+    return d->size;
+}
+
+/*!
+    Returns \c true if the history contains no values.
+*/
+bool QOpcUaValueHistory::isEmpty() const
+{
+    return d->size == 0;
+}
+
+/*!
+    Removes all values from the history.
+*/
+void QOpcUaValueHistory::clear()
+{
+    d->head = 0;
+    d->size = 0;
+}
+
+/*!
+    Appends \a value with the timestamp \a timestamp. If the history is full, the oldest value is removed.
+
+    If \a timestamp is older than the timestamp of the most recent value, the value is stored with the
+    timestamp of the most recent value.
+*/
+void QOpcUaValueHistory::append(qint64 timestamp, double value)
+{
+    const int capacity = d->timestamps.size();
+    int position;
+
+    if (d->size)
+        timestamp = qMax(timestamp, lastTimestamp());
+
+    if (d->size < capacity) {
+        position = d->physicalIndex(d->size);
+        ++d->size;
+    } else {
+        position = d->head;
+        if (++d->head == capacity)
+            d->head = 0;
+    }
+
+    d->timestamps[position] = timestamp;
+    d->values[position] = value;
+    ++d->appended;
+}
+
+/*!
+    Appends the value of \a result if it is a numeric scalar and the status code is not bad.
+    The source timestamp is used if it is valid, otherwise the server timestamp or the current time.
+
+    Source timestamps are not guaranteed to increase, for example after the clock of a device has been
+    changed. A value with a timestamp older than the most recent value is not appended.
+
+    Returns \c true if the value has been appended.
+*/
+bool QOpcUaValueHistory::append(const QOpcUaReadResult &result)
+{
+    // Good and uncertain values are stored, the severity bits of bad status codes are 10 or 11
+    const bool isBad = quint32(result.statusCode()) & 0x80000000;
+
+    double value = 0;
+    if (!isBad) {
+        if (toNumericValue(result.value(), &value)) {
+            qint64 timestamp;
+            if (result.sourceTimestamp().isValid())
+                timestamp = result.sourceTimestamp().toMSecsSinceEpoch();
+            else if (result.serverTimestamp().isValid())
+                timestamp = result.serverTimestamp().toMSecsSinceEpoch();
+            else
+                timestamp = QDateTime::currentMSecsSinceEpoch();
+
+            if (!d->size || timestamp >= lastTimestamp()) {
+                append(timestamp, value);
+                return true;
+            }
+        }
+    }
+
+    ++d->skipped;
+    return false;
+}
+
+/*!
+    Returns the timestamp of the value at \a index. Index 0 is the oldest value.
+*/
+qint64 QOpcUaValueHistory::timestampAt(int index) const
+{
+    Q_ASSERT(index >= 0 && index < d->size);
+    return d->timestamps.at(d->physicalIndex(index));
+}
+
+/*!
+    Returns the value at \a index. Index 0 is the oldest value.
+*/
+double QOpcUaValueHistory::valueAt(int index) const
+{
+    Q_ASSERT(index >= 0 && index < d->size);
+    return d->values.at(d->physicalIndex(index));
+}
+
+/*!
+    Returns the timestamp of the oldest value or 0 if the history is empty.
+*/
+qint64 QOpcUaValueHistory::firstTimestamp() const
+{
+    return d->size ? timestampAt(0) : 0;
+}
+
+/*!
+    Returns the timestamp of the most recent value or 0 if the history is empty.
+*/
+qint64 QOpcUaValueHistory::lastTimestamp() const
+{
+    return d->size ? timestampAt(d->size - 1) : 0;
+}
+
+/*!
+    Returns the index of the first value with a timestamp not older than \a timestamp.
+    If there is no such value, \l size() is returned.
+*/
+int QOpcUaValueHistory::lowerBound(qint64 timestamp) const
+{
+    if (timestamp == std::numeric_limits<qint64>::min())
+        return 0;
+    return d->upperBound(timestamp - 1);
+}
+
+/*!
+    Copies the timestamps and values from the interval [\a from, \a to] to \a timestamps and \a values.
+    The previous content of the vectors is replaced.
+
+    Returns the number of values in the interval.
+*/
+int QOpcUaValueHistory::range(qint64 from, qint64 to, QVector<qint64> *timestamps, QVector<double> *values) const
+{
+    const int first = lowerBound(from);
+    const int count = qMax(0, d->upperBound(to) - first);
+
+    if (timestamps)
+        timestamps->resize(count);
+    if (values)
+        values->resize(count);
+
+    int offset = 0;
+    d->forEachChunk(first, count, [&](const qint64 *chunkTimestamps, const double *chunkValues, int chunkSize) {
+        if (timestamps)
+            std::memcpy(timestamps->data() + offset, chunkTimestamps, chunkSize * sizeof(qint64));
+        if (values)
+            std::memcpy(values->data() + offset, chunkValues, chunkSize * sizeof(double));
+        offset += chunkSize;
+    });
+
+    return count;
+}
+
+/*!
+    Returns the number of values and the minimum, maximum and average value in the interval [\a from, \a to].
+*/
+QOpcUaValueHistory::Aggregate QOpcUaValueHistory::aggregate(qint64 from, qint64 to) const
+{
+    const int first = lowerBound(from);
+    const int count = qMax(0, d->upperBound(to) - first);
+
+    Aggregate result;
+    if (!count)
+        return result;
+
+    double minimum = std::numeric_limits<double>::infinity();
+    double maximum = -std::numeric_limits<double>::infinity();
+    double sum = 0;
+    d->forEachChunk(first, count, [&](const qint64 *, const double *chunkValues, int chunkSize) {
+        for (int i = 0; i < chunkSize; ++i) {
+            minimum = std::min(minimum, chunkValues[i]);
+            maximum = std::max(maximum, chunkValues[i]);
+            sum += chunkValues[i];
+        }
+    });
+
+    result.count = count;
+    result.minimum = minimum;
+    result.maximum = maximum;
+    result.average = sum / count;
+    return result;
+}
+
+/*!
+    Returns the number of values which have been appended since the history has been created.
+    This includes values which have been overwritten.
+*/
+quint64 QOpcUaValueHistory::appendedCount() const
+{
+    return d->appended;
+}
+
+/*!
+    Returns the number of read results which have not been appended because they
+    don't contain a numeric scalar value, have a bad status code or are older than
+    the most recent value.
+*/
+quint64 QOpcUaValueHistory::skippedCount() const
+{
+    return d->skipped;
+}
+
+/*!
+    Returns the number of bytes used by the history.
+*/
+qsizetype QOpcUaValueHistory::memoryUsage() const
+{
+    return sizeof(QOpcUaValueHistory) + sizeof(QOpcUaValueHistoryPrivate)
+            + d->timestamps.capacity() * sizeof(qint64) + d->values.capacity() * sizeof(double);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPCUAVALUEHISTORY_H
+#define QOPCUAVALUEHISTORY_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuareadresult.h>
+
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QOpcUaValueHistoryPrivate;
+
+class Q_OPCUA_EXPORT QOpcUaValueHistory
+{
+public:
+    struct Aggregate {
+        int count = 0;
+        double minimum = 0;
+        double maximum = 0;
+        double average = 0;
+    };
+
+    explicit QOpcUaValueHistory(int capacity);
+    ~QOpcUaValueHistory();
+
+    int capacity() const;
+    int size() const;
+    bool isEmpty() const;
+    void clear();
+
+    void append(qint64 timestamp, double value);
+    bool append(const QOpcUaReadResult &result);
+
+    qint64 timestampAt(int index) const;
+    double valueAt(int index) const;
+    qint64 firstTimestamp() const;
+    qint64 lastTimestamp() const;
+
+    int lowerBound(qint64 timestamp) const;
+    int range(qint64 from, qint64 to, QVector<qint64> *timestamps, QVector<double> *values) const;
+    Aggregate aggregate(qint64 from, qint64 to) const;
+
+    quint64 appendedCount() const;
+    quint64 skippedCount() const;
+    qsizetype memoryUsage() const;
+
+private:
+    Q_DISABLE_COPY(QOpcUaValueHistory)
+    QScopedPointer<QOpcUaValueHistoryPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAVALUEHISTORY_H
@@ -40,6 +40,7 @@
 #include <QtOpcUa/qopcuanode.h>
 #include <QtOpcUa/qopcuatype.h>
 #include <QtOpcUa/qopcuaapplicationidentity.h>
+#include <QtOpcUa/qopcuaauthenticationinformation.h>
 #include <QtOpcUa/qopcuapkiconfiguration.h>
 #include <private/qopcuanodeimpl_p.h>
 #include <QtOpcUa/qopcuaqualifiedname.h>
@@ -55,6 +56,8 @@
 #include <QtOpcUa/qopcuaexpandednodeid.h>
 #include <QtOpcUa/qopcuarelativepathelement.h>
 #include <QtOpcUa/qopcuabrowsepathtarget.h>
+#include <QtOpcUa/qopcuahistorydata.h>
+#include <QtOpcUa/qopcuahistoryreadrequest.h>
 
 #include <private/qfactoryloader_p.h>
 #include <QtCore/qjsonarray.h>
@@ -181,13 +184,23 @@ QOpcUaProvider::QOpcUaProvider(QObject *parent)
     qRegisterMetaType<QOpcUaWriteResult>();
     qRegisterMetaType<QVector<QOpcUaWriteItem>>();
     qRegisterMetaType<QVector<QOpcUaWriteResult>>();
+    qRegisterMetaType<QOpcUaCallMethodItem>();
+    qRegisterMetaType<QOpcUaCallMethodResult>();
+    qRegisterMetaType<QVector<QOpcUaCallMethodItem>>();
+    qRegisterMetaType<QVector<QOpcUaCallMethodResult>>();
     qRegisterMetaType<QOpcUaNodeCreationAttributes>();
     qRegisterMetaType<QOpcUaAddNodeItem>();
     qRegisterMetaType<QOpcUaAddReferenceItem>();
     qRegisterMetaType<QOpcUaDeleteReferenceItem>();
     qRegisterMetaType<QVector<QOpcUaApplicationDescription>>();
     qRegisterMetaType<QOpcUaApplicationIdentity>();
+    qRegisterMetaType<QOpcUaAuthenticationInformation>();
     qRegisterMetaType<QOpcUaPkiConfiguration>();
+    qRegisterMetaType<QOpcUaHistoryData>();
+    qRegisterMetaType<QVector<QOpcUaHistoryData>>();
+    qRegisterMetaType<QOpcUaHistoryReadRequest>();
+    qRegisterMetaType<QVector<quint64>>();
+    qRegisterMetaType<QVector<QOpcUa::UaStatusCode>>();
 }
 
 QOpcUaProvider::~QOpcUaProvider()
@@ -234,6 +247,55 @@ static QOpcUaPlugin *loadPlugin(const QString &key)
         \li Unified Automation
         \li Tells the backend to print additional output to the terminal. The backend specific logging
             level is set to \c OPCUA_TRACE_OUTPUT_LEVEL_ALL.
+    \row
+        \li enableAsyncServiceCalls
+        \li open62541
+        \li Read, write, browse, method call and translate browse path requests are sent without
+            waiting for the response of the previous request. Multiple requests can be in flight at the
+            same time and their results are delivered in the order the server responds.
+    \row
+        \li sharedIoThreads
+        \li open62541
+        \li If set to a value greater than zero, the client does not get a thread of its own. It is
+            assigned to the least loaded thread of a pool shared by all open62541 clients which is grown
+            up to the given number of threads. The calls of each client are still processed in order.
+            As synchronous service calls block the thread for all clients assigned to it, this setting
+            should be combined with \c enableAsyncServiceCalls.
+    \row
+        \li readCoalescingInterval
+        \li open62541
+        \li Attribute reads of single nodes requested within this interval in milliseconds are merged
+            into one read request. The results are delivered to the nodes individually. An interval of
+            \c 0 merges all reads requested until control returns to the event loop of the backend.
+            The interval is measured by a timer of the backend thread, which has a resolution of one
+            millisecond. Windows shorter than a millisecond are not supported. The interval \c 0 is the
+            shortest window and usually covers all reads issued by the client thread in one pass of its
+            event loop.
+    \row
+        \li enableTypedArrays
+        \li open62541
+        \li One-dimensional arrays of Boolean, integer, Float and Double values in read results, data
+            change notifications and method call results are returned as QVector of the matching
+            C++ type, for example QVector<double>, instead of QVariantList. The values are copied in
+            one piece instead of being converted one by one. Independent of this setting, such QVector
+            values can be written and are copied in the same way.
+    \row
+        \li nodeIdCacheSize
+        \li open62541
+        \li If set to a value greater than zero, up to this number of node id strings are kept in
+            their parsed form. Repeated creation of nodes and batch reads, writes and browse requests
+            for the same node ids skip parsing the node id strings.
+    \row
+        \li dataChangeQueueCapacity
+        \li open62541
+        \li If set to a value greater than zero, data change notifications are passed to the client
+            thread in a bounded queue with one entry per monitored attribute instead of queued signals.
+            If a new value arrives before the client thread has taken the previous value of the same
+            attribute, the previous value is discarded and counted in
+            \l QOpcUaClient::conflatedDataChangeCount(). The memory used for pending notifications
+            stays bounded if the client thread falls behind. The capacity should be at least the number
+            of monitored attributes. Notifications for further attributes are discarded and counted in
+            \l QOpcUaClient::droppedDataChangeCount(), a warning is logged when this happens for the first time.
     \endtable
 */
 QOpcUaClient *QOpcUaProvider::createClient(const QString &backend, const QVariantMap &backendProperties)
@@ -16,9 +16,11 @@ qtConfig(open62541):!qtConfig(system-open62541) {
 HEADERS += \
     qopen62541backend.h \
     qopen62541client.h \
+    qopen62541historytypes.h \
     qopen62541node.h \
     qopen62541plugin.h \
     qopen62541subscription.h \
+    qopen62541threadpool.h \
     qopen62541valueconverter.h \
     qopen62541.h \
     qopen62541utils.h
@@ -26,9 +28,11 @@ HEADERS += \
 SOURCES += \
     qopen62541backend.cpp \
     qopen62541client.cpp \
+    qopen62541historytypes.cpp \
     qopen62541node.cpp \
     qopen62541plugin.cpp \
     qopen62541subscription.cpp \
+    qopen62541threadpool.cpp \
     qopen62541valueconverter.cpp \
     qopen62541utils.cpp
 
@@ -46,35 +46,84 @@
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qsocketnotifier.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qurl.h>
 
+#include <cstring>
+
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
 
-Open62541AsyncBackend::Open62541AsyncBackend(QOpen62541Client *parent)
+// If incoming data is signaled by the socket notifier, UA_Client_run_iterate() must only be called
+// when one of the deadlines of the client expires. The deadlines are bounded to avoid waking up
+// too often for very short intervals and to recover from missed deadlines.
+static const int minimumIterationInterval = 10;
+static const int maximumIterationInterval = 5000;
+
+// Without a socket notifier, incoming data can only be detected by polling
+static const int pollingInterval = 10;
+
+// Number of requests of a batch read or write which may be pending at the same time
+static const int maxBatchChunksInFlight = 4;
+
+Open62541AsyncBackend::Open62541AsyncBackend()
     : QOpcUaBackend()
     , m_uaclient(nullptr)
-    , m_clientImpl(parent)
     , m_useStateCallback(false)
+    , m_useAsyncServiceCalls(false)
+    , m_readCoalescingInterval(-1)
+    , m_arrayConversion(QOpen62541ValueConverter::ArrayConversion::VariantList)
     , m_subscriptionTimer(this)
+    , m_socketNotifier(nullptr)
+    , m_readCoalescingTimer(this)
+    , m_pendingReadMaxAge(0)
+    , m_dataChangeTimer(this)
     , m_sendPublishRequests(false)
     , m_minPublishingInterval(0)
 {
     m_subscriptionTimer.setSingleShot(true);
     QObject::connect(&m_subscriptionTimer, &QTimer::timeout,
                      this, &Open62541AsyncBackend::sendPublishRequest);
+
+    // Qt timers have a resolution of one millisecond. A precise timer keeps the coalescing window
+    // from being stretched by the up to 5% slack of a coarse timer.
+    m_readCoalescingTimer.setSingleShot(true);
+    m_readCoalescingTimer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&m_readCoalescingTimer, &QTimer::timeout,
+                     this, &Open62541AsyncBackend::sendCoalescedReads);
+
+    m_dataChangeTimer.setSingleShot(true);
+    QObject::connect(&m_dataChangeTimer, &QTimer::timeout,
+                     this, &Open62541AsyncBackend::sendDataChanges);
 }
 
 Open62541AsyncBackend::~Open62541AsyncBackend()
 {
+    for (auto &readValueId : m_pendingReadValueIds)
+        UA_ReadValueId_deleteMembers(&readValueId);
+    for (auto &registeredId : m_registeredNodes)
+        UA_NodeId_deleteMembers(&registeredId);
     cleanupSubscriptions();
     if (m_uaclient)
         UA_Client_delete(m_uaclient);
 }
 
-void Open62541AsyncBackend::readAttributes(quint64 handle, UA_NodeId id, QOpcUa::NodeAttributes attr, QString indexRange)
+QStringList Open62541AsyncBackend::supportedSecurityPolicies()
+{
+    return QStringList {
+        "http://opcfoundation.org/UA/SecurityPolicy#None"
+#ifdef UA_ENABLE_ENCRYPTION
+        , "http://opcfoundation.org/UA/SecurityPolicy#Basic128Rsa15"
+        , "http://opcfoundation.org/UA/SecurityPolicy#Basic256"
+        , "http://opcfoundation.org/UA/SecurityPolicy#Basic256Sha256"
+#endif
+    };
+}
+
+void Open62541AsyncBackend::readAttributes(quint64 handle, UA_NodeId id, QOpcUa::NodeAttributes attr, QString indexRange, double maxAge)
 {
     UA_ReadRequest req;
     UA_ReadRequest_init(&req);
@@ -84,6 +133,7 @@ void Open62541AsyncBackend::readAttributes(quint64 handle, UA_NodeId id, QOpcUa:
     UA_ReadValueId_init(&readId);
     UaDeleter<UA_ReadValueId> readIdDeleter(&readId, UA_ReadValueId_deleteMembers);
     readId.nodeId = id;
+    useRegisteredNodeId(&readId.nodeId);
 
     QVector<QOpcUaReadResult> vec;
 
@@ -94,38 +144,152 @@ void Open62541AsyncBackend::readAttributes(quint64 handle, UA_NodeId id, QOpcUa:
         valueIds.push_back(readId);
         QOpcUaReadResult temp;
         temp.setAttribute(attribute);
+        temp.setIndexRange(indexRange);
         vec.push_back(temp);
     });
 
-    UA_ReadResponse res;
-    UA_ReadResponse_init(&res);
+    AsyncReadContext context = {handle, vec};
+
+    if (m_readCoalescingInterval >= 0) {
+        // The read is merged with all other reads requested until the timer expires.
+        // Pending reads are sent early if the merged request would exceed the server's limit.
+        // Reads with a different maximum age can't share a request.
+        const UA_UInt32 limit = m_operationLimits.maxNodesPerRead;
+        if ((limit && static_cast<UA_UInt32>(m_pendingReadValueIds.size() + valueIds.size()) > limit)
+                || (!m_pendingReads.isEmpty() && m_pendingReadMaxAge != maxAge)) {
+            m_readCoalescingTimer.stop();
+            sendCoalescedReads();
+        }
+        m_pendingReadMaxAge = maxAge;
+        for (const auto &valueId : qAsConst(valueIds)) {
+            UA_ReadValueId copy;
+            UA_ReadValueId_copy(&valueId, &copy);
+            m_pendingReadValueIds.push_back(copy);
+        }
+        m_pendingReads.push_back(context);
+        if (!m_readCoalescingTimer.isActive())
+            m_readCoalescingTimer.start(m_readCoalescingInterval);
+        return;
+    }
+
     req.nodesToRead = valueIds.data();
     req.nodesToReadSize = valueIds.size();
     req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+    req.maxAge = maxAge;
+
+    if (m_useAsyncServiceCalls) {
+        UA_UInt32 requestId = 0;
+        UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_READREQUEST], &asyncReadCallback,
+                                                &UA_TYPES[UA_TYPES_READRESPONSE], &requestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            m_asyncReadContext[requestId] = context;
+            return;
+        }
 
-    res = UA_Client_Service_read(m_uaclient, req);
+        UA_ReadResponse res;
+        UA_ReadResponse_init(&res);
+        res.responseHeader.serviceResult = result;
+        handleReadResponse(context, &res);
+        return;
+    }
 
+    UA_ReadResponse res = UA_Client_Service_read(m_uaclient, req);
     UaDeleter<UA_ReadResponse> responseDeleter(&res, UA_ReadResponse_deleteMembers);
 
+    handleReadResponse(context, &res);
+}
+
+void Open62541AsyncBackend::handleReadResponse(const AsyncReadContext &context, const UA_ReadResponse *res)
+{
+    QVector<QOpcUaReadResult> vec = context.results;
+
     for (int i = 0; i < vec.size(); ++i) {
         // Use the service result as status code if there is no specific result for the current value.
         // This ensures a result for each attribute when UA_Client_Service_read is called for a disconnected client.
-        if (static_cast<size_t>(i) >= res.resultsSize) {
-            vec[i].setStatusCode(static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult));
+        if (static_cast<size_t>(i) >= res->resultsSize) {
+            vec[i].setStatusCode(static_cast<QOpcUa::UaStatusCode>(res->responseHeader.serviceResult));
             continue;
         }
-        if (res.results[i].hasStatus)
-            vec[i].setStatusCode(static_cast<QOpcUa::UaStatusCode>(res.results[i].status));
+        if (res->results[i].hasStatus)
+            vec[i].setStatusCode(static_cast<QOpcUa::UaStatusCode>(res->results[i].status));
         else
             vec[i].setStatusCode(QOpcUa::UaStatusCode::Good);
-        if (res.results[i].hasValue && res.results[i].value.data)
-                vec[i].setValue(QOpen62541ValueConverter::toQVariant(res.results[i].value));
-        if (res.results[i].hasServerTimestamp)
-            vec[i].setSourceTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime, UA_DateTime>(&res.results[i].sourceTimestamp));
-        if (res.results[i].hasSourceTimestamp)
-            vec[i].setServerTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime, UA_DateTime>(&res.results[i].serverTimestamp));
+        // The response is released after it has been handled, array buffers can be moved out of it
+        if (res->results[i].hasValue && res->results[i].value.data)
+                vec[i].setValue(QOpen62541ValueConverter::takeQVariant(&res->results[i].value, m_arrayConversion));
+        if (res->results[i].hasSourceTimestamp)
+            vec[i].setSourceTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime, UA_DateTime>(&res->results[i].sourceTimestamp));
+        if (res->results[i].hasServerTimestamp)
+            vec[i].setServerTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime, UA_DateTime>(&res->results[i].serverTimestamp));
+    }
+    emit attributesRead(context.handle, vec, static_cast<QOpcUa::UaStatusCode>(res->responseHeader.serviceResult));
+}
+
+void Open62541AsyncBackend::sendCoalescedReads()
+{
+    if (m_pendingReads.isEmpty())
+        return;
+
+    AsyncCoalescedReadContext context = {qExchange(m_pendingReads, {})};
+    QVector<UA_ReadValueId> valueIds = qExchange(m_pendingReadValueIds, {});
+
+    const auto valueIdsDeleter = qScopeGuard([&valueIds]() {
+        for (auto &valueId : valueIds)
+            UA_ReadValueId_deleteMembers(&valueId);
+    });
+
+    UA_ReadResponse res;
+    UA_ReadResponse_init(&res);
+
+    if (!m_uaclient) {
+        res.responseHeader.serviceResult = UA_STATUSCODE_BADSERVERNOTCONNECTED;
+        handleCoalescedReadResponse(context, &res);
+        return;
+    }
+
+    UA_ReadRequest req;
+    UA_ReadRequest_init(&req);
+    req.nodesToRead = valueIds.data();
+    req.nodesToReadSize = valueIds.size();
+    req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+    req.maxAge = m_pendingReadMaxAge;
+
+    qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Sending" << context.reads.size() << "coalesced reads with"
+                                        << valueIds.size() << "attributes in one read request";
+
+    if (m_useAsyncServiceCalls) {
+        UA_UInt32 requestId = 0;
+        UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_READREQUEST], &asyncCoalescedReadCallback,
+                                                &UA_TYPES[UA_TYPES_READRESPONSE], &requestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            m_asyncCoalescedReadContext[requestId] = context;
+            return;
+        }
+
+        res.responseHeader.serviceResult = result;
+        handleCoalescedReadResponse(context, &res);
+        return;
+    }
+
+    res = UA_Client_Service_read(m_uaclient, req);
+    UaDeleter<UA_ReadResponse> responseDeleter(&res, UA_ReadResponse_deleteMembers);
+
+    handleCoalescedReadResponse(context, &res);
+}
+
+void Open62541AsyncBackend::handleCoalescedReadResponse(const AsyncCoalescedReadContext &context, const UA_ReadResponse *res)
+{
+    size_t offset = 0;
+
+    for (const auto &read : context.reads) {
+        // Each node gets a view of its part of the combined response
+        UA_ReadResponse partialResponse = *res;
+        partialResponse.results = offset < res->resultsSize ? res->results + offset : nullptr;
+        partialResponse.resultsSize = offset < res->resultsSize ?
+                    qMin<size_t>(read.results.size(), res->resultsSize - offset) : 0;
+        handleReadResponse(read, &partialResponse);
+        offset += read.results.size();
     }
-    emit attributesRead(handle, vec, static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult));
 }
 
 void Open62541AsyncBackend::writeAttribute(quint64 handle, UA_NodeId id, QOpcUa::NodeAttribute attrId, QVariant value, QOpcUa::Types type, QString indexRange)
@@ -142,23 +306,40 @@ void Open62541AsyncBackend::writeAttribute(quint64 handle, UA_NodeId id, QOpcUa:
     UA_WriteValue_init(req.nodesToWrite);
     req.nodesToWrite->attributeId = QOpen62541ValueConverter::toUaAttributeId(attrId);
     req.nodesToWrite->nodeId = id;
+    useRegisteredNodeId(&req.nodesToWrite->nodeId);
     req.nodesToWrite->value.value = QOpen62541ValueConverter::toOpen62541Variant(value, type);
     req.nodesToWrite->value.hasValue = true;
     if (indexRange.length())
         QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(indexRange, &req.nodesToWrite->indexRange);
 
+    AsyncWriteAttributesContext context = {handle, {qMakePair(attrId, value)}};
+
+    if (m_useAsyncServiceCalls) {
+        UA_UInt32 requestId = 0;
+        UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_WRITEREQUEST], &asyncWriteAttributesCallback,
+                                                &UA_TYPES[UA_TYPES_WRITERESPONSE], &requestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            m_asyncWriteAttributesContext[requestId] = context;
+            return;
+        }
+
+        UA_WriteResponse res;
+        UA_WriteResponse_init(&res);
+        res.responseHeader.serviceResult = result;
+        handleWriteAttributesResponse(context, &res);
+        return;
+    }
+
     UA_WriteResponse res = UA_Client_Service_write(m_uaclient, req);
     UaDeleter<UA_WriteResponse> responseDeleter(&res, UA_WriteResponse_deleteMembers);
 
-    QOpcUa::UaStatusCode status = res.resultsSize ?
-                static_cast<QOpcUa::UaStatusCode>(res.results[0]) : static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
-
-    emit attributeWritten(handle, attrId, value, status);
+    handleWriteAttributesResponse(context, &res);
 }
 
 void Open62541AsyncBackend::writeAttributes(quint64 handle, UA_NodeId id, QOpcUaNode::AttributeMap toWrite, QOpcUa::Types valueAttributeType)
 {
     UaDeleter<UA_NodeId> nodeIdDeleter(&id, UA_NodeId_deleteMembers);
+    useRegisteredNodeId(&id);
 
     if (toWrite.size() == 0) {
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "No values to be written";
@@ -179,20 +360,47 @@ void Open62541AsyncBackend::writeAttributes(quint64 handle, UA_NodeId id, QOpcUa
         QOpcUa::Types type = it.key() == QOpcUa::NodeAttribute::Value ? valueAttributeType : attributeIdToTypeId(it.key());
         req.nodesToWrite[index].value.value = QOpen62541ValueConverter::toOpen62541Variant(it.value(), type);
     }
+
+    AsyncWriteAttributesContext context;
+    context.handle = handle;
+    for (auto it = toWrite.begin(); it != toWrite.end(); ++it)
+        context.toWrite.push_back(qMakePair(it.key(), it.value()));
+
+    if (m_useAsyncServiceCalls) {
+        UA_UInt32 requestId = 0;
+        UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_WRITEREQUEST], &asyncWriteAttributesCallback,
+                                                &UA_TYPES[UA_TYPES_WRITERESPONSE], &requestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            m_asyncWriteAttributesContext[requestId] = context;
+            return;
+        }
+
+        UA_WriteResponse res;
+        UA_WriteResponse_init(&res);
+        res.responseHeader.serviceResult = result;
+        handleWriteAttributesResponse(context, &res);
+        return;
+    }
+
     UA_WriteResponse res = UA_Client_Service_write(m_uaclient, req);
     UaDeleter<UA_WriteResponse> responseDeleter(&res, UA_WriteResponse_deleteMembers);
 
-    index = 0;
-    for (auto it = toWrite.begin(); it != toWrite.end(); ++it, ++index) {
-        QOpcUa::UaStatusCode status = index < res.resultsSize ?
-                    static_cast<QOpcUa::UaStatusCode>(res.results[index]) : static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
-        emit attributeWritten(handle, it.key(), it.value(), status);
+    handleWriteAttributesResponse(context, &res);
+}
+
+void Open62541AsyncBackend::handleWriteAttributesResponse(const AsyncWriteAttributesContext &context, const UA_WriteResponse *res)
+{
+    for (int i = 0; i < context.toWrite.size(); ++i) {
+        QOpcUa::UaStatusCode status = static_cast<size_t>(i) < res->resultsSize ?
+                    static_cast<QOpcUa::UaStatusCode>(res->results[i]) : static_cast<QOpcUa::UaStatusCode>(res->responseHeader.serviceResult);
+        emit attributeWritten(context.handle, context.toWrite.at(i).first, context.toWrite.at(i).second, status);
     }
 }
 
 void Open62541AsyncBackend::enableMonitoring(quint64 handle, UA_NodeId id, QOpcUa::NodeAttributes attr, const QOpcUaMonitoringParameters &settings)
 {
     UaDeleter<UA_NodeId> nodeIdDeleter(&id, UA_NodeId_deleteMembers);
+    useRegisteredNodeId(&id);
 
     QOpen62541Subscription *usedSubscription = nullptr;
 
@@ -257,6 +465,100 @@ void Open62541AsyncBackend::disableMonitoring(quint64 handle, QOpcUa::NodeAttrib
     modifyPublishRequests();
 }
 
+void Open62541AsyncBackend::enableMonitoringForNodes(QVector<quint64> handles, QVector<UA_NodeId> ids, QOpcUa::NodeAttributes attr,
+                                                     const QOpcUaMonitoringParameters &settings)
+{
+    const auto idDeleter = qScopeGuard([&ids]() {
+        for (auto &id : ids)
+            UA_NodeId_deleteMembers(&id);
+    });
+
+    for (auto &id : ids)
+        useRegisteredNodeId(&id);
+
+    const auto reportFailure = [&](QOpcUa::UaStatusCode statusCode) {
+        for (quint64 handle : qAsConst(handles)) {
+            qt_forEachAttribute(attr, [&](QOpcUa::NodeAttribute attribute){
+                QOpcUaMonitoringParameters s;
+                s.setStatusCode(statusCode);
+                emit monitoringEnableDisable(handle, attribute, true, s);
+            });
+        }
+    };
+
+    QOpen62541Subscription *usedSubscription = nullptr;
+
+    if (settings.subscriptionId()) {
+        auto sub = m_subscriptions.find(settings.subscriptionId());
+        if (sub == m_subscriptions.end()) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "There is no subscription with id" << settings.subscriptionId();
+            reportFailure(QOpcUa::UaStatusCode::BadSubscriptionIdInvalid);
+            return;
+        }
+        usedSubscription = sub.value();
+    } else {
+        usedSubscription = getSubscription(settings);
+    }
+
+    if (!usedSubscription) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not create subscription with interval" << settings.publishingInterval();
+        reportFailure(QOpcUa::UaStatusCode::BadSubscriptionIdInvalid);
+        return;
+    }
+
+    QVector<QPair<quint64, QOpcUa::NodeAttribute>> items;
+    QVector<const UA_NodeId *> itemNodeIds;
+    QSet<QPair<quint64, QOpcUa::NodeAttribute>> requestedItems;
+
+    for (int i = 0; i < handles.size(); ++i) {
+        const quint64 handle = handles.at(i);
+        qt_forEachAttribute(attr, [&](QOpcUa::NodeAttribute attribute){
+            if (getSubscriptionForItem(handle, attribute) || requestedItems.contains(qMakePair(handle, attribute))) {
+                qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Monitored item for" << attribute << "has already been created";
+                QOpcUaMonitoringParameters s;
+                s.setStatusCode(QOpcUa::UaStatusCode::BadEntryExists);
+                emit monitoringEnableDisable(handle, attribute, true, s);
+            } else {
+                items.push_back(qMakePair(handle, attribute));
+                itemNodeIds.push_back(&ids.at(i));
+                requestedItems.insert(items.last());
+            }
+        });
+    }
+
+    const auto created = usedSubscription->addAttributeMonitoredItems(items, itemNodeIds, settings);
+    for (const auto &item : created)
+        m_attributeMapping[item.first][item.second] = usedSubscription;
+
+    if (usedSubscription->monitoredItemsCount() == 0)
+        removeSubscription(usedSubscription->subscriptionId()); // No items were added
+
+    modifyPublishRequests();
+}
+
+void Open62541AsyncBackend::disableMonitoringForNodes(QVector<quint64> handles, QOpcUa::NodeAttributes attr)
+{
+    QHash<QOpen62541Subscription *, QVector<QPair<quint64, QOpcUa::NodeAttribute>>> itemsPerSubscription;
+
+    for (quint64 handle : qAsConst(handles)) {
+        qt_forEachAttribute(attr, [&](QOpcUa::NodeAttribute attribute){
+            QOpen62541Subscription *sub = getSubscriptionForItem(handle, attribute);
+            if (sub) {
+                itemsPerSubscription[sub].push_back(qMakePair(handle, attribute));
+                m_attributeMapping[handle].remove(attribute);
+            }
+        });
+    }
+
+    for (auto it = itemsPerSubscription.constBegin(); it != itemsPerSubscription.constEnd(); ++it) {
+        it.key()->removeAttributeMonitoredItems(it.value());
+        if (it.key()->monitoredItemsCount() == 0)
+            removeSubscription(it.key()->subscriptionId());
+    }
+
+    modifyPublishRequests();
+}
+
 void Open62541AsyncBackend::modifyMonitoring(quint64 handle, QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameter item, QVariant value)
 {
     QOpen62541Subscription *subscription = getSubscriptionForItem(handle, attr);
@@ -315,36 +617,79 @@ void Open62541AsyncBackend::callMethod(quint64 handle, UA_NodeId objectId, UA_No
     UaDeleter<UA_NodeId> objectIdDeleter(&objectId, UA_NodeId_deleteMembers);
     UaDeleter<UA_NodeId> methodIdDeleter(&methodId, UA_NodeId_deleteMembers);
 
-    UA_Variant *inputArgs = nullptr;
+    UA_CallRequest req;
+    UA_CallRequest_init(&req);
+    UaDeleter<UA_CallRequest> requestDeleter(&req, UA_CallRequest_deleteMembers);
+
+    req.methodsToCallSize = 1;
+    req.methodsToCall = UA_CallMethodRequest_new();
+    UA_CallMethodRequest_init(req.methodsToCall);
+    UA_NodeId_copy(&objectId, &req.methodsToCall->objectId);
+    UA_NodeId_copy(&methodId, &req.methodsToCall->methodId);
 
     if (args.size()) {
-        inputArgs = static_cast<UA_Variant *>(UA_Array_new(args.size(), &UA_TYPES[UA_TYPES_VARIANT]));
+        req.methodsToCall->inputArguments = static_cast<UA_Variant *>(UA_Array_new(args.size(), &UA_TYPES[UA_TYPES_VARIANT]));
+        req.methodsToCall->inputArgumentsSize = args.size();
         for (int i = 0; i < args.size(); ++i)
-            inputArgs[i] = QOpen62541ValueConverter::toOpen62541Variant(args[i].first, args[i].second);
+            req.methodsToCall->inputArguments[i] = QOpen62541ValueConverter::toOpen62541Variant(args[i].first, args[i].second);
     }
-    UaArrayDeleter<UA_TYPES_VARIANT> inputArgsDeleter(inputArgs, args.size());
 
-    size_t outputSize = 0;
-    UA_Variant *outputArguments = nullptr;
-    UA_StatusCode res = UA_Client_call(m_uaclient, objectId, methodId, args.size(), inputArgs, &outputSize, &outputArguments);
-    UaArrayDeleter<UA_TYPES_VARIANT> outputArgsDeleter(outputArguments, outputSize);
+    AsyncCallMethodContext context = {handle, Open62541Utils::nodeIdToQString(methodId)};
 
-    if (res != UA_STATUSCODE_GOOD)
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not call method:" << UA_StatusCode_name(res);
+    if (m_useAsyncServiceCalls) {
+        UA_UInt32 requestId = 0;
+        UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_CALLREQUEST], &asyncCallMethodCallback,
+                                                &UA_TYPES[UA_TYPES_CALLRESPONSE], &requestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            m_asyncCallMethodContext[requestId] = context;
+            return;
+        }
+
+        UA_CallResponse res;
+        UA_CallResponse_init(&res);
+        res.responseHeader.serviceResult = result;
+        handleCallMethodResponse(context, &res);
+        return;
+    }
+
+    UA_CallResponse res = UA_Client_Service_call(m_uaclient, req);
+    UaDeleter<UA_CallResponse> responseDeleter(&res, UA_CallResponse_deleteMembers);
+
+    handleCallMethodResponse(context, &res);
+}
+
+void Open62541AsyncBackend::handleCallMethodResponse(const AsyncCallMethodContext &context, const UA_CallResponse *res)
+{
+    // Same evaluation of the response as in UA_Client_call()
+    UA_StatusCode status = res->responseHeader.serviceResult;
+    if (status == UA_STATUSCODE_GOOD) {
+        if (res->resultsSize == 1)
+            status = res->results[0].statusCode;
+        else
+            status = UA_STATUSCODE_BADUNEXPECTEDERROR;
+    }
+
+    if (status != UA_STATUSCODE_GOOD)
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not call method:" << UA_StatusCode_name(status);
 
     QVariant result;
 
-    if (outputSize > 1 && res == UA_STATUSCODE_GOOD) {
-        QVariantList temp;
-        for (size_t i = 0; i < outputSize; ++i)
-            temp.append(QOpen62541ValueConverter::toQVariant(outputArguments[i]));
+    if (status == UA_STATUSCODE_GOOD) {
+        const size_t outputSize = res->results[0].outputArgumentsSize;
+        const UA_Variant *outputArguments = res->results[0].outputArguments;
+
+        if (outputSize > 1) {
+            QVariantList temp;
+            for (size_t i = 0; i < outputSize; ++i)
+                temp.append(QOpen62541ValueConverter::toQVariant(outputArguments[i], m_arrayConversion));
 
-        result = temp;
-    } else if (outputSize == 1 && res == UA_STATUSCODE_GOOD) {
-        result = QOpen62541ValueConverter::toQVariant(outputArguments[0]);
+            result = temp;
+        } else if (outputSize == 1) {
+            result = QOpen62541ValueConverter::toQVariant(outputArguments[0], m_arrayConversion);
+        }
     }
 
-    emit methodCallFinished(handle, Open62541Utils::nodeIdToQString(methodId), result, static_cast<QOpcUa::UaStatusCode>(res));
+    emit methodCallFinished(context.handle, context.methodNodeId, result, static_cast<QOpcUa::UaStatusCode>(status));
 }
 
 void Open62541AsyncBackend::resolveBrowsePath(quint64 handle, UA_NodeId startNode, const QVector<QOpcUaRelativePathElement> &path)
@@ -369,28 +714,53 @@ void Open62541AsyncBackend::resolveBrowsePath(quint64 handle, UA_NodeId startNod
                                                                                       path[i].targetName().name().toUtf8().constData());
     }
 
+    AsyncTranslateContext context = {handle, path};
+
+    if (m_useAsyncServiceCalls) {
+        UA_UInt32 requestId = 0;
+        UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_TRANSLATEBROWSEPATHSTONODEIDSREQUEST],
+                                                &asyncTranslateBrowsePathCallback,
+                                                &UA_TYPES[UA_TYPES_TRANSLATEBROWSEPATHSTONODEIDSRESPONSE], &requestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            m_asyncTranslateContext[requestId] = context;
+            return;
+        }
+
+        UA_TranslateBrowsePathsToNodeIdsResponse res;
+        UA_TranslateBrowsePathsToNodeIdsResponse_init(&res);
+        res.responseHeader.serviceResult = result;
+        handleTranslateBrowsePathResponse(context, &res);
+        return;
+    }
+
     UA_TranslateBrowsePathsToNodeIdsResponse res = UA_Client_Service_translateBrowsePathsToNodeIds(m_uaclient, req);
     UaDeleter<UA_TranslateBrowsePathsToNodeIdsResponse> responseDeleter(
                 &res, UA_TranslateBrowsePathsToNodeIdsResponse_deleteMembers);
 
-    if (res.responseHeader.serviceResult != UA_STATUSCODE_GOOD || res.resultsSize != 1) {
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Translate browse path failed:" << UA_StatusCode_name(res.responseHeader.serviceResult);
-        emit resolveBrowsePathFinished(handle, QVector<QOpcUaBrowsePathTarget>(), path,
-                                         static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult));
+    handleTranslateBrowsePathResponse(context, &res);
+}
+
+void Open62541AsyncBackend::handleTranslateBrowsePathResponse(const AsyncTranslateContext &context,
+                                                              const UA_TranslateBrowsePathsToNodeIdsResponse *res)
+{
+    if (res->responseHeader.serviceResult != UA_STATUSCODE_GOOD || res->resultsSize != 1) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Translate browse path failed:" << UA_StatusCode_name(res->responseHeader.serviceResult);
+        emit resolveBrowsePathFinished(context.handle, QVector<QOpcUaBrowsePathTarget>(), context.path,
+                                         static_cast<QOpcUa::UaStatusCode>(res->responseHeader.serviceResult));
         return;
     }
 
     QVector<QOpcUaBrowsePathTarget> ret;
-    for (size_t i = 0; i < res.results[0].targetsSize ; ++i) {
+    for (size_t i = 0; i < res->results[0].targetsSize ; ++i) {
         QOpcUaBrowsePathTarget temp;
-        temp.setRemainingPathIndex(res.results[0].targets[i].remainingPathIndex);
-        temp.targetIdRef().setNamespaceUri(QString::fromUtf8(reinterpret_cast<char *>(res.results[0].targets[i].targetId.namespaceUri.data)));
-        temp.targetIdRef().setServerIndex(res.results[0].targets[i].targetId.serverIndex);
-        temp.targetIdRef().setNodeId(Open62541Utils::nodeIdToQString(res.results[0].targets[i].targetId.nodeId));
+        temp.setRemainingPathIndex(res->results[0].targets[i].remainingPathIndex);
+        temp.targetIdRef().setNamespaceUri(QString::fromUtf8(reinterpret_cast<char *>(res->results[0].targets[i].targetId.namespaceUri.data)));
+        temp.targetIdRef().setServerIndex(res->results[0].targets[i].targetId.serverIndex);
+        temp.targetIdRef().setNodeId(Open62541Utils::nodeIdToQString(res->results[0].targets[i].targetId.nodeId));
         ret.append(temp);
     }
 
-    emit resolveBrowsePathFinished(handle, ret, path, static_cast<QOpcUa::UaStatusCode>(res.results[0].statusCode));
+    emit resolveBrowsePathFinished(context.handle, ret, context.path, static_cast<QOpcUa::UaStatusCode>(res->results[0].statusCode));
 }
 
 void Open62541AsyncBackend::findServers(const QUrl &url, const QStringList &localeIds, const QStringList &serverUris)
@@ -436,320 +806,1705 @@ void Open62541AsyncBackend::findServers(const QUrl &url, const QStringList &loca
     emit findServersFinished(ret, static_cast<QOpcUa::UaStatusCode>(result), url);
 }
 
-void Open62541AsyncBackend::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead)
+void Open62541AsyncBackend::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge)
 {
     if (nodesToRead.size() == 0) {
         emit readNodeAttributesFinished(QVector<QOpcUaReadResult>(), QOpcUa::UaStatusCode::BadNothingToDo);
         return;
     }
 
-    UA_ReadRequest req;
-    UA_ReadRequest_init(&req);
-    UaDeleter<UA_ReadRequest> requestDeleter(&req, UA_ReadRequest_deleteMembers);
+    auto batch = QSharedPointer<BatchRead>::create();
+    batch->nodesToRead = nodesToRead;
+    batch->results.resize(nodesToRead.size());
+    batch->maxAge = maxAge;
 
-    req.nodesToReadSize = nodesToRead.size();
-    req.nodesToRead = static_cast<UA_ReadValueId *>(UA_Array_new(nodesToRead.size(), &UA_TYPES[UA_TYPES_READVALUEID]));
-    req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+    continueBatchRead(batch);
+}
 
-    for (int i = 0; i < nodesToRead.size(); ++i) {
-        UA_ReadValueId_init(&req.nodesToRead[i]);
-        req.nodesToRead[i].attributeId = QOpen62541ValueConverter::toUaAttributeId(nodesToRead.at(i).attribute());
-        req.nodesToRead[i].nodeId = Open62541Utils::nodeIdFromQString(nodesToRead.at(i).nodeId());
-        if (!nodesToRead[i].indexRange().isEmpty())
-            QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(nodesToRead.at(i).indexRange(),
-                                                                       &req.nodesToRead[i].indexRange);
+void Open62541AsyncBackend::readValues(quint64 requestHandle, const QVector<QOpcUaReadItem> &nodesToRead, double maxAge)
+{
+    if (nodesToRead.isEmpty()) {
+        emit valuesRead(requestHandle, QVector<QOpcUaReadResult>(), QOpcUa::UaStatusCode::BadNothingToDo);
+        return;
     }
 
-    UA_ReadResponse res = UA_Client_Service_read(m_uaclient, req);
-    UaDeleter<UA_ReadResponse> responseDeleter(&res, UA_ReadResponse_deleteMembers);
-
-    QOpcUa::UaStatusCode serviceResult = static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
+    auto batch = QSharedPointer<BatchRead>::create();
+    batch->nodesToRead = nodesToRead;
+    batch->results.resize(nodesToRead.size());
+    batch->maxAge = maxAge;
+    batch->requestHandle = requestHandle;
 
-    if (serviceResult != QOpcUa::UaStatusCode::Good) {
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Batch read failed:" << serviceResult;
-        emit readNodeAttributesFinished(QVector<QOpcUaReadResult>(), serviceResult);
-    } else {
-        QVector<QOpcUaReadResult> ret;
-
-        for (int i = 0; i < nodesToRead.size(); ++i) {
-            QOpcUaReadResult item;
-            item.setAttribute(nodesToRead.at(i).attribute());
-            item.setNodeId(nodesToRead.at(i).nodeId());
-            item.setIndexRange(nodesToRead.at(i).indexRange());
-            if (static_cast<size_t>(i) < res.resultsSize) {
-                if (res.results[i].hasServerTimestamp)
-                    item.setServerTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime>(&res.results[i].serverTimestamp));
-                if (res.results[i].hasSourceTimestamp)
-                    item.setSourceTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime>(&res.results[i].sourceTimestamp));
-                if (res.results[i].hasValue)
-                    item.setValue(QOpen62541ValueConverter::toQVariant(res.results[i].value));
-                if (res.results[i].hasStatus)
-                    item.setStatusCode(static_cast<QOpcUa::UaStatusCode>(res.results[i].status));
-                else
-                    item.setStatusCode(serviceResult);
-            } else {
-                item.setStatusCode(serviceResult);
-            }
-            ret.push_back(item);
-        }
-        emit readNodeAttributesFinished(ret, serviceResult);
-    }
+    continueBatchRead(batch);
 }
 
-void Open62541AsyncBackend::writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite)
+void Open62541AsyncBackend::continueBatchRead(const QSharedPointer<BatchRead> &batch)
 {
-    if (nodesToWrite.isEmpty()) {
-        emit writeNodeAttributesFinished(QVector<QOpcUaWriteResult>(), QOpcUa::UaStatusCode::BadNothingToDo);
+    if (batch->finished)
         return;
-    }
 
-    UA_WriteRequest req;
-    UA_WriteRequest_init(&req);
-    UaDeleter<UA_WriteRequest> requestDeleter(&req, UA_WriteRequest_deleteMembers);
+    const int totalSize = batch->nodesToRead.size();
+    const int chunkSize = m_operationLimits.maxNodesPerRead ? static_cast<int>(qMin<UA_UInt32>(m_operationLimits.maxNodesPerRead, totalSize))
+                                                            : totalSize;
+
+    while (batch->serviceResult == QOpcUa::UaStatusCode::Good && batch->nextOffset < totalSize &&
+           batch->pendingChunks < maxBatchChunksInFlight) {
+        const AsyncBatchReadContext context = {batch, batch->nextOffset, qMin(chunkSize, totalSize - batch->nextOffset)};
+        batch->nextOffset += context.count;
+        ++batch->pendingChunks;
+
+        UA_ReadRequest req;
+        UA_ReadRequest_init(&req);
+        UaDeleter<UA_ReadRequest> requestDeleter(&req, UA_ReadRequest_deleteMembers);
+
+        req.nodesToReadSize = context.count;
+        req.nodesToRead = static_cast<UA_ReadValueId *>(UA_Array_new(context.count, &UA_TYPES[UA_TYPES_READVALUEID]));
+        req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+        req.maxAge = batch->maxAge;
+
+        for (int i = 0; i < context.count; ++i) {
+            const QOpcUaReadItem &item = batch->nodesToRead.at(context.offset + i);
+            UA_ReadValueId_init(&req.nodesToRead[i]);
+            req.nodesToRead[i].attributeId = QOpen62541ValueConverter::toUaAttributeId(item.attribute());
+            req.nodesToRead[i].nodeId = requestNodeId(item.nodeId());
+            if (!item.indexRange().isEmpty())
+                QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(item.indexRange(), &req.nodesToRead[i].indexRange);
+        }
 
-    req.nodesToWriteSize = nodesToWrite.size();
-    req.nodesToWrite = static_cast<UA_WriteValue *>(UA_Array_new(nodesToWrite.size(), &UA_TYPES[UA_TYPES_WRITEVALUE]));
+        if (m_useAsyncServiceCalls) {
+            UA_UInt32 requestId = 0;
+            UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_READREQUEST], &asyncBatchReadCallback,
+                                                    &UA_TYPES[UA_TYPES_READRESPONSE], &requestId);
+            if (result == UA_STATUSCODE_GOOD) {
+                m_asyncBatchReadContext[requestId] = context;
+                continue;
+            }
 
-    for (int i = 0; i < nodesToWrite.size(); ++i) {
-        const auto &currentItem = nodesToWrite.at(i);
-        auto &currentUaItem = req.nodesToWrite[i];
-        currentUaItem.attributeId = QOpen62541ValueConverter::toUaAttributeId(currentItem.attribute());
-        currentUaItem.nodeId = Open62541Utils::nodeIdFromQString(currentItem.nodeId());
-        if (currentItem.hasStatusCode()) {
-            currentUaItem.value.status = currentItem.statusCode();
-            currentUaItem.value.hasStatus = UA_TRUE;
-        }
-        if (!currentItem.indexRange().isEmpty())
-            QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(currentItem.indexRange(), &currentUaItem.indexRange);
-        if (!currentItem.value().isNull()) {
-            currentUaItem.value.hasValue = true;
-            currentUaItem.value.value = QOpen62541ValueConverter::toOpen62541Variant(currentItem.value(), currentItem.type());
-        }
-        if (currentItem.sourceTimestamp().isValid()) {
-            QOpen62541ValueConverter::scalarFromQt<UA_DateTime, QDateTime>(currentItem.sourceTimestamp(),
-                                                                           &currentUaItem.value.sourceTimestamp);
-            currentUaItem.value.hasSourceTimestamp = UA_TRUE;
+            UA_ReadResponse res;
+            UA_ReadResponse_init(&res);
+            res.responseHeader.serviceResult = result;
+            handleBatchReadResponse(context, &res);
+            continue;
         }
-        if (currentItem.serverTimestamp().isValid()) {
-            QOpen62541ValueConverter::scalarFromQt<UA_DateTime, QDateTime>(currentItem.serverTimestamp(),
-                                                                           &currentUaItem.value.serverTimestamp);
-            currentUaItem.value.hasServerTimestamp = UA_TRUE;
+
+        UA_ReadResponse res = UA_Client_Service_read(m_uaclient, req);
+        UaDeleter<UA_ReadResponse> responseDeleter(&res, UA_ReadResponse_deleteMembers);
+
+        handleBatchReadResponse(context, &res);
+    }
+
+    if (batch->pendingChunks)
+        return;
+
+    batch->finished = true;
+
+    if (batch->serviceResult != QOpcUa::UaStatusCode::Good)
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Batch read failed:" << batch->serviceResult;
+
+    // There is one result per item. The results of the chunks answered by the server are kept,
+    // the items of the failed chunk and of the chunks which have not been sent carry the service result.
+    if (batch->serviceResult != QOpcUa::UaStatusCode::Good) {
+        for (int i = 0; i < batch->results.size(); ++i) {
+            QOpcUaReadResult &result = batch->results[i];
+            if (result.nodeId().isEmpty()) {
+                result.setNodeId(batch->nodesToRead.at(i).nodeId());
+                result.setAttribute(batch->nodesToRead.at(i).attribute());
+                result.setIndexRange(batch->nodesToRead.at(i).indexRange());
+                result.setStatusCode(batch->serviceResult);
+            }
         }
     }
 
-    UA_WriteResponse res = UA_Client_Service_write(m_uaclient, req);
-    UaDeleter<UA_WriteResponse> responseDeleter(&res, UA_WriteResponse_deleteMembers);
+    if (batch->requestHandle)
+        emit valuesRead(batch->requestHandle, batch->results, batch->serviceResult);
+    else
+        emit readNodeAttributesFinished(batch->results, batch->serviceResult);
+}
+
+void Open62541AsyncBackend::handleBatchReadResponse(const AsyncBatchReadContext &context, const UA_ReadResponse *res)
+{
+    BatchRead &batch = *context.batch;
+    --batch.pendingChunks;
 
-    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode(res.responseHeader.serviceResult);
+    QOpcUa::UaStatusCode serviceResult = static_cast<QOpcUa::UaStatusCode>(res->responseHeader.serviceResult);
 
     if (serviceResult != QOpcUa::UaStatusCode::Good) {
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Batch write failed:" << serviceResult;
-        emit writeNodeAttributesFinished(QVector<QOpcUaWriteResult>(), serviceResult);
-    } else {
-        QVector<QOpcUaWriteResult> ret;
-
-        for (int i = 0; i < nodesToWrite.size(); ++i) {
-            QOpcUaWriteResult item;
-            item.setAttribute(nodesToWrite.at(i).attribute());
-            item.setNodeId(nodesToWrite.at(i).nodeId());
-            item.setIndexRange(nodesToWrite.at(i).indexRange());
-            if (static_cast<size_t>(i) < res.resultsSize)
-                item.setStatusCode(QOpcUa::UaStatusCode(res.results[i]));
+        // The first failed chunk determines the result of the entire batch
+        if (batch.serviceResult == QOpcUa::UaStatusCode::Good)
+            batch.serviceResult = serviceResult;
+        return;
+    }
+
+    for (int i = 0; i < context.count; ++i) {
+        const QOpcUaReadItem &request = batch.nodesToRead.at(context.offset + i);
+        QOpcUaReadResult &item = batch.results[context.offset + i];
+        item.setAttribute(request.attribute());
+        item.setNodeId(request.nodeId());
+        item.setIndexRange(request.indexRange());
+        if (static_cast<size_t>(i) < res->resultsSize) {
+            if (res->results[i].hasServerTimestamp)
+                item.setServerTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime>(&res->results[i].serverTimestamp));
+            if (res->results[i].hasSourceTimestamp)
+                item.setSourceTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime>(&res->results[i].sourceTimestamp));
+            // The response is released after it has been handled, array buffers can be moved out of it
+            if (res->results[i].hasValue)
+                item.setValue(QOpen62541ValueConverter::takeQVariant(&res->results[i].value, m_arrayConversion));
+            if (res->results[i].hasStatus)
+                item.setStatusCode(static_cast<QOpcUa::UaStatusCode>(res->results[i].status));
             else
                 item.setStatusCode(serviceResult);
-            ret.push_back(item);
+        } else {
+            item.setStatusCode(serviceResult);
         }
-        emit writeNodeAttributesFinished(ret, serviceResult);
     }
 }
 
-void Open62541AsyncBackend::addNode(const QOpcUaAddNodeItem &nodeToAdd)
+void Open62541AsyncBackend::writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite)
 {
-    UA_AddNodesRequest req;
-    UA_AddNodesRequest_init(&req);
-    UaDeleter<UA_AddNodesRequest> requestDeleter(&req, UA_AddNodesRequest_deleteMembers);
-    req.nodesToAddSize = 1;
-    req.nodesToAdd = UA_AddNodesItem_new();
-    UA_AddNodesItem_init(req.nodesToAdd);
+    if (nodesToWrite.isEmpty()) {
+        emit writeNodeAttributesFinished(QVector<QOpcUaWriteResult>(), QOpcUa::UaStatusCode::BadNothingToDo);
+        return;
+    }
 
-    QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
-                nodeToAdd.parentNodeId(), &req.nodesToAdd->parentNodeId);
+    auto batch = QSharedPointer<BatchWrite>::create();
+    batch->nodesToWrite = nodesToWrite;
+    batch->results.resize(nodesToWrite.size());
 
-    req.nodesToAdd->referenceTypeId = Open62541Utils::nodeIdFromQString(nodeToAdd.referenceTypeId());
+    continueBatchWrite(batch);
+}
 
-    QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
-                nodeToAdd.requestedNewNodeId(), &req.nodesToAdd->requestedNewNodeId);
+void Open62541AsyncBackend::writeValues(quint64 requestHandle, const QVector<QOpcUaWriteItem> &nodesToWrite)
+{
+    if (nodesToWrite.isEmpty()) {
+        emit valuesWritten(requestHandle, QVector<QOpcUaWriteResult>(), QOpcUa::UaStatusCode::BadNothingToDo);
+        return;
+    }
 
-    QOpen62541ValueConverter::scalarFromQt<UA_QualifiedName, QOpcUaQualifiedName>(
-                nodeToAdd.browseName(), &req.nodesToAdd->browseName);
+    auto batch = QSharedPointer<BatchWrite>::create();
+    batch->nodesToWrite = nodesToWrite;
+    batch->results.resize(nodesToWrite.size());
+    batch->requestHandle = requestHandle;
 
-    req.nodesToAdd->nodeClass = static_cast<UA_NodeClass>(nodeToAdd.nodeClass());
+    continueBatchWrite(batch);
+}
 
-    req.nodesToAdd->nodeAttributes = assembleNodeAttributes(nodeToAdd.nodeAttributes(),
-                                                            nodeToAdd.nodeClass());
+void Open62541AsyncBackend::continueBatchWrite(const QSharedPointer<BatchWrite> &batch)
+{
+    if (batch->finished)
+        return;
 
-    if (!nodeToAdd.typeDefinition().nodeId().isEmpty())
-        QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
-                    nodeToAdd.typeDefinition(), &req.nodesToAdd->typeDefinition);
+    const int totalSize = batch->nodesToWrite.size();
+    const int chunkSize = m_operationLimits.maxNodesPerWrite ? static_cast<int>(qMin<UA_UInt32>(m_operationLimits.maxNodesPerWrite, totalSize))
+                                                             : totalSize;
+
+    while (batch->serviceResult == QOpcUa::UaStatusCode::Good && batch->nextOffset < totalSize &&
+           batch->pendingChunks < maxBatchChunksInFlight) {
+        const AsyncBatchWriteContext context = {batch, batch->nextOffset, qMin(chunkSize, totalSize - batch->nextOffset)};
+        batch->nextOffset += context.count;
+        ++batch->pendingChunks;
+
+        UA_WriteRequest req;
+        UA_WriteRequest_init(&req);
+        UaDeleter<UA_WriteRequest> requestDeleter(&req, UA_WriteRequest_deleteMembers);
+
+        req.nodesToWriteSize = context.count;
+        req.nodesToWrite = static_cast<UA_WriteValue *>(UA_Array_new(context.count, &UA_TYPES[UA_TYPES_WRITEVALUE]));
+
+        for (int i = 0; i < context.count; ++i) {
+            const auto &currentItem = batch->nodesToWrite.at(context.offset + i);
+            auto &currentUaItem = req.nodesToWrite[i];
+            currentUaItem.attributeId = QOpen62541ValueConverter::toUaAttributeId(currentItem.attribute());
+            currentUaItem.nodeId = requestNodeId(currentItem.nodeId());
+            if (currentItem.hasStatusCode()) {
+                currentUaItem.value.status = currentItem.statusCode();
+                currentUaItem.value.hasStatus = UA_TRUE;
+            }
+            if (!currentItem.indexRange().isEmpty())
+                QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(currentItem.indexRange(), &currentUaItem.indexRange);
+            if (!currentItem.value().isNull()) {
+                currentUaItem.value.hasValue = true;
+                currentUaItem.value.value = QOpen62541ValueConverter::toOpen62541Variant(currentItem.value(), currentItem.type());
+            }
+            if (currentItem.sourceTimestamp().isValid()) {
+                QOpen62541ValueConverter::scalarFromQt<UA_DateTime, QDateTime>(currentItem.sourceTimestamp(),
+                                                                               &currentUaItem.value.sourceTimestamp);
+                currentUaItem.value.hasSourceTimestamp = UA_TRUE;
+            }
+            if (currentItem.serverTimestamp().isValid()) {
+                QOpen62541ValueConverter::scalarFromQt<UA_DateTime, QDateTime>(currentItem.serverTimestamp(),
+                                                                               &currentUaItem.value.serverTimestamp);
+                currentUaItem.value.hasServerTimestamp = UA_TRUE;
+            }
+        }
 
-    UA_AddNodesResponse res = UA_Client_Service_addNodes(m_uaclient, req);
-    UaDeleter<UA_AddNodesResponse> responseDeleter(&res, UA_AddNodesResponse_deleteMembers);
+        if (m_useAsyncServiceCalls) {
+            UA_UInt32 requestId = 0;
+            UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_WRITEREQUEST], &asyncBatchWriteCallback,
+                                                    &UA_TYPES[UA_TYPES_WRITERESPONSE], &requestId);
+            if (result == UA_STATUSCODE_GOOD) {
+                m_asyncBatchWriteContext[requestId] = context;
+                continue;
+            }
 
-    QOpcUa::UaStatusCode status = QOpcUa::UaStatusCode::Good;
-    QString resultId;
-    if (res.responseHeader.serviceResult == UA_STATUSCODE_GOOD) {
-        if (res.results[0].statusCode == UA_STATUSCODE_GOOD)
-            resultId = Open62541Utils::nodeIdToQString(res.results[0].addedNodeId);
-        else {
+            UA_WriteResponse res;
+            UA_WriteResponse_init(&res);
+            res.responseHeader.serviceResult = result;
+            handleBatchWriteResponse(context, &res);
+            continue;
+        }
+
+        UA_WriteResponse res = UA_Client_Service_write(m_uaclient, req);
+        UaDeleter<UA_WriteResponse> responseDeleter(&res, UA_WriteResponse_deleteMembers);
+
+        handleBatchWriteResponse(context, &res);
+    }
+
+    if (batch->pendingChunks)
+        return;
+
+    batch->finished = true;
+
+    if (batch->serviceResult != QOpcUa::UaStatusCode::Good)
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Batch write failed:" << batch->serviceResult;
+
+    // There is one result per item. The results of the chunks answered by the server are kept,
+    // the items of the failed chunk and of the chunks which have not been sent carry the service result.
+    if (batch->serviceResult != QOpcUa::UaStatusCode::Good) {
+        for (int i = 0; i < batch->results.size(); ++i) {
+            QOpcUaWriteResult &result = batch->results[i];
+            if (result.nodeId().isEmpty()) {
+                result.setNodeId(batch->nodesToWrite.at(i).nodeId());
+                result.setAttribute(batch->nodesToWrite.at(i).attribute());
+                result.setIndexRange(batch->nodesToWrite.at(i).indexRange());
+                result.setStatusCode(batch->serviceResult);
+            }
+        }
+    }
+
+    if (batch->requestHandle)
+        emit valuesWritten(batch->requestHandle, batch->results, batch->serviceResult);
+    else
+        emit writeNodeAttributesFinished(batch->results, batch->serviceResult);
+}
+
+void Open62541AsyncBackend::handleBatchWriteResponse(const AsyncBatchWriteContext &context, const UA_WriteResponse *res)
+{
+    BatchWrite &batch = *context.batch;
+    --batch.pendingChunks;
+
+    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode(res->responseHeader.serviceResult);
+
+    if (serviceResult != QOpcUa::UaStatusCode::Good) {
+        if (batch.serviceResult == QOpcUa::UaStatusCode::Good)
+            batch.serviceResult = serviceResult;
+        return;
+    }
+
+    for (int i = 0; i < context.count; ++i) {
+        const QOpcUaWriteItem &request = batch.nodesToWrite.at(context.offset + i);
+        QOpcUaWriteResult &item = batch.results[context.offset + i];
+        item.setAttribute(request.attribute());
+        item.setNodeId(request.nodeId());
+        item.setIndexRange(request.indexRange());
+        if (static_cast<size_t>(i) < res->resultsSize)
+            item.setStatusCode(QOpcUa::UaStatusCode(res->results[i]));
+        else
+            item.setStatusCode(serviceResult);
+    }
+}
+
+void Open62541AsyncBackend::callMethods(quint64 requestHandle, const QVector<QOpcUaCallMethodItem> &methodsToCall)
+{
+    if (methodsToCall.isEmpty()) {
+        emit callMethodsFinished(requestHandle, QVector<QOpcUaCallMethodResult>(), QOpcUa::UaStatusCode::BadNothingToDo);
+        return;
+    }
+
+    auto batch = QSharedPointer<BatchCall>::create();
+    batch->methodsToCall = methodsToCall;
+    batch->results.resize(methodsToCall.size());
+    batch->requestHandle = requestHandle;
+
+    continueBatchCall(batch);
+}
+
+void Open62541AsyncBackend::continueBatchCall(const QSharedPointer<BatchCall> &batch)
+{
+    if (batch->finished)
+        return;
+
+    const int totalSize = batch->methodsToCall.size();
+    const int chunkSize = m_operationLimits.maxNodesPerMethodCall
+            ? static_cast<int>(qMin<UA_UInt32>(m_operationLimits.maxNodesPerMethodCall, totalSize)) : totalSize;
+
+    while (batch->serviceResult == QOpcUa::UaStatusCode::Good && batch->nextOffset < totalSize &&
+           batch->pendingChunks < maxBatchChunksInFlight) {
+        const AsyncBatchCallContext context = {batch, batch->nextOffset, qMin(chunkSize, totalSize - batch->nextOffset)};
+        batch->nextOffset += context.count;
+        ++batch->pendingChunks;
+
+        UA_CallRequest req;
+        UA_CallRequest_init(&req);
+        UaDeleter<UA_CallRequest> requestDeleter(&req, UA_CallRequest_deleteMembers);
+
+        req.methodsToCallSize = context.count;
+        req.methodsToCall = static_cast<UA_CallMethodRequest *>(UA_Array_new(context.count, &UA_TYPES[UA_TYPES_CALLMETHODREQUEST]));
+
+        for (int i = 0; i < context.count; ++i) {
+            const auto &currentItem = batch->methodsToCall.at(context.offset + i);
+            auto &currentUaItem = req.methodsToCall[i];
+            currentUaItem.objectId = requestNodeId(currentItem.objectId());
+            currentUaItem.methodId = requestNodeId(currentItem.methodId());
+
+            const auto args = currentItem.inputArguments();
+            if (args.size()) {
+                currentUaItem.inputArguments = static_cast<UA_Variant *>(UA_Array_new(args.size(), &UA_TYPES[UA_TYPES_VARIANT]));
+                currentUaItem.inputArgumentsSize = args.size();
+                for (int j = 0; j < args.size(); ++j)
+                    currentUaItem.inputArguments[j] = QOpen62541ValueConverter::toOpen62541Variant(args[j].first, args[j].second);
+            }
+        }
+
+        if (m_useAsyncServiceCalls) {
+            UA_UInt32 requestId = 0;
+            UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_CALLREQUEST], &asyncBatchCallCallback,
+                                                    &UA_TYPES[UA_TYPES_CALLRESPONSE], &requestId);
+            if (result == UA_STATUSCODE_GOOD) {
+                m_asyncBatchCallContext[requestId] = context;
+                continue;
+            }
+
+            UA_CallResponse res;
+            UA_CallResponse_init(&res);
+            res.responseHeader.serviceResult = result;
+            handleBatchCallResponse(context, &res);
+            continue;
+        }
+
+        UA_CallResponse res = UA_Client_Service_call(m_uaclient, req);
+        UaDeleter<UA_CallResponse> responseDeleter(&res, UA_CallResponse_deleteMembers);
+
+        handleBatchCallResponse(context, &res);
+    }
+
+    if (batch->pendingChunks)
+        return;
+
+    batch->finished = true;
+
+    // Calls which have not been answered because of a failed chunk carry the service result
+    if (batch->serviceResult != QOpcUa::UaStatusCode::Good) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Batch call failed:" << batch->serviceResult;
+        for (int i = 0; i < batch->results.size(); ++i) {
+            QOpcUaCallMethodResult &result = batch->results[i];
+            if (result.methodId().isEmpty()) {
+                result.setObjectId(batch->methodsToCall.at(i).objectId());
+                result.setMethodId(batch->methodsToCall.at(i).methodId());
+                result.setStatusCode(batch->serviceResult);
+            }
+        }
+    }
+
+    emit callMethodsFinished(batch->requestHandle, batch->results, batch->serviceResult);
+}
+
+void Open62541AsyncBackend::handleBatchCallResponse(const AsyncBatchCallContext &context, const UA_CallResponse *res)
+{
+    BatchCall &batch = *context.batch;
+    --batch.pendingChunks;
+
+    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode(res->responseHeader.serviceResult);
+
+    if (serviceResult != QOpcUa::UaStatusCode::Good) {
+        if (batch.serviceResult == QOpcUa::UaStatusCode::Good)
+            batch.serviceResult = serviceResult;
+        return;
+    }
+
+    for (int i = 0; i < context.count; ++i) {
+        const QOpcUaCallMethodItem &request = batch.methodsToCall.at(context.offset + i);
+        QOpcUaCallMethodResult &item = batch.results[context.offset + i];
+        item.setObjectId(request.objectId());
+        item.setMethodId(request.methodId());
+
+        if (static_cast<size_t>(i) >= res->resultsSize) {
+            item.setStatusCode(QOpcUa::UaStatusCode::BadUnexpectedError);
+            continue;
+        }
+
+        const UA_CallMethodResult &uaResult = res->results[i];
+        item.setStatusCode(QOpcUa::UaStatusCode(uaResult.statusCode));
+
+        QVariantList outputArguments;
+        outputArguments.reserve(static_cast<int>(uaResult.outputArgumentsSize));
+        for (size_t j = 0; j < uaResult.outputArgumentsSize; ++j)
+            outputArguments.append(QOpen62541ValueConverter::toQVariant(uaResult.outputArguments[j], m_arrayConversion));
+        item.setOutputArguments(outputArguments);
+
+        if (uaResult.inputArgumentResultsSize) {
+            QVector<QOpcUa::UaStatusCode> inputArgumentResults;
+            inputArgumentResults.reserve(static_cast<int>(uaResult.inputArgumentResultsSize));
+            for (size_t j = 0; j < uaResult.inputArgumentResultsSize; ++j)
+                inputArgumentResults.append(QOpcUa::UaStatusCode(uaResult.inputArgumentResults[j]));
+            item.setInputArgumentResults(inputArgumentResults);
+        }
+    }
+}
+
+void Open62541AsyncBackend::readOperationLimits()
+{
+    m_operationLimits = OperationLimits();
+
+    const struct {
+        UA_UInt32 nodeId;
+        UA_UInt32 *target;
+    } limits[] = {
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERREAD, &m_operationLimits.maxNodesPerRead},
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERWRITE, &m_operationLimits.maxNodesPerWrite},
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERBROWSE, &m_operationLimits.maxNodesPerBrowse},
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_MAXBROWSECONTINUATIONPOINTS, &m_operationLimits.maxBrowseContinuationPoints},
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXMONITOREDITEMSPERCALL, &m_operationLimits.maxMonitoredItemsPerCall},
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERHISTORYREADDATA, &m_operationLimits.maxNodesPerHistoryReadData},
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_MAXHISTORYCONTINUATIONPOINTS, &m_operationLimits.maxHistoryContinuationPoints},
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERREGISTERNODES, &m_operationLimits.maxNodesPerRegisterNodes},
+        {UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERMETHODCALL, &m_operationLimits.maxNodesPerMethodCall}
+    };
+    const size_t limitsSize = sizeof(limits) / sizeof(limits[0]);
+
+    UA_ReadRequest req;
+    UA_ReadRequest_init(&req);
+    UaDeleter<UA_ReadRequest> requestDeleter(&req, UA_ReadRequest_deleteMembers);
+    req.nodesToReadSize = limitsSize;
+    req.nodesToRead = static_cast<UA_ReadValueId *>(UA_Array_new(limitsSize, &UA_TYPES[UA_TYPES_READVALUEID]));
+    for (size_t i = 0; i < limitsSize; ++i) {
+        req.nodesToRead[i].nodeId = UA_NODEID_NUMERIC(0, limits[i].nodeId);
+        req.nodesToRead[i].attributeId = UA_ATTRIBUTEID_VALUE;
+    }
+
+    UA_ReadResponse res = UA_Client_Service_read(m_uaclient, req);
+    UaDeleter<UA_ReadResponse> responseDeleter(&res, UA_ReadResponse_deleteMembers);
+
+    if (res.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Could not read the operation limits of the server:"
+                                            << static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
+        return;
+    }
+
+    // Servers are not required to expose the operation limits, missing values mean there is no limit
+    for (size_t i = 0; i < limitsSize && i < res.resultsSize; ++i) {
+        if (!res.results[i].hasValue)
+            continue;
+        if (UA_Variant_hasScalarType(&res.results[i].value, &UA_TYPES[UA_TYPES_UINT32]))
+            *limits[i].target = *static_cast<UA_UInt32 *>(res.results[i].value.data);
+        else if (UA_Variant_hasScalarType(&res.results[i].value, &UA_TYPES[UA_TYPES_UINT16]))
+            *limits[i].target = *static_cast<UA_UInt16 *>(res.results[i].value.data);
+    }
+
+    qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Operation limits: MaxNodesPerRead" << m_operationLimits.maxNodesPerRead
+                                        << "MaxNodesPerWrite" << m_operationLimits.maxNodesPerWrite
+                                        << "MaxNodesPerBrowse" << m_operationLimits.maxNodesPerBrowse
+                                        << "MaxBrowseContinuationPoints" << m_operationLimits.maxBrowseContinuationPoints
+                                        << "MaxMonitoredItemsPerCall" << m_operationLimits.maxMonitoredItemsPerCall
+                                        << "MaxNodesPerHistoryReadData" << m_operationLimits.maxNodesPerHistoryReadData
+                                        << "MaxHistoryContinuationPoints" << m_operationLimits.maxHistoryContinuationPoints
+                                        << "MaxNodesPerRegisterNodes" << m_operationLimits.maxNodesPerRegisterNodes
+                                        << "MaxNodesPerMethodCall" << m_operationLimits.maxNodesPerMethodCall;
+}
+
+void Open62541AsyncBackend::registerNodes(const QStringList &nodeIds)
+{
+    QStringList registeredNodeIds;
+    const QOpcUa::UaStatusCode statusCode = sendRegisterNodes(nodeIds, &registeredNodeIds);
+    emit registerNodesFinished(nodeIds, registeredNodeIds, statusCode);
+}
+
+void Open62541AsyncBackend::unregisterNodes(const QStringList &nodeIds)
+{
+    // The nodes are forgotten even if the request fails, the server drops the registrations with the session anyway
+    QVector<UA_NodeId> registeredIds;
+    int knownNodes = 0;
+
+    for (const auto &nodeId : nodeIds) {
+        UA_NodeId id = Open62541Utils::nodeIdFromQString(nodeId);
+        UaDeleter<UA_NodeId> nodeIdDeleter(&id, UA_NodeId_deleteMembers);
+
+        const auto it = m_registeredNodes.find(Open62541Utils::nodeIdToQString(id));
+        if (it == m_registeredNodes.end())
+            continue;
+        ++knownNodes;
+        if (!UA_NodeId_isNull(&it.value()))
+            registeredIds.push_back(it.value());
+        m_registeredNodes.erase(it);
+    }
+
+    const auto idDeleter = qScopeGuard([&registeredIds]() {
+        for (auto &id : registeredIds)
+            UA_NodeId_deleteMembers(&id);
+    });
+
+    if (!knownNodes) {
+        emit unregisterNodesFinished(nodeIds, QOpcUa::UaStatusCode::BadNothingToDo);
+        return;
+    }
+
+    QOpcUa::UaStatusCode statusCode = QOpcUa::UaStatusCode::Good;
+    const int totalSize = registeredIds.size();
+    const int chunkSize = m_operationLimits.maxNodesPerRegisterNodes
+            ? static_cast<int>(qMin<UA_UInt32>(m_operationLimits.maxNodesPerRegisterNodes, totalSize)) : totalSize;
+
+    for (int offset = 0; m_uaclient && offset < totalSize; offset += chunkSize) {
+        // The request only borrows the node ids, they are released by the scope guard
+        UA_UnregisterNodesRequest req;
+        UA_UnregisterNodesRequest_init(&req);
+        req.nodesToUnregister = registeredIds.data() + offset;
+        req.nodesToUnregisterSize = qMin(chunkSize, totalSize - offset);
+
+        UA_UnregisterNodesResponse res = UA_Client_Service_unregisterNodes(m_uaclient, req);
+        UaDeleter<UA_UnregisterNodesResponse> responseDeleter(&res, UA_UnregisterNodesResponse_deleteMembers);
+
+        if (res.responseHeader.serviceResult != UA_STATUSCODE_GOOD && statusCode == QOpcUa::UaStatusCode::Good)
+            statusCode = static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
+    }
+
+    if (statusCode != QOpcUa::UaStatusCode::Good)
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to unregister nodes:" << statusCode;
+
+    emit unregisterNodesFinished(nodeIds, statusCode);
+}
+
+QOpcUa::UaStatusCode Open62541AsyncBackend::sendRegisterNodes(const QStringList &nodeIds, QStringList *registeredNodeIds)
+{
+    if (nodeIds.isEmpty())
+        return QOpcUa::UaStatusCode::BadNothingToDo;
+
+    if (!m_uaclient)
+        return QOpcUa::UaStatusCode::BadServerNotConnected;
+
+    const int totalSize = nodeIds.size();
+    const int chunkSize = m_operationLimits.maxNodesPerRegisterNodes
+            ? static_cast<int>(qMin<UA_UInt32>(m_operationLimits.maxNodesPerRegisterNodes, totalSize)) : totalSize;
+
+    for (int offset = 0; offset < totalSize; offset += chunkSize) {
+        const int count = qMin(chunkSize, totalSize - offset);
+
+        UA_RegisterNodesRequest req;
+        UA_RegisterNodesRequest_init(&req);
+        UaDeleter<UA_RegisterNodesRequest> requestDeleter(&req, UA_RegisterNodesRequest_deleteMembers);
+        req.nodesToRegisterSize = count;
+        req.nodesToRegister = static_cast<UA_NodeId *>(UA_Array_new(count, &UA_TYPES[UA_TYPES_NODEID]));
+
+        // The registrations are stored with the normalized node id string to match the ids of QOpcUaNode
+        QStringList keys;
+        keys.reserve(count);
+
+        for (int i = 0; i < count; ++i) {
+            // Always register the original node id, never the id assigned by a previous registration
+            req.nodesToRegister[i] = Open62541Utils::nodeIdFromQString(nodeIds.at(offset + i));
+            if (UA_NodeId_isNull(&req.nodesToRegister[i]))
+                return QOpcUa::UaStatusCode::BadNodeIdInvalid;
+            keys.push_back(Open62541Utils::nodeIdToQString(req.nodesToRegister[i]));
+        }
+
+        UA_RegisterNodesResponse res = UA_Client_Service_registerNodes(m_uaclient, req);
+        UaDeleter<UA_RegisterNodesResponse> responseDeleter(&res, UA_RegisterNodesResponse_deleteMembers);
+
+        if (res.responseHeader.serviceResult != UA_STATUSCODE_GOOD)
+            return static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
+
+        if (res.registeredNodeIdsSize != static_cast<size_t>(count))
+            return QOpcUa::UaStatusCode::BadUnexpectedError;
+
+        for (int i = 0; i < count; ++i) {
+            auto it = m_registeredNodes.find(keys.at(i));
+            if (it == m_registeredNodes.end())
+                it = m_registeredNodes.insert(keys.at(i), UA_NODEID_NULL);
+            else
+                UA_NodeId_deleteMembers(&it.value());
+
+            // The response is released after it has been handled, the node id can be moved out of it
+            it.value() = res.registeredNodeIds[i];
+            UA_NodeId_init(&res.registeredNodeIds[i]);
+            registeredNodeIds->push_back(Open62541Utils::nodeIdToQString(it.value()));
+        }
+    }
+
+    return QOpcUa::UaStatusCode::Good;
+}
+
+void Open62541AsyncBackend::reregisterNodes()
+{
+    if (m_registeredNodes.isEmpty())
+        return;
+
+    const QStringList nodeIds = m_registeredNodes.keys();
+    QStringList registeredNodeIds;
+    const QOpcUa::UaStatusCode statusCode = sendRegisterNodes(nodeIds, &registeredNodeIds);
+
+    if (statusCode != QOpcUa::UaStatusCode::Good)
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to restore the registered nodes:" << statusCode;
+
+    emit registerNodesFinished(nodeIds, registeredNodeIds, statusCode);
+}
+
+void Open62541AsyncBackend::invalidateRegisteredNodes()
+{
+    for (auto &registeredId : m_registeredNodes) {
+        UA_NodeId_deleteMembers(&registeredId);
+        registeredId = UA_NODEID_NULL;
+    }
+}
+
+UA_NodeId Open62541AsyncBackend::requestNodeId(const QString &nodeId)
+{
+    // Node id strings in a different notation than the normalized one are sent unchanged
+    if (!m_registeredNodes.isEmpty()) {
+        const auto it = m_registeredNodes.constFind(nodeId);
+        if (it != m_registeredNodes.constEnd() && !UA_NodeId_isNull(&it.value())) {
+            UA_NodeId result;
+            UA_NodeId_copy(&it.value(), &result);
+            return result;
+        }
+    }
+
+    return m_nodeIdCache.nodeId(nodeId);
+}
+
+void Open62541AsyncBackend::useRegisteredNodeId(UA_NodeId *id) const
+{
+    if (m_registeredNodes.isEmpty())
+        return;
+
+    const auto it = m_registeredNodes.constFind(Open62541Utils::nodeIdToQString(*id));
+    if (it == m_registeredNodes.constEnd() || UA_NodeId_isNull(&it.value()))
+        return;
+
+    UA_NodeId_deleteMembers(id);
+    UA_NodeId_copy(&it.value(), id);
+}
+
+void Open62541AsyncBackend::addNode(const QOpcUaAddNodeItem &nodeToAdd)
+{
+    UA_AddNodesRequest req;
+    UA_AddNodesRequest_init(&req);
+    UaDeleter<UA_AddNodesRequest> requestDeleter(&req, UA_AddNodesRequest_deleteMembers);
+    req.nodesToAddSize = 1;
+    req.nodesToAdd = UA_AddNodesItem_new();
+    UA_AddNodesItem_init(req.nodesToAdd);
+
+    QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
+                nodeToAdd.parentNodeId(), &req.nodesToAdd->parentNodeId);
+
+    req.nodesToAdd->referenceTypeId = Open62541Utils::nodeIdFromQString(nodeToAdd.referenceTypeId());
+
+    QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
+                nodeToAdd.requestedNewNodeId(), &req.nodesToAdd->requestedNewNodeId);
+
+    QOpen62541ValueConverter::scalarFromQt<UA_QualifiedName, QOpcUaQualifiedName>(
+                nodeToAdd.browseName(), &req.nodesToAdd->browseName);
+
+    req.nodesToAdd->nodeClass = static_cast<UA_NodeClass>(nodeToAdd.nodeClass());
+
+    req.nodesToAdd->nodeAttributes = assembleNodeAttributes(nodeToAdd.nodeAttributes(),
+                                                            nodeToAdd.nodeClass());
+
+    if (!nodeToAdd.typeDefinition().nodeId().isEmpty())
+        QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
+                    nodeToAdd.typeDefinition(), &req.nodesToAdd->typeDefinition);
+
+    UA_AddNodesResponse res = UA_Client_Service_addNodes(m_uaclient, req);
+    UaDeleter<UA_AddNodesResponse> responseDeleter(&res, UA_AddNodesResponse_deleteMembers);
+
+    QOpcUa::UaStatusCode status = QOpcUa::UaStatusCode::Good;
+    QString resultId;
+    if (res.responseHeader.serviceResult == UA_STATUSCODE_GOOD) {
+        if (res.results[0].statusCode == UA_STATUSCODE_GOOD)
+            resultId = Open62541Utils::nodeIdToQString(res.results[0].addedNodeId);
+        else {
             status = static_cast<QOpcUa::UaStatusCode>(res.results[0].statusCode);
             qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to add node:" << status;
         }
-    } else {
-        status = static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
-        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to add node:" << status;
+    } else {
+        status = static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to add node:" << status;
+    }
+
+    emit addNodeFinished(nodeToAdd.requestedNewNodeId(), resultId, status);
+}
+
+void Open62541AsyncBackend::deleteNode(const QString &nodeId, bool deleteTargetReferences)
+{
+    UA_NodeId id = Open62541Utils::nodeIdFromQString(nodeId);
+    UaDeleter<UA_NodeId> nodeIdDeleter(&id, UA_NodeId_deleteMembers);
+
+    UA_StatusCode res = UA_Client_deleteNode(m_uaclient, id, deleteTargetReferences);
+
+    QOpcUa::UaStatusCode resultStatus = static_cast<QOpcUa::UaStatusCode>(res);
+
+    if (resultStatus != QOpcUa::UaStatusCode::Good) {
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to delete node" << nodeId << "with status code" << resultStatus;
+    }
+
+    emit deleteNodeFinished(nodeId, resultStatus);
+}
+
+void Open62541AsyncBackend::addReference(const QOpcUaAddReferenceItem &referenceToAdd)
+{
+    UA_ExpandedNodeId target;
+    UA_ExpandedNodeId_init(&target);
+    UaDeleter<UA_ExpandedNodeId> nodeIdDeleter(&target, UA_ExpandedNodeId_deleteMembers);
+
+    QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
+                referenceToAdd.targetNodeId(), &target);
+
+    UA_String serverUri;
+    UaDeleter<UA_String> serverUriDeleter(&serverUri, UA_String_deleteMembers);
+    QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(
+                referenceToAdd.targetServerUri(), &serverUri);
+
+    UA_NodeClass nodeClass = static_cast<UA_NodeClass>(referenceToAdd.targetNodeClass());
+
+    UA_StatusCode res = UA_Client_addReference(m_uaclient,
+                                               Open62541Utils::nodeIdFromQString(referenceToAdd.sourceNodeId()),
+                                               Open62541Utils::nodeIdFromQString(referenceToAdd.referenceTypeId()),
+                                               referenceToAdd.isForwardReference(), serverUri, target, nodeClass);
+
+    QOpcUa::UaStatusCode statusCode = static_cast<QOpcUa::UaStatusCode>(res);
+    if (res != UA_STATUSCODE_GOOD)
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to add reference from" << referenceToAdd.sourceNodeId() << "to"
+                                            << referenceToAdd.targetNodeId().nodeId() << ":" << statusCode;
+
+    emit addReferenceFinished(referenceToAdd.sourceNodeId(), referenceToAdd.referenceTypeId(),
+                              referenceToAdd.targetNodeId(),
+                              referenceToAdd.isForwardReference(), statusCode);
+}
+
+void Open62541AsyncBackend::deleteReference(const QOpcUaDeleteReferenceItem &referenceToDelete)
+{
+    UA_ExpandedNodeId target;
+    UA_ExpandedNodeId_init(&target);
+    UaDeleter<UA_ExpandedNodeId> targetDeleter(&target, UA_ExpandedNodeId_deleteMembers);
+    QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
+                referenceToDelete.targetNodeId(), &target);
+
+    UA_StatusCode res = UA_Client_deleteReference(m_uaclient,
+                                                  Open62541Utils::nodeIdFromQString(referenceToDelete.sourceNodeId()),
+                                                  Open62541Utils::nodeIdFromQString(referenceToDelete.referenceTypeId()),
+                                                  referenceToDelete.isForwardReference(),
+                                                  target, referenceToDelete.deleteBidirectional());
+
+    QOpcUa::UaStatusCode statusCode = static_cast<QOpcUa::UaStatusCode>(res);
+    if (res != UA_STATUSCODE_GOOD)
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to delete reference from" << referenceToDelete.sourceNodeId() << "to"
+                                            << referenceToDelete.targetNodeId().nodeId() << ":" << statusCode;
+
+    emit deleteReferenceFinished(referenceToDelete.sourceNodeId(), referenceToDelete.referenceTypeId(),
+                                 referenceToDelete.targetNodeId(),
+                                 referenceToDelete.isForwardReference(), statusCode);
+}
+
+static void convertBrowseResult(UA_BrowseResult *src, quint32 referencesSize, QVector<QOpcUaReferenceDescription> &dst)
+{
+    if (!src)
+        return;
+
+    for (size_t i = 0; i < referencesSize; ++i) {
+        QOpcUaReferenceDescription temp;
+        temp.setTargetNodeId(QOpen62541ValueConverter::scalarToQt<QOpcUaExpandedNodeId>(&src->references[i].nodeId));
+        temp.setTypeDefinition(QOpen62541ValueConverter::scalarToQt<QOpcUaExpandedNodeId>(&src->references[i].typeDefinition));
+        temp.setRefTypeId(Open62541Utils::nodeIdToQString(src->references[i].referenceTypeId));
+        temp.setNodeClass(static_cast<QOpcUa::NodeClass>(src->references[i].nodeClass));
+        temp.setBrowseName(QOpen62541ValueConverter::scalarToQt<QOpcUaQualifiedName, UA_QualifiedName>(&src->references[i].browseName));
+        temp.setDisplayName(QOpen62541ValueConverter::scalarToQt<QOpcUaLocalizedText, UA_LocalizedText>(&src->references[i].displayName));
+        temp.setIsForwardReference(src->references[i].isForward);
+        dst.push_back(temp);
+    }
+}
+
+static void prepareBrowseNextRequest(UA_BrowseNextRequest *request, const UA_ByteString *continuationPoint)
+{
+    UA_BrowseNextRequest_init(request);
+    request->continuationPoints = UA_ByteString_new();
+    UA_ByteString_copy(continuationPoint, request->continuationPoints);
+    request->continuationPointsSize = 1;
+}
+
+void Open62541AsyncBackend::browse(quint64 handle, UA_NodeId id, const QOpcUaBrowseRequest &request)
+{
+    UA_BrowseRequest uaRequest;
+    UA_BrowseRequest_init(&uaRequest);
+    UaDeleter<UA_BrowseRequest> requestDeleter(&uaRequest, UA_BrowseRequest_deleteMembers);
+
+    uaRequest.nodesToBrowse = UA_BrowseDescription_new();
+    uaRequest.nodesToBrowseSize = 1;
+    uaRequest.nodesToBrowse->browseDirection = static_cast<UA_BrowseDirection>(request.browseDirection());
+    uaRequest.nodesToBrowse->includeSubtypes = request.includeSubtypes();
+    uaRequest.nodesToBrowse->nodeClassMask = static_cast<quint32>(request.nodeClassMask());
+    uaRequest.nodesToBrowse->nodeId = id;
+    uaRequest.nodesToBrowse->resultMask = UA_BROWSERESULTMASK_ALL;
+    uaRequest.nodesToBrowse->referenceTypeId = Open62541Utils::nodeIdFromQString(request.referenceTypeId());
+    uaRequest.requestedMaxReferencesPerNode = 0; // Let the server choose a maximum value
+
+    AsyncBrowseContext context = {handle, QVector<QOpcUaReferenceDescription>(), QOpcUa::UaStatusCode::Good};
+
+    if (m_useAsyncServiceCalls) {
+        UA_UInt32 requestId = 0;
+        UA_StatusCode result = sendAsyncRequest(&uaRequest, &UA_TYPES[UA_TYPES_BROWSEREQUEST], &asyncBrowseCallback,
+                                                &UA_TYPES[UA_TYPES_BROWSERESPONSE], &requestId);
+        if (result == UA_STATUSCODE_GOOD)
+            m_asyncBrowseContext[requestId] = context;
+        else
+            emit browseFinished(handle, QVector<QOpcUaReferenceDescription>(), static_cast<QOpcUa::UaStatusCode>(result));
+        return;
+    }
+
+    UA_BrowseResponse *response = UA_BrowseResponse_new();
+    UaDeleter<UA_BrowseResponse> responseDeleter(response, UA_BrowseResponse_delete);
+    *response = UA_Client_Service_browse(m_uaclient, uaRequest);
+
+    while (handleBrowseResponse(context, response)) {
+        UA_BrowseNextRequest nextReq;
+        prepareBrowseNextRequest(&nextReq, &response->results->continuationPoint);
+        UaDeleter<UA_BrowseNextRequest> nextReqDeleter(&nextReq, UA_BrowseNextRequest_deleteMembers);
+        UA_BrowseResponse_deleteMembers(response); // Deallocate the pointer members before overwriting the response
+        *reinterpret_cast<UA_BrowseNextResponse *>(response) = UA_Client_Service_browseNext(m_uaclient, nextReq);
+    }
+
+    emit browseFinished(handle, context.results, context.statusCode);
+}
+
+bool Open62541AsyncBackend::handleBrowseResponse(AsyncBrowseContext &context, const UA_BrowseResponse *res)
+{
+    if (res->responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+        context.statusCode = static_cast<QOpcUa::UaStatusCode>(res->responseHeader.serviceResult);
+        return false;
+    }
+
+    if (!res->resultsSize)
+        return false;
+
+    if (res->results->statusCode != UA_STATUSCODE_GOOD) {
+        context.statusCode = static_cast<QOpcUa::UaStatusCode>(res->results->statusCode);
+        return false;
+    }
+
+    convertBrowseResult(res->results, res->results->referencesSize, context.results);
+
+    // The caller must continue with a BrowseNext request if there is a continuation point
+    return res->results->continuationPoint.length > 0;
+}
+
+void Open62541AsyncBackend::browseNodes(quint64 requestHandle, const QStringList &nodeIds, const QOpcUaBrowseRequest &request,
+                                        quint32 requestedMaxReferencesPerNode)
+{
+    auto batch = QSharedPointer<BatchBrowse>::create();
+    batch->requestHandle = requestHandle;
+    batch->nodeIds = nodeIds;
+    batch->request = request;
+    batch->requestedMaxReferencesPerNode = requestedMaxReferencesPerNode;
+
+    continueBatchBrowse(batch);
+}
+
+void Open62541AsyncBackend::continueBatchBrowse(const QSharedPointer<BatchBrowse> &batch)
+{
+    const int totalSize = batch->nodeIds.size();
+    int chunkSize = m_operationLimits.maxNodesPerBrowse ? static_cast<int>(qMin<UA_UInt32>(m_operationLimits.maxNodesPerBrowse, totalSize))
+                                                        : totalSize;
+    int maxChunksInFlight = maxBatchChunksInFlight;
+
+    // Each node which has more references than fit into one response occupies a continuation point on the server.
+    // Concurrent chunks would compete for the few continuation points a session may hold.
+    if (batch->requestedMaxReferencesPerNode && m_operationLimits.maxBrowseContinuationPoints) {
+        chunkSize = qMin(chunkSize, static_cast<int>(m_operationLimits.maxBrowseContinuationPoints));
+        maxChunksInFlight = 1;
+    }
+
+    while (batch->abortStatus == QOpcUa::UaStatusCode::Good && (!batch->retryIndices.isEmpty() || batch->nextOffset < totalSize) &&
+           batch->pendingChunks < maxChunksInFlight) {
+        AsyncBatchBrowseContext context = {batch, QVector<int>()};
+        while (context.nodeIndices.size() < chunkSize && !batch->retryIndices.isEmpty())
+            context.nodeIndices.push_back(batch->retryIndices.takeFirst());
+        while (context.nodeIndices.size() < chunkSize && batch->nextOffset < totalSize)
+            context.nodeIndices.push_back(batch->nextOffset++);
+        const int count = context.nodeIndices.size();
+
+        UA_BrowseRequest req;
+        UA_BrowseRequest_init(&req);
+        UaDeleter<UA_BrowseRequest> requestDeleter(&req, UA_BrowseRequest_deleteMembers);
+        req.requestedMaxReferencesPerNode = batch->requestedMaxReferencesPerNode;
+        req.nodesToBrowseSize = count;
+        req.nodesToBrowse = static_cast<UA_BrowseDescription *>(UA_Array_new(count, &UA_TYPES[UA_TYPES_BROWSEDESCRIPTION]));
+
+        for (int i = 0; i < count; ++i) {
+            auto &description = req.nodesToBrowse[i];
+            description.browseDirection = static_cast<UA_BrowseDirection>(batch->request.browseDirection());
+            description.includeSubtypes = batch->request.includeSubtypes();
+            description.nodeClassMask = static_cast<quint32>(batch->request.nodeClassMask());
+            description.nodeId = m_nodeIdCache.nodeId(batch->nodeIds.at(context.nodeIndices.at(i)));
+            description.resultMask = UA_BROWSERESULTMASK_ALL;
+            description.referenceTypeId = m_nodeIdCache.nodeId(batch->request.referenceTypeId());
+        }
+
+        ++batch->pendingChunks;
+
+        if (m_useAsyncServiceCalls) {
+            UA_UInt32 requestId = 0;
+            UA_StatusCode result = sendAsyncRequest(&req, &UA_TYPES[UA_TYPES_BROWSEREQUEST], &asyncBatchBrowseCallback,
+                                                    &UA_TYPES[UA_TYPES_BROWSERESPONSE], &requestId);
+            if (result == UA_STATUSCODE_GOOD) {
+                m_asyncBatchBrowseContext[requestId] = context;
+                continue;
+            }
+
+            UA_BrowseResponse res;
+            UA_BrowseResponse_init(&res);
+            res.responseHeader.serviceResult = result;
+            handleBatchBrowseResponse(context, &res, nullptr);
+            continue;
+        }
+
+        UA_BrowseResponse res = UA_Client_Service_browse(m_uaclient, req);
+        UA_BrowseNextRequest nextReq;
+        bool browseNext = handleBatchBrowseResponse(context, &res, &nextReq);
+        UA_BrowseResponse_deleteMembers(&res);
+
+        while (browseNext) {
+            *reinterpret_cast<UA_BrowseNextResponse *>(&res) = UA_Client_Service_browseNext(m_uaclient, nextReq);
+            UA_BrowseNextRequest_deleteMembers(&nextReq);
+            browseNext = handleBatchBrowseResponse(context, &res, &nextReq);
+            UA_BrowseResponse_deleteMembers(&res);
+        }
+    }
+
+    if (batch->abortStatus != QOpcUa::UaStatusCode::Good) {
+        // Nodes which have not been sent to the server yet will never be browsed
+        for (int index : qExchange(batch->retryIndices, {}))
+            emit browseNodesFinished(batch->requestHandle, batch->nodeIds.at(index), batch->partialResults.take(index),
+                                     batch->abortStatus);
+        for (; batch->nextOffset < totalSize; ++batch->nextOffset)
+            emit browseNodesFinished(batch->requestHandle, batch->nodeIds.at(batch->nextOffset), QVector<QOpcUaReferenceDescription>(),
+                                     batch->abortStatus);
+    }
+}
+
+bool Open62541AsyncBackend::handleBatchBrowseResponse(AsyncBatchBrowseContext &context, const UA_BrowseResponse *res,
+                                                      UA_BrowseNextRequest *nextRequest)
+{
+    BatchBrowse &batch = *context.batch;
+
+    const auto finishNode = [&](int index, QOpcUa::UaStatusCode statusCode) {
+        emit browseNodesFinished(batch.requestHandle, batch.nodeIds.at(index), batch.partialResults.take(index), statusCode);
+    };
+
+    if (res->responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+        const auto statusCode = static_cast<QOpcUa::UaStatusCode>(res->responseHeader.serviceResult);
+        for (int index : qAsConst(context.nodeIndices))
+            finishNode(index, statusCode);
+        --batch.pendingChunks;
+        // The connection is most probably unusable, the remaining nodes are not sent to the server
+        if (res->responseHeader.serviceResult == UA_STATUSCODE_BADSERVERNOTCONNECTED ||
+                res->responseHeader.serviceResult == UA_STATUSCODE_BADSHUTDOWN ||
+                res->responseHeader.serviceResult == UA_STATUSCODE_BADCONNECTIONCLOSED)
+            batch.abortStatus = statusCode;
+        return false;
+    }
+
+    QVector<int> continuedIndices;
+    QVector<const UA_ByteString *> continuationPoints;
+    QVector<int> noContinuationPointIndices;
+    bool progress = false;
+
+    for (int i = 0; i < context.nodeIndices.size(); ++i) {
+        const int index = context.nodeIndices.at(i);
+
+        if (static_cast<size_t>(i) >= res->resultsSize) {
+            finishNode(index, QOpcUa::UaStatusCode::BadInternalError);
+            continue;
+        }
+
+        UA_BrowseResult *result = &res->results[i];
+
+        if (result->statusCode == UA_STATUSCODE_BADNOCONTINUATIONPOINTS) {
+            noContinuationPointIndices.push_back(index);
+            continue;
+        }
+
+        progress = true;
+        convertBrowseResult(result, result->referencesSize, batch.partialResults[index]);
+
+        if (result->statusCode != UA_STATUSCODE_GOOD) {
+            finishNode(index, static_cast<QOpcUa::UaStatusCode>(result->statusCode));
+        } else if (result->continuationPoint.length > 0 && nextRequest) {
+            continuedIndices.push_back(index);
+            continuationPoints.push_back(&result->continuationPoint);
+        } else {
+            finishNode(index, QOpcUa::UaStatusCode::Good);
+        }
+    }
+
+    // Nodes which did not get a continuation point are browsed again after other nodes have released theirs.
+    // If no node has made progress, the continuation points are held by someone else and the nodes fail.
+    for (int index : qAsConst(noContinuationPointIndices)) {
+        if (progress && batch.abortStatus == QOpcUa::UaStatusCode::Good)
+            batch.retryIndices.push_back(index);
+        else
+            finishNode(index, QOpcUa::UaStatusCode::BadNoContinuationPoints);
+    }
+
+    if (continuedIndices.isEmpty()) {
+        --batch.pendingChunks;
+        return false;
+    }
+
+    // The continuation points of all nodes of this chunk are used in one shared BrowseNext request
+    UA_BrowseNextRequest_init(nextRequest);
+    nextRequest->continuationPointsSize = continuationPoints.size();
+    nextRequest->continuationPoints = static_cast<UA_ByteString *>(UA_Array_new(continuationPoints.size(), &UA_TYPES[UA_TYPES_BYTESTRING]));
+    for (int i = 0; i < continuationPoints.size(); ++i)
+        UA_ByteString_copy(continuationPoints.at(i), &nextRequest->continuationPoints[i]);
+
+    context.nodeIndices = continuedIndices;
+    return true;
+}
+
+void Open62541AsyncBackend::readHistoryData(quint64 handle, const QOpcUaHistoryReadRequest &request)
+{
+    auto historyRead = QSharedPointer<HistoryRead>::create();
+    historyRead->handle = handle;
+    historyRead->request = request;
+    m_historyReads.insert(handle, historyRead);
+
+    continueHistoryRead(historyRead);
+}
+
+void Open62541AsyncBackend::acknowledgeHistoryData(quint64 handle)
+{
+    const auto historyRead = m_historyReads.value(handle);
+    if (!historyRead)
+        return;
+
+    historyRead->unacknowledgedPages = qMax(0, historyRead->unacknowledgedPages - 1);
+    continueHistoryRead(historyRead);
+}
+
+void Open62541AsyncBackend::abortHistoryRead(quint64 handle)
+{
+    const auto historyRead = m_historyReads.value(handle);
+    if (!historyRead || historyRead->abortStatus != QOpcUa::UaStatusCode::Good)
+        return;
+
+    historyRead->abortStatus = QOpcUa::UaStatusCode::BadRequestCancelledByClient;
+    continueHistoryRead(historyRead);
+}
+
+void Open62541AsyncBackend::continueHistoryRead(const QSharedPointer<HistoryRead> &historyRead)
+{
+    if (historyRead->finished)
+        return;
+
+    const int totalSize = historyRead->request.nodeIds().size();
+    const int chunkSize = m_operationLimits.maxNodesPerHistoryReadData
+            ? static_cast<int>(qMin<UA_UInt32>(m_operationLimits.maxNodesPerHistoryReadData, totalSize)) : qMax(1, totalSize);
+    // Each started node may hold a continuation point on the server until its last page has been read
+    const int maxActiveNodes = m_operationLimits.maxHistoryContinuationPoints
+            ? static_cast<int>(m_operationLimits.maxHistoryContinuationPoints) : totalSize;
+    const int maxPagesInFlight = historyRead->request.maxPagesInFlight();
+
+    while (historyRead->abortStatus == QOpcUa::UaStatusCode::Good &&
+           historyRead->pendingPages + historyRead->unacknowledgedPages < maxPagesInFlight) {
+        QVector<int> nodeIndices;
+        // Started nodes are continued first, this releases their continuation points as early as possible
+        while (nodeIndices.size() < chunkSize && !historyRead->continuedIndices.isEmpty())
+            nodeIndices.push_back(historyRead->continuedIndices.takeFirst());
+        while (nodeIndices.size() < chunkSize && historyRead->nextOffset < totalSize && historyRead->activeNodes < maxActiveNodes) {
+            nodeIndices.push_back(historyRead->nextOffset++);
+            ++historyRead->activeNodes;
+        }
+
+        if (nodeIndices.isEmpty())
+            break;
+
+        sendHistoryReadRequest(historyRead, nodeIndices, false);
+    }
+
+    if (historyRead->abortStatus != QOpcUa::UaStatusCode::Good) {
+        // The server keeps the continuation points of a cancelled read until they are released or the session is closed
+        const QVector<int> continuedIndices = qExchange(historyRead->continuedIndices, {});
+        if (historyRead->abortStatus == QOpcUa::UaStatusCode::BadRequestCancelledByClient) {
+            for (int offset = 0; offset < continuedIndices.size(); offset += chunkSize)
+                sendHistoryReadRequest(historyRead, continuedIndices.mid(offset, chunkSize), true);
+        }
+        historyRead->continuationPoints.clear();
+    }
+
+    const bool allNodesStarted = historyRead->nextOffset >= totalSize || historyRead->abortStatus != QOpcUa::UaStatusCode::Good;
+    if (historyRead->pendingPages == 0 && historyRead->continuedIndices.isEmpty() && allNodesStarted) {
+        historyRead->finished = true;
+        m_historyReads.remove(historyRead->handle);
+        emit historyReadFinished(historyRead->handle, historyRead->abortStatus);
+    }
+}
+
+UA_ExtensionObject Open62541AsyncBackend::createHistoryReadDetails(const QOpcUaHistoryReadRequest &request, int nodeCount)
+{
+    namespace ht = QOpen62541HistoryTypes;
+    namespace vc = QOpen62541ValueConverter;
+
+    UA_ExtensionObject details;
+    UA_ExtensionObject_init(&details);
+    details.encoding = UA_EXTENSIONOBJECT_DECODED;
+
+    switch (request.readType()) {
+    case QOpcUaHistoryReadRequest::ReadType::Raw:
+    case QOpcUaHistoryReadRequest::ReadType::Modified: {
+        const UA_DataType *type = &ht::types[ht::ReadRawModifiedDetailsType];
+        auto data = static_cast<ht::ReadRawModifiedDetails *>(UA_new(type));
+        data->isReadModified = request.readType() == QOpcUaHistoryReadRequest::ReadType::Modified;
+        vc::scalarFromQt<UA_DateTime, QDateTime>(request.startTime(), &data->startTime);
+        vc::scalarFromQt<UA_DateTime, QDateTime>(request.endTime(), &data->endTime);
+        data->numValuesPerNode = request.numValuesPerNode();
+        data->returnBounds = request.returnBounds();
+        details.content.decoded.type = type;
+        details.content.decoded.data = data;
+        break;
+    }
+    case QOpcUaHistoryReadRequest::ReadType::Processed: {
+        const UA_DataType *type = &ht::types[ht::ReadProcessedDetailsType];
+        auto data = static_cast<ht::ReadProcessedDetails *>(UA_new(type));
+        vc::scalarFromQt<UA_DateTime, QDateTime>(request.startTime(), &data->startTime);
+        vc::scalarFromQt<UA_DateTime, QDateTime>(request.endTime(), &data->endTime);
+        data->processingInterval = request.processingInterval();
+        // One aggregate for each node to read
+        data->aggregateTypeSize = nodeCount;
+        data->aggregateType = static_cast<UA_NodeId *>(UA_Array_new(nodeCount, &UA_TYPES[UA_TYPES_NODEID]));
+        for (int i = 0; i < nodeCount; ++i)
+            data->aggregateType[i] = m_nodeIdCache.nodeId(request.aggregateType());
+        data->aggregateConfiguration.useServerCapabilitiesDefaults = true;
+        details.content.decoded.type = type;
+        details.content.decoded.data = data;
+        break;
+    }
+    case QOpcUaHistoryReadRequest::ReadType::AtTime: {
+        const UA_DataType *type = &ht::types[ht::ReadAtTimeDetailsType];
+        auto data = static_cast<ht::ReadAtTimeDetails *>(UA_new(type));
+        const QVector<QDateTime> requestedTimes = request.requestedTimes();
+        data->reqTimesSize = requestedTimes.size();
+        data->reqTimes = static_cast<UA_DateTime *>(UA_Array_new(requestedTimes.size(), &UA_TYPES[UA_TYPES_DATETIME]));
+        for (int i = 0; i < requestedTimes.size(); ++i)
+            vc::scalarFromQt<UA_DateTime, QDateTime>(requestedTimes.at(i), &data->reqTimes[i]);
+        data->useSimpleBounds = request.useSimpleBounds();
+        details.content.decoded.type = type;
+        details.content.decoded.data = data;
+        break;
+    }
+    }
+
+    return details;
+}
+
+void Open62541AsyncBackend::sendHistoryReadRequest(const QSharedPointer<HistoryRead> &historyRead, const QVector<int> &nodeIndices,
+                                                   bool release)
+{
+    namespace ht = QOpen62541HistoryTypes;
+    const UA_DataType *requestType = &ht::types[ht::HistoryReadRequestType];
+    const UA_DataType *responseType = &ht::types[ht::HistoryReadResponseType];
+
+    const QStringList nodeIds = historyRead->request.nodeIds();
+    const int count = nodeIndices.size();
+
+    ht::HistoryReadRequest req;
+    UA_init(&req, requestType);
+    UaDeleter<ht::HistoryReadRequest> requestDeleter(&req, [requestType](ht::HistoryReadRequest *value) {
+        UA_clear(value, requestType);
+    });
+    req.historyReadDetails = createHistoryReadDetails(historyRead->request, count);
+    req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+    req.releaseContinuationPoints = release;
+    req.nodesToReadSize = count;
+    req.nodesToRead = static_cast<ht::HistoryReadValueId *>(UA_Array_new(count, &ht::types[ht::HistoryReadValueIdType]));
+
+    for (int i = 0; i < count; ++i) {
+        const int index = nodeIndices.at(i);
+        req.nodesToRead[i].nodeId = requestNodeId(nodeIds.at(index));
+        const QByteArray continuationPoint = historyRead->continuationPoints.take(index);
+        if (!continuationPoint.isEmpty() && UA_ByteString_allocBuffer(&req.nodesToRead[i].continuationPoint,
+                                                                      continuationPoint.size()) == UA_STATUSCODE_GOOD)
+            std::memcpy(req.nodesToRead[i].continuationPoint.data, continuationPoint.constData(), continuationPoint.size());
+    }
+
+    ++historyRead->pendingPages;
+    const AsyncHistoryReadContext context = {historyRead, nodeIndices, release};
+
+    ht::HistoryReadResponse res;
+    UA_init(&res, responseType);
+
+    if (m_useAsyncServiceCalls) {
+        UA_UInt32 requestId = 0;
+        UA_StatusCode result = sendAsyncRequest(&req, requestType, &asyncHistoryReadCallback, responseType, &requestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            m_asyncHistoryReadContext[requestId] = context;
+            return;
+        }
+        res.responseHeader.serviceResult = result;
+    } else if (m_uaclient) {
+        __UA_Client_Service(m_uaclient, &req, requestType, &res, responseType);
+    } else {
+        res.responseHeader.serviceResult = UA_STATUSCODE_BADSERVERNOTCONNECTED;
+    }
+
+    handleHistoryReadResponse(context, &res);
+    UA_clear(&res, responseType);
+}
+
+void Open62541AsyncBackend::handleHistoryReadResponse(const AsyncHistoryReadContext &context,
+                                                      QOpen62541HistoryTypes::HistoryReadResponse *res)
+{
+    HistoryRead &historyRead = *context.historyRead;
+    --historyRead.pendingPages;
+
+    // The results of a request which releases the continuation points contain no data
+    if (context.release)
+        return;
+
+    const UA_StatusCode serviceResult = res->responseHeader.serviceResult;
+
+    // The connection is most probably unusable, the remaining pages are not requested
+    if (serviceResult == UA_STATUSCODE_BADSERVERNOTCONNECTED || serviceResult == UA_STATUSCODE_BADSHUTDOWN ||
+            serviceResult == UA_STATUSCODE_BADCONNECTIONCLOSED) {
+        if (historyRead.abortStatus == QOpcUa::UaStatusCode::Good)
+            historyRead.abortStatus = static_cast<QOpcUa::UaStatusCode>(serviceResult);
+    }
+
+    const bool deliver = historyRead.abortStatus == QOpcUa::UaStatusCode::Good;
+    const QStringList nodeIds = historyRead.request.nodeIds();
+    QVector<QOpcUaHistoryData> page;
+    if (deliver)
+        page.reserve(context.nodeIndices.size());
+
+    for (int i = 0; i < context.nodeIndices.size(); ++i) {
+        const int index = context.nodeIndices.at(i);
+
+        UA_StatusCode statusCode = serviceResult;
+        QOpen62541HistoryTypes::HistoryReadResult *result = nullptr;
+        if (serviceResult == UA_STATUSCODE_GOOD) {
+            if (static_cast<size_t>(i) < res->resultsSize) {
+                result = &res->results[i];
+                statusCode = result->statusCode;
+            } else {
+                statusCode = UA_STATUSCODE_BADINTERNALERROR;
+            }
+        }
+
+        // Uncertain results may carry a continuation point, bad results end the read of the node
+        const bool isBad = (statusCode & 0x80000000) != 0;
+        const bool lastPage = isBad || !result || result->continuationPoint.length == 0;
+
+        if (lastPage) {
+            --historyRead.activeNodes;
+        } else {
+            historyRead.continuationPoints.insert(index, QByteArray(reinterpret_cast<const char *>(result->continuationPoint.data),
+                                                                    static_cast<int>(result->continuationPoint.length)));
+            historyRead.continuedIndices.push_back(index);
+        }
+
+        if (!deliver)
+            continue;
+
+        QOpcUaHistoryData data;
+        data.setNodeId(nodeIds.at(index));
+        data.setLastPage(lastPage);
+
+        if (result) {
+            size_t valueCount = 0;
+            UA_DataValue *values = QOpen62541HistoryTypes::dataValues(&result->historyData, &valueCount);
+
+            if (!values && !isBad && (result->historyData.encoding == UA_EXTENSIONOBJECT_ENCODED_BYTESTRING ||
+                                      result->historyData.encoding == UA_EXTENSIONOBJECT_ENCODED_XML))
+                statusCode = UA_STATUSCODE_BADDATAENCODINGUNSUPPORTED;
+
+            QVector<QOpcUaReadResult> converted;
+            converted.reserve(static_cast<int>(valueCount));
+            for (size_t j = 0; j < valueCount; ++j) {
+                UA_DataValue &value = values[j];
+                QOpcUaReadResult item;
+                item.setNodeId(data.nodeId());
+                item.setAttribute(QOpcUa::NodeAttribute::Value);
+                if (value.hasServerTimestamp)
+                    item.setServerTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime>(&value.serverTimestamp));
+                if (value.hasSourceTimestamp)
+                    item.setSourceTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime>(&value.sourceTimestamp));
+                // The response is released after it has been handled, array buffers can be moved out of it
+                if (value.hasValue)
+                    item.setValue(QOpen62541ValueConverter::takeQVariant(&value.value, m_arrayConversion));
+                item.setStatusCode(value.hasStatus ? static_cast<QOpcUa::UaStatusCode>(value.status) : QOpcUa::UaStatusCode::Good);
+                converted.push_back(item);
+            }
+            data.setValues(converted);
+        }
+
+        data.setStatusCode(static_cast<QOpcUa::UaStatusCode>(statusCode));
+        page.push_back(data);
     }
 
-    emit addNodeFinished(nodeToAdd.requestedNewNodeId(), resultId, status);
+    if (deliver) {
+        ++historyRead.unacknowledgedPages;
+        emit historyDataReceived(historyRead.handle, page);
+    }
 }
 
-void Open62541AsyncBackend::deleteNode(const QString &nodeId, bool deleteTargetReferences)
+void Open62541AsyncBackend::abortHistoryReads(UA_StatusCode statusCode)
 {
-    UA_NodeId id = Open62541Utils::nodeIdFromQString(nodeId);
-    UaDeleter<UA_NodeId> nodeIdDeleter(&id, UA_NodeId_deleteMembers);
+    const auto historyReadContexts = qExchange(m_asyncHistoryReadContext, {});
+    for (const auto &context : historyReadContexts) {
+        QOpen62541HistoryTypes::HistoryReadResponse res;
+        UA_init(&res, &QOpen62541HistoryTypes::types[QOpen62541HistoryTypes::HistoryReadResponseType]);
+        res.responseHeader.serviceResult = statusCode;
+        handleHistoryReadResponse(context, &res);
+    }
 
-    UA_StatusCode res = UA_Client_deleteNode(m_uaclient, id, deleteTargetReferences);
+    // The continuation points are gone with the session, history reads waiting for an acknowledgement are finished too
+    const auto historyReads = m_historyReads;
+    for (const auto &historyRead : historyReads) {
+        if (historyRead->abortStatus == QOpcUa::UaStatusCode::Good)
+            historyRead->abortStatus = static_cast<QOpcUa::UaStatusCode>(statusCode);
+        historyRead->continuedIndices.clear();
+        historyRead->continuationPoints.clear();
+        continueHistoryRead(historyRead);
+    }
+}
 
-    QOpcUa::UaStatusCode resultStatus = static_cast<QOpcUa::UaStatusCode>(res);
+UA_StatusCode Open62541AsyncBackend::sendAsyncRequest(const void *request, const UA_DataType *requestType,
+                                                      UA_ClientAsyncServiceCallback callback,
+                                                      const UA_DataType *responseType, UA_UInt32 *requestId)
+{
+    if (!m_uaclient)
+        return UA_STATUSCODE_BADSERVERNOTCONNECTED;
 
-    if (resultStatus != QOpcUa::UaStatusCode::Good) {
-        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to delete node" << nodeId << "with status code" << resultStatus;
+    UA_StatusCode result = __UA_Client_AsyncService(m_uaclient, request, requestType, callback, responseType, this, requestId);
+
+    if (result != UA_STATUSCODE_GOOD) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to send asynchronous service request:" << UA_StatusCode_name(result);
+        return result;
     }
 
-    emit deleteNodeFinished(nodeId, resultStatus);
+    // The responses are received by UA_Client_run_iterate(), make sure it is called until all requests have been answered.
+    // This function may be called from inside UA_Client_run_iterate(), the timer defers the next iteration.
+    m_sendPublishRequests = true;
+    if (!m_subscriptionTimer.isActive())
+        m_subscriptionTimer.start(0);
+
+    return result;
 }
 
-void Open62541AsyncBackend::addReference(const QOpcUaAddReferenceItem &referenceToAdd)
+bool Open62541AsyncBackend::hasPendingAsyncRequests() const
 {
-    UA_ExpandedNodeId target;
-    UA_ExpandedNodeId_init(&target);
-    UaDeleter<UA_ExpandedNodeId> nodeIdDeleter(&target, UA_ExpandedNodeId_deleteMembers);
+    return !m_asyncReadContext.isEmpty() || !m_asyncWriteAttributesContext.isEmpty() || !m_asyncBrowseContext.isEmpty() ||
+            !m_asyncCallMethodContext.isEmpty() || !m_asyncTranslateContext.isEmpty() || !m_asyncBatchReadContext.isEmpty() ||
+            !m_asyncBatchWriteContext.isEmpty() || !m_asyncCoalescedReadContext.isEmpty() || !m_asyncBatchBrowseContext.isEmpty() ||
+            !m_asyncHistoryReadContext.isEmpty() || !m_asyncBatchCallContext.isEmpty();
+}
 
-    QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
-                referenceToAdd.targetNodeId(), &target);
+void Open62541AsyncBackend::abortAsyncRequests(UA_StatusCode statusCode)
+{
+    // Finish all requests which will never be answered with an empty response carrying the status code.
+    // This is the same behavior as in open62541 for cancelled requests.
+    const auto readContexts = qExchange(m_asyncReadContext, {});
+    for (const auto &context : readContexts) {
+        UA_ReadResponse res;
+        UA_ReadResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleReadResponse(context, &res);
+    }
 
-    UA_String serverUri;
-    UaDeleter<UA_String> serverUriDeleter(&serverUri, UA_String_deleteMembers);
-    QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(
-                referenceToAdd.targetServerUri(), &serverUri);
+    const auto writeContexts = qExchange(m_asyncWriteAttributesContext, {});
+    for (const auto &context : writeContexts) {
+        UA_WriteResponse res;
+        UA_WriteResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleWriteAttributesResponse(context, &res);
+    }
 
-    UA_NodeClass nodeClass = static_cast<UA_NodeClass>(referenceToAdd.targetNodeClass());
+    const auto browseContexts = qExchange(m_asyncBrowseContext, {});
+    for (const auto &context : browseContexts)
+        emit browseFinished(context.handle, context.results, static_cast<QOpcUa::UaStatusCode>(statusCode));
 
-    UA_StatusCode res = UA_Client_addReference(m_uaclient,
-                                               Open62541Utils::nodeIdFromQString(referenceToAdd.sourceNodeId()),
-                                               Open62541Utils::nodeIdFromQString(referenceToAdd.referenceTypeId()),
-                                               referenceToAdd.isForwardReference(), serverUri, target, nodeClass);
+    const auto callContexts = qExchange(m_asyncCallMethodContext, {});
+    for (const auto &context : callContexts) {
+        UA_CallResponse res;
+        UA_CallResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleCallMethodResponse(context, &res);
+    }
 
-    QOpcUa::UaStatusCode statusCode = static_cast<QOpcUa::UaStatusCode>(res);
-    if (res != UA_STATUSCODE_GOOD)
-        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to add reference from" << referenceToAdd.sourceNodeId() << "to"
-                                            << referenceToAdd.targetNodeId().nodeId() << ":" << statusCode;
+    const auto translateContexts = qExchange(m_asyncTranslateContext, {});
+    for (const auto &context : translateContexts) {
+        UA_TranslateBrowsePathsToNodeIdsResponse res;
+        UA_TranslateBrowsePathsToNodeIdsResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleTranslateBrowsePathResponse(context, &res);
+    }
 
-    emit addReferenceFinished(referenceToAdd.sourceNodeId(), referenceToAdd.referenceTypeId(),
-                              referenceToAdd.targetNodeId(),
-                              referenceToAdd.isForwardReference(), statusCode);
+    const auto coalescedReadContexts = qExchange(m_asyncCoalescedReadContext, {});
+    for (const auto &context : coalescedReadContexts) {
+        UA_ReadResponse res;
+        UA_ReadResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleCoalescedReadResponse(context, &res);
+    }
+
+    const auto batchReadContexts = qExchange(m_asyncBatchReadContext, {});
+    for (const auto &context : batchReadContexts) {
+        UA_ReadResponse res;
+        UA_ReadResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleBatchReadResponse(context, &res);
+        continueBatchRead(context.batch);
+    }
+
+    const auto batchWriteContexts = qExchange(m_asyncBatchWriteContext, {});
+    for (const auto &context : batchWriteContexts) {
+        UA_WriteResponse res;
+        UA_WriteResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleBatchWriteResponse(context, &res);
+        continueBatchWrite(context.batch);
+    }
+
+    const auto batchCallContexts = qExchange(m_asyncBatchCallContext, {});
+    for (const auto &context : batchCallContexts) {
+        UA_CallResponse res;
+        UA_CallResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleBatchCallResponse(context, &res);
+        continueBatchCall(context.batch);
+    }
+
+    auto batchBrowseContexts = qExchange(m_asyncBatchBrowseContext, {});
+    for (auto &context : batchBrowseContexts) {
+        UA_BrowseResponse res;
+        UA_BrowseResponse_init(&res);
+        res.responseHeader.serviceResult = statusCode;
+        handleBatchBrowseResponse(context, &res, nullptr);
+        context.batch->abortStatus = static_cast<QOpcUa::UaStatusCode>(statusCode);
+        continueBatchBrowse(context.batch);
+    }
+
+    abortHistoryReads(statusCode);
 }
 
-void Open62541AsyncBackend::deleteReference(const QOpcUaDeleteReferenceItem &referenceToDelete)
+void Open62541AsyncBackend::asyncReadCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
 {
-    UA_ExpandedNodeId target;
-    UA_ExpandedNodeId_init(&target);
-    UaDeleter<UA_ExpandedNodeId> targetDeleter(&target, UA_ExpandedNodeId_deleteMembers);
-    QOpen62541ValueConverter::scalarFromQt<UA_ExpandedNodeId, QOpcUaExpandedNodeId>(
-                referenceToDelete.targetNodeId(), &target);
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
 
-    UA_StatusCode res = UA_Client_deleteReference(m_uaclient,
-                                                  Open62541Utils::nodeIdFromQString(referenceToDelete.sourceNodeId()),
-                                                  Open62541Utils::nodeIdFromQString(referenceToDelete.referenceTypeId()),
-                                                  referenceToDelete.isForwardReference(),
-                                                  target, referenceToDelete.deleteBidirectional());
+    auto it = backend->m_asyncReadContext.find(requestId);
+    if (it == backend->m_asyncReadContext.end())
+        return;
 
-    QOpcUa::UaStatusCode statusCode = static_cast<QOpcUa::UaStatusCode>(res);
-    if (res != UA_STATUSCODE_GOOD)
-        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to delete reference from" << referenceToDelete.sourceNodeId() << "to"
-                                            << referenceToDelete.targetNodeId().nodeId() << ":" << statusCode;
+    const auto context = it.value();
+    backend->m_asyncReadContext.erase(it);
 
-    emit deleteReferenceFinished(referenceToDelete.sourceNodeId(), referenceToDelete.referenceTypeId(),
-                                 referenceToDelete.targetNodeId(),
-                                 referenceToDelete.isForwardReference(), statusCode);
+    backend->handleReadResponse(context, static_cast<UA_ReadResponse *>(response));
 }
 
-static void convertBrowseResult(UA_BrowseResult *src, quint32 referencesSize, QVector<QOpcUaReferenceDescription> &dst)
+void Open62541AsyncBackend::asyncWriteAttributesCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
 {
-    if (!src)
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
+
+    auto it = backend->m_asyncWriteAttributesContext.find(requestId);
+    if (it == backend->m_asyncWriteAttributesContext.end())
         return;
 
-    for (size_t i = 0; i < referencesSize; ++i) {
-        QOpcUaReferenceDescription temp;
-        temp.setTargetNodeId(QOpen62541ValueConverter::scalarToQt<QOpcUaExpandedNodeId>(&src->references[i].nodeId));
-        temp.setTypeDefinition(QOpen62541ValueConverter::scalarToQt<QOpcUaExpandedNodeId>(&src->references[i].typeDefinition));
-        temp.setRefTypeId(Open62541Utils::nodeIdToQString(src->references[i].referenceTypeId));
-        temp.setNodeClass(static_cast<QOpcUa::NodeClass>(src->references[i].nodeClass));
-        temp.setBrowseName(QOpen62541ValueConverter::scalarToQt<QOpcUaQualifiedName, UA_QualifiedName>(&src->references[i].browseName));
-        temp.setDisplayName(QOpen62541ValueConverter::scalarToQt<QOpcUaLocalizedText, UA_LocalizedText>(&src->references[i].displayName));
-        temp.setIsForwardReference(src->references[i].isForward);
-        dst.push_back(temp);
+    const auto context = it.value();
+    backend->m_asyncWriteAttributesContext.erase(it);
+
+    backend->handleWriteAttributesResponse(context, static_cast<UA_WriteResponse *>(response));
+}
+
+void Open62541AsyncBackend::asyncBrowseCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
+{
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
+
+    auto it = backend->m_asyncBrowseContext.find(requestId);
+    if (it == backend->m_asyncBrowseContext.end())
+        return;
+
+    auto context = it.value();
+    backend->m_asyncBrowseContext.erase(it);
+
+    // BrowseResponse and BrowseNextResponse have the same memory layout
+    UA_BrowseResponse *res = static_cast<UA_BrowseResponse *>(response);
+
+    if (backend->handleBrowseResponse(context, res)) {
+        UA_BrowseNextRequest nextReq;
+        prepareBrowseNextRequest(&nextReq, &res->results->continuationPoint);
+        UaDeleter<UA_BrowseNextRequest> nextReqDeleter(&nextReq, UA_BrowseNextRequest_deleteMembers);
+
+        UA_UInt32 nextRequestId = 0;
+        UA_StatusCode result = backend->sendAsyncRequest(&nextReq, &UA_TYPES[UA_TYPES_BROWSENEXTREQUEST], &asyncBrowseCallback,
+                                                         &UA_TYPES[UA_TYPES_BROWSENEXTRESPONSE], &nextRequestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            backend->m_asyncBrowseContext[nextRequestId] = context;
+            return;
+        }
+        context.statusCode = static_cast<QOpcUa::UaStatusCode>(result);
     }
+
+    emit backend->browseFinished(context.handle, context.results, context.statusCode);
 }
 
-void Open62541AsyncBackend::browse(quint64 handle, UA_NodeId id, const QOpcUaBrowseRequest &request)
+void Open62541AsyncBackend::asyncCallMethodCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
 {
-    UA_BrowseRequest uaRequest;
-    UA_BrowseRequest_init(&uaRequest);
-    UaDeleter<UA_BrowseRequest> requestDeleter(&uaRequest, UA_BrowseRequest_deleteMembers);
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
 
-    uaRequest.nodesToBrowse = UA_BrowseDescription_new();
-    uaRequest.nodesToBrowseSize = 1;
-    uaRequest.nodesToBrowse->browseDirection = static_cast<UA_BrowseDirection>(request.browseDirection());
-    uaRequest.nodesToBrowse->includeSubtypes = request.includeSubtypes();
-    uaRequest.nodesToBrowse->nodeClassMask = static_cast<quint32>(request.nodeClassMask());
-    uaRequest.nodesToBrowse->nodeId = id;
-    uaRequest.nodesToBrowse->resultMask = UA_BROWSERESULTMASK_ALL;
-    uaRequest.nodesToBrowse->referenceTypeId = Open62541Utils::nodeIdFromQString(request.referenceTypeId());
-    uaRequest.requestedMaxReferencesPerNode = 0; // Let the server choose a maximum value
+    auto it = backend->m_asyncCallMethodContext.find(requestId);
+    if (it == backend->m_asyncCallMethodContext.end())
+        return;
 
-    UA_BrowseResponse *response = UA_BrowseResponse_new();
-    UaDeleter<UA_BrowseResponse> responseDeleter(response, UA_BrowseResponse_delete);
-    *response = UA_Client_Service_browse(m_uaclient, uaRequest);
+    const auto context = it.value();
+    backend->m_asyncCallMethodContext.erase(it);
 
-    QVector<QOpcUaReferenceDescription> ret;
+    backend->handleCallMethodResponse(context, static_cast<UA_CallResponse *>(response));
+}
 
-    QOpcUa::UaStatusCode statusCode = QOpcUa::UaStatusCode::Good;
+void Open62541AsyncBackend::asyncTranslateBrowsePathCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
+{
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
 
-    while (response->resultsSize && statusCode == QOpcUa::UaStatusCode::Good) {
-        UA_BrowseResponse *res = static_cast<UA_BrowseResponse *>(response);
+    auto it = backend->m_asyncTranslateContext.find(requestId);
+    if (it == backend->m_asyncTranslateContext.end())
+        return;
 
-        if (res->responseHeader.serviceResult != UA_STATUSCODE_GOOD || res->results->statusCode != UA_STATUSCODE_GOOD) {
-            statusCode = static_cast<QOpcUa::UaStatusCode>(res->results->statusCode);
-            break;
-        }
+    const auto context = it.value();
+    backend->m_asyncTranslateContext.erase(it);
+
+    backend->handleTranslateBrowsePathResponse(context, static_cast<UA_TranslateBrowsePathsToNodeIdsResponse *>(response));
+}
+
+void Open62541AsyncBackend::asyncCoalescedReadCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
+{
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
+
+    auto it = backend->m_asyncCoalescedReadContext.find(requestId);
+    if (it == backend->m_asyncCoalescedReadContext.end())
+        return;
+
+    const auto context = it.value();
+    backend->m_asyncCoalescedReadContext.erase(it);
+
+    backend->handleCoalescedReadResponse(context, static_cast<UA_ReadResponse *>(response));
+}
+
+void Open62541AsyncBackend::asyncBatchReadCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
+{
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
+
+    auto it = backend->m_asyncBatchReadContext.find(requestId);
+    if (it == backend->m_asyncBatchReadContext.end())
+        return;
+
+    const auto context = it.value();
+    backend->m_asyncBatchReadContext.erase(it);
+
+    backend->handleBatchReadResponse(context, static_cast<UA_ReadResponse *>(response));
+    backend->continueBatchRead(context.batch);
+}
 
-        convertBrowseResult(res->results, res->results->referencesSize, ret);
+void Open62541AsyncBackend::asyncBatchBrowseCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
+{
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
+
+    auto it = backend->m_asyncBatchBrowseContext.find(requestId);
+    if (it == backend->m_asyncBatchBrowseContext.end())
+        return;
 
-        if (res->results->continuationPoint.length) {
-            UA_BrowseNextRequest nextReq;
-            UA_BrowseNextRequest_init(&nextReq);
-            UaDeleter<UA_BrowseNextRequest> nextReqDeleter(&nextReq, UA_BrowseNextRequest_deleteMembers);
-            nextReq.continuationPoints = UA_ByteString_new();
-            UA_ByteString_copy(&(res->results->continuationPoint), nextReq.continuationPoints);
-            nextReq.continuationPointsSize = 1;
-            UA_BrowseResponse_deleteMembers(res); // Deallocate the pointer members before overwriting the response
-            *reinterpret_cast<UA_BrowseNextResponse *>(response) = UA_Client_Service_browseNext(m_uaclient, nextReq);
+    auto context = it.value();
+    backend->m_asyncBatchBrowseContext.erase(it);
+
+    // BrowseNext responses have the same layout as browse responses
+    UA_BrowseNextRequest nextReq;
+    if (backend->handleBatchBrowseResponse(context, static_cast<UA_BrowseResponse *>(response), &nextReq)) {
+        UaDeleter<UA_BrowseNextRequest> nextReqDeleter(&nextReq, UA_BrowseNextRequest_deleteMembers);
+        UA_UInt32 nextRequestId = 0;
+        UA_StatusCode result = backend->sendAsyncRequest(&nextReq, &UA_TYPES[UA_TYPES_BROWSENEXTREQUEST], &asyncBatchBrowseCallback,
+                                                         &UA_TYPES[UA_TYPES_BROWSENEXTRESPONSE], &nextRequestId);
+        if (result == UA_STATUSCODE_GOOD) {
+            backend->m_asyncBatchBrowseContext[nextRequestId] = context;
         } else {
-            break;
+            UA_BrowseResponse res;
+            UA_BrowseResponse_init(&res);
+            res.responseHeader.serviceResult = result;
+            backend->handleBatchBrowseResponse(context, &res, nullptr);
         }
     }
 
-    emit browseFinished(handle, ret, statusCode);
+    backend->continueBatchBrowse(context.batch);
+}
+
+void Open62541AsyncBackend::asyncHistoryReadCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
+{
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
+
+    auto it = backend->m_asyncHistoryReadContext.find(requestId);
+    if (it == backend->m_asyncHistoryReadContext.end())
+        return;
+
+    const auto context = it.value();
+    backend->m_asyncHistoryReadContext.erase(it);
+
+    backend->handleHistoryReadResponse(context, static_cast<QOpen62541HistoryTypes::HistoryReadResponse *>(response));
+    backend->continueHistoryRead(context.historyRead);
+}
+
+void Open62541AsyncBackend::asyncBatchWriteCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
+{
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
+
+    auto it = backend->m_asyncBatchWriteContext.find(requestId);
+    if (it == backend->m_asyncBatchWriteContext.end())
+        return;
+
+    const auto context = it.value();
+    backend->m_asyncBatchWriteContext.erase(it);
+
+    backend->handleBatchWriteResponse(context, static_cast<UA_WriteResponse *>(response));
+    backend->continueBatchWrite(context.batch);
+}
+
+void Open62541AsyncBackend::asyncBatchCallCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response)
+{
+    Q_UNUSED(client);
+    Open62541AsyncBackend *backend = static_cast<Open62541AsyncBackend *>(userdata);
+
+    auto it = backend->m_asyncBatchCallContext.find(requestId);
+    if (it == backend->m_asyncBatchCallContext.end())
+        return;
+
+    const auto context = it.value();
+    backend->m_asyncBatchCallContext.erase(it);
+
+    backend->handleBatchCallResponse(context, static_cast<UA_CallResponse *>(response));
+    backend->continueBatchCall(context.batch);
+}
+
+// open62541 does not expose the socket of the client connection.
+// The default connection function is wrapped to obtain it for the socket notifier.
+static thread_local UA_SOCKET lastConnectedSocket = UA_INVALID_SOCKET;
+
+static UA_Connection connectClientConnection(UA_ConnectionConfig config, UA_String endpointUrl,
+                                             UA_UInt32 timeout, UA_Logger *logger)
+{
+    UA_Connection connection = UA_ClientConnectionTCP(config, endpointUrl, timeout, logger);
+    lastConnectedSocket = connection.sockfd;
+    return connection;
 }
 
 static void clientStateCallback(UA_Client *client, UA_ClientState state)
@@ -767,9 +2522,16 @@ static void clientStateCallback(UA_Client *client, UA_ClientState state)
     }
 }
 
-void Open62541AsyncBackend::connectToEndpoint(const QOpcUaEndpointDescription &endpoint)
+void Open62541AsyncBackend::connectToEndpoint(const QOpcUaEndpointDescription &endpoint, const QOpcUaApplicationIdentity &identity,
+                                              const QOpcUaAuthenticationInformation &authInfo, const QOpcUaPkiConfiguration &pkiConfig)
 {
+#ifndef UA_ENABLE_ENCRYPTION
+    Q_UNUSED(pkiConfig);
+#endif
+
     cleanupSubscriptions();
+    resetSocketNotifier();
+    invalidateRegisteredNodes();
 
     if (m_uaclient)
         UA_Client_delete(m_uaclient);
@@ -781,7 +2543,7 @@ void Open62541AsyncBackend::connectToEndpoint(const QOpcUaEndpointDescription &e
         return;
     }
 
-    if (!m_clientImpl->supportedSecurityPolicies().contains(endpoint.securityPolicy())) {
+    if (!supportedSecurityPolicies().contains(endpoint.securityPolicy())) {
 #ifndef UA_ENABLE_ENCRYPTION
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "The open62541 plugin has been built without encryption support";
 #endif
@@ -797,12 +2559,6 @@ void Open62541AsyncBackend::connectToEndpoint(const QOpcUaEndpointDescription &e
     m_uaclient = UA_Client_new();
     auto conf = UA_Client_getConfig(m_uaclient);
 
-    const auto identity = m_clientImpl->m_client->applicationIdentity();
-    const auto authInfo = m_clientImpl->m_client->authenticationInformation();
-#ifdef UA_ENABLE_ENCRYPTION
-    const auto pkiConfig = m_clientImpl->m_client->pkiConfiguration();
-#endif
-
 #ifdef UA_ENABLE_ENCRYPTION
     if (pkiConfig.isPkiValid()) {
         UA_ByteString localCertificate;
@@ -867,8 +2623,12 @@ void Open62541AsyncBackend::connectToEndpoint(const QOpcUaEndpointDescription &e
         UA_ClientConfig_setDefault(conf);
     }
 
+    // Required for decoding the history data in HistoryRead responses
+    conf->customDataTypes = &QOpen62541HistoryTypes::customTypes;
+
     conf->clientContext = this;
     conf->stateCallback = &clientStateCallback;
+    conf->connectionFunc = &connectClientConnection;
     conf->clientDescription.applicationName = UA_LOCALIZEDTEXT_ALLOC("", identity.applicationName().toUtf8().constData());
     conf->clientDescription.applicationUri  = UA_STRING_ALLOC(identity.applicationUri().toUtf8().constData());
     conf->clientDescription.productUri      = UA_STRING_ALLOC(identity.productUri().toUtf8().constData());
@@ -878,6 +2638,7 @@ void Open62541AsyncBackend::connectToEndpoint(const QOpcUaEndpointDescription &e
     conf->securityMode = static_cast<UA_MessageSecurityMode>(endpoint.securityMode());
 
     UA_StatusCode ret;
+    lastConnectedSocket = UA_INVALID_SOCKET;
 
     if (authInfo.authenticationType() == QOpcUaUserTokenPolicy::TokenType::Anonymous) {
         ret = UA_Client_connect(m_uaclient, endpoint.endpointUrl().toUtf8().constData());
@@ -886,7 +2647,7 @@ void Open62541AsyncBackend::connectToEndpoint(const QOpcUaEndpointDescription &e
         bool suitableTokenFound = false;
         for (const auto token : endpoint.userIdentityTokens()) {
             if (token.tokenType() == QOpcUaUserTokenPolicy::Username &&
-                    m_clientImpl->supportedSecurityPolicies().contains(token.securityPolicy())) {
+                    supportedSecurityPolicies().contains(token.securityPolicy())) {
                 suitableTokenFound = true;
                 break;
             }
@@ -928,14 +2689,22 @@ void Open62541AsyncBackend::connectToEndpoint(const QOpcUaEndpointDescription &e
         return;
     }
 
+    createSocketNotifier(lastConnectedSocket);
+
+    readOperationLimits();
+
     m_useStateCallback = true;
     emit stateAndOrErrorChanged(QOpcUaClient::Connected, QOpcUaClient::NoError);
+
+    // Registrations are bound to the session, restore them before any request of the client is handled
+    reregisterNodes();
 }
 
 void Open62541AsyncBackend::disconnectFromEndpoint()
 {
     m_subscriptionTimer.stop();
     cleanupSubscriptions();
+    resetSocketNotifier();
 
     m_useStateCallback = false;
 
@@ -949,6 +2718,9 @@ void Open62541AsyncBackend::disconnectFromEndpoint()
         m_uaclient = nullptr;
     }
 
+    abortHistoryReads(UA_STATUSCODE_BADSHUTDOWN);
+    invalidateRegisteredNodes();
+
     emit stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::NoError);
 }
 
@@ -1019,20 +2791,166 @@ void Open62541AsyncBackend::sendPublishRequest()
         return;
     }
 
+    if (!iterateClient())
+        return;
+
+    if (m_subscriptions.count() == 0 && !hasPendingAsyncRequests()) {
+        m_sendPublishRequests = false;
+        return;
+    }
+
+    m_subscriptionTimer.start(nextIterationInterval());
+}
+
+void Open62541AsyncBackend::handleSocketActivity()
+{
+    if (!m_uaclient)
+        return;
+
+    if (!iterateClient())
+        return;
+
+    if (m_sendPublishRequests && m_subscriptions.count() == 0 && !hasPendingAsyncRequests()) {
+        m_subscriptionTimer.stop();
+        m_sendPublishRequests = false;
+    }
+}
+
+void Open62541AsyncBackend::queueDataChange(quint64 handle, const QOpcUaReadResult &result)
+{
+    if (m_dataChangeQueue) {
+        const auto pushResult = m_dataChangeQueue->push(handle, result,
+                                                        [this](quint64 itemHandle, QOpcUa::NodeAttribute attribute) {
+            return getSubscriptionForItem(itemHandle, attribute) != nullptr;
+        });
+
+        if (pushResult == QOpcUaDataChangeQueue::PushResult::Queued) {
+            if (m_dataChangeQueue->requestNotification())
+                emit dataChangesAvailable();
+        } else if (pushResult == QOpcUaDataChangeQueue::PushResult::Full) {
+            // The value has been dropped and counted by the queue. Falling back to the unbounded
+            // signal path would defeat the purpose of the queue exactly when it is overloaded.
+            if (m_dataChangeQueue->overflowCount() == 1) {
+                qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Data change queue capacity of" << m_dataChangeQueue->capacity()
+                                                      << "exceeded, notifications for further monitored attributes"
+                                                      << "are discarded";
+            }
+        }
+        return;
+    }
+
+    m_pendingDataChangeHandles.push_back(handle);
+    m_pendingDataChanges.push_back(result);
+
+    // Publish responses are also processed while waiting for the response of a synchronous service call.
+    // In this case, the data changes are delivered as soon as control returns to the event loop.
+    if (!m_dataChangeTimer.isActive())
+        m_dataChangeTimer.start(0);
+}
+
+void Open62541AsyncBackend::sendDataChanges()
+{
+    m_dataChangeTimer.stop();
+
+    if (m_pendingDataChanges.isEmpty())
+        return;
+
+    emit dataChangesOccurred(qExchange(m_pendingDataChangeHandles, {}), qExchange(m_pendingDataChanges, {}));
+}
+
+bool Open62541AsyncBackend::iterateClient()
+{
+    // A connection opened by open62541 during the iteration is detected by the wrapped connection function
+    lastConnectedSocket = UA_INVALID_SOCKET;
+
     // If BADSERVERNOTCONNECTED is returned, the subscriptions are gone and local information can be deleted.
-    if (UA_Client_run_iterate(m_uaclient, 1) == UA_STATUSCODE_BADSERVERNOTCONNECTED) {
+    const UA_StatusCode result = UA_Client_run_iterate(m_uaclient, 1);
+
+    // All notifications of the publish responses received in this iteration are delivered in one signal
+    sendDataChanges();
+
+    if (result == UA_STATUSCODE_BADSERVERNOTCONNECTED) {
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Unable to send publish request";
+        m_subscriptionTimer.stop();
         m_sendPublishRequests = false;
         cleanupSubscriptions();
+        abortAsyncRequests(UA_STATUSCODE_BADSERVERNOTCONNECTED);
+        resetSocketNotifier();
+        return false;
+    }
+
+    const UA_ClientState state = UA_Client_getState(m_uaclient);
+
+    // The socket has been closed by open62541 if the connection was lost
+    if (state < UA_CLIENTSTATE_SECURECHANNEL) {
+        resetSocketNotifier();
+
+        // Requests of a lost connection are never answered, iterating until they time out is pointless
+        if (state == UA_CLIENTSTATE_DISCONNECTED) {
+            m_subscriptionTimer.stop();
+            m_sendPublishRequests = false;
+            abortAsyncRequests(UA_STATUSCODE_BADCONNECTIONCLOSED);
+            return false;
+        }
+    } else if (lastConnectedSocket != UA_INVALID_SOCKET) {
+        // The connection has been reestablished on a new socket
+        createSocketNotifier(lastConnectedSocket);
+    }
+
+    return true;
+}
+
+void Open62541AsyncBackend::createSocketNotifier(UA_SOCKET socket)
+{
+    resetSocketNotifier();
+
+    if (socket == UA_INVALID_SOCKET) {
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Socket of the connection is unknown, falling back to polling";
         return;
     }
 
-    m_subscriptionTimer.start(0);
+    m_socketNotifier = new QSocketNotifier(static_cast<qintptr>(socket), QSocketNotifier::Read, this);
+    QObject::connect(m_socketNotifier, &QSocketNotifier::activated, this, &Open62541AsyncBackend::handleSocketActivity);
+}
+
+void Open62541AsyncBackend::resetSocketNotifier()
+{
+    if (!m_socketNotifier)
+        return;
+
+    // The notifier might be deleted from a slot connected to its activated() signal
+    m_socketNotifier->setEnabled(false);
+    m_socketNotifier->deleteLater();
+    m_socketNotifier = nullptr;
+}
+
+int Open62541AsyncBackend::nextIterationInterval() const
+{
+    if (!m_socketNotifier)
+        return pollingInterval;
+
+    // Responses and publish responses are signaled by the socket notifier, each iteration also refills
+    // the publish requests. The timer is only needed for the deadlines which expire without incoming data:
+    // the renewal of the secure channel, the connectivity check, the timeout of pending service calls
+    // and the keep-alive of the subscriptions which detects a lost subscription.
+    const UA_ClientConfig *conf = UA_Client_getConfig(m_uaclient);
+    double interval = conf->secureChannelLifeTime * 0.75;
+
+    if (conf->connectivityCheckInterval)
+        interval = qMin(interval, static_cast<double>(conf->connectivityCheckInterval));
+
+    if (hasPendingAsyncRequests() && conf->timeout)
+        interval = qMin(interval, static_cast<double>(conf->timeout));
+
+    for (const auto sub : m_subscriptions)
+        interval = qMin(interval, sub->interval() * qMax<UA_UInt32>(sub->maxKeepAliveCount(), 1));
+
+    return qBound(minimumIterationInterval, static_cast<int>(interval), maximumIterationInterval);
 }
 
 void Open62541AsyncBackend::modifyPublishRequests()
 {
-    if (m_subscriptions.count() == 0) {
+    if (m_subscriptions.count() == 0 && !hasPendingAsyncRequests()) {
         m_subscriptionTimer.stop();
         m_sendPublishRequests = false;
         return;
@@ -35,42 +35,73 @@
 ****************************************************************************/
 
 #include "qopen62541client.h"
+#include "qopen62541historytypes.h"
 #include "qopen62541subscription.h"
+#include "qopen62541utils.h"
+#include "qopen62541valueconverter.h"
 #include <private/qopcuabackend_p.h>
+#include <private/qopcuadatachangequeue_p.h>
+
+#include <QtOpcUa/qopcuaauthenticationinformation.h>
 
 #include <QtCore/qset.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qtimer.h>
 
 QT_BEGIN_NAMESPACE
 
+class QSocketNotifier;
+
 class Open62541AsyncBackend : public QOpcUaBackend
 {
     Q_OBJECT
 public:
-    Open62541AsyncBackend(QOpen62541Client *parent);
+    Open62541AsyncBackend();
     ~Open62541AsyncBackend();
 
+    static QStringList supportedSecurityPolicies();
+
 public Q_SLOTS:
-    void connectToEndpoint(const QOpcUaEndpointDescription &endpoint);
+    // The settings of the client are passed with the call, the backend must not access the client
+    // because it may be destroyed while a slot is running in the thread of the backend.
+    void connectToEndpoint(const QOpcUaEndpointDescription &endpoint, const QOpcUaApplicationIdentity &identity,
+                           const QOpcUaAuthenticationInformation &authInfo, const QOpcUaPkiConfiguration &pkiConfig);
     void disconnectFromEndpoint();
     void requestEndpoints(const QUrl &url);
 
     // Node functions
     void browse(quint64 handle, UA_NodeId id, const QOpcUaBrowseRequest &request);
-    void readAttributes(quint64 handle, UA_NodeId id, QOpcUa::NodeAttributes attr, QString indexRange);
+    void readAttributes(quint64 handle, UA_NodeId id, QOpcUa::NodeAttributes attr, QString indexRange, double maxAge);
 
     void writeAttribute(quint64 handle, UA_NodeId id, QOpcUa::NodeAttribute attrId, QVariant value, QOpcUa::Types type, QString indexRange);
     void writeAttributes(quint64 handle, UA_NodeId id, QOpcUaNode::AttributeMap toWrite, QOpcUa::Types valueAttributeType);
     void enableMonitoring(quint64 handle, UA_NodeId id, QOpcUa::NodeAttributes attr, const QOpcUaMonitoringParameters &settings);
     void disableMonitoring(quint64 handle, QOpcUa::NodeAttributes attr);
+    void enableMonitoringForNodes(QVector<quint64> handles, QVector<UA_NodeId> ids, QOpcUa::NodeAttributes attr,
+                                  const QOpcUaMonitoringParameters &settings);
+    void disableMonitoringForNodes(QVector<quint64> handles, QOpcUa::NodeAttributes attr);
     void modifyMonitoring(quint64 handle, QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameter item, QVariant value);
     void callMethod(quint64 handle, UA_NodeId objectId, UA_NodeId methodId, QVector<QOpcUa::TypedVariant> args);
     void resolveBrowsePath(quint64 handle, UA_NodeId startNode, const QVector<QOpcUaRelativePathElement> &path);
     void findServers(const QUrl &url, const QStringList &localeIds, const QStringList &serverUris);
 
-    void readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead);
+    void readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge);
     void writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite);
+    void readValues(quint64 requestHandle, const QVector<QOpcUaReadItem> &nodesToRead, double maxAge);
+    void writeValues(quint64 requestHandle, const QVector<QOpcUaWriteItem> &nodesToWrite);
+    void callMethods(quint64 requestHandle, const QVector<QOpcUaCallMethodItem> &methodsToCall);
+    void browseNodes(quint64 requestHandle, const QStringList &nodeIds, const QOpcUaBrowseRequest &request,
+                     quint32 requestedMaxReferencesPerNode);
+
+    // History access
+    void readHistoryData(quint64 handle, const QOpcUaHistoryReadRequest &request);
+    void acknowledgeHistoryData(quint64 handle);
+    void abortHistoryRead(quint64 handle);
+
+    // Registered nodes
+    void registerNodes(const QStringList &nodeIds);
+    void unregisterNodes(const QStringList &nodeIds);
 
     // Node management
     void addNode(const QOpcUaAddNodeItem &nodeToAdd);
@@ -83,15 +114,205 @@ public Q_SLOTS:
     bool removeSubscription(UA_UInt32 subscriptionId);
     void sendPublishRequest();
     void modifyPublishRequests();
+    void handleSocketActivity();
+    void sendCoalescedReads();
+    void sendDataChanges();
     void handleSubscriptionTimeout(QOpen62541Subscription *sub, QVector<QPair<quint64, QOpcUa::NodeAttribute>> items);
     void cleanupSubscriptions();
 
 public:
+    // Data changes are collected and delivered to the client in one signal per publish response
+    void queueDataChange(quint64 handle, const QOpcUaReadResult &result);
+
+    // Operation limits announced by the server, 0 means there is no limit
+    struct OperationLimits {
+        UA_UInt32 maxNodesPerRead = 0;
+        UA_UInt32 maxNodesPerWrite = 0;
+        UA_UInt32 maxNodesPerBrowse = 0;
+        UA_UInt32 maxBrowseContinuationPoints = 0; // Per session, from ServerCapabilities
+        UA_UInt32 maxMonitoredItemsPerCall = 0;
+        UA_UInt32 maxNodesPerHistoryReadData = 0;
+        UA_UInt32 maxHistoryContinuationPoints = 0; // Per session, from ServerCapabilities
+        UA_UInt32 maxNodesPerRegisterNodes = 0;
+        UA_UInt32 maxNodesPerMethodCall = 0;
+    };
+
     UA_Client *m_uaclient;
-    QOpen62541Client *m_clientImpl;
     bool m_useStateCallback;
+    bool m_useAsyncServiceCalls;
+    int m_readCoalescingInterval;
+    OperationLimits m_operationLimits;
+    QOpen62541NodeIdCache m_nodeIdCache;
+    QOpen62541ValueConverter::ArrayConversion m_arrayConversion;
 
 private:
+    struct AsyncReadContext {
+        quint64 handle;
+        QVector<QOpcUaReadResult> results;
+    };
+
+    struct AsyncWriteAttributesContext {
+        quint64 handle;
+        QVector<QPair<QOpcUa::NodeAttribute, QVariant>> toWrite;
+    };
+
+    struct AsyncBrowseContext {
+        quint64 handle;
+        QVector<QOpcUaReferenceDescription> results;
+        QOpcUa::UaStatusCode statusCode;
+    };
+
+    struct AsyncCallMethodContext {
+        quint64 handle;
+        QString methodNodeId;
+    };
+
+    struct AsyncTranslateContext {
+        quint64 handle;
+        QVector<QOpcUaRelativePathElement> path;
+    };
+
+    struct AsyncCoalescedReadContext {
+        QVector<AsyncReadContext> reads;
+    };
+
+    // A batch read or write which is split into chunks according to the operation limits of the server
+    struct BatchRead {
+        QVector<QOpcUaReadItem> nodesToRead;
+        QVector<QOpcUaReadResult> results;
+        double maxAge = 0;
+        quint64 requestHandle = 0; // Set for reads of value handles
+        int nextOffset = 0;
+        int pendingChunks = 0;
+        QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::Good;
+        bool finished = false;
+    };
+
+    struct BatchWrite {
+        QVector<QOpcUaWriteItem> nodesToWrite;
+        QVector<QOpcUaWriteResult> results;
+        quint64 requestHandle = 0; // Set for writes of value handles
+        int nextOffset = 0;
+        int pendingChunks = 0;
+        QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::Good;
+        bool finished = false;
+    };
+
+    struct BatchCall {
+        QVector<QOpcUaCallMethodItem> methodsToCall;
+        QVector<QOpcUaCallMethodResult> results;
+        quint64 requestHandle = 0; // Set for calls of futures
+        int nextOffset = 0;
+        int pendingChunks = 0;
+        QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::Good;
+        bool finished = false;
+    };
+
+    struct BatchBrowse {
+        quint64 requestHandle = 0;
+        QStringList nodeIds;
+        QOpcUaBrowseRequest request;
+        quint32 requestedMaxReferencesPerNode = 0;
+        QHash<int, QVector<QOpcUaReferenceDescription>> partialResults; // Node index -> references received so far
+        QVector<int> retryIndices; // Nodes which did not get a continuation point
+        int nextOffset = 0;
+        int pendingChunks = 0;
+        QOpcUa::UaStatusCode abortStatus = QOpcUa::UaStatusCode::Good;
+    };
+
+    struct AsyncBatchBrowseContext {
+        QSharedPointer<BatchBrowse> batch;
+        QVector<int> nodeIndices; // Nodes in the order of the request
+    };
+
+    // A history read which follows the continuation points of its nodes and delivers the values page by page.
+    // A page is only requested if the number of unanswered requests and unacknowledged pages is below the limit of the request.
+    struct HistoryRead {
+        quint64 handle = 0;
+        QOpcUaHistoryReadRequest request;
+        QVector<int> continuedIndices; // Nodes waiting for their next page
+        QHash<int, QByteArray> continuationPoints; // Node index -> continuation point of the next page
+        int nextOffset = 0;
+        int activeNodes = 0; // Nodes which have been started and have not received their last page
+        int pendingPages = 0;
+        int unacknowledgedPages = 0;
+        QOpcUa::UaStatusCode abortStatus = QOpcUa::UaStatusCode::Good;
+        bool finished = false;
+    };
+
+    struct AsyncHistoryReadContext {
+        QSharedPointer<HistoryRead> historyRead;
+        QVector<int> nodeIndices; // Nodes in the order of the request
+        bool release; // Only releases the continuation points
+    };
+
+    struct AsyncBatchReadContext {
+        QSharedPointer<BatchRead> batch;
+        int offset;
+        int count;
+    };
+
+    struct AsyncBatchWriteContext {
+        QSharedPointer<BatchWrite> batch;
+        int offset;
+        int count;
+    };
+
+    struct AsyncBatchCallContext {
+        QSharedPointer<BatchCall> batch;
+        int offset;
+        int count;
+    };
+
+    static void asyncReadCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncWriteAttributesCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncBrowseCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncCallMethodCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncTranslateBrowsePathCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncCoalescedReadCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncBatchReadCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncBatchWriteCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncBatchCallCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncBatchBrowseCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+    static void asyncHistoryReadCallback(UA_Client *client, void *userdata, UA_UInt32 requestId, void *response);
+
+    void handleReadResponse(const AsyncReadContext &context, const UA_ReadResponse *res);
+    void handleWriteAttributesResponse(const AsyncWriteAttributesContext &context, const UA_WriteResponse *res);
+    bool handleBrowseResponse(AsyncBrowseContext &context, const UA_BrowseResponse *res);
+    void handleCallMethodResponse(const AsyncCallMethodContext &context, const UA_CallResponse *res);
+    void handleTranslateBrowsePathResponse(const AsyncTranslateContext &context, const UA_TranslateBrowsePathsToNodeIdsResponse *res);
+    void handleCoalescedReadResponse(const AsyncCoalescedReadContext &context, const UA_ReadResponse *res);
+    void handleBatchReadResponse(const AsyncBatchReadContext &context, const UA_ReadResponse *res);
+    void handleBatchWriteResponse(const AsyncBatchWriteContext &context, const UA_WriteResponse *res);
+    void continueBatchRead(const QSharedPointer<BatchRead> &batch);
+    void continueBatchWrite(const QSharedPointer<BatchWrite> &batch);
+    void handleBatchCallResponse(const AsyncBatchCallContext &context, const UA_CallResponse *res);
+    void continueBatchCall(const QSharedPointer<BatchCall> &batch);
+    bool handleBatchBrowseResponse(AsyncBatchBrowseContext &context, const UA_BrowseResponse *res, UA_BrowseNextRequest *nextRequest);
+    void continueBatchBrowse(const QSharedPointer<BatchBrowse> &batch);
+    void sendHistoryReadRequest(const QSharedPointer<HistoryRead> &historyRead, const QVector<int> &nodeIndices, bool release);
+    void handleHistoryReadResponse(const AsyncHistoryReadContext &context, QOpen62541HistoryTypes::HistoryReadResponse *res);
+    void continueHistoryRead(const QSharedPointer<HistoryRead> &historyRead);
+    void abortHistoryReads(UA_StatusCode statusCode);
+    UA_ExtensionObject createHistoryReadDetails(const QOpcUaHistoryReadRequest &request, int nodeCount);
+
+    void readOperationLimits();
+
+    QOpcUa::UaStatusCode sendRegisterNodes(const QStringList &nodeIds, QStringList *registeredNodeIds);
+    void reregisterNodes();
+    void invalidateRegisteredNodes();
+    UA_NodeId requestNodeId(const QString &nodeId);
+    void useRegisteredNodeId(UA_NodeId *id) const;
+
+    UA_StatusCode sendAsyncRequest(const void *request, const UA_DataType *requestType, UA_ClientAsyncServiceCallback callback,
+                                   const UA_DataType *responseType, UA_UInt32 *requestId);
+    bool hasPendingAsyncRequests() const;
+    bool iterateClient();
+    void createSocketNotifier(UA_SOCKET socket);
+    void resetSocketNotifier();
+    int nextIterationInterval() const;
+    void abortAsyncRequests(UA_StatusCode statusCode);
+
     QOpen62541Subscription *getSubscriptionForItem(quint64 handle, QOpcUa::NodeAttribute attr);
     QOpcUaApplicationDescription convertApplicationDescription(UA_ApplicationDescription &desc);
 
@@ -103,6 +324,21 @@ private:
     bool loadAllFilesInDirectory(const QString &location, UA_ByteString **target, int *size) const;
 
     QTimer m_subscriptionTimer;
+    QSocketNotifier *m_socketNotifier;
+
+    // Reads of single nodes waiting to be merged into one read request
+    QTimer m_readCoalescingTimer;
+    QVector<AsyncReadContext> m_pendingReads;
+    QVector<UA_ReadValueId> m_pendingReadValueIds;
+    double m_pendingReadMaxAge;
+
+    // Data changes waiting to be delivered to the client
+    QTimer m_dataChangeTimer;
+    QVector<quint64> m_pendingDataChangeHandles;
+    QVector<QOpcUaReadResult> m_pendingDataChanges;
+
+    // Bounded queue with latest value conflation, replaces the signals if set
+    QSharedPointer<QOpcUaDataChangeQueue> m_dataChangeQueue;
 
     QHash<quint32, QOpen62541Subscription *> m_subscriptions;
 
@@ -111,6 +347,26 @@ private:
     bool m_sendPublishRequests;
 
     double m_minPublishingInterval;
+
+    // Request id -> context of a service call which has been dispatched using the async API of open62541
+    QHash<UA_UInt32, AsyncReadContext> m_asyncReadContext;
+    QHash<UA_UInt32, AsyncWriteAttributesContext> m_asyncWriteAttributesContext;
+    QHash<UA_UInt32, AsyncBrowseContext> m_asyncBrowseContext;
+    QHash<UA_UInt32, AsyncCallMethodContext> m_asyncCallMethodContext;
+    QHash<UA_UInt32, AsyncTranslateContext> m_asyncTranslateContext;
+    QHash<UA_UInt32, AsyncCoalescedReadContext> m_asyncCoalescedReadContext;
+    QHash<UA_UInt32, AsyncBatchReadContext> m_asyncBatchReadContext;
+    QHash<UA_UInt32, AsyncBatchWriteContext> m_asyncBatchWriteContext;
+    QHash<UA_UInt32, AsyncBatchCallContext> m_asyncBatchCallContext;
+    QHash<UA_UInt32, AsyncBatchBrowseContext> m_asyncBatchBrowseContext;
+    QHash<UA_UInt32, AsyncHistoryReadContext> m_asyncHistoryReadContext;
+
+    QHash<quint64, QSharedPointer<HistoryRead>> m_historyReads;
+
+    // Normalized node id -> id assigned by the RegisterNodes service of the current session.
+    // The assigned id is null while the node is not registered in the current session, the
+    // registration is restored when the next session is established.
+    QHash<QString, UA_NodeId> m_registeredNodes;
 };
 
 QT_END_NAMESPACE
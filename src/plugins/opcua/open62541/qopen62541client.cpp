@@ -38,10 +38,12 @@
 #include "qopen62541client.h"
 #include "qopen62541node.h"
 #include "qopen62541subscription.h"
+#include "qopen62541threadpool.h"
 #include "qopen62541utils.h"
 #include "qopen62541valueconverter.h"
 #include <private/qopcuaclient_p.h>
 
+#include <QtCore/qcoreapplication.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qthread.h>
@@ -51,20 +53,72 @@ QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
 
-QOpen62541Client::QOpen62541Client()
+QOpen62541Client::QOpen62541Client(const QVariantMap &backendProperties)
     : QOpcUaClientImpl()
-    , m_backend(new Open62541AsyncBackend(this))
+    , m_thread(nullptr)
+    , m_backend(new Open62541AsyncBackend())
+    , m_useSharedThread(false)
 {
-    m_thread = new QThread();
+    if (backendProperties.value(QLatin1String("enableAsyncServiceCalls"), false).toBool()) {
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Enabling asynchronous service calls.";
+        m_backend->m_useAsyncServiceCalls = true;
+    }
+
+    const QVariant readCoalescingInterval = backendProperties.value(QLatin1String("readCoalescingInterval"));
+    if (readCoalescingInterval.isValid()) {
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Coalescing reads with an interval of" << readCoalescingInterval.toInt() << "ms.";
+        m_backend->m_readCoalescingInterval = qMax(0, readCoalescingInterval.toInt());
+    }
+
+    if (backendProperties.value(QLatin1String("enableTypedArrays"), false).toBool()) {
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Returning numeric and boolean arrays as QVector.";
+        m_backend->m_arrayConversion = QOpen62541ValueConverter::ArrayConversion::TypedVector;
+    }
+
+    const int nodeIdCacheSize = backendProperties.value(QLatin1String("nodeIdCacheSize"), 0).toInt();
+    if (nodeIdCacheSize > 0) {
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Caching up to" << nodeIdCacheSize << "converted node ids.";
+        m_nodeIdCache.setMaxEntries(nodeIdCacheSize);
+        m_backend->m_nodeIdCache.setMaxEntries(nodeIdCacheSize);
+    }
+
+    const int dataChangeQueueCapacity = backendProperties.value(QLatin1String("dataChangeQueueCapacity"), 0).toInt();
+    if (dataChangeQueueCapacity > 0) {
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Conflating data changes for up to" << dataChangeQueueCapacity << "monitored attributes.";
+        m_backend->m_dataChangeQueue.reset(new QOpcUaDataChangeQueue(dataChangeQueueCapacity));
+        setDataChangeQueue(m_backend->m_dataChangeQueue);
+    }
+
+    const int sharedIoThreads = backendProperties.value(QLatin1String("sharedIoThreads"), 0).toInt();
+    if (sharedIoThreads > 0) {
+        m_thread = QOpen62541ThreadPool::instance()->acquireThread(sharedIoThreads);
+        m_useSharedThread = m_thread != nullptr;
+    }
+
     connectBackendWithClient(m_backend);
-    m_backend->moveToThread(m_thread);
-    connect(m_thread, &QThread::finished, m_thread, &QObject::deleteLater);
-    connect(m_thread, &QThread::finished, m_backend, &QObject::deleteLater);
-    m_thread->start();
+
+    if (m_useSharedThread) {
+        m_backend->moveToThread(m_thread);
+    } else {
+        m_thread = new QThread();
+        m_backend->moveToThread(m_thread);
+        connect(m_thread, &QThread::finished, m_thread, &QObject::deleteLater);
+        connect(m_thread, &QThread::finished, m_backend, &QObject::deleteLater);
+        m_thread->start();
+    }
 }
 
 QOpen62541Client::~QOpen62541Client()
 {
+    if (m_useSharedThread) {
+        // The thread is used by other clients and keeps running.
+        // Pending calls must not reach the backend after the client is gone.
+        QCoreApplication::removePostedEvents(m_backend);
+        m_backend->deleteLater();
+        QOpen62541ThreadPool::instance()->releaseThread(m_thread);
+        return;
+    }
+
     if (m_thread->isRunning())
         m_thread->quit();
 }
@@ -72,7 +126,10 @@ QOpen62541Client::~QOpen62541Client()
 void QOpen62541Client::connectToEndpoint(const QOpcUaEndpointDescription &endpoint)
 {
     QMetaObject::invokeMethod(m_backend, "connectToEndpoint", Qt::QueuedConnection,
-                                     Q_ARG(QOpcUaEndpointDescription, endpoint));
+                                     Q_ARG(QOpcUaEndpointDescription, endpoint),
+                                     Q_ARG(QOpcUaApplicationIdentity, m_client->applicationIdentity()),
+                                     Q_ARG(QOpcUaAuthenticationInformation, m_client->authenticationInformation()),
+                                     Q_ARG(QOpcUaPkiConfiguration, m_client->pkiConfiguration()));
 }
 
 void QOpen62541Client::disconnectFromEndpoint()
@@ -82,7 +139,7 @@ void QOpen62541Client::disconnectFromEndpoint()
 
 QOpcUaNode *QOpen62541Client::node(const QString &nodeId)
 {
-    UA_NodeId uaNodeId = Open62541Utils::nodeIdFromQString(nodeId);
+    UA_NodeId uaNodeId = m_nodeIdCache.nodeId(nodeId);
     if (UA_NodeId_isNull(&uaNodeId))
         return nullptr;
 
@@ -113,10 +170,11 @@ bool QOpen62541Client::findServers(const QUrl &url, const QStringList &localeIds
                                     Q_ARG(QStringList, serverUris));
 }
 
-bool QOpen62541Client::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead)
+bool QOpen62541Client::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge)
 {
     return QMetaObject::invokeMethod(m_backend, "readNodeAttributes", Qt::QueuedConnection,
-                                     Q_ARG(QVector<QOpcUaReadItem>, nodesToRead));
+                                     Q_ARG(QVector<QOpcUaReadItem>, nodesToRead),
+                                     Q_ARG(double, maxAge));
 }
 
 bool QOpen62541Client::writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite)
@@ -125,6 +183,202 @@ bool QOpen62541Client::writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodes
                                      Q_ARG(QVector<QOpcUaWriteItem>, nodesToWrite));
 }
 
+bool QOpen62541Client::enableMonitoring(const QVector<QOpcUaNodeImpl *> &nodes, QOpcUa::NodeAttributes attr,
+                                        const QOpcUaMonitoringParameters &settings)
+{
+    QVector<quint64> handles;
+    QVector<UA_NodeId> ids;
+    handles.reserve(nodes.size());
+    ids.reserve(nodes.size());
+
+    for (QOpcUaNodeImpl *node : nodes) {
+        UA_NodeId tempId;
+        UA_NodeId_copy(&static_cast<QOpen62541Node *>(node)->m_nodeId, &tempId);
+        handles.push_back(node->handle());
+        ids.push_back(tempId);
+    }
+
+    const bool success = QMetaObject::invokeMethod(m_backend, "enableMonitoringForNodes", Qt::QueuedConnection,
+                                                   Q_ARG(QVector<quint64>, handles),
+                                                   Q_ARG(QVector<UA_NodeId>, ids),
+                                                   Q_ARG(QOpcUa::NodeAttributes, attr),
+                                                   Q_ARG(QOpcUaMonitoringParameters, settings));
+    if (!success) {
+        for (auto &id : ids)
+            UA_NodeId_deleteMembers(&id);
+    }
+
+    return success;
+}
+
+bool QOpen62541Client::disableMonitoring(const QVector<QOpcUaNodeImpl *> &nodes, QOpcUa::NodeAttributes attr)
+{
+    QVector<quint64> handles;
+    handles.reserve(nodes.size());
+    for (QOpcUaNodeImpl *node : nodes)
+        handles.push_back(node->handle());
+
+    return QMetaObject::invokeMethod(m_backend, "disableMonitoringForNodes", Qt::QueuedConnection,
+                                     Q_ARG(QVector<quint64>, handles),
+                                     Q_ARG(QOpcUa::NodeAttributes, attr));
+}
+
+bool QOpen62541Client::registerNodes(const QStringList &nodeIds)
+{
+    return QMetaObject::invokeMethod(m_backend, "registerNodes", Qt::QueuedConnection,
+                                     Q_ARG(QStringList, nodeIds));
+}
+
+bool QOpen62541Client::unregisterNodes(const QStringList &nodeIds)
+{
+    return QMetaObject::invokeMethod(m_backend, "unregisterNodes", Qt::QueuedConnection,
+                                     Q_ARG(QStringList, nodeIds));
+}
+
+bool QOpen62541Client::startHistoryRead(quint64 handle, const QOpcUaHistoryReadRequest &request)
+{
+    return QMetaObject::invokeMethod(m_backend, "readHistoryData", Qt::QueuedConnection,
+                                     Q_ARG(quint64, handle),
+                                     Q_ARG(QOpcUaHistoryReadRequest, request));
+}
+
+void QOpen62541Client::acknowledgeHistoryData(quint64 handle)
+{
+    QMetaObject::invokeMethod(m_backend, "acknowledgeHistoryData", Qt::QueuedConnection,
+                              Q_ARG(quint64, handle));
+}
+
+void QOpen62541Client::cancelHistoryRead(quint64 handle)
+{
+    QMetaObject::invokeMethod(m_backend, "abortHistoryRead", Qt::QueuedConnection,
+                              Q_ARG(quint64, handle));
+}
+
+bool QOpen62541Client::startValueRead(quint64 requestHandle, const QVector<QOpcUaReadItem> &items, double maxAge)
+{
+    return QMetaObject::invokeMethod(m_backend, "readValues", Qt::QueuedConnection,
+                                     Q_ARG(quint64, requestHandle),
+                                     Q_ARG(QVector<QOpcUaReadItem>, items),
+                                     Q_ARG(double, maxAge));
+}
+
+bool QOpen62541Client::startValueWrite(quint64 requestHandle, const QVector<QOpcUaWriteItem> &items)
+{
+    return QMetaObject::invokeMethod(m_backend, "writeValues", Qt::QueuedConnection,
+                                     Q_ARG(quint64, requestHandle),
+                                     Q_ARG(QVector<QOpcUaWriteItem>, items));
+}
+
+bool QOpen62541Client::startValueMonitoring(const QVector<quint64> &handles, const QStringList &nodeIds, QOpcUa::NodeAttribute attr,
+                                            const QOpcUaMonitoringParameters &settings)
+{
+    QVector<UA_NodeId> ids;
+    ids.reserve(nodeIds.size());
+
+    for (const auto &nodeId : nodeIds) {
+        UA_NodeId uaNodeId = m_nodeIdCache.nodeId(nodeId);
+        if (UA_NodeId_isNull(&uaNodeId)) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Unable to monitor value handle, invalid node id:" << nodeId;
+            for (auto &id : ids)
+                UA_NodeId_deleteMembers(&id);
+            return false;
+        }
+        ids.push_back(uaNodeId);
+    }
+
+    const bool success = QMetaObject::invokeMethod(m_backend, "enableMonitoringForNodes", Qt::QueuedConnection,
+                                                   Q_ARG(QVector<quint64>, handles),
+                                                   Q_ARG(QVector<UA_NodeId>, ids),
+                                                   Q_ARG(QOpcUa::NodeAttributes, QOpcUa::NodeAttributes() | attr),
+                                                   Q_ARG(QOpcUaMonitoringParameters, settings));
+    if (!success) {
+        for (auto &id : ids)
+            UA_NodeId_deleteMembers(&id);
+    }
+
+    return success;
+}
+
+bool QOpen62541Client::stopValueMonitoring(const QVector<quint64> &handles, QOpcUa::NodeAttribute attr)
+{
+    return QMetaObject::invokeMethod(m_backend, "disableMonitoringForNodes", Qt::QueuedConnection,
+                                     Q_ARG(QVector<quint64>, handles),
+                                     Q_ARG(QOpcUa::NodeAttributes, QOpcUa::NodeAttributes() | attr));
+}
+
+bool QOpen62541Client::startBrowse(quint64 requestHandle, const QString &nodeId, const QOpcUaBrowseRequest &request)
+{
+    UA_NodeId id = m_nodeIdCache.nodeId(nodeId);
+    if (UA_NodeId_isNull(&id))
+        return false;
+
+    const bool success = QMetaObject::invokeMethod(m_backend, "browse", Qt::QueuedConnection,
+                                                   Q_ARG(quint64, requestHandle),
+                                                   Q_ARG(UA_NodeId, id),
+                                                   Q_ARG(QOpcUaBrowseRequest, request));
+    if (!success)
+        UA_NodeId_deleteMembers(&id);
+
+    return success;
+}
+
+bool QOpen62541Client::startMethodCall(quint64 requestHandle, const QString &objectId, const QString &methodId,
+                                       const QVector<QOpcUa::TypedVariant> &args)
+{
+    UA_NodeId object = m_nodeIdCache.nodeId(objectId);
+    UA_NodeId method = m_nodeIdCache.nodeId(methodId);
+
+    bool success = !UA_NodeId_isNull(&object) && !UA_NodeId_isNull(&method);
+    if (success) {
+        success = QMetaObject::invokeMethod(m_backend, "callMethod", Qt::QueuedConnection,
+                                            Q_ARG(quint64, requestHandle),
+                                            Q_ARG(UA_NodeId, object),
+                                            Q_ARG(UA_NodeId, method),
+                                            Q_ARG(QVector<QOpcUa::TypedVariant>, args));
+    }
+
+    if (!success) {
+        UA_NodeId_deleteMembers(&object);
+        UA_NodeId_deleteMembers(&method);
+    }
+
+    return success;
+}
+
+bool QOpen62541Client::startResolveBrowsePath(quint64 requestHandle, const QString &startNodeId,
+                                              const QVector<QOpcUaRelativePathElement> &path)
+{
+    UA_NodeId start = m_nodeIdCache.nodeId(startNodeId);
+    if (UA_NodeId_isNull(&start))
+        return false;
+
+    const bool success = QMetaObject::invokeMethod(m_backend, "resolveBrowsePath", Qt::QueuedConnection,
+                                                   Q_ARG(quint64, requestHandle),
+                                                   Q_ARG(UA_NodeId, start),
+                                                   Q_ARG(QVector<QOpcUaRelativePathElement>, path));
+    if (!success)
+        UA_NodeId_deleteMembers(&start);
+
+    return success;
+}
+
+bool QOpen62541Client::startMethodCalls(quint64 requestHandle, const QVector<QOpcUaCallMethodItem> &methodsToCall)
+{
+    return QMetaObject::invokeMethod(m_backend, "callMethods", Qt::QueuedConnection,
+                                     Q_ARG(quint64, requestHandle),
+                                     Q_ARG(QVector<QOpcUaCallMethodItem>, methodsToCall));
+}
+
+bool QOpen62541Client::startBrowseNodes(quint64 requestHandle, const QStringList &nodeIds, const QOpcUaBrowseRequest &request,
+                                        quint32 requestedMaxReferencesPerNode)
+{
+    return QMetaObject::invokeMethod(m_backend, "browseNodes", Qt::QueuedConnection,
+                                     Q_ARG(quint64, requestHandle),
+                                     Q_ARG(QStringList, nodeIds),
+                                     Q_ARG(QOpcUaBrowseRequest, request),
+                                     Q_ARG(quint32, requestedMaxReferencesPerNode));
+}
+
 bool QOpen62541Client::addNode(const QOpcUaAddNodeItem &nodeToAdd)
 {
     return QMetaObject::invokeMethod(m_backend, "addNode", Qt::QueuedConnection,
@@ -152,14 +406,7 @@ bool QOpen62541Client::deleteReference(const QOpcUaDeleteReferenceItem &referenc
 
 QStringList QOpen62541Client::supportedSecurityPolicies() const
 {
-    return QStringList {
-        "http://opcfoundation.org/UA/SecurityPolicy#None"
-#ifdef UA_ENABLE_ENCRYPTION
-        , "http://opcfoundation.org/UA/SecurityPolicy#Basic128Rsa15"
-        , "http://opcfoundation.org/UA/SecurityPolicy#Basic256"
-        , "http://opcfoundation.org/UA/SecurityPolicy#Basic256Sha256"
-#endif
-    };
+    return Open62541AsyncBackend::supportedSecurityPolicies();
 }
 
 QVector<QOpcUaUserTokenPolicy::TokenType> QOpen62541Client::supportedUserTokenTypes() const
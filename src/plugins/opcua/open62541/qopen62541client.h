@@ -38,6 +38,7 @@
 #define QOPEN62541CLIENT_H
 
 #include "qopen62541.h"
+#include "qopen62541utils.h"
 #include <private/qopcuaclientimpl_p.h>
 
 #include <QtCore/qtimer.h>
@@ -51,7 +52,7 @@ class QOpen62541Client : public QOpcUaClientImpl
     Q_OBJECT
 
 public:
-    explicit QOpen62541Client();
+    explicit QOpen62541Client(const QVariantMap &backendProperties);
     ~QOpen62541Client();
 
     void connectToEndpoint(const QOpcUaEndpointDescription &endpoint) override;
@@ -65,9 +66,16 @@ public:
 
     bool findServers(const QUrl &url, const QStringList &localeIds, const QStringList &serverUris) override;
 
-    bool readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead) override;
+    bool readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge) override;
     bool writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite) override;
 
+    bool enableMonitoring(const QVector<QOpcUaNodeImpl *> &nodes, QOpcUa::NodeAttributes attr,
+                          const QOpcUaMonitoringParameters &settings) override;
+    bool disableMonitoring(const QVector<QOpcUaNodeImpl *> &nodes, QOpcUa::NodeAttributes attr) override;
+
+    bool registerNodes(const QStringList &nodeIds) override;
+    bool unregisterNodes(const QStringList &nodeIds) override;
+
     bool addNode(const QOpcUaAddNodeItem &nodeToAdd) override;
     bool deleteNode(const QString &nodeId, bool deleteTargetReferences) override;
 
@@ -77,12 +85,34 @@ public:
     QStringList supportedSecurityPolicies() const override;
     QVector<QOpcUaUserTokenPolicy::TokenType> supportedUserTokenTypes() const override;
 
+protected:
+    bool startHistoryRead(quint64 handle, const QOpcUaHistoryReadRequest &request) override;
+    void acknowledgeHistoryData(quint64 handle) override;
+    void cancelHistoryRead(quint64 handle) override;
+
+    bool startValueRead(quint64 requestHandle, const QVector<QOpcUaReadItem> &items, double maxAge) override;
+    bool startValueWrite(quint64 requestHandle, const QVector<QOpcUaWriteItem> &items) override;
+    bool startValueMonitoring(const QVector<quint64> &handles, const QStringList &nodeIds, QOpcUa::NodeAttribute attr,
+                              const QOpcUaMonitoringParameters &settings) override;
+    bool stopValueMonitoring(const QVector<quint64> &handles, QOpcUa::NodeAttribute attr) override;
+
+    bool startBrowse(quint64 requestHandle, const QString &nodeId, const QOpcUaBrowseRequest &request) override;
+    bool startMethodCall(quint64 requestHandle, const QString &objectId, const QString &methodId,
+                         const QVector<QOpcUa::TypedVariant> &args) override;
+    bool startResolveBrowsePath(quint64 requestHandle, const QString &startNodeId,
+                                const QVector<QOpcUaRelativePathElement> &path) override;
+    bool startMethodCalls(quint64 requestHandle, const QVector<QOpcUaCallMethodItem> &methodsToCall) override;
+    bool startBrowseNodes(quint64 requestHandle, const QStringList &nodeIds, const QOpcUaBrowseRequest &request,
+                          quint32 requestedMaxReferencesPerNode) override;
+
 private slots:
 
 private:
     friend class QOpen62541Node;
     QThread *m_thread;
     Open62541AsyncBackend *m_backend;
+    bool m_useSharedThread;
+    QOpen62541NodeIdCache m_nodeIdCache;
 };
 
 QT_END_NAMESPACE
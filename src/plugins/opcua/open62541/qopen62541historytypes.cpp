@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopen62541historytypes.h"
+
+#include <cstddef>
+
+QT_BEGIN_NAMESPACE
+
+namespace QOpen62541HistoryTypes {
+
+// Padding before a member as expected by open62541, previousEnd is the offset after the previous member.
+// For array members, the padding is the padding before the size_t length member.
+#define QOPEN62541_PADDING(type, member, previousEnd) (offsetof(type, member) - (previousEnd))
+#define QOPEN62541_END(type, member, memberType) (offsetof(type, member) + sizeof(memberType))
+
+static UA_DataTypeMember HistoryReadValueId_members[4] = {
+    {UA_TYPENAME("NodeId") UA_TYPES_NODEID, 0, true, false},
+    {UA_TYPENAME("IndexRange") UA_TYPES_STRING,
+     QOPEN62541_PADDING(HistoryReadValueId, indexRange, QOPEN62541_END(HistoryReadValueId, nodeId, UA_NodeId)), true, false},
+    {UA_TYPENAME("DataEncoding") UA_TYPES_QUALIFIEDNAME,
+     QOPEN62541_PADDING(HistoryReadValueId, dataEncoding, QOPEN62541_END(HistoryReadValueId, indexRange, UA_String)), true, false},
+    {UA_TYPENAME("ContinuationPoint") UA_TYPES_BYTESTRING,
+     QOPEN62541_PADDING(HistoryReadValueId, continuationPoint, QOPEN62541_END(HistoryReadValueId, dataEncoding, UA_QualifiedName)), true, false}
+};
+
+static UA_DataTypeMember HistoryReadResult_members[3] = {
+    {UA_TYPENAME("StatusCode") UA_TYPES_STATUSCODE, 0, true, false},
+    {UA_TYPENAME("ContinuationPoint") UA_TYPES_BYTESTRING,
+     QOPEN62541_PADDING(HistoryReadResult, continuationPoint, QOPEN62541_END(HistoryReadResult, statusCode, UA_StatusCode)), true, false},
+    {UA_TYPENAME("HistoryData") UA_TYPES_EXTENSIONOBJECT,
+     QOPEN62541_PADDING(HistoryReadResult, historyData, QOPEN62541_END(HistoryReadResult, continuationPoint, UA_ByteString)), true, false}
+};
+
+static UA_DataTypeMember ReadRawModifiedDetails_members[5] = {
+    {UA_TYPENAME("IsReadModified") UA_TYPES_BOOLEAN, 0, true, false},
+    {UA_TYPENAME("StartTime") UA_TYPES_DATETIME,
+     QOPEN62541_PADDING(ReadRawModifiedDetails, startTime, QOPEN62541_END(ReadRawModifiedDetails, isReadModified, UA_Boolean)), true, false},
+    {UA_TYPENAME("EndTime") UA_TYPES_DATETIME,
+     QOPEN62541_PADDING(ReadRawModifiedDetails, endTime, QOPEN62541_END(ReadRawModifiedDetails, startTime, UA_DateTime)), true, false},
+    {UA_TYPENAME("NumValuesPerNode") UA_TYPES_UINT32,
+     QOPEN62541_PADDING(ReadRawModifiedDetails, numValuesPerNode, QOPEN62541_END(ReadRawModifiedDetails, endTime, UA_DateTime)), true, false},
+    {UA_TYPENAME("ReturnBounds") UA_TYPES_BOOLEAN,
+     QOPEN62541_PADDING(ReadRawModifiedDetails, returnBounds, QOPEN62541_END(ReadRawModifiedDetails, numValuesPerNode, UA_UInt32)), true, false}
+};
+
+static UA_DataTypeMember ReadProcessedDetails_members[5] = {
+    {UA_TYPENAME("StartTime") UA_TYPES_DATETIME, 0, true, false},
+    {UA_TYPENAME("EndTime") UA_TYPES_DATETIME,
+     QOPEN62541_PADDING(ReadProcessedDetails, endTime, QOPEN62541_END(ReadProcessedDetails, startTime, UA_DateTime)), true, false},
+    {UA_TYPENAME("ProcessingInterval") UA_TYPES_DOUBLE,
+     QOPEN62541_PADDING(ReadProcessedDetails, processingInterval, QOPEN62541_END(ReadProcessedDetails, endTime, UA_DateTime)), true, false},
+    {UA_TYPENAME("AggregateType") UA_TYPES_NODEID,
+     QOPEN62541_PADDING(ReadProcessedDetails, aggregateTypeSize, QOPEN62541_END(ReadProcessedDetails, processingInterval, UA_Double)), true, true},
+    {UA_TYPENAME("AggregateConfiguration") UA_TYPES_AGGREGATECONFIGURATION,
+     QOPEN62541_PADDING(ReadProcessedDetails, aggregateConfiguration, QOPEN62541_END(ReadProcessedDetails, aggregateType, UA_NodeId *)), true, false}
+};
+
+static UA_DataTypeMember ReadAtTimeDetails_members[2] = {
+    {UA_TYPENAME("ReqTimes") UA_TYPES_DATETIME, 0, true, true},
+    {UA_TYPENAME("UseSimpleBounds") UA_TYPES_BOOLEAN,
+     QOPEN62541_PADDING(ReadAtTimeDetails, useSimpleBounds, QOPEN62541_END(ReadAtTimeDetails, reqTimes, UA_DateTime *)), true, false}
+};
+
+static UA_DataTypeMember HistoryData_members[1] = {
+    {UA_TYPENAME("DataValues") UA_TYPES_DATAVALUE, 0, true, true}
+};
+
+static UA_DataTypeMember ModificationInfo_members[3] = {
+    {UA_TYPENAME("ModificationTime") UA_TYPES_DATETIME, 0, true, false},
+    {UA_TYPENAME("UpdateType") UA_TYPES_INT32,
+     QOPEN62541_PADDING(ModificationInfo, updateType, QOPEN62541_END(ModificationInfo, modificationTime, UA_DateTime)), true, false},
+    {UA_TYPENAME("UserName") UA_TYPES_STRING,
+     QOPEN62541_PADDING(ModificationInfo, userName, QOPEN62541_END(ModificationInfo, updateType, UA_Int32)), true, false}
+};
+
+static UA_DataTypeMember HistoryModifiedData_members[2] = {
+    {UA_TYPENAME("DataValues") UA_TYPES_DATAVALUE, 0, true, true},
+    {UA_TYPENAME("ModificationInfos") ModificationInfoType,
+     QOPEN62541_PADDING(HistoryModifiedData, modificationInfosSize, QOPEN62541_END(HistoryModifiedData, dataValues, UA_DataValue *)), false, true}
+};
+
+static UA_DataTypeMember HistoryReadRequest_members[5] = {
+    {UA_TYPENAME("RequestHeader") UA_TYPES_REQUESTHEADER, 0, true, false},
+    {UA_TYPENAME("HistoryReadDetails") UA_TYPES_EXTENSIONOBJECT,
+     QOPEN62541_PADDING(HistoryReadRequest, historyReadDetails, QOPEN62541_END(HistoryReadRequest, requestHeader, UA_RequestHeader)), true, false},
+    {UA_TYPENAME("TimestampsToReturn") UA_TYPES_TIMESTAMPSTORETURN,
+     QOPEN62541_PADDING(HistoryReadRequest, timestampsToReturn, QOPEN62541_END(HistoryReadRequest, historyReadDetails, UA_ExtensionObject)), true, false},
+    {UA_TYPENAME("ReleaseContinuationPoints") UA_TYPES_BOOLEAN,
+     QOPEN62541_PADDING(HistoryReadRequest, releaseContinuationPoints, QOPEN62541_END(HistoryReadRequest, timestampsToReturn, UA_TimestampsToReturn)), true, false},
+    {UA_TYPENAME("NodesToRead") HistoryReadValueIdType,
+     QOPEN62541_PADDING(HistoryReadRequest, nodesToReadSize, QOPEN62541_END(HistoryReadRequest, releaseContinuationPoints, UA_Boolean)), false, true}
+};
+
+static UA_DataTypeMember HistoryReadResponse_members[3] = {
+    {UA_TYPENAME("ResponseHeader") UA_TYPES_RESPONSEHEADER, 0, true, false},
+    {UA_TYPENAME("Results") HistoryReadResultType,
+     QOPEN62541_PADDING(HistoryReadResponse, resultsSize, QOPEN62541_END(HistoryReadResponse, responseHeader, UA_ResponseHeader)), false, true},
+    {UA_TYPENAME("DiagnosticInfos") UA_TYPES_DIAGNOSTICINFO,
+     QOPEN62541_PADDING(HistoryReadResponse, diagnosticInfosSize, QOPEN62541_END(HistoryReadResponse, results, HistoryReadResult *)), true, true}
+};
+
+#undef QOPEN62541_PADDING
+#undef QOPEN62541_END
+
+// The type ids and binary encoding ids are defined in namespace 0 of the OPC UA specification
+const UA_DataType types[TypeCount] = {
+    {UA_TYPENAME("HistoryReadValueId") {0, UA_NODEIDTYPE_NUMERIC, {635}}, sizeof(HistoryReadValueId), HistoryReadValueIdType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 4, 637, HistoryReadValueId_members},
+    {UA_TYPENAME("HistoryReadResult") {0, UA_NODEIDTYPE_NUMERIC, {638}}, sizeof(HistoryReadResult), HistoryReadResultType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 3, 640, HistoryReadResult_members},
+    {UA_TYPENAME("ReadRawModifiedDetails") {0, UA_NODEIDTYPE_NUMERIC, {647}}, sizeof(ReadRawModifiedDetails), ReadRawModifiedDetailsType,
+     UA_DATATYPEKIND_STRUCTURE, true, false, 5, 649, ReadRawModifiedDetails_members},
+    {UA_TYPENAME("ReadProcessedDetails") {0, UA_NODEIDTYPE_NUMERIC, {650}}, sizeof(ReadProcessedDetails), ReadProcessedDetailsType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 5, 652, ReadProcessedDetails_members},
+    {UA_TYPENAME("ReadAtTimeDetails") {0, UA_NODEIDTYPE_NUMERIC, {653}}, sizeof(ReadAtTimeDetails), ReadAtTimeDetailsType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 2, 655, ReadAtTimeDetails_members},
+    {UA_TYPENAME("HistoryData") {0, UA_NODEIDTYPE_NUMERIC, {656}}, sizeof(HistoryData), HistoryDataType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 1, 658, HistoryData_members},
+    {UA_TYPENAME("ModificationInfo") {0, UA_NODEIDTYPE_NUMERIC, {11216}}, sizeof(ModificationInfo), ModificationInfoType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 3, 11226, ModificationInfo_members},
+    {UA_TYPENAME("HistoryModifiedData") {0, UA_NODEIDTYPE_NUMERIC, {11217}}, sizeof(HistoryModifiedData), HistoryModifiedDataType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 2, 11227, HistoryModifiedData_members},
+    {UA_TYPENAME("HistoryReadRequest") {0, UA_NODEIDTYPE_NUMERIC, {662}}, sizeof(HistoryReadRequest), HistoryReadRequestType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 5, 664, HistoryReadRequest_members},
+    {UA_TYPENAME("HistoryReadResponse") {0, UA_NODEIDTYPE_NUMERIC, {665}}, sizeof(HistoryReadResponse), HistoryReadResponseType,
+     UA_DATATYPEKIND_STRUCTURE, false, false, 3, 667, HistoryReadResponse_members}
+};
+
+const UA_DataTypeArray customTypes = {nullptr, TypeCount, types};
+
+UA_DataValue *dataValues(UA_ExtensionObject *historyData, size_t *size)
+{
+    *size = 0;
+
+    if (historyData->encoding != UA_EXTENSIONOBJECT_DECODED && historyData->encoding != UA_EXTENSIONOBJECT_DECODED_NODELETE)
+        return nullptr;
+
+    // A system library with historizing support decodes the data using its own type descriptions, compare the type ids
+    const UA_DataType *type = historyData->content.decoded.type;
+    if (!type || type->typeId.namespaceIndex != 0 || type->typeId.identifierType != UA_NODEIDTYPE_NUMERIC)
+        return nullptr;
+
+    // HistoryModifiedData starts with the members of HistoryData
+    const UA_UInt32 typeId = type->typeId.identifier.numeric;
+    if (typeId != types[HistoryDataType].typeId.identifier.numeric && typeId != types[HistoryModifiedDataType].typeId.identifier.numeric)
+        return nullptr;
+
+    auto data = static_cast<HistoryData *>(historyData->content.decoded.data);
+    *size = data->dataValuesSize;
+    return data->dataValues;
+}
+
+}
+
+QT_END_NAMESPACE
@@ -63,7 +63,7 @@ QOpen62541Node::~QOpen62541Node()
     UA_NodeId_deleteMembers(&m_nodeId);
 }
 
-bool QOpen62541Node::readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange)
+bool QOpen62541Node::readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange, double maxAge)
 {
     if (!m_client)
         return false;
@@ -75,7 +75,8 @@ bool QOpen62541Node::readAttributes(QOpcUa::NodeAttributes attr, const QString &
                                      Q_ARG(quint64, handle()),
                                      Q_ARG(UA_NodeId, tempId),
                                      Q_ARG(QOpcUa::NodeAttributes, attr),
-                                     Q_ARG(QString, indexRange));
+                                     Q_ARG(QString, indexRange),
+                                     Q_ARG(double, maxAge));
 }
 
 bool QOpen62541Node::enableMonitoring(QOpcUa::NodeAttributes attr, const QOpcUaMonitoringParameters &settings)
@@ -50,7 +50,7 @@ public:
     explicit QOpen62541Node(const UA_NodeId nodeId, QOpen62541Client *client, const QString nodeIdString);
     ~QOpen62541Node() override;
 
-    bool readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange) override;
+    bool readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange, double maxAge) override;
     bool enableMonitoring(QOpcUa::NodeAttributes attr, const QOpcUaMonitoringParameters &settings) override;
     bool disableMonitoring(QOpcUa::NodeAttributes attr) override;
     bool modifyMonitoring(QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameter item, const QVariant &value) override;
@@ -64,6 +64,7 @@ public:
     bool resolveBrowsePath(const QVector<QOpcUaRelativePathElement> &path) override;
 
 private:
+    friend class QOpen62541Client;
     QPointer<QOpen62541Client> m_client;
     QString m_nodeIdString;
     UA_NodeId m_nodeId;
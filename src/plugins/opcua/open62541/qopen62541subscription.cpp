@@ -54,6 +54,9 @@ QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
 
+// open62541 allocates the internal representation of all items of a CreateMonitoredItems request on the stack
+static const int defaultMonitoredItemsPerRequest = 1000;
+
 static void monitoredValueHandler(UA_Client *client, UA_UInt32 subId, void *subContext, UA_UInt32 monId, void *monContext, UA_DataValue *value)
 {
     Q_UNUSED(client)
@@ -253,49 +256,157 @@ bool QOpen62541Subscription::addAttributeMonitoredItem(quint64 handle, QOpcUa::N
     UA_MonitoredItemCreateRequest req;
     UA_MonitoredItemCreateRequest_init(&req);
     UaDeleter<UA_MonitoredItemCreateRequest> requestDeleter(&req, UA_MonitoredItemCreateRequest_deleteMembers);
-    req.itemToMonitor.attributeId = QOpen62541ValueConverter::toUaAttributeId(attr);
-    UA_NodeId_copy(&id, &(req.itemToMonitor.nodeId));
-    if (settings.indexRange().size())
-        QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(settings.indexRange(), &req.itemToMonitor.indexRange);
-    req.monitoringMode = static_cast<UA_MonitoringMode>(settings.monitoringMode());
-    req.requestedParameters.samplingInterval = qFuzzyCompare(settings.samplingInterval(), 0.0) ? m_interval : settings.samplingInterval();
-    req.requestedParameters.queueSize = settings.queueSize() == 0 ? 1 : settings.queueSize();
-    req.requestedParameters.discardOldest = settings.discardOldest();
-    req.requestedParameters.clientHandle = ++m_clientHandle;
 
-    if (settings.filter().isValid()) {
-        UA_ExtensionObject filter = createFilter(settings.filter());
-        if (filter.content.decoded.data)
-            req.requestedParameters.filter = filter;
-        else {
-            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not create monitored item, filter creation failed";
-            QOpcUaMonitoringParameters s;
-            s.setStatusCode(QOpcUa::UaStatusCode::BadInternalError);
-            emit m_backend->monitoringEnableDisable(handle, attr, true, s);
-            return false;
-        }
+    if (!fillMonitoredItemCreateRequest(attr, id, settings, &req)) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not create monitored item, filter creation failed";
+        QOpcUaMonitoringParameters s;
+        s.setStatusCode(QOpcUa::UaStatusCode::BadInternalError);
+        emit m_backend->monitoringEnableDisable(handle, attr, true, s);
+        return false;
     }
 
     UA_MonitoredItemCreateResult res;
     UaDeleter<UA_MonitoredItemCreateResult> resultDeleter(&res, UA_MonitoredItemCreateResult_deleteMembers);
 
-    if (attr == QOpcUa::NodeAttribute::EventNotifier && settings.filter().canConvert<QOpcUaMonitoringParameters::EventFilter>())
+    if (isEventMonitoredItem(attr, settings))
         res = UA_Client_MonitoredItems_createEvent(m_backend->m_uaclient, m_subscriptionId,
                                                    UA_TIMESTAMPSTORETURN_BOTH, req, this, eventHandler, nullptr);
     else
         res = UA_Client_MonitoredItems_createDataChange(m_backend->m_uaclient, m_subscriptionId, UA_TIMESTAMPSTORETURN_BOTH, req, this, monitoredValueHandler, nullptr);
 
-    if (res.statusCode != UA_STATUSCODE_GOOD) {
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not add monitored item for" << attr << "of node" << Open62541Utils::nodeIdToQString(id) << ":" << UA_StatusCode_name(res.statusCode);
+    return handleMonitoredItemCreateResult(handle, attr, id, settings, req.requestedParameters.clientHandle, &res);
+}
+
+QVector<QPair<quint64, QOpcUa::NodeAttribute>> QOpen62541Subscription::addAttributeMonitoredItems(const QVector<QPair<quint64, QOpcUa::NodeAttribute>> &items,
+                                                                                                  const QVector<const UA_NodeId *> &nodeIds,
+                                                                                                  const QOpcUaMonitoringParameters &settings)
+{
+    QVector<QPair<quint64, QOpcUa::NodeAttribute>> created;
+    const int chunkSize = monitoredItemsPerRequest();
+
+    // Event and data change monitored items require different callbacks and are created in separate requests
+    QVector<int> dataChangeItems;
+    QVector<int> eventItems;
+    for (int i = 0; i < items.size(); ++i) {
+        if (isEventMonitoredItem(items.at(i).second, settings))
+            eventItems.push_back(i);
+        else
+            dataChangeItems.push_back(i);
+    }
+
+    for (int i = 0; i < dataChangeItems.size(); i += chunkSize)
+        createMonitoredItems(items, nodeIds, dataChangeItems.mid(i, chunkSize), settings, &created);
+    for (int i = 0; i < eventItems.size(); i += chunkSize)
+        createMonitoredItems(items, nodeIds, eventItems.mid(i, chunkSize), settings, &created);
+
+    return created;
+}
+
+void QOpen62541Subscription::createMonitoredItems(const QVector<QPair<quint64, QOpcUa::NodeAttribute>> &items, const QVector<const UA_NodeId *> &nodeIds,
+                                                  const QVector<int> &indices, const QOpcUaMonitoringParameters &settings,
+                                                  QVector<QPair<quint64, QOpcUa::NodeAttribute>> *created)
+{
+    UA_CreateMonitoredItemsRequest req;
+    UA_CreateMonitoredItemsRequest_init(&req);
+    UaDeleter<UA_CreateMonitoredItemsRequest> requestDeleter(&req, UA_CreateMonitoredItemsRequest_deleteMembers);
+    req.subscriptionId = m_subscriptionId;
+    req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+    req.itemsToCreate = static_cast<UA_MonitoredItemCreateRequest *>(UA_Array_new(indices.size(), &UA_TYPES[UA_TYPES_MONITOREDITEMCREATEREQUEST]));
+
+    QVector<int> requested; // Items which are part of the request, in request order
+    requested.reserve(indices.size());
+
+    for (int index : indices) {
+        const auto &item = items.at(index);
+        if (!fillMonitoredItemCreateRequest(item.second, *nodeIds.at(index), settings, &req.itemsToCreate[req.itemsToCreateSize])) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not create monitored item, filter creation failed";
+            QOpcUaMonitoringParameters s;
+            s.setStatusCode(QOpcUa::UaStatusCode::BadInternalError);
+            emit m_backend->monitoringEnableDisable(item.first, item.second, true, s);
+            continue;
+        }
+        ++req.itemsToCreateSize;
+        requested.push_back(index);
+    }
+
+    if (requested.isEmpty())
+        return;
+
+    const bool isEvent = isEventMonitoredItem(items.at(requested.first()).second, settings);
+
+    QVector<void *> contexts(requested.size(), this);
+    QVector<UA_Client_DeleteMonitoredItemCallback> deleteCallbacks(requested.size(), nullptr);
+
+    UA_CreateMonitoredItemsResponse res;
+    UaDeleter<UA_CreateMonitoredItemsResponse> responseDeleter(&res, UA_CreateMonitoredItemsResponse_deleteMembers);
+
+    if (isEvent) {
+        QVector<UA_Client_EventNotificationCallback> callbacks(requested.size(), eventHandler);
+        res = UA_Client_MonitoredItems_createEvents(m_backend->m_uaclient, req, contexts.data(), callbacks.data(), deleteCallbacks.data());
+    } else {
+        QVector<UA_Client_DataChangeNotificationCallback> callbacks(requested.size(), monitoredValueHandler);
+        res = UA_Client_MonitoredItems_createDataChanges(m_backend->m_uaclient, req, contexts.data(), callbacks.data(), deleteCallbacks.data());
+    }
+
+    for (int i = 0; i < requested.size(); ++i) {
+        const auto &item = items.at(requested.at(i));
+
+        if (res.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not add monitored item for" << item.second << "of node"
+                                                  << Open62541Utils::nodeIdToQString(*nodeIds.at(requested.at(i))) << ":"
+                                                  << UA_StatusCode_name(res.responseHeader.serviceResult);
+            QOpcUaMonitoringParameters s;
+            s.setStatusCode(static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult));
+            emit m_backend->monitoringEnableDisable(item.first, item.second, true, s);
+            continue;
+        }
+
+        if (handleMonitoredItemCreateResult(item.first, item.second, *nodeIds.at(requested.at(i)), settings,
+                                            req.itemsToCreate[i].requestedParameters.clientHandle, &res.results[i]))
+            created->push_back(item);
+    }
+}
+
+bool QOpen62541Subscription::fillMonitoredItemCreateRequest(QOpcUa::NodeAttribute attr, const UA_NodeId &id, const QOpcUaMonitoringParameters &settings,
+                                                            UA_MonitoredItemCreateRequest *req)
+{
+    req->itemToMonitor.attributeId = QOpen62541ValueConverter::toUaAttributeId(attr);
+    UA_NodeId_copy(&id, &(req->itemToMonitor.nodeId));
+    if (settings.indexRange().size())
+        QOpen62541ValueConverter::scalarFromQt<UA_String, QString>(settings.indexRange(), &req->itemToMonitor.indexRange);
+    req->monitoringMode = static_cast<UA_MonitoringMode>(settings.monitoringMode());
+    req->requestedParameters.samplingInterval = qFuzzyCompare(settings.samplingInterval(), 0.0) ? m_interval : settings.samplingInterval();
+    req->requestedParameters.queueSize = settings.queueSize() == 0 ? 1 : settings.queueSize();
+    req->requestedParameters.discardOldest = settings.discardOldest();
+    req->requestedParameters.clientHandle = ++m_clientHandle;
+
+    if (settings.filter().isValid()) {
+        UA_ExtensionObject filter = createFilter(settings.filter());
+        if (!filter.content.decoded.data) {
+            UA_MonitoredItemCreateRequest_deleteMembers(req);
+            return false;
+        }
+        req->requestedParameters.filter = filter;
+    }
+
+    return true;
+}
+
+bool QOpen62541Subscription::handleMonitoredItemCreateResult(quint64 handle, QOpcUa::NodeAttribute attr, const UA_NodeId &id,
+                                                             const QOpcUaMonitoringParameters &settings, UA_UInt32 clientHandle,
+                                                             UA_MonitoredItemCreateResult *res)
+{
+    if (res->statusCode != UA_STATUSCODE_GOOD) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not add monitored item for" << attr << "of node" << Open62541Utils::nodeIdToQString(id) << ":" << UA_StatusCode_name(res->statusCode);
         QOpcUaMonitoringParameters s;
-        s.setStatusCode(static_cast<QOpcUa::UaStatusCode>(res.statusCode));
+        s.setStatusCode(static_cast<QOpcUa::UaStatusCode>(res->statusCode));
         emit m_backend->monitoringEnableDisable(handle, attr, true, s);
         return false;
     }
 
-    MonitoredItem *temp = new MonitoredItem(handle, attr, res.monitoredItemId);
+    MonitoredItem *temp = new MonitoredItem(handle, attr, res->monitoredItemId);
     m_nodeHandleToItemMapping[handle][attr] = temp;
-    m_itemIdToItemMapping[res.monitoredItemId] = temp;
+    m_itemIdToItemMapping[res->monitoredItemId] = temp;
 
     QOpcUaMonitoringParameters s = settings;
     s.setSubscriptionId(m_subscriptionId);
@@ -303,15 +414,15 @@ bool QOpen62541Subscription::addAttributeMonitoredItem(quint64 handle, QOpcUa::N
     s.setMaxKeepAliveCount(m_maxKeepaliveCount);
     s.setLifetimeCount(m_lifetimeCount);
     s.setStatusCode(QOpcUa::UaStatusCode::Good);
-    s.setSamplingInterval(res.revisedSamplingInterval);
-    s.setQueueSize(res.revisedQueueSize);
-    s.setMonitoredItemId(res.monitoredItemId);
+    s.setSamplingInterval(res->revisedSamplingInterval);
+    s.setQueueSize(res->revisedQueueSize);
+    s.setMonitoredItemId(res->monitoredItemId);
     temp->parameters = s;
-    temp->clientHandle = m_clientHandle;
+    temp->clientHandle = clientHandle;
 
-    if (res.filterResult.encoding >= UA_EXTENSIONOBJECT_DECODED &&
-            res.filterResult.content.decoded.type == &UA_TYPES[UA_TYPES_EVENTFILTERRESULT])
-        s.setFilterResult(convertEventFilterResult(&res.filterResult));
+    if (res->filterResult.encoding >= UA_EXTENSIONOBJECT_DECODED &&
+            res->filterResult.content.decoded.type == &UA_TYPES[UA_TYPES_EVENTFILTERRESULT])
+        s.setFilterResult(convertEventFilterResult(&res->filterResult));
     else
         s.clearFilterResult();
 
@@ -320,6 +431,17 @@ bool QOpen62541Subscription::addAttributeMonitoredItem(quint64 handle, QOpcUa::N
     return true;
 }
 
+int QOpen62541Subscription::monitoredItemsPerRequest() const
+{
+    const UA_UInt32 limit = m_backend->m_operationLimits.maxMonitoredItemsPerCall;
+    return limit ? static_cast<int>(qMin<UA_UInt32>(limit, defaultMonitoredItemsPerRequest)) : defaultMonitoredItemsPerRequest;
+}
+
+bool QOpen62541Subscription::isEventMonitoredItem(QOpcUa::NodeAttribute attr, const QOpcUaMonitoringParameters &settings) const
+{
+    return attr == QOpcUa::NodeAttribute::EventNotifier && settings.filter().canConvert<QOpcUaMonitoringParameters::EventFilter>();
+}
+
 bool QOpen62541Subscription::removeAttributeMonitoredItem(quint64 handle, QOpcUa::NodeAttribute attr)
 {
     MonitoredItem *item = getItemForAttribute(handle, attr);
@@ -335,6 +457,60 @@ bool QOpen62541Subscription::removeAttributeMonitoredItem(quint64 handle, QOpcUa
     if (res != UA_STATUSCODE_GOOD)
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not remove monitored item" << item->monitoredItemId << "from subscription" << m_subscriptionId << ":" << UA_StatusCode_name(res);
 
+    removeItem(item, res);
+
+    return true;
+}
+
+void QOpen62541Subscription::removeAttributeMonitoredItems(const QVector<QPair<quint64, QOpcUa::NodeAttribute>> &items)
+{
+    QVector<MonitoredItem *> toRemove;
+    toRemove.reserve(items.size());
+
+    for (const auto &entry : items) {
+        MonitoredItem *item = getItemForAttribute(entry.first, entry.second);
+        if (!item) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "There is no monitored item for this attribute";
+            QOpcUaMonitoringParameters s;
+            s.setStatusCode(QOpcUa::UaStatusCode::BadMonitoredItemIdInvalid);
+            emit m_backend->monitoringEnableDisable(entry.first, entry.second, false, s);
+            continue;
+        }
+        toRemove.push_back(item);
+    }
+
+    const int chunkSize = monitoredItemsPerRequest();
+    for (int offset = 0; offset < toRemove.size(); offset += chunkSize) {
+        const QVector<MonitoredItem *> chunk = toRemove.mid(offset, chunkSize);
+
+        UA_DeleteMonitoredItemsRequest req;
+        UA_DeleteMonitoredItemsRequest_init(&req);
+        UaDeleter<UA_DeleteMonitoredItemsRequest> requestDeleter(&req, UA_DeleteMonitoredItemsRequest_deleteMembers);
+        req.subscriptionId = m_subscriptionId;
+        req.monitoredItemIdsSize = chunk.size();
+        req.monitoredItemIds = static_cast<UA_UInt32 *>(UA_Array_new(chunk.size(), &UA_TYPES[UA_TYPES_UINT32]));
+        for (int i = 0; i < chunk.size(); ++i)
+            req.monitoredItemIds[i] = chunk.at(i)->monitoredItemId;
+
+        UA_DeleteMonitoredItemsResponse res = UA_Client_MonitoredItems_delete(m_backend->m_uaclient, req);
+        UaDeleter<UA_DeleteMonitoredItemsResponse> responseDeleter(&res, UA_DeleteMonitoredItemsResponse_deleteMembers);
+
+        for (int i = 0; i < chunk.size(); ++i) {
+            UA_StatusCode status = res.responseHeader.serviceResult;
+            if (status == UA_STATUSCODE_GOOD)
+                status = static_cast<size_t>(i) < res.resultsSize ? res.results[i] : UA_STATUSCODE_BADINTERNALERROR;
+            if (status != UA_STATUSCODE_GOOD)
+                qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not remove monitored item" << chunk.at(i)->monitoredItemId << "from subscription" << m_subscriptionId << ":" << UA_StatusCode_name(status);
+            removeItem(chunk.at(i), status);
+        }
+    }
+}
+
+void QOpen62541Subscription::removeItem(MonitoredItem *item, UA_StatusCode status)
+{
+    const quint64 handle = item->handle;
+    const QOpcUa::NodeAttribute attr = item->attr;
+
     m_itemIdToItemMapping.remove(item->monitoredItemId);
     auto it = m_nodeHandleToItemMapping.find(handle);
     it->remove(attr);
@@ -344,10 +520,8 @@ bool QOpen62541Subscription::removeAttributeMonitoredItem(quint64 handle, QOpcUa
     delete item;
 
     QOpcUaMonitoringParameters s;
-    s.setStatusCode(static_cast<QOpcUa::UaStatusCode>(res));
+    s.setStatusCode(static_cast<QOpcUa::UaStatusCode>(status));
     emit m_backend->monitoringEnableDisable(handle, attr, false, s);
-
-    return true;
 }
 
 void QOpen62541Subscription::monitoredValueUpdated(UA_UInt32 monId, UA_DataValue *value)
@@ -359,18 +533,18 @@ void QOpen62541Subscription::monitoredValueUpdated(UA_UInt32 monId, UA_DataValue
 
     if (!value || value == UA_EMPTY_ARRAY_SENTINEL) {
         res.setStatusCode(QOpcUa::UaStatusCode::Good);
-        emit m_backend->dataChangeOccurred(item.value()->handle, res);
+        m_backend->queueDataChange(item.value()->handle, res);
         return;
     }
 
-    res.setValue(QOpen62541ValueConverter::toQVariant(value->value));
+    res.setValue(QOpen62541ValueConverter::takeQVariant(&value->value, m_backend->m_arrayConversion));
     res.setAttribute(item.value()->attr);
     if (value->hasServerTimestamp)
         res.setServerTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime, UA_DateTime>(&value->serverTimestamp));
     if (value->hasSourceTimestamp)
         res.setSourceTimestamp(QOpen62541ValueConverter::scalarToQt<QDateTime, UA_DateTime>(&value->sourceTimestamp));
     res.setStatusCode(QOpcUa::UaStatusCode::Good);
-    emit m_backend->dataChangeOccurred(item.value()->handle, res);
+    m_backend->queueDataChange(item.value()->handle, res);
 }
 
 void QOpen62541Subscription::sendTimeoutNotification()
@@ -398,6 +572,11 @@ double QOpen62541Subscription::interval() const
     return m_interval;
 }
 
+UA_UInt32 QOpen62541Subscription::maxKeepAliveCount() const
+{
+    return m_maxKeepaliveCount;
+}
+
 UA_UInt32 QOpen62541Subscription::subscriptionId() const
 {
     return m_subscriptionId;
@@ -60,6 +60,11 @@ public:
     bool addAttributeMonitoredItem(quint64 handle, QOpcUa::NodeAttribute attr, const UA_NodeId &id, QOpcUaMonitoringParameters settings);
     bool removeAttributeMonitoredItem(quint64 handle, QOpcUa::NodeAttribute attr);
 
+    QVector<QPair<quint64, QOpcUa::NodeAttribute>> addAttributeMonitoredItems(const QVector<QPair<quint64, QOpcUa::NodeAttribute>> &items,
+                                                                               const QVector<const UA_NodeId *> &nodeIds,
+                                                                               const QOpcUaMonitoringParameters &settings);
+    void removeAttributeMonitoredItems(const QVector<QPair<quint64, QOpcUa::NodeAttribute>> &items);
+
     void monitoredValueUpdated(UA_UInt32 monId, UA_DataValue *value);
     void eventReceived(UA_UInt32 monId, QVariantList list);
 
@@ -83,6 +88,7 @@ public:
     };
 
     double interval() const;
+    UA_UInt32 maxKeepAliveCount() const;
     UA_UInt32 subscriptionId() const;
     int monitoredItemsCount() const;
 
@@ -93,6 +99,17 @@ signals:
 
 private:
     MonitoredItem *getItemForAttribute(quint64 nodeHandle, QOpcUa::NodeAttribute attr);
+    bool fillMonitoredItemCreateRequest(QOpcUa::NodeAttribute attr, const UA_NodeId &id, const QOpcUaMonitoringParameters &settings,
+                                        UA_MonitoredItemCreateRequest *req);
+    bool handleMonitoredItemCreateResult(quint64 handle, QOpcUa::NodeAttribute attr, const UA_NodeId &id,
+                                         const QOpcUaMonitoringParameters &settings, UA_UInt32 clientHandle,
+                                         UA_MonitoredItemCreateResult *res);
+    void createMonitoredItems(const QVector<QPair<quint64, QOpcUa::NodeAttribute>> &items, const QVector<const UA_NodeId *> &nodeIds,
+                              const QVector<int> &indices, const QOpcUaMonitoringParameters &settings,
+                              QVector<QPair<quint64, QOpcUa::NodeAttribute>> *created);
+    bool isEventMonitoredItem(QOpcUa::NodeAttribute attr, const QOpcUaMonitoringParameters &settings) const;
+    int monitoredItemsPerRequest() const;
+    void removeItem(MonitoredItem *item, UA_StatusCode status);
     UA_ExtensionObject createFilter(const QVariant &filterData);
     void createDataChangeFilter(const QOpcUaMonitoringParameters::DataChangeFilter &filter, UA_ExtensionObject *out);
     void createEventFilter(const QOpcUaMonitoringParameters::EventFilter &filter, UA_ExtensionObject *out);
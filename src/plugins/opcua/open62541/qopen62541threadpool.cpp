@@ -0,0 +1,133 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopen62541threadpool.h"
+
+#include <QtCore/qglobalstatic.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qthread.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
+
+Q_GLOBAL_STATIC(QOpen62541ThreadPool, qOpen62541ThreadPool)
+
+/*
+    A process wide pool of threads for Open62541AsyncBackend objects.
+
+    Each backend lives in exactly one thread of the pool, so all calls to a backend
+    are still processed in the order they have been invoked.
+    New backends are assigned to the thread with the lowest number of backends.
+    The pool grows on demand up to the largest thread count requested by a client.
+    A thread is stopped as soon as the last backend living in it has been released.
+*/
+QOpen62541ThreadPool::QOpen62541ThreadPool()
+{
+}
+
+QOpen62541ThreadPool::~QOpen62541ThreadPool()
+{
+    for (auto thread : qAsConst(m_threads)) {
+        thread->quit();
+        thread->wait();
+        delete thread;
+    }
+
+    // Threads which have been released, but not yet deleted
+    for (const auto &thread : qAsConst(m_stoppingThreads)) {
+        if (thread) {
+            thread->wait();
+            delete thread.data();
+        }
+    }
+}
+
+QOpen62541ThreadPool *QOpen62541ThreadPool::instance()
+{
+    return qOpen62541ThreadPool();
+}
+
+QThread *QOpen62541ThreadPool::acquireThread(int maximumThreadCount)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QThread *result = nullptr;
+
+    for (auto thread : qAsConst(m_threads)) {
+        if (!result || m_load.value(thread) < m_load.value(result))
+            result = thread;
+    }
+
+    // Only start another thread if all existing threads are in use
+    if (m_threads.size() < maximumThreadCount && (!result || m_load.value(result) > 0)) {
+        result = new QThread();
+        result->setObjectName(QStringLiteral("open62541 I/O thread %1").arg(m_startedThreads++));
+        result->start();
+        m_threads.push_back(result);
+        qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Started shared I/O thread" << m_threads.size();
+    }
+
+    if (result)
+        ++m_load[result];
+
+    return result;
+}
+
+void QOpen62541ThreadPool::releaseThread(QThread *thread)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_load.find(thread);
+    if (it == m_load.end() || --it.value() > 0)
+        return;
+
+    // Backends which have been released are deleted by deleteLater(), the remaining
+    // deferred deletes are processed when the thread finishes.
+    // The caller must not wait for the thread, it may still be blocked in a synchronous
+    // service call of the last backend. The thread deletes itself after it has finished.
+    m_load.erase(it);
+    m_threads.removeOne(thread);
+    m_stoppingThreads.removeAll(nullptr);
+    m_stoppingThreads.push_back(thread);
+
+    QObject::connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->quit();
+    qCDebug(QT_OPCUA_PLUGINS_OPEN62541) << "Stopping idle shared I/O thread";
+}
+
+QT_END_NAMESPACE
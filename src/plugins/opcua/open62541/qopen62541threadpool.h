@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPEN62541THREADPOOL_H
+#define QOPEN62541THREADPOOL_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QThread;
+
+class QOpen62541ThreadPool
+{
+public:
+    QOpen62541ThreadPool();
+    ~QOpen62541ThreadPool();
+
+    static QOpen62541ThreadPool *instance();
+
+    QThread *acquireThread(int maximumThreadCount);
+    void releaseThread(QThread *thread);
+
+private:
+    QMutex m_mutex;
+    QVector<QThread *> m_threads;
+    QHash<QThread *, int> m_load; // Thread -> number of backends living in the thread
+    QVector<QPointer<QThread>> m_stoppingThreads; // Released threads which delete themselves when they have finished
+    int m_startedThreads = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPEN62541THREADPOOL_H
@@ -36,9 +36,9 @@
 
 #include "qopen62541utils.h"
 #include <qopcuatype.h>
+#include <private/qopcuanodeidparser_p.h>
 
 #include <QtCore/qloggingcategory.h>
-#include <QtCore/qstringlist.h>
 #include <QtCore/quuid.h>
 
 #include <cstring>
@@ -47,37 +47,78 @@ QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
 
+namespace {
+
+bool copyToByteString(const char *data, size_t length, UA_ByteString *target)
+{
+    if (UA_ByteString_allocBuffer(target, length) != UA_STATUSCODE_GOOD)
+        return false;
+    std::memcpy(target->data, data, length);
+    return true;
+}
+
+void appendNumber(QString &target, quint32 value)
+{
+    char buffer[10];
+    int pos = sizeof(buffer);
+    do {
+        buffer[--pos] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    target.append(QLatin1String(buffer + pos, static_cast<int>(sizeof(buffer)) - pos));
+}
+
+void appendHex(QString &target, quint32 value, int digits)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    char buffer[8];
+    for (int i = digits - 1; i >= 0; --i) {
+        buffer[i] = hexDigits[value & 0xF];
+        value >>= 4;
+    }
+    target.append(QLatin1String(buffer, digits));
+}
+
+} // namespace
+
 UA_NodeId Open62541Utils::nodeIdFromQString(const QString &name)
 {
-    quint16 namespaceIndex;
-    QString identifierString;
-    char identifierType;
-    bool success = QOpcUa::nodeIdStringSplit(name, &namespaceIndex, &identifierString, &identifierType);
+    QOpcUaNodeIdComponents components;
 
-    if (!success) {
+    if (!qt_opcuaParseNodeIdString(name, &components)) {
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Failed to split node id string:" << name;
         return UA_NODEID_NULL;
     }
 
-    switch (identifierType) {
+    const QStringView identifier = QStringView(name).mid(components.identifierOffset);
+    const UA_UInt16 namespaceIndex = components.namespaceIndex;
+
+    switch (components.identifierType) {
     case 'i': {
         bool isNumber;
-        uint identifier = identifierString.toUInt(&isNumber);
-        if (isNumber && identifier <= ((std::numeric_limits<quint32>::max)()))
-            return UA_NODEID_NUMERIC(namespaceIndex, static_cast<UA_UInt32>(identifier));
+        const uint numericIdentifier = name.midRef(components.identifierOffset).toUInt(&isNumber);
+        if (isNumber && numericIdentifier <= ((std::numeric_limits<quint32>::max)()))
+            return UA_NODEID_NUMERIC(namespaceIndex, static_cast<UA_UInt32>(numericIdentifier));
         else
             qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << name << "does not contain a valid numeric identifier";
         break;
     }
     case 's': {
-        if (identifierString.length() > 0)
-            return UA_NODEID_STRING_ALLOC(namespaceIndex, identifierString.toUtf8().constData());
-        else
+        if (identifier.size() > 0) {
+            const QByteArray temp = identifier.toUtf8();
+            UA_NodeId result;
+            UA_NodeId_init(&result);
+            result.namespaceIndex = namespaceIndex;
+            result.identifierType = UA_NODEIDTYPE_STRING;
+            if (copyToByteString(temp.constData(), temp.size(), &result.identifier.string))
+                return result;
+        } else {
             qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << name << "does not contain a valid string identifier";
+        }
         break;
     }
     case 'g': {
-        QUuid uuid(identifierString);
+        const QUuid uuid = QUuid::fromString(identifier);
 
         if (uuid.isNull()) {
             qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << name << "does not contain a valid guid identifier";
@@ -92,12 +133,18 @@ UA_NodeId Open62541Utils::nodeIdFromQString(const QString &name)
         return UA_NODEID_GUID(namespaceIndex, guid);
     }
     case 'b': {
-        const QByteArray temp = QByteArray::fromBase64(identifierString.toLatin1());
+        // The length is copied explicitly, UA_NODEID_BYTESTRING_ALLOC() would stop at the first null byte
+        const QByteArray temp = QByteArray::fromBase64(identifier.toLatin1());
         if (temp.size() > 0) {
-            return UA_NODEID_BYTESTRING_ALLOC(namespaceIndex, temp.constData());
-        }
-        else
+            UA_NodeId result;
+            UA_NodeId_init(&result);
+            result.namespaceIndex = namespaceIndex;
+            result.identifierType = UA_NODEIDTYPE_BYTESTRING;
+            if (copyToByteString(temp.constData(), temp.size(), &result.identifier.byteString))
+                return result;
+        } else {
             qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << name << "does not contain a valid byte string identifier";
+        }
         break;
     }
     default:
@@ -108,34 +155,97 @@ UA_NodeId Open62541Utils::nodeIdFromQString(const QString &name)
 
 QString Open62541Utils::nodeIdToQString(UA_NodeId id)
 {
-    QString result = QString::fromLatin1("ns=%1;").arg(id.namespaceIndex);
+    QString result;
 
     switch (id.identifierType) {
     case UA_NODEIDTYPE_NUMERIC:
-        result.append(QString::fromLatin1("i=%1").arg(id.identifier.numeric));
+        result.reserve(21); // "ns=65535;i=4294967295"
+        result.append(QLatin1String("ns="));
+        appendNumber(result, id.namespaceIndex);
+        result.append(QLatin1String(";i="));
+        appendNumber(result, id.identifier.numeric);
         break;
     case UA_NODEIDTYPE_STRING:
-        result.append(QLatin1String("s="));
-        result.append(QString::fromLocal8Bit(reinterpret_cast<char *>(id.identifier.string.data),
-                                             id.identifier.string.length));
+        // OPC UA strings are UTF-8 encoded
+        result.reserve(11 + static_cast<int>(id.identifier.string.length));
+        result.append(QLatin1String("ns="));
+        appendNumber(result, id.namespaceIndex);
+        result.append(QLatin1String(";s="));
+        result.append(QString::fromUtf8(reinterpret_cast<char *>(id.identifier.string.data),
+                                        static_cast<int>(id.identifier.string.length)));
         break;
     case UA_NODEIDTYPE_GUID: {
         const UA_Guid &src = id.identifier.guid;
-        const QUuid uuid(src.data1, src.data2, src.data3, src.data4[0], src.data4[1], src.data4[2],
-                src.data4[3], src.data4[4], src.data4[5], src.data4[6], src.data4[7]);
-        result.append(QStringLiteral("g=")).append(uuid.toString().midRef(1, 36)); // Remove enclosing {...}
+        result.reserve(47);
+        result.append(QLatin1String("ns="));
+        appendNumber(result, id.namespaceIndex);
+        result.append(QLatin1String(";g="));
+        appendHex(result, src.data1, 8);
+        result.append(QLatin1Char('-'));
+        appendHex(result, src.data2, 4);
+        result.append(QLatin1Char('-'));
+        appendHex(result, src.data3, 4);
+        result.append(QLatin1Char('-'));
+        appendHex(result, src.data4[0], 2);
+        appendHex(result, src.data4[1], 2);
+        result.append(QLatin1Char('-'));
+        for (int i = 2; i < 8; ++i)
+            appendHex(result, src.data4[i], 2);
         break;
     }
     case UA_NODEIDTYPE_BYTESTRING: {
-        const QByteArray temp(reinterpret_cast<char *>(id.identifier.byteString.data), id.identifier.byteString.length);
-        result.append(QStringLiteral("b=")).append(temp.toBase64());
+        const QByteArray temp = QByteArray::fromRawData(reinterpret_cast<char *>(id.identifier.byteString.data),
+                                                        static_cast<int>(id.identifier.byteString.length)).toBase64();
+        result.reserve(11 + temp.size());
+        result.append(QLatin1String("ns="));
+        appendNumber(result, id.namespaceIndex);
+        result.append(QLatin1String(";b="));
+        result.append(QLatin1String(temp));
         break;
     }
     default:
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Open62541 Utils: Could not convert UA_NodeId to QString";
-        result.clear();
     }
     return result;
 }
 
+QOpen62541NodeIdCache::QOpen62541NodeIdCache(int maxEntries)
+    : m_cache(maxEntries)
+{
+}
+
+void QOpen62541NodeIdCache::setMaxEntries(int maxEntries)
+{
+    m_cache.setMaxCost(qMax(0, maxEntries));
+}
+
+int QOpen62541NodeIdCache::maxEntries() const
+{
+    return m_cache.maxCost();
+}
+
+UA_NodeId QOpen62541NodeIdCache::nodeId(const QString &nodeIdString)
+{
+    if (m_cache.maxCost() <= 0)
+        return Open62541Utils::nodeIdFromQString(nodeIdString);
+
+    UA_NodeId result;
+
+    const Entry *entry = m_cache.object(nodeIdString);
+    if (entry) {
+        UA_NodeId_copy(&entry->id, &result);
+        return result;
+    }
+
+    result = Open62541Utils::nodeIdFromQString(nodeIdString);
+    if (UA_NodeId_isNull(&result))
+        return result;
+
+    UA_NodeId cached;
+    if (UA_NodeId_copy(&result, &cached) == UA_STATUSCODE_GOOD)
+        m_cache.insert(nodeIdString, new Entry(cached));
+
+    return result;
+}
+
 QT_END_NAMESPACE
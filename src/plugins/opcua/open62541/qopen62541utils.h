@@ -39,6 +39,7 @@
 
 #include "qopen62541.h"
 
+#include <QtCore/qcache.h>
 #include <QString>
 
 #include <functional>
@@ -98,6 +99,30 @@ namespace Open62541Utils {
     QString nodeIdToQString(UA_NodeId id);
 }
 
+// Bounded cache for the conversion of node id strings to UA_NodeId.
+// The cache is not thread safe and must only be used by the thread which owns it.
+class QOpen62541NodeIdCache
+{
+public:
+    explicit QOpen62541NodeIdCache(int maxEntries = 0);
+
+    void setMaxEntries(int maxEntries);
+    int maxEntries() const;
+
+    // Returns a copy which must be freed by the caller, just like Open62541Utils::nodeIdFromQString()
+    UA_NodeId nodeId(const QString &nodeIdString);
+
+private:
+    struct Entry {
+        Entry(const UA_NodeId &nodeId) : id(nodeId) {}
+        ~Entry() { UA_NodeId_deleteMembers(&id); }
+        Q_DISABLE_COPY(Entry)
+        UA_NodeId id;
+    };
+
+    QCache<QString, Entry> m_cache;
+};
+
 QT_END_NAMESPACE
 
 #endif // QOPEN62541UTILS_H
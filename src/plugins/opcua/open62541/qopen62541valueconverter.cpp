@@ -39,12 +39,15 @@
 #include "qopen62541valueconverter.h"
 
 #include "qopcuamultidimensionalarray.h"
+#include <private/qopcuamultidimensionalarray_p.h>
 
 #include <QtCore/qdatetime.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/quuid.h>
+#include <QtCore/qvector.h>
 
 #include <cstring>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -52,6 +55,112 @@ Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
 
 using namespace QOpcUa::NodeIds;
 
+namespace {
+
+// Element types of QOpcUaMultiDimensionalArray with typed storage which have the same layout as the open62541 type
+QMetaType::Type typedElementType(UA_UInt16 typeIndex)
+{
+    switch (typeIndex) {
+    case UA_TYPES_BOOLEAN:
+        return QMetaType::Bool;
+    case UA_TYPES_SBYTE:
+        return QMetaType::SChar;
+    case UA_TYPES_BYTE:
+        return QMetaType::UChar;
+    case UA_TYPES_INT16:
+        return QMetaType::Short;
+    case UA_TYPES_UINT16:
+        return QMetaType::UShort;
+    case UA_TYPES_INT32:
+        return QMetaType::Int;
+    case UA_TYPES_UINT32:
+        return QMetaType::UInt;
+    case UA_TYPES_INT64:
+        return QMetaType::LongLong;
+    case UA_TYPES_UINT64:
+        return QMetaType::ULongLong;
+    case UA_TYPES_FLOAT:
+        return QMetaType::Float;
+    case UA_TYPES_DOUBLE:
+        return QMetaType::Double;
+    default:
+        return QMetaType::UnknownType;
+    }
+}
+
+const UA_DataType *typedElementDataType(QMetaType::Type elementType)
+{
+    switch (elementType) {
+    case QMetaType::Bool:
+        return &UA_TYPES[UA_TYPES_BOOLEAN];
+    case QMetaType::SChar:
+        return &UA_TYPES[UA_TYPES_SBYTE];
+    case QMetaType::UChar:
+        return &UA_TYPES[UA_TYPES_BYTE];
+    case QMetaType::Short:
+        return &UA_TYPES[UA_TYPES_INT16];
+    case QMetaType::UShort:
+        return &UA_TYPES[UA_TYPES_UINT16];
+    case QMetaType::Int:
+        return &UA_TYPES[UA_TYPES_INT32];
+    case QMetaType::UInt:
+        return &UA_TYPES[UA_TYPES_UINT32];
+    case QMetaType::LongLong:
+        return &UA_TYPES[UA_TYPES_INT64];
+    case QMetaType::ULongLong:
+        return &UA_TYPES[UA_TYPES_UINT64];
+    case QMetaType::Float:
+        return &UA_TYPES[UA_TYPES_FLOAT];
+    case QMetaType::Double:
+        return &UA_TYPES[UA_TYPES_DOUBLE];
+    default:
+        return nullptr;
+    }
+}
+
+void freeUaBuffer(void *data)
+{
+    UA_free(data);
+}
+
+bool isTypedMultiDimensionalArray(const UA_Variant &var)
+{
+    return var.type && var.arrayDimensionsSize > 0 && var.arrayLength > 0 && var.data > UA_EMPTY_ARRAY_SENTINEL
+            && typedElementType(var.type->typeIndex) != QMetaType::UnknownType;
+}
+
+// Creates a QOpcUaMultiDimensionalArray with typed storage, the buffer of var is either copied or moved
+QVariant typedMultiDimensionalArrayToQVariant(UA_Variant *var, bool takeBuffer)
+{
+    // Ensure that the array dimensions fit in a QVector and the length in the array
+    if (var->arrayDimensionsSize > static_cast<quint64>((std::numeric_limits<int>::max)())
+            || var->arrayLength > (std::numeric_limits<quint32>::max)())
+        return QOpcUaMultiDimensionalArray();
+
+    QVector<quint32> arrayDimensions;
+    std::copy(var->arrayDimensions, var->arrayDimensions + var->arrayDimensionsSize, std::back_inserter(arrayDimensions));
+
+    const quint32 length = static_cast<quint32>(var->arrayLength);
+    void *buffer = nullptr;
+
+    if (takeBuffer) {
+        buffer = var->data;
+        var->data = nullptr;
+        var->arrayLength = 0;
+    } else {
+        const size_t size = var->arrayLength * var->type->memSize;
+        buffer = UA_malloc(size);
+        if (!buffer)
+            return QOpcUaMultiDimensionalArray();
+        std::memcpy(buffer, var->data, size);
+    }
+
+    return QOpcUaMultiDimensionalArrayPrivate::fromTypedBuffer(typedElementType(var->type->typeIndex), buffer, length,
+                                                               &freeUaBuffer, arrayDimensions);
+}
+
+} // namespace
+
 namespace QOpen62541ValueConverter {
 
 UA_Variant toOpen62541Variant(const QVariant &value, QOpcUa::Types type)
@@ -61,7 +170,25 @@ UA_Variant toOpen62541Variant(const QVariant &value, QOpcUa::Types type)
 
     if (value.canConvert<QOpcUaMultiDimensionalArray>()) {
         QOpcUaMultiDimensionalArray data = value.value<QOpcUaMultiDimensionalArray>();
-        UA_Variant result = toOpen62541Variant(data.valueArray(), type);
+        const UA_DataType *typedDataType = data.hasTypedStorage() && data.isValid() ?
+                    typedElementDataType(data.elementType()) : nullptr;
+
+        UA_Variant result;
+        if (typedDataType && (type == QOpcUa::Undefined || toDataType(type) == typedDataType)) {
+            // The typed storage has the same layout as the open62541 array
+            const QVector<quint32> arrayDimensions = data.arrayDimensions();
+            const quint64 length = std::accumulate(arrayDimensions.constBegin(), arrayDimensions.constEnd(),
+                                                   quint64(1), std::multiplies<quint64>());
+            UA_Variant_init(&result);
+            void *arr = UA_Array_new(length, typedDataType);
+            if (!arr)
+                return open62541value;
+            if (length)
+                std::memcpy(arr, data.constTypedData(), length * typedDataType->memSize);
+            UA_Variant_setArray(&result, arr, length, typedDataType);
+        } else {
+            result = toOpen62541Variant(data.valueArray(), type);
+        }
 
         if (!data.arrayDimensions().isEmpty()) {
             // Ensure that the array dimensions size is < UINT32_MAX
@@ -74,6 +201,20 @@ UA_Variant toOpen62541Variant(const QVariant &value, QOpcUa::Types type)
         return result;
     }
 
+    // Arrays of numeric and boolean values in a QVector are copied without per element conversion
+    if (typedArrayFromQVariant<bool>(value, QOpcUa::Boolean, type, &open62541value)
+            || typedArrayFromQVariant<qint8>(value, QOpcUa::SByte, type, &open62541value)
+            || typedArrayFromQVariant<quint8>(value, QOpcUa::Byte, type, &open62541value)
+            || typedArrayFromQVariant<qint16>(value, QOpcUa::Int16, type, &open62541value)
+            || typedArrayFromQVariant<quint16>(value, QOpcUa::UInt16, type, &open62541value)
+            || typedArrayFromQVariant<qint32>(value, QOpcUa::Int32, type, &open62541value)
+            || typedArrayFromQVariant<quint32>(value, QOpcUa::UInt32, type, &open62541value)
+            || typedArrayFromQVariant<qint64>(value, QOpcUa::Int64, type, &open62541value)
+            || typedArrayFromQVariant<quint64>(value, QOpcUa::UInt64, type, &open62541value)
+            || typedArrayFromQVariant<float>(value, QOpcUa::Float, type, &open62541value)
+            || typedArrayFromQVariant<double>(value, QOpcUa::Double, type, &open62541value))
+        return open62541value;
+
     if (value.type() == QVariant::List && value.toList().size() == 0)
         return open62541value;
 
@@ -149,12 +290,47 @@ UA_Variant toOpen62541Variant(const QVariant &value, QOpcUa::Types type)
     return open62541value;
 }
 
-QVariant toQVariant(const UA_Variant &value)
+QVariant toQVariant(const UA_Variant &value, ArrayConversion arrayConversion)
 {
     if (value.type == nullptr) {
         return QVariant();
     }
 
+    if (arrayConversion == ArrayConversion::TypedVector && !UA_Variant_isScalar(&value)
+            && value.arrayDimensionsSize == 0 && (value.arrayLength > 0 || value.data == UA_EMPTY_ARRAY_SENTINEL)) {
+        switch (value.type->typeIndex) {
+        case UA_TYPES_BOOLEAN:
+            return typedArrayToQVariant<bool, UA_Boolean>(value);
+        case UA_TYPES_SBYTE:
+            return typedArrayToQVariant<qint8, UA_SByte>(value);
+        case UA_TYPES_BYTE:
+            return typedArrayToQVariant<quint8, UA_Byte>(value);
+        case UA_TYPES_INT16:
+            return typedArrayToQVariant<qint16, UA_Int16>(value);
+        case UA_TYPES_UINT16:
+            return typedArrayToQVariant<quint16, UA_UInt16>(value);
+        case UA_TYPES_INT32:
+            return typedArrayToQVariant<qint32, UA_Int32>(value);
+        case UA_TYPES_UINT32:
+            return typedArrayToQVariant<quint32, UA_UInt32>(value);
+        case UA_TYPES_INT64:
+            return typedArrayToQVariant<qint64, UA_Int64>(value);
+        case UA_TYPES_UINT64:
+            return typedArrayToQVariant<quint64, UA_UInt64>(value);
+        case UA_TYPES_FLOAT:
+            return typedArrayToQVariant<float, UA_Float>(value);
+        case UA_TYPES_DOUBLE:
+            return typedArrayToQVariant<double, UA_Double>(value);
+        default:
+            break; // All other types are returned as QVariantList
+        }
+    }
+
+    if (isTypedMultiDimensionalArray(value)) {
+        UA_Variant shallowCopy = value;
+        return typedMultiDimensionalArrayToQVariant(&shallowCopy, false);
+    }
+
     switch (value.type->typeIndex) {
     case UA_TYPES_BOOLEAN:
         return arrayToQVariant<bool, UA_Boolean>(value, QMetaType::Bool);
@@ -210,6 +386,14 @@ QVariant toQVariant(const UA_Variant &value)
     }
 }
 
+QVariant takeQVariant(UA_Variant *value, ArrayConversion arrayConversion)
+{
+    if (value && value->storageType == UA_VARIANT_DATA && isTypedMultiDimensionalArray(*value))
+        return typedMultiDimensionalArrayToQVariant(value, true);
+
+    return value ? toQVariant(*value, arrayConversion) : QVariant();
+}
+
 const UA_DataType *toDataType(QOpcUa::Types valueType)
 {
     switch (valueType) {
@@ -469,6 +653,21 @@ QVariant arrayToQVariant(const UA_Variant &var, QMetaType::Type type)
     return QVariant(); // Return empty QVariant for empty scalar variant
 }
 
+template<typename TARGETTYPE, typename UATYPE>
+QVariant typedArrayToQVariant(const UA_Variant &var)
+{
+    static_assert(sizeof(TARGETTYPE) == sizeof(UATYPE), "The Qt type must have the same layout as the open62541 type");
+
+    // Ensure that the array fits in a QVector
+    if (var.arrayLength > static_cast<quint64>((std::numeric_limits<int>::max)()))
+        return QVariant();
+
+    QVector<TARGETTYPE> result(static_cast<int>(var.arrayLength));
+    if (var.arrayLength > 0)
+        std::memcpy(result.data(), var.data, var.arrayLength * sizeof(UATYPE));
+    return QVariant::fromValue(result);
+}
+
 template<typename TARGETTYPE, typename QTTYPE>
 void scalarFromQt(const QTTYPE &value, TARGETTYPE *ptr)
 {
@@ -664,6 +863,36 @@ UA_Variant arrayFromQVariant(const QVariant &var, const UA_DataType *type)
     return open62541value;
 }
 
+template<typename QTTYPE>
+bool typedArrayFromQVariant(const QVariant &var, QOpcUa::Types elementType, QOpcUa::Types type, UA_Variant *result)
+{
+    if (var.userType() != qMetaTypeId<QVector<QTTYPE>>())
+        return false;
+
+    // A different type has been requested, the elements must be converted one by one
+    if (type != QOpcUa::Undefined && type != elementType) {
+        *result = toOpen62541Variant(var.value<QVariantList>(), type);
+        return true;
+    }
+
+    const QVector<QTTYPE> &data = *static_cast<const QVector<QTTYPE> *>(var.constData());
+    UA_Variant_init(result);
+
+    if (data.isEmpty())
+        return true;
+
+    const UA_DataType *dt = toDataType(elementType);
+    Q_ASSERT(dt && dt->memSize == sizeof(QTTYPE));
+
+    void *arr = UA_Array_new(data.size(), dt);
+    if (!arr)
+        return true;
+
+    std::memcpy(arr, data.constData(), data.size() * sizeof(QTTYPE));
+    UA_Variant_setArray(result, arr, data.size(), dt);
+    return true;
+}
+
 void createExtensionObject(QByteArray &data, const UA_NodeId &typeEncodingId, UA_ExtensionObject *ptr, QOpcUaExtensionObject::Encoding encoding)
 {
     UA_ExtensionObject obj;
@@ -59,8 +59,16 @@ namespace QOpen62541ValueConverter {
         return static_cast<UA_AttributeId>(0);
     }
 
+    // Determines how one-dimensional arrays of numeric and boolean values are returned by toQVariant()
+    enum class ArrayConversion {
+        VariantList, // QVariantList with one QVariant per element
+        TypedVector  // QVector of the element type which is filled with a single memcpy()
+    };
+
     UA_Variant toOpen62541Variant(const QVariant&, QOpcUa::Types);
-    QVariant toQVariant(const UA_Variant&);
+    QVariant toQVariant(const UA_Variant&, ArrayConversion arrayConversion = ArrayConversion::VariantList);
+    // Like toQVariant(), but the buffer of a numeric multidimensional array is moved out of value
+    QVariant takeQVariant(UA_Variant *value, ArrayConversion arrayConversion = ArrayConversion::VariantList);
     const UA_DataType *toDataType(QOpcUa::Types valueType);
     QOpcUa::Types qvariantTypeToQOpcUaType(QMetaType::Type type);
 
@@ -70,12 +78,18 @@ namespace QOpen62541ValueConverter {
     template<typename TARGETTYPE, typename UATYPE>
     QVariant arrayToQVariant(const UA_Variant &var, QMetaType::Type type = QMetaType::UnknownType);
 
+    template<typename TARGETTYPE, typename UATYPE>
+    QVariant typedArrayToQVariant(const UA_Variant &var);
+
     template<typename TARGETTYPE, typename QTTYPE>
     void scalarFromQt(const QTTYPE &var, TARGETTYPE *ptr);
 
     template<typename TARGETTYPE, typename QTTYPE>
     UA_Variant arrayFromQVariant(const QVariant &var, const UA_DataType *type);
 
+    template<typename QTTYPE>
+    bool typedArrayFromQVariant(const QVariant &var, QOpcUa::Types elementType, QOpcUa::Types type, UA_Variant *result);
+
     void createExtensionObject(QByteArray &data, const UA_NodeId &typeEncodingId, UA_ExtensionObject *ptr,
                                QOpcUaExtensionObject::Encoding encoding = QOpcUaExtensionObject::Encoding::ByteString);
 }
@@ -423,7 +423,7 @@ void UACppAsyncBackend::requestEndpoints(const QUrl &url)
     emit endpointsRequestFinished(ret, static_cast<QOpcUa::UaStatusCode>(res.code()), url);
 }
 
-void UACppAsyncBackend::readAttributes(quint64 handle, const UaNodeId &id, QOpcUa::NodeAttributes attr, QString indexRange)
+void UACppAsyncBackend::readAttributes(quint64 handle, const UaNodeId &id, QOpcUa::NodeAttributes attr, QString indexRange, double maxAge)
 {
     UaStatus result;
 
@@ -447,11 +447,12 @@ void UACppAsyncBackend::readAttributes(quint64 handle, const UaNodeId &id, QOpcU
         }
         QOpcUaReadResult temp;
         temp.setAttribute(attribute);
+        temp.setIndexRange(indexRange);
         vec.push_back(temp);
     });
 
     result = m_nativeSession->read(settings,
-                                   0,
+                                   maxAge,
                                    OpcUa_TimestampsToReturn_Both,
                                    nodeToRead,
                                    values,
@@ -792,7 +793,7 @@ void UACppAsyncBackend::findServers(const QUrl &url, const QStringList &localeId
     emit findServersFinished(ret, static_cast<QOpcUa::UaStatusCode>(result.statusCode()), url);
 }
 
-void UACppAsyncBackend::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead)
+void UACppAsyncBackend::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge)
 {
     if (nodesToRead.size() == 0) {
         emit readNodeAttributesFinished(QVector<QOpcUaReadResult>(), QOpcUa::UaStatusCode::BadNothingToDo);
@@ -815,7 +816,7 @@ void UACppAsyncBackend::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesT
     UaDiagnosticInfos diagnosticInfos;
     ServiceSettings serviceSettings;
 
-    UaStatus result  = m_nativeSession->read(serviceSettings, 0.0 /* maxAge */,
+    UaStatus result  = m_nativeSession->read(serviceSettings, maxAge,
                                              OpcUa_TimestampsToReturn_Both,
                                              nodesToReadNativeType, values,
                                              diagnosticInfos);
@@ -64,7 +64,7 @@ public Q_SLOTS:
     void disconnectFromEndpoint();
 
     void browse(quint64 handle, const UaNodeId &id, const QOpcUaBrowseRequest &request);
-    void readAttributes(quint64 handle, const UaNodeId &id, QOpcUa::NodeAttributes attr, QString indexRange);
+    void readAttributes(quint64 handle, const UaNodeId &id, QOpcUa::NodeAttributes attr, QString indexRange, double maxAge);
     void writeAttribute(quint64 handle, const UaNodeId &id, QOpcUa::NodeAttribute attrId, QVariant value, QOpcUa::Types type, QString indexRange);
     void writeAttributes(quint64 handle, const UaNodeId &id, QOpcUaNode::AttributeMap toWrite, QOpcUa::Types valueAttributeType);
     void enableMonitoring(quint64 handle, const UaNodeId &id, QOpcUa::NodeAttributes attr, const QOpcUaMonitoringParameters &settings);
@@ -78,7 +78,7 @@ public Q_SLOTS:
 
     void findServers(const QUrl &url, const QStringList &localeIds, const QStringList &serverUris);
 
-    void readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead);
+    void readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge);
     void writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite);
 
     // Node management
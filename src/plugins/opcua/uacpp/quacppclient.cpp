@@ -117,10 +117,11 @@ bool QUACppClient::findServers(const QUrl &url, const QStringList &localeIds, co
                                      Q_ARG(QStringList, serverUris));
 }
 
-bool QUACppClient::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead)
+bool QUACppClient::readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge)
 {
     return QMetaObject::invokeMethod(m_backend, "readNodeAttributes", Qt::QueuedConnection,
-                                     Q_ARG(QVector<QOpcUaReadItem>, nodesToRead));
+                                     Q_ARG(QVector<QOpcUaReadItem>, nodesToRead),
+                                     Q_ARG(double, maxAge));
 }
 
 bool QUACppClient::writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite)
@@ -57,7 +57,7 @@ public:
 
     bool findServers(const QUrl &url, const QStringList &localeIds, const QStringList &serverUris) override;
 
-    bool readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead) override;
+    bool readNodeAttributes(const QVector<QOpcUaReadItem> &nodesToRead, double maxAge) override;
     bool writeNodeAttributes(const QVector<QOpcUaWriteItem> &nodesToWrite) override;
 
     bool addNode(const QOpcUaAddNodeItem &nodeToAdd) override;
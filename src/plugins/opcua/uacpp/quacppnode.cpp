@@ -54,7 +54,7 @@ QUACppNode::~QUACppNode()
         m_client->unregisterNode(this);
 }
 
-bool QUACppNode::readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange)
+bool QUACppNode::readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange, double maxAge)
 {
     if (!m_client)
         return false;
@@ -64,7 +64,8 @@ bool QUACppNode::readAttributes(QOpcUa::NodeAttributes attr, const QString &inde
                                      Q_ARG(quint64, handle()),
                                      Q_ARG(UaNodeId, m_nodeId),
                                      Q_ARG(QOpcUa::NodeAttributes, attr),
-                                     Q_ARG(QString, indexRange));
+                                     Q_ARG(QString, indexRange),
+                                     Q_ARG(double, maxAge));
 }
 
 bool QUACppNode::enableMonitoring(QOpcUa::NodeAttributes attr, const QOpcUaMonitoringParameters &settings)
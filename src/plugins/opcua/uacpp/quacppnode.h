@@ -46,7 +46,7 @@ public:
     explicit QUACppNode(const UaNodeId nodeId, QUACppClient *client, const QString nodeIdString);
     ~QUACppNode() override;
 
-    bool readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange) override;
+    bool readAttributes(QOpcUa::NodeAttributes attr, const QString &indexRange, double maxAge) override;
     bool enableMonitoring(QOpcUa::NodeAttributes attr, const QOpcUaMonitoringParameters &settings) override;
     bool disableMonitoring(QOpcUa::NodeAttributes attr) override;
     bool modifyMonitoring(QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameter item, const QVariant &value) override;
@@ -40,10 +40,18 @@
 #include <QtOpcUa/QOpcUaClient>
 #include <QtOpcUa/QOpcUaNode>
 #include <QtOpcUa/QOpcUaProvider>
+#include <QtOpcUa/qopcuaaddressspacecrawler.h>
 #include <QtOpcUa/qopcuabinarydataencoding.h>
+#include <QtOpcUa/qopcuahistoryreadresponse.h>
 #include <QtOpcUa/qopcuamultidimensionalarray.h>
+#include <QtOpcUa/qopcuavaluehistory.h>
+
+#include <private/qopcuaclient_p.h>
+#include <private/qopcuaclientimpl_p.h>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
 #include <QtCore/QProcess>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QThread>
@@ -119,6 +127,53 @@ public:
     QOpcUaClient *opcuaClient;
 };
 
+// Records the debug messages of the open62541 backend while it is in scope.
+// The backend emits its messages from the backend thread.
+class BackendMessageRecorder
+{
+public:
+    BackendMessageRecorder()
+    {
+        QLoggingCategory::setFilterRules(QStringLiteral("qt.opcua.plugins.open62541.debug=true"));
+        m_previousHandler = qInstallMessageHandler(&BackendMessageRecorder::handler);
+    }
+
+    ~BackendMessageRecorder()
+    {
+        qInstallMessageHandler(m_previousHandler);
+        QLoggingCategory::setFilterRules(QString());
+        QMutexLocker locker(&m_mutex);
+        m_messages.clear();
+    }
+
+    QStringList messages(const QString &prefix) const
+    {
+        QMutexLocker locker(&m_mutex);
+        QStringList result;
+        for (const auto &message : qAsConst(m_messages)) {
+            if (message.startsWith(prefix))
+                result.push_back(message);
+        }
+        return result;
+    }
+
+private:
+    static void handler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+    {
+        if (type == QtDebugMsg && qstrcmp(context.category, "qt.opcua.plugins.open62541") == 0) {
+            QMutexLocker locker(&m_mutex);
+            m_messages.push_back(message);
+        }
+    }
+
+    QtMessageHandler m_previousHandler = nullptr;
+    static QMutex m_mutex;
+    static QStringList m_messages;
+};
+
+QMutex BackendMessageRecorder::m_mutex;
+QStringList BackendMessageRecorder::m_messages;
+
 const QString readWriteNode = QStringLiteral("ns=3;s=TestNode.ReadWrite");
 const QVector<QString> xmlElements = {
     QStringLiteral("<?xml version=\"1\" encoding=\"UTF-8\"?>"),
@@ -451,6 +506,8 @@ private slots:
 
     defineDataMethod(multiDimensionalArray_data)
     void multiDimensionalArray();
+    defineDataMethod(multiDimensionalArrayTypedStorage_data)
+    void multiDimensionalArrayTypedStorage();
 
     defineDataMethod(dateTimeConversion_data)
     void dateTimeConversion();
@@ -479,6 +536,47 @@ private slots:
     defineDataMethod(extensionObjectWithGuid_data)
     void extensionObjectWithGuid();
 
+    defineDataMethod(asyncServiceCalls_data)
+    void asyncServiceCalls();
+    defineDataMethod(sharedIoThreads_data)
+    void sharedIoThreads();
+    defineDataMethod(readCoalescing_data)
+    void readCoalescing();
+    defineDataMethod(bulkMonitoring_data)
+    void bulkMonitoring();
+    defineDataMethod(batchReadWriteChunking_data)
+    void batchReadWriteChunking();
+    defineDataMethod(browseNodes_data)
+    void browseNodes();
+    defineDataMethod(addressSpaceCrawler_data)
+    void addressSpaceCrawler();
+    defineDataMethod(addressSpaceCache_data)
+    void addressSpaceCache();
+    defineDataMethod(typedArrays_data)
+    void typedArrays();
+    defineDataMethod(batchedDataChanges_data)
+    void batchedDataChanges();
+    defineDataMethod(dataChangeQueue_data)
+    void dataChangeQueue();
+    defineDataMethod(deliveryThrottling_data)
+    void deliveryThrottling();
+    defineDataMethod(queuedDataChanges_data)
+    void queuedDataChanges();
+    defineDataMethod(valueHistory_data)
+    void valueHistory();
+    defineDataMethod(historyRead_data)
+    void historyRead();
+    defineDataMethod(registerNodes_data)
+    void registerNodes();
+    defineDataMethod(attributeCache_data)
+    void attributeCache();
+    defineDataMethod(valueHandles_data)
+    void valueHandles();
+    defineDataMethod(futures_data)
+    void futures();
+    defineDataMethod(callMethods_data)
+    void callMethods();
+
     void statusStrings();
 
     // This test case restarts the server. It must be run last to avoid
@@ -826,6 +924,20 @@ void Tst_QOpcUaClient::compareNodeIds()
         QCOMPARE(identifierType, 'b');
         QCOMPARE(identifier, QStringLiteral("UXQgZnR3IQ=="));
     }
+    {
+        quint16 namespaceIndex = 0;
+        char identifierType = 0;
+        QString identifier;
+        QVERIFY(QOpcUa::nodeIdStringSplit(QStringLiteral("ns=65535;s=Test;String"), nullptr, nullptr, nullptr) == false);
+        QVERIFY(QOpcUa::nodeIdStringSplit(QStringLiteral("ns=65536;i=42"), nullptr, nullptr, nullptr) == false);
+        QVERIFY(QOpcUa::nodeIdStringSplit(QStringLiteral("ns=1x;i=42"), nullptr, nullptr, nullptr) == false);
+        QVERIFY(QOpcUa::nodeIdStringSplit(QStringLiteral("ns=1;x=42"), nullptr, nullptr, nullptr) == false);
+        QVERIFY(QOpcUa::nodeIdStringSplit(QStringLiteral("ns=1;i="), nullptr, nullptr, nullptr) == false);
+        QVERIFY(QOpcUa::nodeIdStringSplit(QStringLiteral("ns=65535;s=Test String"), &namespaceIndex, &identifier, &identifierType));
+        QCOMPARE(namespaceIndex, 65535);
+        QCOMPARE(identifierType, 's');
+        QCOMPARE(identifier, QStringLiteral("Test String"));
+    }
 }
 
 void Tst_QOpcUaClient::readNS0OmitNode()
@@ -1059,6 +1171,14 @@ void Tst_QOpcUaClient::getRootNode()
     READ_MANDATORY_BASE_NODE(root)
     QCOMPARE(root->attribute(QOpcUa::NodeAttribute::DisplayName).value<QOpcUaLocalizedText>().text(), QLatin1String("Root"));
 
+    // None and combinations of attributes never have an entry
+    const auto combined = static_cast<QOpcUa::NodeAttribute>(int(QOpcUa::NodeAttribute::NodeId | QOpcUa::NodeAttribute::DisplayName));
+    for (const auto attribute : {QOpcUa::NodeAttribute::None, combined}) {
+        QVERIFY(!root->attribute(attribute).isValid());
+        QCOMPARE(root->attributeError(attribute), QOpcUa::UaStatusCode::BadNoEntryExists);
+        QVERIFY(root->sourceTimestamp(attribute).isNull());
+    }
+
     QString nodeId = root->nodeId();
     QCOMPARE(nodeId, QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::RootFolder));
 }
@@ -3318,6 +3438,58 @@ void Tst_QOpcUaClient::multiDimensionalArray()
     QCOMPARE(arr, readBack);
 }
 
+void Tst_QOpcUaClient::multiDimensionalArrayTypedStorage()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    const QVector<quint32> arrayDimensions({2, 2, 3});
+    QOpcUaMultiDimensionalArray arr(QMetaType::Double, arrayDimensions);
+    QVERIFY(arr.isValid());
+    QVERIFY(arr.hasTypedStorage());
+    QCOMPARE(arr.elementType(), QMetaType::Double);
+    QCOMPARE(arr.strides(), QVector<quint32>({6, 3, 1}));
+
+    double *values = static_cast<double *>(arr.typedData());
+    QVERIFY(values != nullptr);
+    for (int i = 0; i < 12; ++i)
+        values[i] = i;
+    QVERIFY(arr.setValue({1, 1, 2}, 42));
+    QCOMPARE(arr.value({1, 1, 2}), 42.0);
+    QCOMPARE(values[arr.arrayIndex({1, 1, 2})], 42.0);
+    QVERIFY(!arr.setValue({1, 1, 2}, QStringLiteral("NotANumber")));
+
+    // The typed storage and the QVariantList storage are interchangeable
+    QVariantList list({0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 42.0});
+    QCOMPARE(arr.valueArray(), list);
+    QCOMPARE(arr, QOpcUaMultiDimensionalArray(list, arrayDimensions));
+
+    QOpcUaMultiDimensionalArray copy = arr;
+    copy.valueArrayRef()[0] = 23.0;
+    QVERIFY(!copy.hasTypedStorage());
+    QCOMPARE(copy.value({0, 0, 0}), 23.0);
+    QCOMPARE(arr.value({0, 0, 0}), 0.0);
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node("ns=2;s=Demo.Static.Arrays.MultiDimensionalDouble"));
+    QVERIFY(node != nullptr);
+    WRITE_VALUE_ATTRIBUTE(node, arr, QOpcUa::Double);
+    READ_MANDATORY_VARIABLE_NODE(node);
+
+    QOpcUaMultiDimensionalArray readBack = node->attribute(QOpcUa::NodeAttribute::Value).value<QOpcUaMultiDimensionalArray>();
+    QVERIFY(readBack.isValid());
+    QCOMPARE(readBack.arrayDimensions(), arrayDimensions);
+    QCOMPARE(readBack, arr);
+
+    if (opcuaClient->backend() == QLatin1String("open62541")) {
+        QVERIFY(readBack.hasTypedStorage());
+        QCOMPARE(readBack.elementType(), QMetaType::Double);
+        const double *readValues = static_cast<const double *>(readBack.constTypedData());
+        QCOMPARE(readValues[readBack.arrayIndex({0, 1, 2})], 5.0);
+        QCOMPARE(readValues[readBack.arrayIndex({1, 1, 2})], 42.0);
+    }
+}
+
 void Tst_QOpcUaClient::dateTimeConversion()
 {
     QFETCH(QOpcUaClient *, opcuaClient);
@@ -3386,6 +3558,24 @@ void Tst_QOpcUaClient::timeStamps()
     QCOMPARE(monitoringDisabledSpy.size(), 1);
     QCOMPARE(monitoringDisabledSpy.at(0).at(0).value<QOpcUa::NodeAttribute>(), QOpcUa::NodeAttribute::Value);
     QCOMPARE(monitoringDisabledSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    // The source timestamp is the one written by the client, the server timestamp is set by the server's Read service
+    const QDateTime sourceTimestamp = QDateTime::fromString(QStringLiteral("2018-08-03 01:00:00"), Qt::ISODate);
+    QOpcUaWriteItem writeItem(QStringLiteral("ns=2;s=Demo.Static.Scalar.Double"), QOpcUa::NodeAttribute::Value,
+                              23.0, QOpcUa::Types::Double);
+    writeItem.setSourceTimestamp(sourceTimestamp);
+    QSignalSpy writeNodeAttributesSpy(opcuaClient, &QOpcUaClient::writeNodeAttributesFinished);
+    QVERIFY(opcuaClient->writeNodeAttributes({writeItem}));
+    writeNodeAttributesSpy.wait(signalSpyTimeout);
+    QCOMPARE(writeNodeAttributesSpy.size(), 1);
+    QCOMPARE(writeNodeAttributesSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    QScopedPointer<QOpcUaNode> doubleScalarNode(opcuaClient->node("ns=2;s=Demo.Static.Scalar.Double"));
+    QVERIFY(doubleScalarNode != nullptr);
+    const QDateTime beforeRead = QDateTime::currentDateTimeUtc().addSecs(-60);
+    READ_MANDATORY_VARIABLE_NODE(doubleScalarNode);
+    QCOMPARE(doubleScalarNode->sourceTimestamp(QOpcUa::NodeAttribute::Value), sourceTimestamp);
+    QVERIFY(doubleScalarNode->serverTimestamp(QOpcUa::NodeAttribute::Value) > beforeRead);
 }
 
 void Tst_QOpcUaClient::createNodeFromExpandedId()
@@ -3633,6 +3823,1432 @@ void Tst_QOpcUaClient::extensionObjectWithGuid()
     QCOMPARE(decodedNodeId, sampleNodeId);
 }
 
+void Tst_QOpcUaClient::asyncServiceCalls()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Asynchronous service calls are only available in the open62541 backend");
+
+    QVariantMap backendOptions;
+    backendOptions.insert(QLatin1String("enableAsyncServiceCalls"), true);
+    QScopedPointer<QOpcUaClient> client(m_opcUa.createClient(opcuaClient->backend(), backendOptions));
+    QVERIFY(client != nullptr);
+    OpcuaConnector connector(client.data(), m_endpoint);
+
+    // Send all requests before waiting for the first result
+    const int requestCount = 25;
+    QVector<QSharedPointer<QOpcUaNode>> readNodes;
+    QVector<QSharedPointer<QSignalSpy>> readSpies;
+    for (int i = 0; i < requestCount; ++i) {
+        QSharedPointer<QOpcUaNode> node(client->node(QStringLiteral("ns=2;s=Demo.Static.Scalar.Double")));
+        QVERIFY(node != nullptr);
+        readSpies.push_back(QSharedPointer<QSignalSpy>::create(node.data(), &QOpcUaNode::attributeRead));
+        node->readAttributes(QOpcUaNode::mandatoryBaseAttributes() | QOpcUa::NodeAttribute::Value);
+        readNodes.push_back(node);
+    }
+
+    // Large.Folder requires BrowseNext requests which are chained to the asynchronous browse request
+    QScopedPointer<QOpcUaNode> folderNode(client->node("ns=1;s=Large.Folder"));
+    QVERIFY(folderNode != nullptr);
+    QSignalSpy browseSpy(folderNode.data(), &QOpcUaNode::browseFinished);
+    folderNode->browseChildren(QOpcUa::ReferenceTypeId::HierarchicalReferences, QOpcUa::NodeClass::Object);
+
+    QSignalSpy readNodeAttributesSpy(client.data(), &QOpcUaClient::readNodeAttributesFinished);
+    QVector<QOpcUaReadItem> request;
+    request.push_back(QOpcUaReadItem(QStringLiteral("ns=2;s=Demo.Static.Scalar.Double"),
+                                     QOpcUa::NodeAttribute::DisplayName));
+    request.push_back(QOpcUaReadItem(QStringLiteral("ns=2;s=Demo.Static.Arrays.UInt32")));
+    client->readNodeAttributes(request);
+
+    for (int i = 0; i < requestCount; ++i) {
+        QTRY_COMPARE_WITH_TIMEOUT(readSpies.at(i)->size(), 1, signalSpyTimeout);
+        QVERIFY(QOpcUa::isSuccessStatus(readNodes.at(i)->attributeError(QOpcUa::NodeAttribute::Value)));
+        QCOMPARE(readNodes.at(i)->attribute(QOpcUa::NodeAttribute::NodeId).toString(),
+                 QStringLiteral("ns=2;s=Demo.Static.Scalar.Double"));
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(browseSpy.size(), 1, signalSpyTimeout);
+    QCOMPARE(browseSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(browseSpy.at(0).at(0).value<QVector<QOpcUaReferenceDescription>>().size(), 100);
+
+    QTRY_COMPARE_WITH_TIMEOUT(readNodeAttributesSpy.size(), 1, signalSpyTimeout);
+    QCOMPARE(readNodeAttributesSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+    const auto results = readNodeAttributesSpy.at(0).at(0).value<QVector<QOpcUaReadResult>>();
+    QCOMPARE(results.size(), 2);
+    for (const auto &result : results)
+        QCOMPARE(result.statusCode(), QOpcUa::UaStatusCode::Good);
+
+    // Writes and method calls use the same asynchronous dispatch
+    QScopedPointer<QOpcUaNode> writeNode(client->node(readWriteNode));
+    QVERIFY(writeNode != nullptr);
+    WRITE_VALUE_ATTRIBUTE(writeNode, 23.0, QOpcUa::Types::Double);
+    READ_MANDATORY_VARIABLE_NODE(writeNode);
+    QCOMPARE(writeNode->attribute(QOpcUa::NodeAttribute::Value).toDouble(), 23.0);
+
+    QScopedPointer<QOpcUaNode> methodNode(client->node("ns=3;s=TestFolder"));
+    QVERIFY(methodNode != nullptr);
+    QSignalSpy methodSpy(methodNode.data(), &QOpcUaNode::methodCallFinished);
+    QVector<QOpcUa::TypedVariant> args;
+    for (int i = 0; i < 2; i++)
+        args.push_back(QOpcUa::TypedVariant(double(4), QOpcUa::Double));
+    QVERIFY(methodNode->callMethod("ns=3;s=Test.Method.Multiply", args));
+    methodSpy.wait(signalSpyTimeout);
+    QCOMPARE(methodSpy.size(), 1);
+    QCOMPARE(methodSpy.at(0).at(1).value<double>(), 16.0);
+    QCOMPARE(methodSpy.at(0).at(2).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+}
+
+void Tst_QOpcUaClient::sharedIoThreads()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Shared I/O threads are only available in the open62541 backend");
+
+    QVariantMap backendOptions;
+    backendOptions.insert(QLatin1String("sharedIoThreads"), 2);
+    backendOptions.insert(QLatin1String("enableAsyncServiceCalls"), true);
+
+    // More clients than threads, some of them share a thread
+    QVector<QSharedPointer<QOpcUaClient>> clients;
+    for (int i = 0; i < 5; ++i) {
+        QSharedPointer<QOpcUaClient> client(m_opcUa.createClient(opcuaClient->backend(), backendOptions));
+        QVERIFY(client != nullptr);
+        client->connectToEndpoint(m_endpoint);
+        clients.push_back(client);
+    }
+
+    for (const auto &client : qAsConst(clients))
+        QTRY_VERIFY2(client->state() == QOpcUaClient::Connected, "Could not connect to server");
+
+    // The backends of the five clients live in two threads
+    QSet<QThread *> threads;
+    for (const auto &client : qAsConst(clients)) {
+        QThread *thread = static_cast<QOpcUaClientPrivate *>(QObjectPrivate::get(client.data()))->m_impl->backendThread();
+        QVERIFY(thread != nullptr);
+        QVERIFY(thread != QThread::currentThread());
+        threads.insert(thread);
+    }
+    QCOMPARE(threads.size(), 2);
+
+    QVector<QSharedPointer<QOpcUaNode>> nodes;
+    QVector<QSharedPointer<QSignalSpy>> spies;
+    for (const auto &client : qAsConst(clients)) {
+        QSharedPointer<QOpcUaNode> node(client->node(readWriteNode));
+        QVERIFY(node != nullptr);
+        spies.push_back(QSharedPointer<QSignalSpy>::create(node.data(), &QOpcUaNode::attributeRead));
+        node->readAttributes(QOpcUaNode::mandatoryBaseAttributes() | QOpcUa::NodeAttribute::Value);
+        nodes.push_back(node);
+    }
+
+    for (int i = 0; i < nodes.size(); ++i) {
+        QTRY_COMPARE_WITH_TIMEOUT(spies.at(i)->size(), 1, signalSpyTimeout);
+        QVERIFY(QOpcUa::isSuccessStatus(nodes.at(i)->attributeError(QOpcUa::NodeAttribute::Value)));
+    }
+
+    nodes.clear();
+
+    for (const auto &client : qAsConst(clients))
+        client->disconnectFromEndpoint();
+    for (const auto &client : qAsConst(clients))
+        QTRY_VERIFY2(client->state() == QOpcUaClient::Disconnected, "Could not disconnect from server");
+
+    // The threads are stopped and deleted when the last client using them is gone
+    QVector<QPointer<QThread>> threadPointers;
+    for (QThread *thread : qAsConst(threads))
+        threadPointers.push_back(thread);
+    clients.clear();
+    for (const auto &thread : qAsConst(threadPointers))
+        QVERIFY(thread.isNull());
+}
+
+void Tst_QOpcUaClient::readCoalescing()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Read coalescing is only available in the open62541 backend");
+
+    QVariantMap backendOptions;
+    backendOptions.insert(QLatin1String("readCoalescingInterval"), 10);
+    QScopedPointer<QOpcUaClient> client(m_opcUa.createClient(opcuaClient->backend(), backendOptions));
+    QVERIFY(client != nullptr);
+    OpcuaConnector connector(client.data(), m_endpoint);
+
+    BackendMessageRecorder recorder;
+
+    // The reads of all nodes end up in one read request, each node must only get its own results
+    const QStringList nodeIds = {QStringLiteral("ns=2;s=Demo.Static.Scalar.Double"), QStringLiteral("ns=0;s=doesnotexist"),
+                                 readWriteNode, QStringLiteral("ns=2;s=Demo.Static.Arrays.UInt32")};
+    QVector<QSharedPointer<QOpcUaNode>> nodes;
+    QVector<QSharedPointer<QSignalSpy>> spies;
+    for (const auto &nodeId : nodeIds) {
+        QSharedPointer<QOpcUaNode> node(client->node(nodeId));
+        QVERIFY(node != nullptr);
+        spies.push_back(QSharedPointer<QSignalSpy>::create(node.data(), &QOpcUaNode::attributeRead));
+        node->readAttributes(QOpcUaNode::mandatoryBaseAttributes());
+        nodes.push_back(node);
+    }
+
+    for (int i = 0; i < nodes.size(); ++i) {
+        QTRY_COMPARE_WITH_TIMEOUT(spies.at(i)->size(), 1, signalSpyTimeout);
+        QCOMPARE(spies.at(i)->at(0).at(0).value<QOpcUa::NodeAttributes>(), QOpcUaNode::mandatoryBaseAttributes());
+        if (nodeIds.at(i) == QLatin1String("ns=0;s=doesnotexist")) {
+            QCOMPARE(nodes.at(i)->attributeError(QOpcUa::NodeAttribute::NodeId), QOpcUa::UaStatusCode::BadNodeIdUnknown);
+        } else {
+            QCOMPARE(nodes.at(i)->attributeError(QOpcUa::NodeAttribute::NodeId), QOpcUa::UaStatusCode::Good);
+            QCOMPARE(nodes.at(i)->attribute(QOpcUa::NodeAttribute::NodeId).toString(), nodeIds.at(i));
+        }
+    }
+
+    // All reads were issued within the coalescing interval and must have been sent in a single Read service call
+    const int attributeCount = qPopulationCount(static_cast<quint32>(QOpcUaNode::mandatoryBaseAttributes()));
+    const QStringList readRequests = recorder.messages(QStringLiteral("Sending"));
+    QCOMPARE(readRequests.size(), 1);
+    QCOMPARE(readRequests.at(0), QStringLiteral("Sending %1 coalesced reads with %2 attributes in one read request")
+             .arg(nodes.size()).arg(nodes.size() * attributeCount));
+}
+
+void Tst_QOpcUaClient::bulkMonitoring()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    const QStringList nodeIds = {QStringLiteral("ns=2;s=Demo.Static.Scalar.Double"), QStringLiteral("ns=0;s=doesnotexist"),
+                                 readWriteNode, QStringLiteral("ns=2;s=Demo.Static.Arrays.UInt32")};
+    QVector<QSharedPointer<QOpcUaNode>> nodes;
+    QVector<QOpcUaNode *> nodePointers;
+    QVector<QSharedPointer<QSignalSpy>> enabledSpies;
+    QVector<QSharedPointer<QSignalSpy>> disabledSpies;
+    for (const auto &nodeId : nodeIds) {
+        QSharedPointer<QOpcUaNode> node(opcuaClient->node(nodeId));
+        QVERIFY(node != nullptr);
+        enabledSpies.push_back(QSharedPointer<QSignalSpy>::create(node.data(), &QOpcUaNode::enableMonitoringFinished));
+        disabledSpies.push_back(QSharedPointer<QSignalSpy>::create(node.data(), &QOpcUaNode::disableMonitoringFinished));
+        nodes.push_back(node);
+        nodePointers.push_back(node.data());
+    }
+
+    QVERIFY(opcuaClient->enableMonitoring(nodePointers, QOpcUa::NodeAttribute::Value, QOpcUaMonitoringParameters(100)));
+
+    for (int i = 0; i < nodes.size(); ++i) {
+        QTRY_COMPARE_WITH_TIMEOUT(enabledSpies.at(i)->size(), 1, signalSpyTimeout);
+        QCOMPARE(enabledSpies.at(i)->at(0).at(0).value<QOpcUa::NodeAttribute>(), QOpcUa::NodeAttribute::Value);
+        const auto expectedStatus = nodeIds.at(i) == QLatin1String("ns=0;s=doesnotexist") ? QOpcUa::UaStatusCode::BadNodeIdUnknown
+                                                                                          : QOpcUa::UaStatusCode::Good;
+        QCOMPARE(enabledSpies.at(i)->at(0).at(1).value<QOpcUa::UaStatusCode>(), expectedStatus);
+        QCOMPARE(nodes.at(i)->monitoringStatus(QOpcUa::NodeAttribute::Value).statusCode(), expectedStatus);
+    }
+
+    // All monitored items share one subscription
+    const quint32 subscriptionId = nodes.at(0)->monitoringStatus(QOpcUa::NodeAttribute::Value).subscriptionId();
+    QVERIFY(subscriptionId != 0);
+    QCOMPARE(nodes.at(2)->monitoringStatus(QOpcUa::NodeAttribute::Value).subscriptionId(), subscriptionId);
+    QCOMPARE(nodes.at(3)->monitoringStatus(QOpcUa::NodeAttribute::Value).subscriptionId(), subscriptionId);
+
+    QVERIFY(opcuaClient->disableMonitoring(nodePointers, QOpcUa::NodeAttribute::Value));
+
+    for (int i = 0; i < nodes.size(); ++i) {
+        if (nodeIds.at(i) == QLatin1String("ns=0;s=doesnotexist"))
+            continue;
+        QTRY_COMPARE_WITH_TIMEOUT(disabledSpies.at(i)->size(), 1, signalSpyTimeout);
+        QCOMPARE(disabledSpies.at(i)->at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+        QCOMPARE(nodes.at(i)->monitoringStatus(QOpcUa::NodeAttribute::Value).statusCode(), QOpcUa::UaStatusCode::BadNoEntryExists);
+    }
+
+    // Nodes of other clients are rejected
+    QScopedPointer<QOpcUaClient> otherClient(m_opcUa.createClient(opcuaClient->backend()));
+    QVERIFY(otherClient != nullptr);
+    OpcuaConnector otherConnector(otherClient.data(), m_endpoint);
+    QScopedPointer<QOpcUaNode> foreignNode(otherClient->node(readWriteNode));
+    QVERIFY(foreignNode != nullptr);
+    QVERIFY(!opcuaClient->enableMonitoring({foreignNode.data()}, QOpcUa::NodeAttribute::Value, QOpcUaMonitoringParameters(100)));
+}
+
+void Tst_QOpcUaClient::batchReadWriteChunking()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Splitting batch requests according to the operation limits is only available in the open62541 backend");
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    // The test server limits the number of nodes per read and write request to 100
+    const int batchSize = 350;
+    const QStringList nodeIds = {QStringLiteral("ns=2;s=Demo.Static.Scalar.Double"), readWriteNode,
+                                 QStringLiteral("ns=0;s=doesnotexist")};
+
+    QVector<QOpcUaReadItem> readRequest;
+    for (int i = 0; i < batchSize; ++i)
+        readRequest.push_back(QOpcUaReadItem(nodeIds.at(i % nodeIds.size()),
+                                             i % 2 ? QOpcUa::NodeAttribute::Value : QOpcUa::NodeAttribute::NodeId));
+
+    QSignalSpy readSpy(opcuaClient, &QOpcUaClient::readNodeAttributesFinished);
+    QVERIFY(opcuaClient->readNodeAttributes(readRequest));
+    readSpy.wait(signalSpyTimeout);
+    QCOMPARE(readSpy.size(), 1);
+    QCOMPARE(readSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    const auto readResults = readSpy.at(0).at(0).value<QVector<QOpcUaReadResult>>();
+    QCOMPARE(readResults.size(), batchSize);
+    for (int i = 0; i < batchSize; ++i) {
+        QCOMPARE(readResults.at(i).nodeId(), readRequest.at(i).nodeId());
+        QCOMPARE(readResults.at(i).attribute(), readRequest.at(i).attribute());
+        if (readRequest.at(i).nodeId() == QLatin1String("ns=0;s=doesnotexist")) {
+            QCOMPARE(readResults.at(i).statusCode(), QOpcUa::UaStatusCode::BadNodeIdUnknown);
+        } else {
+            QCOMPARE(readResults.at(i).statusCode(), QOpcUa::UaStatusCode::Good);
+            if (readRequest.at(i).attribute() == QOpcUa::NodeAttribute::NodeId)
+                QCOMPARE(readResults.at(i).value().toString(), readRequest.at(i).nodeId());
+        }
+    }
+
+    QVector<QOpcUaWriteItem> writeRequest;
+    for (int i = 0; i < batchSize; ++i)
+        writeRequest.push_back(QOpcUaWriteItem(i % 2 ? readWriteNode : QStringLiteral("ns=0;s=doesnotexist"),
+                                               QOpcUa::NodeAttribute::Value, double(i), QOpcUa::Types::Double));
+
+    QSignalSpy writeSpy(opcuaClient, &QOpcUaClient::writeNodeAttributesFinished);
+    QVERIFY(opcuaClient->writeNodeAttributes(writeRequest));
+    writeSpy.wait(signalSpyTimeout);
+    QCOMPARE(writeSpy.size(), 1);
+    QCOMPARE(writeSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    const auto writeResults = writeSpy.at(0).at(0).value<QVector<QOpcUaWriteResult>>();
+    QCOMPARE(writeResults.size(), batchSize);
+    for (int i = 0; i < batchSize; ++i) {
+        QCOMPARE(writeResults.at(i).nodeId(), writeRequest.at(i).nodeId());
+        QCOMPARE(writeResults.at(i).statusCode(), i % 2 ? QOpcUa::UaStatusCode::Good : QOpcUa::UaStatusCode::BadNodeIdUnknown);
+    }
+
+    // The last write wins
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != nullptr);
+    READ_MANDATORY_VARIABLE_NODE(node);
+    QCOMPARE(node->attribute(QOpcUa::NodeAttribute::Value).toDouble(), double(batchSize - 1));
+}
+
+void Tst_QOpcUaClient::browseNodes()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Browsing multiple nodes is only available in the open62541 backend");
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QStringList nodeIds = {QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::RootFolder),
+                           QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::ObjectsFolder),
+                           QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::Server),
+                           QStringLiteral("ns=0;s=doesnotexist")};
+    // More nodes than the test server accepts in one browse request
+    for (int i = 0; i < 150; ++i)
+        nodeIds.push_back(QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::RootFolder));
+
+    QOpcUaBrowseRequest request;
+    request.setReferenceTypeId(QOpcUa::ReferenceTypeId::HierarchicalReferences);
+
+    // Reference counts from browsing each node on its own
+    QHash<QString, int> expectedReferenceCounts;
+    for (int i = 0; i < 3; ++i) {
+        QScopedPointer<QOpcUaNode> node(opcuaClient->node(nodeIds.at(i)));
+        QVERIFY(node != nullptr);
+        QSignalSpy spy(node.data(), &QOpcUaNode::browseFinished);
+        QVERIFY(node->browse(request));
+        spy.wait(signalSpyTimeout);
+        QCOMPARE(spy.size(), 1);
+        QCOMPARE(spy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+        expectedReferenceCounts[nodeIds.at(i)] = spy.at(0).at(0).value<QVector<QOpcUaReferenceDescription>>().size();
+        QVERIFY(expectedReferenceCounts[nodeIds.at(i)] > 1);
+    }
+
+    // A single reference per response forces the use of BrowseNext for all nodes.
+    // The server only holds a few continuation points per session, the nodes must be browsed in small groups.
+    QSignalSpy browseSpy(opcuaClient, &QOpcUaClient::browseNodesFinished);
+    QVERIFY(opcuaClient->browseNodes(nodeIds, request, 1));
+    QTRY_COMPARE_WITH_TIMEOUT(browseSpy.size(), nodeIds.size(), signalSpyTimeout);
+
+    QStringList finishedNodes;
+    for (const auto &result : qAsConst(browseSpy)) {
+        const QString nodeId = result.at(0).toString();
+        const auto references = result.at(1).value<QVector<QOpcUaReferenceDescription>>();
+        const auto statusCode = result.at(2).value<QOpcUa::UaStatusCode>();
+        finishedNodes.push_back(nodeId);
+
+        if (nodeId == QLatin1String("ns=0;s=doesnotexist")) {
+            QCOMPARE(statusCode, QOpcUa::UaStatusCode::BadNodeIdUnknown);
+            QVERIFY(references.isEmpty());
+        } else {
+            QCOMPARE(statusCode, QOpcUa::UaStatusCode::Good);
+            QCOMPARE(references.size(), expectedReferenceCounts.value(nodeId));
+        }
+    }
+
+    finishedNodes.sort();
+    nodeIds.sort();
+    QCOMPARE(finishedNodes, nodeIds);
+}
+
+void Tst_QOpcUaClient::addressSpaceCrawler()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("The address space crawler requires browsing multiple nodes which is only available in the open62541 backend");
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    const QString objectsFolder = QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::ObjectsFolder);
+
+    {
+        QOpcUaAddressSpaceCrawler crawler(opcuaClient);
+        QSignalSpy discoveredSpy(&crawler, &QOpcUaAddressSpaceCrawler::nodesDiscovered);
+        QSignalSpy finishedSpy(&crawler, &QOpcUaAddressSpaceCrawler::finished);
+        QSignalSpy clientBrowseSpy(opcuaClient, &QOpcUaClient::browseNodesFinished);
+
+        QVERIFY(crawler.start(objectsFolder));
+        QVERIFY(crawler.isRunning());
+        QVERIFY(!crawler.start(objectsFolder));
+
+        // The client is used for the same nodes while the crawler is running
+        QVERIFY(opcuaClient->browseNodes({objectsFolder, QStringLiteral("ns=3;s=TestFolder")}));
+
+        finishedSpy.wait(signalSpyTimeout);
+        QCOMPARE(finishedSpy.size(), 1);
+        QCOMPARE(finishedSpy.at(0).at(0).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+        QVERIFY(!crawler.isRunning());
+
+        // Only the results of the client's own request are emitted by the client
+        QTRY_COMPARE_WITH_TIMEOUT(clientBrowseSpy.size(), 2, signalSpyTimeout);
+        QTest::qWait(100);
+        QCOMPARE(clientBrowseSpy.size(), 2);
+        QCOMPARE(clientBrowseSpy.at(0).at(0).toString(), objectsFolder);
+        QCOMPARE(clientBrowseSpy.at(1).at(0).toString(), QStringLiteral("ns=3;s=TestFolder"));
+
+        QSet<QString> discoveredNodes;
+        for (const auto &signal : qAsConst(discoveredSpy)) {
+            const auto references = signal.at(1).value<QVector<QOpcUaReferenceDescription>>();
+            for (const auto &reference : references)
+                discoveredNodes.insert(reference.targetNodeId().nodeId());
+        }
+
+        // Every node is reported exactly once
+        QCOMPARE(static_cast<quint64>(discoveredNodes.size()), crawler.discoveredNodeCount());
+        QVERIFY(!discoveredNodes.contains(objectsFolder));
+        QVERIFY(discoveredNodes.contains(QStringLiteral("ns=1;s=Large.Folder")));
+        QVERIFY(discoveredNodes.contains(QStringLiteral("ns=3;s=TestNode.ReadWrite")));
+        QVERIFY(discoveredNodes.contains(QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::Server_ServerStatus)));
+
+        QCOMPARE(crawler.browsedNodeCount(), crawler.discoveredNodeCount() + 1);
+        QCOMPARE(crawler.failedNodeCount(), quint64(0));
+        QVERIFY(crawler.browseRequestCount() > 1);
+        QCOMPARE(crawler.readRequestCount(), quint64(0));
+        QVERIFY(crawler.elapsed() >= 0);
+    }
+
+    {
+        QOpcUaAddressSpaceCrawler crawler(opcuaClient);
+        crawler.setNodeClassFilter(QOpcUa::NodeClass::Variable);
+        crawler.setAttributesToRead(QOpcUa::NodeAttribute::DataType | QOpcUa::NodeAttribute::AccessLevel);
+        crawler.setBatchSize(50);
+        crawler.setMaxRequestsInFlight(2);
+        QSignalSpy discoveredSpy(&crawler, &QOpcUaAddressSpaceCrawler::nodesDiscovered);
+        QSignalSpy readSpy(&crawler, &QOpcUaAddressSpaceCrawler::attributesRead);
+        QSignalSpy finishedSpy(&crawler, &QOpcUaAddressSpaceCrawler::finished);
+
+        QVERIFY(crawler.start(objectsFolder));
+        finishedSpy.wait(signalSpyTimeout);
+        QCOMPARE(finishedSpy.size(), 1);
+        QCOMPARE(finishedSpy.at(0).at(0).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+        QSet<QString> variables;
+        for (const auto &signal : qAsConst(discoveredSpy)) {
+            const auto references = signal.at(1).value<QVector<QOpcUaReferenceDescription>>();
+            for (const auto &reference : references) {
+                QCOMPARE(reference.nodeClass(), QOpcUa::NodeClass::Variable);
+                variables.insert(reference.targetNodeId().nodeId());
+            }
+        }
+        QVERIFY(variables.contains(QStringLiteral("ns=3;s=TestNode.ReadWrite")));
+        QVERIFY(static_cast<quint64>(variables.size()) < crawler.discoveredNodeCount());
+
+        int readResults = 0;
+        for (const auto &signal : qAsConst(readSpy)) {
+            const auto results = signal.at(0).value<QVector<QOpcUaReadResult>>();
+            QVERIFY(results.size() <= 50);
+            for (const auto &result : results) {
+                QVERIFY(variables.contains(result.nodeId()));
+                QVERIFY(result.attribute() == QOpcUa::NodeAttribute::DataType || result.attribute() == QOpcUa::NodeAttribute::AccessLevel);
+                if (result.nodeId() == QLatin1String("ns=3;s=TestNode.ReadWrite") && result.attribute() == QOpcUa::NodeAttribute::DataType)
+                    QCOMPARE(result.value().toString(), QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::Double));
+            }
+            readResults += results.size();
+        }
+        QCOMPARE(readResults, variables.size() * 2);
+        QCOMPARE(crawler.readResultCount(), static_cast<quint64>(readResults));
+    }
+
+    {
+        QOpcUaAddressSpaceCrawler crawler(opcuaClient);
+        QSignalSpy finishedSpy(&crawler, &QOpcUaAddressSpaceCrawler::finished);
+
+        QVERIFY(crawler.start(objectsFolder));
+        crawler.abort();
+        QCOMPARE(finishedSpy.size(), 1);
+        QCOMPARE(finishedSpy.at(0).at(0).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::BadRequestCancelledByClient);
+        QVERIFY(!crawler.isRunning());
+
+        // Results of the aborted crawl are ignored
+        QTest::qWait(100);
+        QCOMPARE(finishedSpy.size(), 1);
+    }
+}
+
+void Tst_QOpcUaClient::addressSpaceCache()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    QTemporaryDir cacheDirectory;
+    QVERIFY(cacheDirectory.isValid());
+
+    opcuaClient->setAddressSpaceCacheDirectory(cacheDirectory.path());
+    QCOMPARE(opcuaClient->addressSpaceCacheDirectory(), cacheDirectory.path());
+    auto cleanup = qScopeGuard([opcuaClient]() { opcuaClient->setAddressSpaceCacheDirectory(QString()); });
+
+    const auto browseChildCount = [](QOpcUaNode *node) {
+        QSignalSpy browseSpy(node, &QOpcUaNode::browseFinished);
+        if (!node->browseChildren())
+            return -1;
+        browseSpy.wait(signalSpyTimeout);
+        if (browseSpy.size() != 1 || browseSpy.at(0).at(1).value<QOpcUa::UaStatusCode>() != QOpcUa::UaStatusCode::Good)
+            return -1;
+        return browseSpy.at(0).at(0).value<QVector<QOpcUaReferenceDescription>>().size();
+    };
+
+    const QString newNodeId = QStringLiteral("ns=3;s=AddressSpaceCacheNode_%1").arg(opcuaClient->backend());
+    int childCount = 0;
+
+    {
+        OpcuaConnector connector(opcuaClient, m_endpoint);
+        // The cache becomes active after the namespace array has been read
+        QTRY_VERIFY(!opcuaClient->namespaceArray().isEmpty());
+
+        QScopedPointer<QOpcUaNode> folder(opcuaClient->node(QStringLiteral("ns=3;s=TestFolder")));
+        QVERIFY(folder != nullptr);
+        childCount = browseChildCount(folder.data());
+        QVERIFY(childCount > 0);
+
+        QScopedPointer<QOpcUaNode> node(opcuaClient->node(QStringLiteral("ns=3;s=TestNode.ReadWrite")));
+        QVERIFY(node != nullptr);
+        for (int i = 0; i < 2; ++i) {
+            QSignalSpy readSpy(node.data(), &QOpcUaNode::attributeRead);
+            QVERIFY(node->readAttributes(QOpcUa::NodeAttribute::DisplayName | QOpcUa::NodeAttribute::DataType));
+            readSpy.wait(signalSpyTimeout);
+            QCOMPARE(readSpy.size(), 1);
+            QCOMPARE(readSpy.at(0).at(0).value<QOpcUa::NodeAttributes>(), QOpcUa::NodeAttribute::DisplayName | QOpcUa::NodeAttribute::DataType);
+            QCOMPARE(node->attribute(QOpcUa::NodeAttribute::DisplayName).value<QOpcUaLocalizedText>().text(), QStringLiteral("TestNode.ReadWrite"));
+            QCOMPARE(node->attribute(QOpcUa::NodeAttribute::DataType).toString(), QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::Double));
+        }
+
+        // Add a node which is not known to the cache
+        QSignalSpy addNodeSpy(opcuaClient, &QOpcUaClient::addNodeFinished);
+        QOpcUaAddNodeItem nodeInfo;
+        nodeInfo.setParentNodeId(QOpcUaExpandedNodeId(QString(), QStringLiteral("ns=3;s=TestFolder")));
+        nodeInfo.setReferenceTypeId(QOpcUa::nodeIdFromReferenceType(QOpcUa::ReferenceTypeId::Organizes));
+        nodeInfo.setRequestedNewNodeId(QOpcUaExpandedNodeId(QString(), newNodeId));
+        nodeInfo.setBrowseName(QOpcUaQualifiedName(3, newNodeId));
+        nodeInfo.setNodeClass(QOpcUa::NodeClass::Object);
+        QVERIFY(opcuaClient->addNode(nodeInfo));
+        addNodeSpy.wait(signalSpyTimeout);
+        QCOMPARE(addNodeSpy.size(), 1);
+        QCOMPARE(addNodeSpy.at(0).at(2).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+        // The browse result is served from the cache
+        QCOMPARE(browseChildCount(folder.data()), childCount);
+    }
+
+    // The cache has been written when the client disconnected
+    const QStringList cacheFiles = QDir(cacheDirectory.path()).entryList({QStringLiteral("*.qopcuacache")}, QDir::Files);
+    QCOMPARE(cacheFiles.size(), 1);
+
+    {
+        OpcuaConnector connector(opcuaClient, m_endpoint);
+        QTRY_VERIFY(!opcuaClient->namespaceArray().isEmpty());
+
+        QScopedPointer<QOpcUaNode> folder(opcuaClient->node(QStringLiteral("ns=3;s=TestFolder")));
+        QVERIFY(folder != nullptr);
+
+        // The cache file from the previous session is used
+        QCOMPARE(browseChildCount(folder.data()), childCount);
+
+        opcuaClient->invalidateAddressSpaceCache();
+        QVERIFY(QDir(cacheDirectory.path()).entryList({QStringLiteral("*.qopcuacache")}, QDir::Files).isEmpty());
+        QCOMPARE(browseChildCount(folder.data()), childCount + 1);
+
+        QSignalSpy deleteNodeSpy(opcuaClient, &QOpcUaClient::deleteNodeFinished);
+        QVERIFY(opcuaClient->deleteNode(newNodeId));
+        deleteNodeSpy.wait(signalSpyTimeout);
+        QCOMPARE(deleteNodeSpy.size(), 1);
+        QCOMPARE(deleteNodeSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+    }
+}
+
+void Tst_QOpcUaClient::typedArrays()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Typed arrays are only available in the open62541 backend");
+
+    QVariantMap backendOptions;
+    backendOptions.insert(QLatin1String("enableTypedArrays"), true);
+    QScopedPointer<QOpcUaClient> client(m_opcUa.createClient(opcuaClient->backend(), backendOptions));
+    QVERIFY(client != nullptr);
+    OpcuaConnector connector(client.data(), m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(client->node("ns=2;s=Demo.Static.Arrays.Double"));
+    QVERIFY(node != nullptr);
+    READ_MANDATORY_VARIABLE_NODE(node);
+    const QVariant originalValue = node->valueAttribute();
+    QCOMPARE(originalValue.userType(), qMetaTypeId<QVector<double>>());
+    auto restoreValue = qScopeGuard([&node, &originalValue]() {
+        QSignalSpy resultSpy(node.data(), &QOpcUaNode::attributeWritten);
+        node->writeValueAttribute(originalValue, QOpcUa::Double);
+        resultSpy.wait(signalSpyTimeout);
+    });
+
+    const QVector<double> doubleValues = {1.5, -2.5, 1e300, 0};
+    WRITE_VALUE_ATTRIBUTE(node, QVariant::fromValue(doubleValues), QOpcUa::Undefined);
+    READ_MANDATORY_VARIABLE_NODE(node);
+    QCOMPARE(node->valueAttribute().value<QVector<double>>(), doubleValues);
+
+    // Conversion to a different element type is done element by element
+    const QVector<qint32> intValues = {1, 2, 3};
+    WRITE_VALUE_ATTRIBUTE(node, QVariant::fromValue(intValues), QOpcUa::Double);
+    READ_MANDATORY_VARIABLE_NODE(node);
+    QCOMPARE(node->valueAttribute().value<QVector<double>>(), QVector<double>({1, 2, 3}));
+
+    // Data change notifications contain typed arrays as well
+    QSignalSpy monitoringEnabledSpy(node.data(), &QOpcUaNode::enableMonitoringFinished);
+    QSignalSpy dataChangeSpy(node.data(), &QOpcUaNode::dataChangeOccurred);
+    node->enableMonitoring(QOpcUa::NodeAttribute::Value, QOpcUaMonitoringParameters(100));
+    monitoringEnabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringEnabledSpy.size(), 1);
+    QCOMPARE(monitoringEnabledSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+    QTRY_VERIFY_WITH_TIMEOUT(dataChangeSpy.size() >= 1, signalSpyTimeout);
+    QCOMPARE(dataChangeSpy.at(0).at(1).userType(), qMetaTypeId<QVector<double>>());
+    QCOMPARE(dataChangeSpy.at(0).at(1).value<QVector<double>>(), QVector<double>({1, 2, 3}));
+
+    QSignalSpy monitoringDisabledSpy(node.data(), &QOpcUaNode::disableMonitoringFinished);
+    node->disableMonitoring(QOpcUa::NodeAttribute::Value);
+    monitoringDisabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringDisabledSpy.size(), 1);
+
+    // Clients without the option still get QVariantList
+    {
+        OpcuaConnector listConnector(opcuaClient, m_endpoint);
+        QScopedPointer<QOpcUaNode> listNode(opcuaClient->node("ns=2;s=Demo.Static.Arrays.Double"));
+        QVERIFY(listNode != nullptr);
+        READ_MANDATORY_VARIABLE_NODE(listNode);
+        QCOMPARE(listNode->valueAttribute().type(), QVariant::List);
+        QCOMPARE(listNode->valueAttribute().toList().size(), 3);
+    }
+}
+
+void Tst_QOpcUaClient::batchedDataChanges()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Batched data change notifications are only available in the open62541 backend");
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    const QStringList nodeIds = {readWriteNode, QStringLiteral("ns=2;s=Demo.Static.Scalar.Double")};
+    QScopedPointer<QOpcUaNode> firstNode(opcuaClient->node(nodeIds.at(0)));
+    QVERIFY(firstNode != nullptr);
+    QScopedPointer<QOpcUaNode> secondNode(opcuaClient->node(nodeIds.at(1)));
+    QVERIFY(secondNode != nullptr);
+    const QVector<QOpcUaNode *> nodes = {firstNode.data(), secondNode.data()};
+
+    QSignalSpy firstDataChangeSpy(firstNode.data(), &QOpcUaNode::dataChangeOccurred);
+    QSignalSpy secondDataChangeSpy(secondNode.data(), &QOpcUaNode::dataChangeOccurred);
+    QSignalSpy batchSpy(opcuaClient, &QOpcUaClient::dataChangesOccurred);
+
+    quint32 subscriptionId = 0;
+    for (QOpcUaNode *node : nodes) {
+        QSignalSpy monitoringEnabledSpy(node, &QOpcUaNode::enableMonitoringFinished);
+        node->enableMonitoring(QOpcUa::NodeAttribute::DisplayName,
+                               QOpcUaMonitoringParameters(100, QOpcUaMonitoringParameters::SubscriptionType::Exclusive, subscriptionId));
+        monitoringEnabledSpy.wait(signalSpyTimeout);
+        QCOMPARE(monitoringEnabledSpy.size(), 1);
+        QCOMPARE(node->monitoringStatus(QOpcUa::NodeAttribute::DisplayName).statusCode(), QOpcUa::UaStatusCode::Good);
+        subscriptionId = node->monitoringStatus(QOpcUa::NodeAttribute::DisplayName).subscriptionId();
+    }
+
+    QTRY_VERIFY_WITH_TIMEOUT(firstDataChangeSpy.size() >= 1, signalSpyTimeout);
+    QTRY_VERIFY_WITH_TIMEOUT(secondDataChangeSpy.size() >= 1, signalSpyTimeout);
+    QVERIFY(batchSpy.size() >= 1);
+
+    // Each node signal has a matching entry in one of the batches
+    QStringList batchedNodeIds;
+    for (const auto &batch : batchSpy) {
+        const auto results = batch.at(0).value<QVector<QOpcUaReadResult>>();
+        QVERIFY(!results.isEmpty());
+        for (const auto &result : results) {
+            QCOMPARE(result.attribute(), QOpcUa::NodeAttribute::DisplayName);
+            QCOMPARE(result.statusCode(), QOpcUa::UaStatusCode::Good);
+            batchedNodeIds.append(result.nodeId());
+        }
+    }
+
+    for (const auto &nodeId : nodeIds)
+        QVERIFY(batchedNodeIds.contains(nodeId));
+
+    for (QOpcUaNode *node : nodes) {
+        QSignalSpy monitoringDisabledSpy(node, &QOpcUaNode::disableMonitoringFinished);
+        node->disableMonitoring(QOpcUa::NodeAttribute::DisplayName);
+        monitoringDisabledSpy.wait(signalSpyTimeout);
+        QCOMPARE(monitoringDisabledSpy.size(), 1);
+    }
+}
+
+void Tst_QOpcUaClient::dataChangeQueue()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    QCOMPARE(opcuaClient->conflatedDataChangeCount(), quint64(0));
+    QCOMPARE(opcuaClient->droppedDataChangeCount(), quint64(0));
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("The data change queue is only available in the open62541 backend");
+
+    QVariantMap backendOptions;
+    backendOptions.insert(QLatin1String("dataChangeQueueCapacity"), 4);
+    QScopedPointer<QOpcUaClient> client(m_opcUa.createClient(opcuaClient->backend(), backendOptions));
+    QVERIFY(client != nullptr);
+    OpcuaConnector connector(client.data(), m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(client->node(readWriteNode));
+    QVERIFY(node != nullptr);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QSignalSpy monitoringEnabledSpy(node.data(), &QOpcUaNode::enableMonitoringFinished);
+    QSignalSpy dataChangeSpy(node.data(), &QOpcUaNode::dataChangeOccurred);
+    QSignalSpy batchSpy(client.data(), &QOpcUaClient::dataChangesOccurred);
+
+    QOpcUaMonitoringParameters parameters(50);
+    parameters.setSamplingInterval(0);
+    node->enableMonitoring(QOpcUa::NodeAttribute::Value, parameters);
+    monitoringEnabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringEnabledSpy.size(), 1);
+    QCOMPARE(node->monitoringStatus(QOpcUa::NodeAttribute::Value).statusCode(), QOpcUa::UaStatusCode::Good);
+    QTRY_VERIFY_WITH_TIMEOUT(dataChangeSpy.size() >= 1, signalSpyTimeout);
+    QCOMPARE(batchSpy.size(), dataChangeSpy.size());
+
+    // Keep the client thread busy while the values change, the notifications are conflated in the queue
+    constexpr int valueCount = 10;
+    QSignalSpy writeSpy(node.data(), &QOpcUaNode::attributeWritten);
+    for (int i = 1; i <= valueCount; ++i)
+        QVERIFY(node->writeValueAttribute(double(i), QOpcUa::Types::Double));
+    QThread::msleep(500);
+
+    QTRY_COMPARE_WITH_TIMEOUT(writeSpy.size(), valueCount, signalSpyTimeout);
+
+    // The latest value is never lost
+    QTRY_COMPARE_WITH_TIMEOUT(dataChangeSpy.last().at(1).toDouble(), double(valueCount), signalSpyTimeout);
+    QVERIFY(dataChangeSpy.size() <= valueCount + 1);
+    QVERIFY(client->conflatedDataChangeCount() <= quint64(valueCount));
+    QCOMPARE(client->droppedDataChangeCount(), quint64(0));
+
+    QSignalSpy monitoringDisabledSpy(node.data(), &QOpcUaNode::disableMonitoringFinished);
+    node->disableMonitoring(QOpcUa::NodeAttribute::Value);
+    monitoringDisabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringDisabledSpy.size(), 1);
+
+    // A full queue discards notifications for further attributes instead of growing
+    backendOptions.insert(QLatin1String("dataChangeQueueCapacity"), 1);
+    QScopedPointer<QOpcUaClient> smallQueueClient(m_opcUa.createClient(opcuaClient->backend(), backendOptions));
+    QVERIFY(smallQueueClient != nullptr);
+    OpcuaConnector smallQueueConnector(smallQueueClient.data(), m_endpoint);
+
+    QScopedPointer<QOpcUaNode> smallQueueNode(smallQueueClient->node(readWriteNode));
+    QVERIFY(smallQueueNode != nullptr);
+    QSignalSpy smallQueueEnabledSpy(smallQueueNode.data(), &QOpcUaNode::enableMonitoringFinished);
+    QSignalSpy smallQueueDataChangeSpy(smallQueueNode.data(), &QOpcUaNode::dataChangeOccurred);
+    smallQueueNode->enableMonitoring(QOpcUa::NodeAttribute::Value | QOpcUa::NodeAttribute::DisplayName, parameters);
+    QTRY_COMPARE_WITH_TIMEOUT(smallQueueEnabledSpy.size(), 2, signalSpyTimeout);
+
+    // Only the attribute which got the slot of the queue delivers its initial value
+    QTRY_COMPARE_WITH_TIMEOUT(smallQueueClient->droppedDataChangeCount(), quint64(1), signalSpyTimeout);
+    QTRY_COMPARE_WITH_TIMEOUT(smallQueueDataChangeSpy.size(), 1, signalSpyTimeout);
+    QTest::qWait(200);
+    QCOMPARE(smallQueueDataChangeSpy.size(), 1);
+    QCOMPARE(smallQueueClient->droppedDataChangeCount(), quint64(1));
+
+    QSignalSpy smallQueueDisabledSpy(smallQueueNode.data(), &QOpcUaNode::disableMonitoringFinished);
+    smallQueueNode->disableMonitoring(QOpcUa::NodeAttribute::Value | QOpcUa::NodeAttribute::DisplayName);
+    QTRY_COMPARE_WITH_TIMEOUT(smallQueueDisabledSpy.size(), 2, signalSpyTimeout);
+}
+
+void Tst_QOpcUaClient::deliveryThrottling()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != nullptr);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QCOMPARE(node->deliveryInterval(QOpcUa::NodeAttribute::Value), 0);
+    node->setDeliveryThrottling(QOpcUa::NodeAttribute::Value, 5000, QOpcUaNode::DeliveryAggregation::MinMaxLast);
+    QCOMPARE(node->deliveryInterval(QOpcUa::NodeAttribute::Value), 5000);
+    QCOMPARE(node->deliveryAggregation(QOpcUa::NodeAttribute::Value), QOpcUaNode::DeliveryAggregation::MinMaxLast);
+
+    QSignalSpy monitoringEnabledSpy(node.data(), &QOpcUaNode::enableMonitoringFinished);
+    QSignalSpy dataChangeSpy(node.data(), &QOpcUaNode::dataChangeOccurred);
+    QSignalSpy aggregatedSpy(node.data(), &QOpcUaNode::dataChangeAggregated);
+
+    node->enableMonitoring(QOpcUa::NodeAttribute::Value, QOpcUaMonitoringParameters(50));
+    monitoringEnabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringEnabledSpy.size(), 1);
+    QCOMPARE(node->monitoringStatus(QOpcUa::NodeAttribute::Value).statusCode(), QOpcUa::UaStatusCode::Good);
+
+    // The first notification is delivered immediately
+    QTRY_COMPARE_WITH_TIMEOUT(dataChangeSpy.size(), 1, signalSpyTimeout);
+    QCOMPARE(dataChangeSpy.at(0).at(1).toDouble(), 0.0);
+    QCOMPARE(aggregatedSpy.size(), 1);
+
+    // Notifications within the interval are combined
+    for (double value : {1.0, 5.0, 3.0}) {
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(value), QOpcUa::Types::Double);
+        QTest::qWait(200);
+    }
+    QCOMPARE(node->valueAttribute().toDouble(), 3.0);
+    QCOMPARE(dataChangeSpy.size(), 1);
+
+    QTRY_COMPARE_WITH_TIMEOUT(dataChangeSpy.size(), 2, 6000);
+    QCOMPARE(dataChangeSpy.at(1).at(1).toDouble(), 3.0);
+    QCOMPARE(aggregatedSpy.size(), 2);
+    QCOMPARE(aggregatedSpy.at(1).at(1).toDouble(), 1.0);
+    QCOMPARE(aggregatedSpy.at(1).at(2).toDouble(), 5.0);
+    QCOMPARE(aggregatedSpy.at(1).at(3).toDouble(), 3.0);
+
+    // Removing the limit delivers every notification again
+    node->setDeliveryThrottling(QOpcUa::NodeAttribute::Value, 0);
+    QCOMPARE(node->deliveryInterval(QOpcUa::NodeAttribute::Value), 0);
+    dataChangeSpy.clear();
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(7)), QOpcUa::Types::Double);
+    QTRY_VERIFY_WITH_TIMEOUT(dataChangeSpy.size() >= 1, signalSpyTimeout);
+    QCOMPARE(dataChangeSpy.last().at(1).toDouble(), 7.0);
+    QCOMPARE(aggregatedSpy.size(), 2);
+
+    QSignalSpy monitoringDisabledSpy(node.data(), &QOpcUaNode::disableMonitoringFinished);
+    node->disableMonitoring(QOpcUa::NodeAttribute::Value);
+    monitoringDisabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringDisabledSpy.size(), 1);
+}
+
+void Tst_QOpcUaClient::queuedDataChanges()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != nullptr);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QSignalSpy monitoringEnabledSpy(node.data(), &QOpcUaNode::enableMonitoringFinished);
+    QSignalSpy dataChangeSpy(node.data(), &QOpcUaNode::dataChangeOccurred);
+    QSignalSpy dataChangesSpy(node.data(), &QOpcUaNode::dataChangesOccurred);
+
+    QOpcUaMonitoringParameters parameters(1000);
+    parameters.setSamplingInterval(10);
+    parameters.setQueueSize(10);
+    node->enableMonitoring(QOpcUa::NodeAttribute::Value, parameters);
+    monitoringEnabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringEnabledSpy.size(), 1);
+    QCOMPARE(node->monitoringStatus(QOpcUa::NodeAttribute::Value).statusCode(), QOpcUa::UaStatusCode::Good);
+
+    QTRY_VERIFY_WITH_TIMEOUT(dataChangesSpy.size() >= 1, signalSpyTimeout);
+    dataChangeSpy.clear();
+    dataChangesSpy.clear();
+
+    // All values written within one publishing interval are queued on the server
+    for (double value : {1.0, 2.0, 3.0})
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(value), QOpcUa::Types::Double);
+
+    const auto receivedValues = [&dataChangesSpy]() {
+        QVector<QOpcUaReadResult> result;
+        for (const auto &emission : dataChangesSpy)
+            result.append(emission.at(1).value<QVector<QOpcUaReadResult>>());
+        return result;
+    };
+    QTRY_VERIFY_WITH_TIMEOUT(receivedValues().size() >= 3, 5000);
+
+    QVector<double> values;
+    for (const auto &value : receivedValues()) {
+        QCOMPARE(value.attribute(), QOpcUa::NodeAttribute::Value);
+        QCOMPARE(value.statusCode(), QOpcUa::UaStatusCode::Good);
+        QVERIFY(value.serverTimestamp().isValid());
+        values.push_back(value.value().toDouble());
+    }
+
+    QCOMPARE(values, QVector<double>({1, 2, 3}));
+    QCOMPARE(dataChangeSpy.size(), values.size());
+    QCOMPARE(node->valueAttribute().toDouble(), 3.0);
+
+    if (opcuaClient->backend() == QLatin1String("open62541"))
+        QVERIFY(dataChangesSpy.size() < values.size());
+
+    QSignalSpy monitoringDisabledSpy(node.data(), &QOpcUaNode::disableMonitoringFinished);
+    node->disableMonitoring(QOpcUa::NodeAttribute::Value);
+    monitoringDisabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringDisabledSpy.size(), 1);
+}
+
+void Tst_QOpcUaClient::valueHistory()
+{
+    // Ring buffer behavior with explicit timestamps
+    QOpcUaValueHistory history(4);
+    QCOMPARE(history.capacity(), 4);
+    QVERIFY(history.isEmpty());
+    QCOMPARE(history.aggregate(0, 100).count, 0);
+    for (int i = 1; i <= 6; ++i)
+        history.append(i * 10, i);
+    QCOMPARE(history.size(), 4);
+    QCOMPARE(history.appendedCount(), quint64(6));
+    QCOMPARE(history.firstTimestamp(), qint64(30));
+    QCOMPARE(history.lastTimestamp(), qint64(60));
+    QCOMPARE(history.valueAt(0), 3.0);
+    QCOMPARE(history.valueAt(3), 6.0);
+    QCOMPARE(history.lowerBound(35), 1);
+    QCOMPARE(history.lowerBound(100), 4);
+
+    QVector<qint64> timestamps;
+    QVector<double> values;
+    QCOMPARE(history.range(40, 55, &timestamps, &values), 2);
+    QCOMPARE(timestamps, QVector<qint64>({40, 50}));
+    QCOMPARE(values, QVector<double>({4, 5}));
+
+    const auto aggregate = history.aggregate(0, 60);
+    QCOMPARE(aggregate.count, 4);
+    QCOMPARE(aggregate.minimum, 3.0);
+    QCOMPARE(aggregate.maximum, 6.0);
+    QCOMPARE(aggregate.average, 4.5);
+    QVERIFY(history.memoryUsage() >= qsizetype(4 * (sizeof(qint64) + sizeof(double))));
+
+    QOpcUaReadResult stringResult;
+    stringResult.setValue(QStringLiteral("abc"));
+    QVERIFY(!history.append(stringResult));
+    QCOMPARE(history.skippedCount(), quint64(1));
+
+    // Out of order timestamps must not break the binary search of the queries
+    QOpcUaReadResult outOfOrderResult;
+    outOfOrderResult.setValue(100.0);
+    outOfOrderResult.setSourceTimestamp(QDateTime::fromMSecsSinceEpoch(45));
+    QVERIFY(!history.append(outOfOrderResult));
+    QCOMPARE(history.skippedCount(), quint64(2));
+    QCOMPARE(history.size(), 4);
+    QCOMPARE(history.lastTimestamp(), qint64(60));
+
+    QOpcUaReadResult inOrderResult;
+    inOrderResult.setValue(7.0);
+    inOrderResult.setSourceTimestamp(QDateTime::fromMSecsSinceEpoch(60));
+    QVERIFY(history.append(inOrderResult));
+    QCOMPARE(history.lastTimestamp(), qint64(60));
+    QCOMPARE(history.valueAt(3), 7.0);
+
+    // Explicit timestamps are clamped to the most recent timestamp
+    history.append(5, 8);
+    QCOMPARE(history.size(), 4);
+    QCOMPARE(history.lastTimestamp(), qint64(60));
+    QCOMPARE(history.valueAt(3), 8.0);
+    QCOMPARE(history.range(55, 60, &timestamps, &values), 3);
+    QCOMPARE(timestamps, QVector<qint64>({60, 60, 60}));
+    QCOMPARE(values, QVector<double>({6, 7, 8}));
+    QCOMPARE(history.aggregate(0, 50).count, 1);
+    QCOMPARE(history.aggregate(0, 50).maximum, 5.0);
+    for (int i = 1; i < history.size(); ++i)
+        QVERIFY(history.timestampAt(i - 1) <= history.timestampAt(i));
+
+    // History filled by data change notifications
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != nullptr);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QVERIFY(node->valueHistory(QOpcUa::NodeAttribute::Value) == nullptr);
+    node->setValueHistoryCapacity(QOpcUa::NodeAttribute::Value, 3);
+    const QOpcUaValueHistory *nodeHistory = node->valueHistory(QOpcUa::NodeAttribute::Value);
+    QVERIFY(nodeHistory != nullptr);
+    QCOMPARE(nodeHistory->capacity(), 3);
+
+    QSignalSpy monitoringEnabledSpy(node.data(), &QOpcUaNode::enableMonitoringFinished);
+    QSignalSpy dataChangeSpy(node.data(), &QOpcUaNode::dataChangeOccurred);
+    node->enableMonitoring(QOpcUa::NodeAttribute::Value, QOpcUaMonitoringParameters(50));
+    monitoringEnabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringEnabledSpy.size(), 1);
+    QCOMPARE(node->monitoringStatus(QOpcUa::NodeAttribute::Value).statusCode(), QOpcUa::UaStatusCode::Good);
+    QTRY_COMPARE_WITH_TIMEOUT(dataChangeSpy.size(), 1, signalSpyTimeout);
+
+    for (int i = 1; i <= 4; ++i) {
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(i)), QOpcUa::Types::Double);
+        QTRY_COMPARE_WITH_TIMEOUT(dataChangeSpy.size(), i + 1, signalSpyTimeout);
+    }
+
+    QCOMPARE(nodeHistory->appendedCount(), quint64(5));
+    QCOMPARE(nodeHistory->size(), 3);
+    QCOMPARE(nodeHistory->valueAt(0), 2.0);
+    QCOMPARE(nodeHistory->valueAt(2), 4.0);
+    QVERIFY(nodeHistory->firstTimestamp() <= nodeHistory->lastTimestamp());
+
+    const auto nodeAggregate = nodeHistory->aggregate(nodeHistory->firstTimestamp(), nodeHistory->lastTimestamp());
+    QCOMPARE(nodeAggregate.count, 3);
+    QCOMPARE(nodeAggregate.minimum, 2.0);
+    QCOMPARE(nodeAggregate.maximum, 4.0);
+    QCOMPARE(nodeAggregate.average, 3.0);
+
+    node->setValueHistoryCapacity(QOpcUa::NodeAttribute::Value, 0);
+    QVERIFY(node->valueHistory(QOpcUa::NodeAttribute::Value) == nullptr);
+
+    QSignalSpy monitoringDisabledSpy(node.data(), &QOpcUaNode::disableMonitoringFinished);
+    node->disableMonitoring(QOpcUa::NodeAttribute::Value);
+    monitoringDisabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringDisabledSpy.size(), 1);
+}
+
+void Tst_QOpcUaClient::historyRead()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("History read is only available in the open62541 backend");
+
+    QOpcUaHistoryReadRequest request;
+    request.setNodeIds({readWriteNode, QStringLiteral("ns=3;s=theStringId")});
+    request.setStartTime(QDateTime::currentDateTimeUtc().addSecs(-3600));
+    request.setEndTime(QDateTime::currentDateTimeUtc());
+    request.setNumValuesPerNode(10);
+    request.setMaxPagesInFlight(1);
+
+    // Not connected
+    QVERIFY(opcuaClient->readHistoryData(request) == nullptr);
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QOpcUaHistoryReadRequest emptyRequest = request;
+    emptyRequest.setNodeIds(QStringList());
+    QVERIFY(opcuaClient->readHistoryData(emptyRequest) == nullptr);
+
+    // Abort before the first page has arrived
+    QScopedPointer<QOpcUaHistoryReadResponse> abortedResponse(opcuaClient->readHistoryData(request));
+    QVERIFY(abortedResponse != nullptr);
+    QSignalSpy abortedSpy(abortedResponse.data(), &QOpcUaHistoryReadResponse::finished);
+    abortedResponse->abort();
+    QCOMPARE(abortedSpy.size(), 1);
+    QCOMPARE(abortedSpy.at(0).at(0).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::BadRequestCancelledByClient);
+    QVERIFY(abortedResponse->isFinished());
+    QCOMPARE(abortedResponse->statusCode(), QOpcUa::UaStatusCode::BadRequestCancelledByClient);
+
+    QScopedPointer<QOpcUaHistoryReadResponse> response(opcuaClient->readHistoryData(request));
+    QVERIFY(response != nullptr);
+    QCOMPARE(response->request().nodeIds(), request.nodeIds());
+    QSignalSpy dataSpy(response.data(), &QOpcUaHistoryReadResponse::dataReceived);
+    QSignalSpy finishedSpy(response.data(), &QOpcUaHistoryReadResponse::finished);
+    finishedSpy.wait(signalSpyTimeout);
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(finishedSpy.at(0).at(0).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+    QVERIFY(response->isFinished());
+
+    // Every node must report its last page exactly once, pages of a node arrive in order
+    QHash<QString, int> lastPages;
+    QHash<QString, QOpcUa::UaStatusCode> nodeStatus;
+    int valueCount = 0;
+    for (const auto &signal : dataSpy) {
+        const auto pages = signal.at(0).value<QVector<QOpcUaHistoryData>>();
+        for (const auto &page : pages) {
+            QVERIFY(request.nodeIds().contains(page.nodeId()));
+            QCOMPARE(lastPages.value(page.nodeId()), 0);
+            if (page.isLastPage())
+                ++lastPages[page.nodeId()];
+            nodeStatus.insert(page.nodeId(), page.statusCode());
+            valueCount += page.values().size();
+        }
+    }
+    QCOMPARE(lastPages.size(), request.nodeIds().size());
+    QCOMPARE(response->receivedValueCount(), quint64(valueCount));
+
+    // The vendored open62541 is built without historizing, the test server rejects every HistoryRead.
+    // Paging, continuation points and the order of the values are tested with a fake backend in tst_qopcuahistoryread.
+    for (const auto &nodeId : request.nodeIds()) {
+        const QOpcUa::UaStatusCode status = nodeStatus.value(nodeId);
+        QVERIFY2(status == QOpcUa::UaStatusCode::BadServiceUnsupported || status == QOpcUa::UaStatusCode::BadHistoryOperationUnsupported,
+                 qPrintable(QStringLiteral("%1: unexpected status 0x%2").arg(nodeId).arg(quint32(status), 8, 16, QLatin1Char('0'))));
+    }
+    QCOMPARE(valueCount, 0);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != nullptr);
+    QScopedPointer<QOpcUaHistoryReadResponse> nodeResponse(node->readHistoryRaw(request.startTime(), request.endTime(), 5));
+    QVERIFY(nodeResponse != nullptr);
+    QSignalSpy nodeFinishedSpy(nodeResponse.data(), &QOpcUaHistoryReadResponse::finished);
+    nodeFinishedSpy.wait(signalSpyTimeout);
+    QCOMPARE(nodeFinishedSpy.size(), 1);
+    QCOMPARE(nodeResponse->request().nodeIds(), QStringList({readWriteNode}));
+    QCOMPARE(nodeResponse->request().numValuesPerNode(), quint32(5));
+    QCOMPARE(nodeResponse->receivedValueCount(), quint64(0));
+}
+
+void Tst_QOpcUaClient::registerNodes()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Registered nodes are only available in the open62541 backend");
+
+    // Not connected
+    QVERIFY(!opcuaClient->registerNodes({readWriteNode}));
+
+    QSignalSpy registerSpy(opcuaClient, &QOpcUaClient::registerNodesFinished);
+    QSignalSpy unregisterSpy(opcuaClient, &QOpcUaClient::unregisterNodesFinished);
+
+    {
+        OpcuaConnector connector(opcuaClient, m_endpoint);
+
+        QVERIFY(opcuaClient->registerNodes({readWriteNode}));
+        registerSpy.wait(signalSpyTimeout);
+        QCOMPARE(registerSpy.size(), 1);
+        QCOMPARE(registerSpy.at(0).at(0).toStringList(), QStringList({readWriteNode}));
+        QCOMPARE(registerSpy.at(0).at(1).toStringList().size(), 1);
+        QCOMPARE(registerSpy.at(0).at(2).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+        // Reads and writes of the node use the registered id
+        QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+        QVERIFY(node != nullptr);
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(23)), QOpcUa::Types::Double);
+        READ_MANDATORY_VARIABLE_NODE(node);
+        QCOMPARE(node->valueAttribute(), QVariant(double(23)));
+
+        QSignalSpy readSpy(opcuaClient, &QOpcUaClient::readNodeAttributesFinished);
+        QVERIFY(opcuaClient->readNodeAttributes({QOpcUaReadItem(readWriteNode)}));
+        readSpy.wait(signalSpyTimeout);
+        QCOMPARE(readSpy.size(), 1);
+        const auto results = readSpy.at(0).at(0).value<QVector<QOpcUaReadResult>>();
+        QCOMPARE(results.size(), 1);
+        QCOMPARE(results.at(0).nodeId(), readWriteNode);
+        QCOMPARE(results.at(0).statusCode(), QOpcUa::UaStatusCode::Good);
+        QCOMPARE(results.at(0).value(), QVariant(double(23)));
+
+        registerSpy.clear();
+    }
+
+    // The registration is restored after a reconnect
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+    QTRY_COMPARE_WITH_TIMEOUT(registerSpy.size(), 1, signalSpyTimeout);
+    QCOMPARE(registerSpy.at(0).at(0).toStringList(), QStringList({readWriteNode}));
+    QCOMPARE(registerSpy.at(0).at(2).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != nullptr);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(42)), QOpcUa::Types::Double);
+    READ_MANDATORY_VARIABLE_NODE(node);
+    QCOMPARE(node->valueAttribute(), QVariant(double(42)));
+
+    QVERIFY(node->unregisterNode());
+    unregisterSpy.wait(signalSpyTimeout);
+    QCOMPARE(unregisterSpy.size(), 1);
+    QCOMPARE(unregisterSpy.at(0).at(0).toStringList(), QStringList({readWriteNode}));
+    QCOMPARE(unregisterSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    QVERIFY(opcuaClient->unregisterNodes({readWriteNode}));
+    unregisterSpy.wait(signalSpyTimeout);
+    QCOMPARE(unregisterSpy.size(), 2);
+    QCOMPARE(unregisterSpy.at(1).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::BadNothingToDo);
+
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+}
+
+void Tst_QOpcUaClient::attributeCache()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QCOMPARE(opcuaClient->attributeCacheSize(), 0);
+    opcuaClient->setAttributeCacheSize(10);
+    QCOMPARE(opcuaClient->attributeCacheSize(), 10);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != nullptr);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(5)), QOpcUa::Types::Double);
+
+    const quint64 initialMisses = opcuaClient->attributeCacheMissCount();
+    const quint64 initialHits = opcuaClient->attributeCacheHitCount();
+
+    // The first read must be sent to the server and fills the cache
+    QSignalSpy attributeReadSpy(node.data(), &QOpcUaNode::attributeRead);
+    QVERIFY(node->readAttributes(QOpcUa::NodeAttribute::Value, 60000));
+    attributeReadSpy.wait(signalSpyTimeout);
+    QCOMPARE(attributeReadSpy.size(), 1);
+    QCOMPARE(node->valueAttribute(), QVariant(double(5)));
+    QCOMPARE(opcuaClient->attributeCacheMissCount(), initialMisses + quint64(1));
+    QCOMPARE(opcuaClient->attributeCacheHitCount(), initialHits);
+
+    // The second read is answered from the cache
+    attributeReadSpy.clear();
+    QVERIFY(node->readAttributes(QOpcUa::NodeAttribute::Value, 60000));
+    attributeReadSpy.wait(signalSpyTimeout);
+    QCOMPARE(attributeReadSpy.size(), 1);
+    QCOMPARE(node->valueAttribute(), QVariant(double(5)));
+    QCOMPARE(opcuaClient->attributeCacheHitCount(), initialHits + quint64(1));
+
+    // A read without maxAge always goes to the server
+    attributeReadSpy.clear();
+    QVERIFY(node->readValueAttribute());
+    attributeReadSpy.wait(signalSpyTimeout);
+    QCOMPARE(attributeReadSpy.size(), 1);
+    QCOMPARE(opcuaClient->attributeCacheHitCount(), initialHits + quint64(1));
+    QCOMPARE(opcuaClient->attributeCacheMissCount(), initialMisses + quint64(1));
+
+    // Batch reads use the same cache
+    QSignalSpy readSpy(opcuaClient, &QOpcUaClient::readNodeAttributesFinished);
+    QVERIFY(opcuaClient->readNodeAttributes({QOpcUaReadItem(readWriteNode)}, 60000));
+    readSpy.wait(signalSpyTimeout);
+    QCOMPARE(readSpy.size(), 1);
+    auto results = readSpy.at(0).at(0).value<QVector<QOpcUaReadResult>>();
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0).nodeId(), readWriteNode);
+    QCOMPARE(results.at(0).value(), QVariant(double(5)));
+    QCOMPARE(readSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(opcuaClient->attributeCacheHitCount(), initialHits + quint64(2));
+
+    // A write invalidates the cached value
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+    attributeReadSpy.clear();
+    QVERIFY(node->readAttributes(QOpcUa::NodeAttribute::Value, 60000));
+    attributeReadSpy.wait(signalSpyTimeout);
+    QCOMPARE(attributeReadSpy.size(), 1);
+    QCOMPARE(node->valueAttribute(), QVariant(double(0)));
+    QCOMPARE(opcuaClient->attributeCacheMissCount(), initialMisses + quint64(2));
+
+    opcuaClient->setAttributeCacheSize(0);
+    QCOMPARE(opcuaClient->attributeCacheSize(), 0);
+}
+
+void Tst_QOpcUaClient::valueHandles()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Value handles are currently only supported by the open62541 backend");
+
+    const auto handles = opcuaClient->registerValueHandles({QOpcUaReadItem(readWriteNode), QOpcUaReadItem(QString())});
+    QCOMPARE(handles.size(), 2);
+    QVERIFY(handles.at(0) != 0);
+    QCOMPARE(handles.at(1), quint64(0));
+
+    const QVector<quint64> valueHandle = {handles.at(0)};
+    QVERIFY(!opcuaClient->readValues({handles.at(1)}));
+    QVERIFY(!opcuaClient->writeValues(valueHandle, {}));
+
+    QSignalSpy writeSpy(opcuaClient, &QOpcUaClient::valuesWritten);
+    QVERIFY(opcuaClient->writeValues(valueHandle, {QOpcUa::TypedVariant(double(23), QOpcUa::Types::Double)}));
+    writeSpy.wait(signalSpyTimeout);
+    QCOMPARE(writeSpy.size(), 1);
+    QCOMPARE(writeSpy.at(0).at(0).value<QVector<quint64>>(), valueHandle);
+    QCOMPARE(writeSpy.at(0).at(1).value<QVector<QOpcUa::UaStatusCode>>(), QVector<QOpcUa::UaStatusCode>({QOpcUa::UaStatusCode::Good}));
+    QCOMPARE(writeSpy.at(0).at(2).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    QSignalSpy readSpy(opcuaClient, &QOpcUaClient::valuesRead);
+    QVERIFY(opcuaClient->readValues(valueHandle));
+    readSpy.wait(signalSpyTimeout);
+    QCOMPARE(readSpy.size(), 1);
+    QCOMPARE(readSpy.at(0).at(0).value<QVector<quint64>>(), valueHandle);
+    auto results = readSpy.at(0).at(1).value<QVector<QOpcUaReadResult>>();
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0).nodeId(), readWriteNode);
+    QCOMPARE(results.at(0).statusCode(), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(results.at(0).value(), QVariant(double(23)));
+
+    QSignalSpy monitoringEnabledSpy(opcuaClient, &QOpcUaClient::valueMonitoringEnabled);
+    QSignalSpy valuesChangedSpy(opcuaClient, &QOpcUaClient::valuesChanged);
+    QVERIFY(opcuaClient->enableValueMonitoring(valueHandle, QOpcUaMonitoringParameters(100)));
+    monitoringEnabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringEnabledSpy.size(), 1);
+    QCOMPARE(monitoringEnabledSpy.at(0).at(0).value<QVector<quint64>>(), valueHandle);
+    QCOMPARE(monitoringEnabledSpy.at(0).at(1).value<QVector<QOpcUa::UaStatusCode>>(), QVector<QOpcUa::UaStatusCode>({QOpcUa::UaStatusCode::Good}));
+
+    // The initial value is reported after the monitored item has been created
+    if (valuesChangedSpy.isEmpty())
+        valuesChangedSpy.wait(signalSpyTimeout);
+    QVERIFY(valuesChangedSpy.size() >= 1);
+    QCOMPARE(valuesChangedSpy.at(0).at(0).value<QVector<quint64>>(), valueHandle);
+    results = valuesChangedSpy.at(0).at(1).value<QVector<QOpcUaReadResult>>();
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0).nodeId(), readWriteNode);
+    QCOMPARE(results.at(0).value(), QVariant(double(23)));
+
+    QSignalSpy monitoringDisabledSpy(opcuaClient, &QOpcUaClient::valueMonitoringDisabled);
+    QVERIFY(opcuaClient->disableValueMonitoring(valueHandle));
+    monitoringDisabledSpy.wait(signalSpyTimeout);
+    QCOMPARE(monitoringDisabledSpy.size(), 1);
+    QCOMPARE(monitoringDisabledSpy.at(0).at(0).value<QVector<quint64>>(), valueHandle);
+    QCOMPARE(monitoringDisabledSpy.at(0).at(1).value<QVector<QOpcUa::UaStatusCode>>(), QVector<QOpcUa::UaStatusCode>({QOpcUa::UaStatusCode::Good}));
+
+    writeSpy.clear();
+    QVERIFY(opcuaClient->writeValues(valueHandle, {QOpcUa::TypedVariant(double(0), QOpcUa::Types::Double)}));
+    writeSpy.wait(signalSpyTimeout);
+    QCOMPARE(writeSpy.size(), 1);
+
+    opcuaClient->unregisterValueHandles(valueHandle);
+    QVERIFY(!opcuaClient->readValues(valueHandle));
+}
+
+void Tst_QOpcUaClient::futures()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Futures are currently only supported by the open62541 backend");
+
+    // Requests which can't be dispatched return a canceled future
+    auto canceledRead = opcuaClient->readNodeAttributesAsync({QOpcUaReadItem(readWriteNode)});
+    QVERIFY(canceledRead.isFinished());
+    QVERIFY(canceledRead.isCanceled());
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != nullptr);
+
+    QSignalSpy attributeWrittenSpy(node.data(), &QOpcUaNode::attributeWritten);
+    auto writeFuture = node->writeAttributesAsync({{QOpcUa::NodeAttribute::Value, double(42)}}, QOpcUa::Types::Double);
+    QTRY_VERIFY_WITH_TIMEOUT(writeFuture.isFinished(), signalSpyTimeout);
+    QVERIFY(!writeFuture.isCanceled());
+    QCOMPARE(writeFuture.result().size(), 1);
+    QCOMPARE(writeFuture.result().at(0).nodeId(), readWriteNode);
+    QCOMPARE(writeFuture.result().at(0).statusCode(), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(attributeWrittenSpy.size(), 0);
+
+    // Many requests in flight are finished independently
+    QVector<QFuture<QVector<QOpcUaReadResult>>> readFutures;
+    for (int i = 0; i < 20; ++i)
+        readFutures.push_back(i % 2 ? node->readAttributesAsync(QOpcUa::NodeAttribute::Value | QOpcUa::NodeAttribute::DataType)
+                                    : opcuaClient->readNodeAttributesAsync({QOpcUaReadItem(readWriteNode)}));
+
+    for (int i = 0; i < readFutures.size(); ++i) {
+        const auto &future = readFutures.at(i);
+        QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), signalSpyTimeout);
+        QVERIFY(!future.isCanceled());
+        const auto results = future.result();
+        QCOMPARE(results.size(), i % 2 ? 2 : 1);
+        QCOMPARE(results.at(0).attribute(), QOpcUa::NodeAttribute::Value);
+        QCOMPARE(results.at(0).value(), QVariant(double(42)));
+        QCOMPARE(results.at(0).statusCode(), QOpcUa::UaStatusCode::Good);
+    }
+    QCOMPARE(node->valueAttribute(), QVariant());
+
+    QScopedPointer<QOpcUaNode> folderNode(opcuaClient->node("ns=3;s=TestFolder"));
+    QVERIFY(folderNode != nullptr);
+    auto methodFuture = folderNode->callMethodAsync("ns=3;s=Test.Method.Multiply", {QOpcUa::TypedVariant(double(4), QOpcUa::Double),
+                                                                                 QOpcUa::TypedVariant(double(4), QOpcUa::Double)});
+
+    QOpcUaBrowseRequest request;
+    request.setReferenceTypeId(QOpcUa::ReferenceTypeId::References);
+    request.setBrowseDirection(QOpcUaBrowseRequest::BrowseDirection::Inverse);
+    QScopedPointer<QOpcUaNode> booleanNode(opcuaClient->node(QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::Boolean)));
+    QVERIFY(booleanNode != nullptr);
+    auto browseFuture = booleanNode->browseAsync(request);
+
+    QScopedPointer<QOpcUaNode> typesNode(opcuaClient->node(QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::TypesFolder)));
+    QVERIFY(typesNode != nullptr);
+    const QString referenceTypeId = QOpcUa::nodeIdFromReferenceType(QOpcUa::ReferenceTypeId::Organizes);
+    auto resolveFuture = typesNode->resolveBrowsePathAsync({QOpcUaRelativePathElement(QOpcUaQualifiedName(0, "DataTypes"), referenceTypeId),
+                                                           QOpcUaRelativePathElement(QOpcUaQualifiedName(0, "BaseDataType"), referenceTypeId)});
+
+    QTRY_VERIFY_WITH_TIMEOUT(methodFuture.isFinished(), signalSpyTimeout);
+    QVERIFY(!methodFuture.isCanceled());
+    QCOMPARE(methodFuture.result().statusCode(), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(methodFuture.result().value().toDouble(), 16.0);
+
+    QTRY_VERIFY_WITH_TIMEOUT(browseFuture.isFinished(), signalSpyTimeout);
+    QVERIFY(!browseFuture.isCanceled());
+    QVERIFY(browseFuture.result().isGood());
+    QCOMPARE(browseFuture.result().value().size(), 1);
+    QCOMPARE(browseFuture.result().value().at(0).targetNodeId().nodeId(), QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::BaseDataType));
+
+    QTRY_VERIFY_WITH_TIMEOUT(resolveFuture.isFinished(), signalSpyTimeout);
+    QVERIFY(!resolveFuture.isCanceled());
+    QCOMPARE(resolveFuture.result().statusCode(), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(resolveFuture.result().value().size(), 1);
+    QCOMPARE(resolveFuture.result().value().at(0).targetId().nodeId(), QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::BaseDataType));
+
+    writeFuture = opcuaClient->writeNodeAttributesAsync({QOpcUaWriteItem(readWriteNode, QOpcUa::NodeAttribute::Value, double(0),
+                                                                         QOpcUa::Types::Double)});
+    QTRY_VERIFY_WITH_TIMEOUT(writeFuture.isFinished(), signalSpyTimeout);
+    QCOMPARE(writeFuture.result().at(0).statusCode(), QOpcUa::UaStatusCode::Good);
+}
+
+void Tst_QOpcUaClient::callMethods()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() != QLatin1String("open62541"))
+        QSKIP("Batch method calls are currently only supported by the open62541 backend");
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    const QString objectId = QStringLiteral("ns=3;s=TestFolder");
+    const QString multiplyId = QStringLiteral("ns=3;s=Test.Method.Multiply");
+
+    QVector<QOpcUaCallMethodItem> request;
+    request.push_back(QOpcUaCallMethodItem(objectId, multiplyId, {QOpcUa::TypedVariant(double(4), QOpcUa::Double),
+                                                                 QOpcUa::TypedVariant(double(4), QOpcUa::Double)}));
+    request.push_back(QOpcUaCallMethodItem(objectId, QStringLiteral("ns=3;s=Test.Method.Divide"))); // Does not exist
+    request.push_back(QOpcUaCallMethodItem(objectId, multiplyId, {QOpcUa::TypedVariant(double(2), QOpcUa::Double)}));
+    request.push_back(QOpcUaCallMethodItem(objectId, multiplyId, {QOpcUa::TypedVariant(double(2), QOpcUa::Double),
+                                                                 QOpcUa::TypedVariant(double(3), QOpcUa::Double)}));
+
+    QSignalSpy callMethodsSpy(opcuaClient, &QOpcUaClient::callMethodsFinished);
+    QVERIFY(opcuaClient->callMethods(request));
+    callMethodsSpy.wait(signalSpyTimeout);
+    QCOMPARE(callMethodsSpy.size(), 1);
+    QCOMPARE(callMethodsSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    // The results have the order of the request
+    const auto results = callMethodsSpy.at(0).at(0).value<QVector<QOpcUaCallMethodResult>>();
+    QCOMPARE(results.size(), request.size());
+    for (int i = 0; i < results.size(); ++i) {
+        QCOMPARE(results.at(i).objectId(), objectId);
+        QCOMPARE(results.at(i).methodId(), request.at(i).methodId());
+    }
+    QCOMPARE(results.at(0).statusCode(), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(results.at(0).outputArguments(), QVariantList({16.0}));
+    QCOMPARE(QOpcUa::errorCategory(results.at(1).statusCode()), QOpcUa::ErrorCategory::NodeError);
+    QCOMPARE(results.at(2).statusCode(), QOpcUa::UaStatusCode::BadArgumentsMissing);
+    QVERIFY(results.at(2).outputArguments().isEmpty());
+    QCOMPARE(results.at(3).statusCode(), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(results.at(3).outputArguments(), QVariantList({6.0}));
+
+    auto future = opcuaClient->callMethodsAsync(request);
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), signalSpyTimeout);
+    QVERIFY(!future.isCanceled());
+    QCOMPARE(future.result().size(), request.size());
+    QCOMPARE(future.result().at(3).outputArguments(), QVariantList({6.0}));
+    QCOMPARE(callMethodsSpy.size(), 1);
+
+    callMethodsSpy.clear();
+    QVERIFY(opcuaClient->callMethods({}));
+    callMethodsSpy.wait(signalSpyTimeout);
+    QCOMPARE(callMethodsSpy.size(), 1);
+    QCOMPARE(callMethodsSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::BadNothingToDo);
+}
+
 void Tst_QOpcUaClient::statusStrings()
 {
     QCOMPARE(statusToString(QOpcUa::Good), "Good");
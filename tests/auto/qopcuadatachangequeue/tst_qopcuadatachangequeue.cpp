@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/qopcuadatachangequeue_p.h>
+
+#include <QtTest/QtTest>
+
+class Tst_QOpcUaDataChangeQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void conflation();
+    void separateAttributes();
+    void overflow();
+    void reclaimSlots();
+
+private:
+    static QOpcUaReadResult result(QOpcUa::NodeAttribute attribute, double value)
+    {
+        QOpcUaReadResult result;
+        result.setAttribute(attribute);
+        result.setValue(value);
+        return result;
+    }
+};
+
+void Tst_QOpcUaDataChangeQueue::conflation()
+{
+    QOpcUaDataChangeQueue queue(4);
+    QCOMPARE(queue.capacity(), 4);
+    QCOMPARE(queue.conflatedCount(), quint64(0));
+
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 1)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QVERIFY(queue.requestNotification());
+
+    // Newer values replace the pending value of the occupied slot
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 2)), QOpcUaDataChangeQueue::PushResult::Conflated);
+    QCOMPARE(queue.conflatedCount(), quint64(1));
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 3)), QOpcUaDataChangeQueue::PushResult::Conflated);
+    QCOMPARE(queue.conflatedCount(), quint64(2));
+
+    // There is only one outstanding notification until the values have been taken
+    QVERIFY(!queue.requestNotification());
+
+    QVector<quint64> handles;
+    QVector<QOpcUaReadResult> results;
+    QCOMPARE(queue.take(&handles, &results), 1);
+    QCOMPARE(handles, QVector<quint64>({1}));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0).attribute(), QOpcUa::NodeAttribute::Value);
+    QCOMPARE(results.at(0).value().toDouble(), 3.0);
+
+    handles.clear();
+    results.clear();
+    QCOMPARE(queue.take(&handles, &results), 0);
+    QVERIFY(handles.isEmpty());
+
+    // After the value has been taken, the slot is free for a new pending value
+    QVERIFY(queue.requestNotification());
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 4)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 5)), QOpcUaDataChangeQueue::PushResult::Conflated);
+    QCOMPARE(queue.conflatedCount(), quint64(3));
+    QCOMPARE(queue.take(&handles, &results), 1);
+    QCOMPARE(results.at(0).value().toDouble(), 5.0);
+    QCOMPARE(queue.overflowCount(), quint64(0));
+}
+
+void Tst_QOpcUaDataChangeQueue::separateAttributes()
+{
+    QOpcUaDataChangeQueue queue(4);
+
+    // Each attribute of a node has its own slot, the values are taken in the order of the first push
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 1)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::DisplayName, 2)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.push(2, result(QOpcUa::NodeAttribute::Value, 3)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 4)), QOpcUaDataChangeQueue::PushResult::Conflated);
+    QCOMPARE(queue.conflatedCount(), quint64(1));
+
+    QVector<quint64> handles;
+    QVector<QOpcUaReadResult> results;
+    QCOMPARE(queue.take(&handles, &results), 3);
+    QCOMPARE(handles, QVector<quint64>({1, 1, 2}));
+    QCOMPARE(results.at(0).attribute(), QOpcUa::NodeAttribute::Value);
+    QCOMPARE(results.at(0).value().toDouble(), 4.0);
+    QCOMPARE(results.at(1).attribute(), QOpcUa::NodeAttribute::DisplayName);
+    QCOMPARE(results.at(1).value().toDouble(), 2.0);
+    QCOMPARE(results.at(2).attribute(), QOpcUa::NodeAttribute::Value);
+    QCOMPARE(results.at(2).value().toDouble(), 3.0);
+}
+
+void Tst_QOpcUaDataChangeQueue::overflow()
+{
+    QOpcUaDataChangeQueue queue(2);
+
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 1)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.push(2, result(QOpcUa::NodeAttribute::Value, 2)), QOpcUaDataChangeQueue::PushResult::Queued);
+
+    // All slots are in use, a further attribute is rejected and counted
+    QCOMPARE(queue.push(3, result(QOpcUa::NodeAttribute::Value, 3)), QOpcUaDataChangeQueue::PushResult::Full);
+    QCOMPARE(queue.overflowCount(), quint64(1));
+
+    // The slots stay assigned after their values have been taken
+    QVector<quint64> handles;
+    QVector<QOpcUaReadResult> results;
+    QCOMPARE(queue.take(&handles, &results), 2);
+    QCOMPARE(queue.push(3, result(QOpcUa::NodeAttribute::Value, 3)), QOpcUaDataChangeQueue::PushResult::Full);
+    QCOMPARE(queue.overflowCount(), quint64(2));
+
+    // Attributes which own a slot are not affected
+    QCOMPARE(queue.push(2, result(QOpcUa::NodeAttribute::Value, 4)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.overflowCount(), quint64(2));
+    QCOMPARE(queue.conflatedCount(), quint64(0));
+}
+
+void Tst_QOpcUaDataChangeQueue::reclaimSlots()
+{
+    QOpcUaDataChangeQueue queue(2);
+    const auto onlySecondMonitored = [](quint64 handle, QOpcUa::NodeAttribute) { return handle == 2; };
+
+    QCOMPARE(queue.push(1, result(QOpcUa::NodeAttribute::Value, 1)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.push(2, result(QOpcUa::NodeAttribute::Value, 2)), QOpcUaDataChangeQueue::PushResult::Queued);
+
+    // The slot of an attribute which is no longer monitored is kept while its value is pending
+    queue.reclaimSlots(onlySecondMonitored);
+    QCOMPARE(queue.push(3, result(QOpcUa::NodeAttribute::Value, 3)), QOpcUaDataChangeQueue::PushResult::Full);
+    QCOMPARE(queue.push(3, result(QOpcUa::NodeAttribute::Value, 3), onlySecondMonitored),
+             QOpcUaDataChangeQueue::PushResult::Full);
+
+    QVector<quint64> handles;
+    QVector<QOpcUaReadResult> results;
+    QCOMPARE(queue.take(&handles, &results), 2);
+
+    // After the value has been taken, the slot is freed
+    queue.reclaimSlots(onlySecondMonitored);
+    QCOMPARE(queue.push(3, result(QOpcUa::NodeAttribute::Value, 3)), QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.push(4, result(QOpcUa::NodeAttribute::Value, 4)), QOpcUaDataChangeQueue::PushResult::Full);
+
+    // push() reclaims slots on its own if it gets the monitoring state
+    handles.clear();
+    results.clear();
+    QCOMPARE(queue.take(&handles, &results), 1);
+    QCOMPARE(queue.push(4, result(QOpcUa::NodeAttribute::Value, 4),
+                        [](quint64 handle, QOpcUa::NodeAttribute) { return handle == 4; }),
+             QOpcUaDataChangeQueue::PushResult::Queued);
+    QCOMPARE(queue.overflowCount(), quint64(3));
+
+    handles.clear();
+    results.clear();
+    QCOMPARE(queue.take(&handles, &results), 1);
+    QCOMPARE(handles, QVector<quint64>({4}));
+    QCOMPARE(results.at(0).value().toDouble(), 4.0);
+}
+
+QTEST_GUILESS_MAIN(Tst_QOpcUaDataChangeQueue)
+
+#include "tst_qopcuadatachangequeue.moc"
@@ -0,0 +1,8 @@
+TARGET = tst_qopcuahistoryread
+
+QT += testlib opcua opcua-private
+QT -= gui
+CONFIG += testcase
+
+SOURCES += \
+    tst_qopcuahistoryread.cpp
@@ -0,0 +1,503 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/qopcuabackend_p.h>
+#include <private/qopcuaclientimpl_p.h>
+#include <private/qopcuanodeimpl_p.h>
+
+#include <QtOpcUa/QOpcUaClient>
+#include <QtOpcUa/QOpcUaHistoryReadResponse>
+#include <QtOpcUa/QOpcUaNode>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QScopedPointer>
+
+#include <QtTest/QSignalSpy>
+#include <QtTest/QtTest>
+
+// The open62541 test server has no history backend, the paging is tested with a backend
+// which answers history reads from generated values and behaves like a server with continuation points.
+
+static const QDateTime historyStart(QDate(2020, 1, 1), QTime(0, 0), Qt::UTC);
+
+// The value with the index i of a node has the source timestamp historyStart + i seconds
+static QOpcUaReadResult historyValue(const QString &nodeId, int index)
+{
+    QOpcUaReadResult result;
+    result.setNodeId(nodeId);
+    result.setAttribute(QOpcUa::NodeAttribute::Value);
+    result.setValue(QStringLiteral("%1/%2").arg(nodeId).arg(index));
+    result.setSourceTimestamp(historyStart.addSecs(index));
+    result.setServerTimestamp(historyStart.addSecs(index));
+    result.setStatusCode(QOpcUa::UaStatusCode::Good);
+    return result;
+}
+
+class FakeNodeImpl : public QOpcUaNodeImpl
+{
+public:
+    explicit FakeNodeImpl(const QString &nodeId)
+        : m_nodeId(nodeId)
+    {}
+
+    bool readAttributes(QOpcUa::NodeAttributes, const QString &, double) override { return false; }
+    bool enableMonitoring(QOpcUa::NodeAttributes, const QOpcUaMonitoringParameters &) override { return false; }
+    bool disableMonitoring(QOpcUa::NodeAttributes) override { return false; }
+    bool browse(const QOpcUaBrowseRequest &) override { return false; }
+    QString nodeId() const override { return m_nodeId; }
+    bool writeAttribute(QOpcUa::NodeAttribute, const QVariant &, QOpcUa::Types, const QString &) override { return false; }
+    bool writeAttributes(const QOpcUaNode::AttributeMap &, QOpcUa::Types) override { return false; }
+    bool modifyMonitoring(QOpcUa::NodeAttribute, QOpcUaMonitoringParameters::Parameter, const QVariant &) override { return false; }
+    bool callMethod(const QString &, const QVector<QOpcUa::TypedVariant> &) override { return false; }
+    bool resolveBrowsePath(const QVector<QOpcUaRelativePathElement> &) override { return false; }
+
+private:
+    QString m_nodeId;
+};
+
+class FakeClientImpl : public QOpcUaClientImpl
+{
+public:
+    FakeClientImpl()
+    {
+        connectBackendWithClient(&m_backend);
+    }
+
+    void connectToEndpoint(const QOpcUaEndpointDescription &) override
+    {
+        emit m_backend.stateAndOrErrorChanged(QOpcUaClient::Connected, QOpcUaClient::NoError);
+    }
+    void disconnectFromEndpoint() override
+    {
+        emit m_backend.stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::NoError);
+    }
+    QOpcUaNode *node(const QString &nodeId) override { return new QOpcUaNode(new FakeNodeImpl(nodeId), m_client); }
+    QString backend() const override { return QStringLiteral("fake"); }
+    bool requestEndpoints(const QUrl &) override { return false; }
+    bool findServers(const QUrl &, const QStringList &, const QStringList &) override { return false; }
+    bool readNodeAttributes(const QVector<QOpcUaReadItem> &, double) override { return false; }
+    bool writeNodeAttributes(const QVector<QOpcUaWriteItem> &) override { return false; }
+    bool addNode(const QOpcUaAddNodeItem &) override { return false; }
+    bool deleteNode(const QString &, bool) override { return false; }
+    bool addReference(const QOpcUaAddReferenceItem &) override { return false; }
+    bool deleteReference(const QOpcUaDeleteReferenceItem &) override { return false; }
+    QStringList supportedSecurityPolicies() const override { return {}; }
+    QVector<QOpcUaUserTokenPolicy::TokenType> supportedUserTokenTypes() const override { return {}; }
+
+    // The node has the values 0 to valueCount - 1, see historyValue()
+    void setHistory(const QString &nodeId, int valueCount) { m_valueCounts.insert(nodeId, valueCount); }
+
+    int pagesSent() const { return m_pagesSent; }
+    int acknowledgements() const { return m_acknowledgements; }
+    int canceledReads() const { return m_canceledReads; }
+    int maxUnacknowledgedPages() const { return m_maxUnacknowledgedPages; }
+    int pagesInTransit() const { return m_pagesInTransit; }
+    int activeReads() const { return m_reads.size(); }
+
+    int unacknowledgedPages() const
+    {
+        int count = 0;
+        for (const auto &read : m_reads)
+            count += read.unacknowledgedPages;
+        return count;
+    }
+
+protected:
+    bool startHistoryRead(quint64 handle, const QOpcUaHistoryReadRequest &request) override
+    {
+        if (request.readType() != QOpcUaHistoryReadRequest::ReadType::Raw)
+            return false;
+
+        HistoryRead read;
+        read.request = request;
+        for (const auto &nodeId : request.nodeIds()) {
+            // The continuation point of a node is the index of its next value
+            const int count = m_valueCounts.value(nodeId);
+            read.continuationPoints.insert(nodeId, qBound(0, int(historyStart.secsTo(request.startTime())), count));
+            read.endIndices.insert(nodeId, qBound(0, int(historyStart.secsTo(request.endTime())) + 1, count));
+        }
+        m_reads.insert(handle, read);
+
+        sendPages(handle);
+        return true;
+    }
+
+    void acknowledgeHistoryData(quint64 handle) override
+    {
+        ++m_acknowledgements;
+
+        auto it = m_reads.find(handle);
+        if (it == m_reads.end())
+            return;
+
+        QVERIFY(it->unacknowledgedPages > 0);
+        --it->unacknowledgedPages;
+        sendPages(handle);
+    }
+
+    void cancelHistoryRead(quint64 handle) override
+    {
+        if (m_reads.remove(handle))
+            ++m_canceledReads;
+    }
+
+private:
+    struct HistoryRead {
+        QOpcUaHistoryReadRequest request;
+        QHash<QString, int> continuationPoints;
+        QHash<QString, int> endIndices;
+        int unacknowledgedPages = 0;
+    };
+
+    // Sends pages until maxPagesInFlight pages are unacknowledged, the pages arrive asynchronously like server responses
+    void sendPages(quint64 handle)
+    {
+        HistoryRead &read = m_reads[handle];
+
+        while (!read.continuationPoints.isEmpty() && read.unacknowledgedPages < read.request.maxPagesInFlight()) {
+            QVector<QOpcUaHistoryData> page;
+            for (const auto &nodeId : read.request.nodeIds()) {
+                if (!read.continuationPoints.contains(nodeId))
+                    continue;
+
+                const int begin = read.continuationPoints.value(nodeId);
+                const int numValues = int(read.request.numValuesPerNode());
+                const int end = numValues ? qMin(begin + numValues, read.endIndices.value(nodeId))
+                                          : read.endIndices.value(nodeId);
+
+                QOpcUaHistoryData data;
+                data.setNodeId(nodeId);
+                data.setStatusCode(QOpcUa::UaStatusCode::Good);
+                QVector<QOpcUaReadResult> values;
+                for (int i = begin; i < end; ++i)
+                    values.push_back(historyValue(nodeId, i));
+                data.setValues(values);
+
+                if (end == read.endIndices.value(nodeId)) {
+                    data.setLastPage(true);
+                    read.continuationPoints.remove(nodeId);
+                } else {
+                    read.continuationPoints.insert(nodeId, end);
+                }
+                page.push_back(data);
+            }
+
+            ++read.unacknowledgedPages;
+            m_maxUnacknowledgedPages = qMax(m_maxUnacknowledgedPages, read.unacknowledgedPages);
+            ++m_pagesSent;
+            ++m_pagesInTransit;
+            QMetaObject::invokeMethod(&m_backend, [this, handle, page]() {
+                --m_pagesInTransit;
+                emit m_backend.historyDataReceived(handle, page);
+            }, Qt::QueuedConnection);
+        }
+
+        if (read.continuationPoints.isEmpty() && read.unacknowledgedPages == 0) {
+            m_reads.remove(handle);
+            ++m_pagesInTransit;
+            QMetaObject::invokeMethod(&m_backend, [this, handle]() {
+                --m_pagesInTransit;
+                emit m_backend.historyReadFinished(handle, QOpcUa::UaStatusCode::Good);
+            }, Qt::QueuedConnection);
+        }
+    }
+
+    QOpcUaBackend m_backend;
+    QHash<QString, int> m_valueCounts;
+    QHash<quint64, HistoryRead> m_reads;
+    int m_pagesSent = 0;
+    int m_acknowledgements = 0;
+    int m_canceledReads = 0;
+    int m_maxUnacknowledgedPages = 0;
+    int m_pagesInTransit = 0;
+};
+
+class Tst_QOpcUaHistoryRead : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void readHistoryRaw_data();
+    void readHistoryRaw();
+    void readMultipleNodes();
+    void acknowledgement();
+    void abort();
+    void deleteResponse();
+
+private:
+    // Checks that the pages of each node contain the values from begin to end - 1 in order
+    static void verifyPages(const QSignalSpy &dataSpy, const QString &nodeId, int begin, int end, int numValuesPerNode);
+
+    FakeClientImpl *m_impl = nullptr;
+    QScopedPointer<QOpcUaClient> m_client;
+};
+
+static const QString longHistoryNode = QStringLiteral("ns=2;s=LongHistory");
+static const QString shortHistoryNode = QStringLiteral("ns=2;s=ShortHistory");
+
+void Tst_QOpcUaHistoryRead::initTestCase()
+{
+    // The client is created without QOpcUaProvider, which registers the types for the signal spies
+    qRegisterMetaType<QOpcUa::UaStatusCode>();
+    qRegisterMetaType<QVector<QOpcUaHistoryData>>();
+}
+
+void Tst_QOpcUaHistoryRead::init()
+{
+    m_impl = new FakeClientImpl;
+    m_impl->setHistory(longHistoryNode, 50);
+    m_impl->setHistory(shortHistoryNode, 12);
+    m_client.reset(new QOpcUaClient(m_impl));
+    m_client->connectToEndpoint(QOpcUaEndpointDescription());
+    QCOMPARE(m_client->state(), QOpcUaClient::Connected);
+}
+
+void Tst_QOpcUaHistoryRead::cleanup()
+{
+    m_client.reset();
+    m_impl = nullptr;
+}
+
+void Tst_QOpcUaHistoryRead::verifyPages(const QSignalSpy &dataSpy, const QString &nodeId, int begin, int end, int numValuesPerNode)
+{
+    QVector<QOpcUaHistoryData> pages;
+    for (const auto &signal : dataSpy) {
+        for (const auto &data : signal.at(0).value<QVector<QOpcUaHistoryData>>()) {
+            if (data.nodeId() == nodeId)
+                pages.push_back(data);
+        }
+    }
+
+    const int valueCount = end - begin;
+    const int expectedPages = numValuesPerNode ? qMax(1, (valueCount + numValuesPerNode - 1) / numValuesPerNode) : 1;
+    QCOMPARE(pages.size(), expectedPages);
+
+    int index = begin;
+    for (int i = 0; i < pages.size(); ++i) {
+        const QOpcUaHistoryData &page = pages.at(i);
+        QCOMPARE(page.statusCode(), QOpcUa::UaStatusCode::Good);
+        QCOMPARE(page.isLastPage(), i == pages.size() - 1);
+        if (numValuesPerNode)
+            QVERIFY(page.values().size() <= numValuesPerNode);
+
+        for (const auto &value : page.values()) {
+            const QOpcUaReadResult expected = historyValue(nodeId, index++);
+            QCOMPARE(value.nodeId(), nodeId);
+            QCOMPARE(value.value(), expected.value());
+            QCOMPARE(value.sourceTimestamp(), expected.sourceTimestamp());
+            QCOMPARE(value.statusCode(), QOpcUa::UaStatusCode::Good);
+        }
+    }
+    QCOMPARE(index, end);
+}
+
+void Tst_QOpcUaHistoryRead::readHistoryRaw_data()
+{
+    QTest::addColumn<quint32>("numValuesPerNode");
+
+    QTest::newRow("5 values per page") << quint32(5);
+    QTest::newRow("1 value per page") << quint32(1);
+    QTest::newRow("page size equals value count") << quint32(38);
+    QTest::newRow("unlimited") << quint32(0);
+}
+
+void Tst_QOpcUaHistoryRead::readHistoryRaw()
+{
+    QFETCH(quint32, numValuesPerNode);
+
+    QScopedPointer<QOpcUaNode> node(m_client->node(longHistoryNode));
+    QVERIFY(node != nullptr);
+
+    // The values 3 to 40 are in the time range
+    QScopedPointer<QOpcUaHistoryReadResponse> response(node->readHistoryRaw(historyStart.addSecs(3), historyStart.addSecs(40),
+                                                                             numValuesPerNode));
+    QVERIFY(response != nullptr);
+    QCOMPARE(response->request().nodeIds(), QStringList({longHistoryNode}));
+    QCOMPARE(response->request().numValuesPerNode(), numValuesPerNode);
+    QCOMPARE(response->request().maxPagesInFlight(), 4);
+
+    QSignalSpy dataSpy(response.data(), &QOpcUaHistoryReadResponse::dataReceived);
+    QSignalSpy finishedSpy(response.data(), &QOpcUaHistoryReadResponse::finished);
+
+    // Nothing is delivered synchronously
+    QCOMPARE(dataSpy.size(), 0);
+
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(finishedSpy.at(0).at(0).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+    QVERIFY(response->isFinished());
+    QCOMPARE(response->statusCode(), QOpcUa::UaStatusCode::Good);
+
+    verifyPages(dataSpy, longHistoryNode, 3, 41, int(numValuesPerNode));
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(response->receivedValueCount(), quint64(38));
+
+    // Every page has been acknowledged after it has been processed
+    QCOMPARE(dataSpy.size(), m_impl->pagesSent());
+    QCOMPARE(m_impl->acknowledgements(), m_impl->pagesSent());
+    QVERIFY(m_impl->maxUnacknowledgedPages() <= 4);
+    QCOMPARE(m_impl->activeReads(), 0);
+    QCOMPARE(m_impl->pagesInTransit(), 0);
+}
+
+void Tst_QOpcUaHistoryRead::readMultipleNodes()
+{
+    QOpcUaHistoryReadRequest request;
+    request.setNodeIds({longHistoryNode, shortHistoryNode});
+    request.setStartTime(historyStart.addSecs(3));
+    request.setEndTime(historyStart.addSecs(40));
+    request.setNumValuesPerNode(5);
+    request.setMaxPagesInFlight(2);
+
+    QScopedPointer<QOpcUaHistoryReadResponse> response(m_client->readHistoryData(request));
+    QVERIFY(response != nullptr);
+
+    QSignalSpy dataSpy(response.data(), &QOpcUaHistoryReadResponse::dataReceived);
+    QSignalSpy finishedSpy(response.data(), &QOpcUaHistoryReadResponse::finished);
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(finishedSpy.at(0).at(0).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    // The short history ends with the value 11, the read continues only for the remaining node
+    verifyPages(dataSpy, longHistoryNode, 3, 41, 5);
+    if (QTest::currentTestFailed())
+        return;
+    verifyPages(dataSpy, shortHistoryNode, 3, 12, 5);
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(dataSpy.size(), 8);
+    QCOMPARE(dataSpy.at(0).at(0).value<QVector<QOpcUaHistoryData>>().size(), 2);
+    QCOMPARE(dataSpy.at(1).at(0).value<QVector<QOpcUaHistoryData>>().size(), 2);
+    QCOMPARE(dataSpy.at(2).at(0).value<QVector<QOpcUaHistoryData>>().size(), 1);
+    QCOMPARE(response->receivedValueCount(), quint64(38 + 9));
+
+    QCOMPARE(m_impl->acknowledgements(), 8);
+    QCOMPARE(m_impl->maxUnacknowledgedPages(), 2);
+}
+
+void Tst_QOpcUaHistoryRead::acknowledgement()
+{
+    QOpcUaHistoryReadRequest request;
+    request.setNodeIds({longHistoryNode});
+    request.setStartTime(historyStart);
+    request.setEndTime(historyStart.addSecs(49));
+    request.setNumValuesPerNode(10);
+    request.setMaxPagesInFlight(1);
+
+    QScopedPointer<QOpcUaHistoryReadResponse> response(m_client->readHistoryData(request));
+    QVERIFY(response != nullptr);
+
+    // The next page is not sent before the receivers have processed the current one
+    int received = 0;
+    connect(response.data(), &QOpcUaHistoryReadResponse::dataReceived, this, [&]() {
+        ++received;
+        QCOMPARE(m_impl->pagesSent(), received);
+        QCOMPARE(m_impl->acknowledgements(), received - 1);
+        QCOMPARE(m_impl->unacknowledgedPages(), 1);
+    });
+
+    QSignalSpy finishedSpy(response.data(), &QOpcUaHistoryReadResponse::finished);
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(received, 5);
+    QCOMPARE(m_impl->acknowledgements(), 5);
+    QCOMPARE(m_impl->maxUnacknowledgedPages(), 1);
+    QCOMPARE(response->receivedValueCount(), quint64(50));
+}
+
+void Tst_QOpcUaHistoryRead::abort()
+{
+    QOpcUaHistoryReadRequest request;
+    request.setNodeIds({longHistoryNode, shortHistoryNode});
+    request.setStartTime(historyStart);
+    request.setEndTime(historyStart.addSecs(49));
+    request.setNumValuesPerNode(5);
+    request.setMaxPagesInFlight(1);
+
+    QScopedPointer<QOpcUaHistoryReadResponse> response(m_client->readHistoryData(request));
+    QVERIFY(response != nullptr);
+
+    // Abort after the first page, the continuation points are released and no more pages are delivered
+    QSignalSpy dataSpy(response.data(), &QOpcUaHistoryReadResponse::dataReceived);
+    QSignalSpy finishedSpy(response.data(), &QOpcUaHistoryReadResponse::finished);
+    connect(response.data(), &QOpcUaHistoryReadResponse::dataReceived, response.data(), &QOpcUaHistoryReadResponse::abort);
+
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(finishedSpy.at(0).at(0).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::BadRequestCancelledByClient);
+    QCOMPARE(response->statusCode(), QOpcUa::UaStatusCode::BadRequestCancelledByClient);
+    QCOMPARE(dataSpy.size(), 1);
+    QCOMPARE(response->receivedValueCount(), quint64(10));
+
+    QTRY_COMPARE(m_impl->pagesInTransit(), 0);
+    QCOMPARE(m_impl->canceledReads(), 1);
+    QCOMPARE(m_impl->activeReads(), 0);
+    QCOMPARE(m_impl->pagesSent(), 1);
+    QCOMPARE(m_impl->acknowledgements(), 0);
+    QCOMPARE(dataSpy.size(), 1);
+    QCOMPARE(finishedSpy.size(), 1);
+}
+
+void Tst_QOpcUaHistoryRead::deleteResponse()
+{
+    QOpcUaHistoryReadRequest request;
+    request.setNodeIds({longHistoryNode});
+    request.setStartTime(historyStart);
+    request.setEndTime(historyStart.addSecs(49));
+    request.setNumValuesPerNode(5);
+    request.setMaxPagesInFlight(3);
+
+    QOpcUaHistoryReadResponse *response = m_client->readHistoryData(request);
+    QVERIFY(response != nullptr);
+
+    // Destroying the response aborts the read, pages which are already in transit are discarded
+    QCOMPARE(m_impl->pagesInTransit(), 3);
+    delete response;
+    QCOMPARE(m_impl->canceledReads(), 1);
+    QCOMPARE(m_impl->activeReads(), 0);
+
+    QTRY_COMPARE(m_impl->pagesInTransit(), 0);
+    QCOMPARE(m_impl->pagesSent(), 3);
+    QCOMPARE(m_impl->acknowledgements(), 0);
+}
+
+QTEST_GUILESS_MAIN(Tst_QOpcUaHistoryRead)
+
+#include "tst_qopcuahistoryread.moc"
@@ -0,0 +1,8 @@
+TARGET = tst_qopcuaslotmap
+
+QT += testlib opcua opcua-private
+QT -= gui
+CONFIG += testcase
+
+SOURCES += \
+    tst_qopcuaslotmap.cpp
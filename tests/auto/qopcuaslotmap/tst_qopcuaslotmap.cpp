@@ -0,0 +1,189 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/qopcuaslotmap_p.h>
+
+#include <QtCore/QString>
+
+#include <QtTest/QtTest>
+
+class Tst_QOpcUaSlotMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndFind();
+    void staleHandleAfterReuse();
+    void generationBump();
+    void tagMismatch();
+    void forEach();
+
+private:
+    static quint32 generation(quint64 handle) { return quint32(handle >> 32); }
+    static quint64 indexBits(quint64 handle) { return handle & ((quint64(1) << 30) - 1); }
+};
+
+void Tst_QOpcUaSlotMap::insertAndFind()
+{
+    QOpcUaSlotMap<QString> map;
+    QVERIFY(map.isEmpty());
+
+    const quint64 first = map.insert(QStringLiteral("first"));
+    const quint64 second = map.insert(QStringLiteral("second"));
+    QVERIFY(first != 0);
+    QVERIFY(second != 0);
+    QVERIFY(first != second);
+    QCOMPARE(map.size(), 2);
+
+    QVERIFY(map.contains(first));
+    QCOMPARE(map.value(first), QStringLiteral("first"));
+    QVERIFY(map.find(second) != nullptr);
+    QCOMPARE(*map.find(second), QStringLiteral("second"));
+
+    // Handle 0 is never valid
+    QVERIFY(!map.contains(0));
+    QVERIFY(map.find(0) == nullptr);
+    QVERIFY(!map.remove(0));
+
+    QCOMPARE(map.take(first), QStringLiteral("first"));
+    QCOMPARE(map.size(), 1);
+    QVERIFY(map.remove(second));
+    QVERIFY(map.isEmpty());
+}
+
+void Tst_QOpcUaSlotMap::staleHandleAfterReuse()
+{
+    QOpcUaSlotMap<QString> map;
+
+    const quint64 stale = map.insert(QStringLiteral("removed"));
+    QVERIFY(map.remove(stale));
+
+    // The freed slot is reused for the next value
+    const quint64 current = map.insert(QStringLiteral("current"));
+    QCOMPARE(indexBits(current), indexBits(stale));
+    QVERIFY(current != stale);
+    QCOMPARE(map.size(), 1);
+
+    // The handle of the removed value must not resolve to the new value of its slot
+    QVERIFY(!map.contains(stale));
+    QVERIFY(map.find(stale) == nullptr);
+    QCOMPARE(map.value(stale, QStringLiteral("default")), QStringLiteral("default"));
+    QVERIFY(map.take(stale).isNull());
+    QVERIFY(!map.remove(stale));
+
+    // The failed operations with the stale handle left the new value untouched
+    QCOMPARE(map.size(), 1);
+    QCOMPARE(map.value(current), QStringLiteral("current"));
+}
+
+void Tst_QOpcUaSlotMap::generationBump()
+{
+    QOpcUaSlotMap<int> map;
+
+    const quint64 first = map.insert(1);
+    QCOMPARE(generation(first) & 1, 1u);
+
+    // Removal and insertion both bump the generation, a used slot always has an odd generation
+    QVERIFY(map.remove(first));
+    const quint64 second = map.insert(2);
+    QCOMPARE(indexBits(second), indexBits(first));
+    QCOMPARE(generation(second), generation(first) + 2);
+
+    QVERIFY(map.remove(second));
+    const quint64 third = map.insert(3);
+    QCOMPARE(generation(third), generation(second) + 2);
+
+    // A forged handle with the even generation of a free slot is rejected
+    QVERIFY(map.remove(third));
+    const quint64 freeSlot = (quint64(generation(third) + 1) << 32) | indexBits(third);
+    QVERIFY(!map.contains(freeSlot));
+    QVERIFY(!map.contains(third));
+}
+
+void Tst_QOpcUaSlotMap::tagMismatch()
+{
+    QOpcUaSlotMap<int> nodes(0);
+    QOpcUaSlotMap<int> values(1);
+
+    // The first slot of both maps has the same index and generation, only the tag differs
+    const quint64 nodeHandle = nodes.insert(1);
+    const quint64 valueHandle = values.insert(2);
+    QCOMPARE(indexBits(nodeHandle), indexBits(valueHandle));
+    QCOMPARE(generation(nodeHandle), generation(valueHandle));
+    QVERIFY(nodeHandle != valueHandle);
+
+    QVERIFY(!nodes.contains(valueHandle));
+    QVERIFY(nodes.find(valueHandle) == nullptr);
+    QVERIFY(!nodes.remove(valueHandle));
+    QVERIFY(!values.contains(nodeHandle));
+    QVERIFY(values.find(nodeHandle) == nullptr);
+    QVERIFY(!values.remove(nodeHandle));
+
+    QCOMPARE(nodes.size(), 1);
+    QCOMPARE(values.size(), 1);
+    QCOMPARE(nodes.value(nodeHandle), 1);
+    QCOMPARE(values.value(valueHandle), 2);
+
+    // Only the two lowest bits of the tag are used
+    QOpcUaSlotMap<int> wrapped(4);
+    const quint64 wrappedHandle = wrapped.insert(3);
+    QCOMPARE(wrappedHandle, nodeHandle);
+    QVERIFY(!values.contains(wrappedHandle));
+}
+
+void Tst_QOpcUaSlotMap::forEach()
+{
+    QOpcUaSlotMap<int> map(2);
+
+    const quint64 first = map.insert(1);
+    const quint64 second = map.insert(2);
+    const quint64 third = map.insert(3);
+    QVERIFY(map.remove(second));
+
+    QVector<quint64> handles;
+    QVector<int> values;
+    map.forEach([&handles, &values](quint64 handle, int value) {
+        handles.push_back(handle);
+        values.push_back(value);
+    });
+
+    QCOMPARE(handles, QVector<quint64>({first, third}));
+    QCOMPARE(values, QVector<int>({1, 3}));
+}
+
+QTEST_GUILESS_MAIN(Tst_QOpcUaSlotMap)
+
+#include "tst_qopcuaslotmap.moc"
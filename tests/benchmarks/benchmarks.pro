@@ -0,0 +1,7 @@
+TEMPLATE = subdirs
+
+QT_FOR_CONFIG += opcua-private
+
+SUBDIRS += handlelookup nodefootprint
+
+qtConfig(open62541): SUBDIRS += nodeidparsing
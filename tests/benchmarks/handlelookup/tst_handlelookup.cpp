@@ -0,0 +1,192 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <private/qopcuaslotmap_p.h>
+
+#include <QtTest>
+
+#include <QtCore/QHash>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QVector>
+
+#include <limits>
+
+/*
+    This benchmark compares the handle registry of QOpcUaClientImpl with the previous
+    implementation, which is kept here as reference. Previously, a free handle was found by
+    incrementing a counter and probing a hash, and every result from the backend was
+    dispatched by a hash lookup of its handle.
+*/
+
+namespace Legacy {
+
+class HandleRegistry
+{
+public:
+    quint64 insert(void *object)
+    {
+        if (m_handles.count() == (std::numeric_limits<int>::max)())
+            return 0;
+
+        while (true) {
+            ++m_handleCounter;
+
+            if (!m_handles.contains(m_handleCounter)) {
+                m_handles[m_handleCounter] = object;
+                return m_handleCounter;
+            }
+        }
+    }
+
+    void remove(quint64 handle) { m_handles.remove(handle); }
+    void *value(quint64 handle) const { return m_handles.value(handle); }
+
+private:
+    QHash<quint64, void *> m_handles;
+    quint64 m_handleCounter = 0;
+};
+
+} // namespace Legacy
+
+class HandleLookupBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void registerAndUnregister_data();
+    void registerAndUnregister();
+    void dispatch_data();
+    void dispatch();
+
+private:
+    template <typename Registry>
+    void runRegisterAndUnregister(int count);
+
+    template <typename Registry>
+    void runDispatch(int count);
+};
+
+static void addCases()
+{
+    QTest::addColumn<bool>("slotMap");
+    QTest::addColumn<int>("count");
+
+    for (int count : {1000, 100000}) {
+        QTest::addRow("hash, %d handles", count) << false << count;
+        QTest::addRow("slot map, %d handles", count) << true << count;
+    }
+}
+
+template <typename Registry>
+void HandleLookupBenchmark::runRegisterAndUnregister(int count)
+{
+    Registry registry;
+    QVector<quint64> handles(count);
+    int dummy = 0;
+
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            handles[i] = registry.insert(&dummy);
+        for (int i = 0; i < count; ++i)
+            registry.remove(handles.at(i));
+    }
+}
+
+template <typename Registry>
+void HandleLookupBenchmark::runDispatch(int count)
+{
+    Registry registry;
+    QVector<quint64> handles(count);
+    QVector<int> objects(count);
+
+    for (int i = 0; i < count; ++i)
+        handles[i] = registry.insert(&objects[i]);
+
+    // Data change notifications arrive in no particular order
+    QVector<quint64> notifications(count);
+    for (int i = 0; i < count; ++i)
+        notifications[i] = handles.at(QRandomGenerator::global()->bounded(count));
+
+    // A removed node must be detected as such
+    registry.remove(handles.at(0));
+    notifications[0] = handles.at(0);
+
+    int found = 0;
+    QBENCHMARK {
+        for (quint64 handle : qAsConst(notifications)) {
+            if (registry.value(handle))
+                ++found;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void HandleLookupBenchmark::registerAndUnregister_data()
+{
+    addCases();
+}
+
+void HandleLookupBenchmark::registerAndUnregister()
+{
+    QFETCH(bool, slotMap);
+    QFETCH(int, count);
+
+    if (slotMap)
+        runRegisterAndUnregister<QOpcUaSlotMap<void *>>(count);
+    else
+        runRegisterAndUnregister<Legacy::HandleRegistry>(count);
+}
+
+void HandleLookupBenchmark::dispatch_data()
+{
+    addCases();
+}
+
+void HandleLookupBenchmark::dispatch()
+{
+    QFETCH(bool, slotMap);
+    QFETCH(int, count);
+
+    if (slotMap)
+        runDispatch<QOpcUaSlotMap<void *>>(count);
+    else
+        runDispatch<Legacy::HandleRegistry>(count);
+}
+
+QTEST_MAIN(HandleLookupBenchmark)
+
+#include "tst_handlelookup.moc"
@@ -0,0 +1,11 @@
+QT       += testlib opcua opcua-private
+QT       -= gui
+
+TARGET = tst_nodefootprint
+CONFIG   -= app_bundle
+CONFIG   += release
+
+TEMPLATE = app
+
+SOURCES += \
+        tst_nodefootprint.cpp
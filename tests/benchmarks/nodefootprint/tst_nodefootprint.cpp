@@ -0,0 +1,445 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtOpcUa/qopcuaclient.h>
+#include <QtOpcUa/qopcuanode.h>
+#include <QtOpcUa/qopcualocalizedtext.h>
+#include <QtOpcUa/qopcuaqualifiedname.h>
+#include <QtOpcUa/qopcuausertokenpolicy.h>
+#include <private/qopcuaclientimpl_p.h>
+#include <private/qopcuanode_p.h>
+#include <private/qopcuanodeimpl_p.h>
+
+#include <QtTest>
+
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QVector>
+
+#include <cstdlib>
+#if defined(Q_OS_LINUX)
+#include <malloc.h>
+#endif
+
+/*
+    This benchmark compares the construction time and the memory footprint of QOpcUaNode
+    with the previous node layout, which is kept here as reference. Previously, the backend
+    part of the node was a second QObject whose signals were connected to the node by ten
+    lambda connections, and the attribute values were kept in hashes.
+
+    No server is required, the nodes are created with a stub backend.
+*/
+
+namespace Legacy {
+
+class NodeImpl : public QObject
+{
+    Q_OBJECT
+
+Q_SIGNALS:
+    void attributesRead(QVector<QOpcUaReadResult> attr, QOpcUa::UaStatusCode serviceResult);
+    void attributeWritten(QOpcUa::NodeAttribute attr, QVariant value, QOpcUa::UaStatusCode statusCode);
+    void browseFinished(QVector<QOpcUaReferenceDescription> children, QOpcUa::UaStatusCode statusCode);
+    void dataChangeOccurred(QOpcUa::NodeAttribute attr, QOpcUaReadResult value);
+    void dataChangesOccurred(QOpcUa::NodeAttribute attr, QVector<QOpcUaReadResult> values);
+    void eventOccurred(QVariantList eventFields);
+    void monitoringEnableDisable(QOpcUa::NodeAttribute attr, bool subscribe, QOpcUaMonitoringParameters status);
+    void monitoringStatusChanged(QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items,
+                                 QOpcUaMonitoringParameters param);
+    void methodCallFinished(QString methodNodeId, QVariant result, QOpcUa::UaStatusCode statusCode);
+    void resolveBrowsePathFinished(QVector<QOpcUaBrowsePathTarget> targets,
+                                   QVector<QOpcUaRelativePathElement> path, QOpcUa::UaStatusCode status);
+};
+
+class Node;
+
+class NodePrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(Node)
+
+public:
+    explicit NodePrivate(NodeImpl *impl);
+    ~NodePrivate();
+
+    QScopedPointer<NodeImpl> m_impl;
+    QHash<QOpcUa::NodeAttribute, QOpcUaReadResult> m_nodeAttributes;
+    QHash<QOpcUa::NodeAttribute, QOpcUaMonitoringParameters> m_monitoringStatus;
+    QMetaObject::Connection m_connections[10];
+};
+
+class Node : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(Node)
+
+public:
+    explicit Node(NodeImpl *impl)
+        : QObject(*new NodePrivate(impl))
+    {}
+
+    int attributeCount() const
+    {
+        Q_D(const Node);
+        return d->m_nodeAttributes.size();
+    }
+
+Q_SIGNALS:
+    void attributeRead(QOpcUa::NodeAttributes attributes);
+    void attributeWritten(QOpcUa::NodeAttribute attribute, QOpcUa::UaStatusCode statusCode);
+    void attributeUpdated(QOpcUa::NodeAttribute attr, QVariant value);
+    void dataChangesOccurred(QOpcUa::NodeAttribute attr, QVector<QOpcUaReadResult> values);
+    void eventOccurred(QVariantList eventFields);
+    void monitoringStatusChanged(QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items,
+                                 QOpcUa::UaStatusCode statusCode);
+    void enableMonitoringFinished(QOpcUa::NodeAttribute attr, QOpcUa::UaStatusCode statusCode);
+    void disableMonitoringFinished(QOpcUa::NodeAttribute attr, QOpcUa::UaStatusCode statusCode);
+    void methodCallFinished(QString methodNodeId, QVariant result, QOpcUa::UaStatusCode statusCode);
+    void browseFinished(QVector<QOpcUaReferenceDescription> children, QOpcUa::UaStatusCode statusCode);
+    void resolveBrowsePathFinished(QVector<QOpcUaBrowsePathTarget> targets,
+                                   QVector<QOpcUaRelativePathElement> path, QOpcUa::UaStatusCode statusCode);
+};
+
+NodePrivate::NodePrivate(NodeImpl *impl)
+    : m_impl(impl)
+{
+    m_connections[0] = QObject::connect(impl, &NodeImpl::attributesRead,
+            [this](QVector<QOpcUaReadResult> attr, QOpcUa::UaStatusCode serviceResult) {
+        Q_Q(Node);
+        QOpcUa::NodeAttributes updatedAttributes;
+        for (const auto &entry : qAsConst(attr)) {
+            if (serviceResult == QOpcUa::UaStatusCode::Good)
+                m_nodeAttributes[entry.attribute()] = entry;
+            updatedAttributes |= entry.attribute();
+            emit q->attributeUpdated(entry.attribute(), entry.value());
+        }
+        emit q->attributeRead(updatedAttributes);
+    });
+    m_connections[1] = QObject::connect(impl, &NodeImpl::attributeWritten,
+            [this](QOpcUa::NodeAttribute attr, QVariant value, QOpcUa::UaStatusCode statusCode) {
+        Q_Q(Node);
+        m_nodeAttributes[attr].setStatusCode(statusCode);
+        m_nodeAttributes[attr].setValue(value);
+        emit q->attributeWritten(attr, statusCode);
+    });
+    m_connections[2] = QObject::connect(impl, &NodeImpl::dataChangeOccurred,
+            [this](QOpcUa::NodeAttribute attr, QOpcUaReadResult value) {
+        Q_Q(Node);
+        m_nodeAttributes[attr] = value;
+        emit q->dataChangesOccurred(attr, {value});
+    });
+    m_connections[3] = QObject::connect(impl, &NodeImpl::dataChangesOccurred,
+            [this](QOpcUa::NodeAttribute attr, QVector<QOpcUaReadResult> values) {
+        Q_Q(Node);
+        if (!values.isEmpty())
+            m_nodeAttributes[attr] = values.constLast();
+        emit q->dataChangesOccurred(attr, values);
+    });
+    m_connections[4] = QObject::connect(impl, &NodeImpl::monitoringEnableDisable,
+            [this](QOpcUa::NodeAttribute attr, bool subscribe, QOpcUaMonitoringParameters status) {
+        Q_Q(Node);
+        if (subscribe) {
+            m_monitoringStatus[attr] = status;
+            emit q->enableMonitoringFinished(attr, status.statusCode());
+        } else {
+            m_monitoringStatus.remove(attr);
+            emit q->disableMonitoringFinished(attr, status.statusCode());
+        }
+    });
+    m_connections[5] = QObject::connect(impl, &NodeImpl::monitoringStatusChanged,
+            [this](QOpcUa::NodeAttribute attr, QOpcUaMonitoringParameters::Parameters items, QOpcUaMonitoringParameters param) {
+        Q_Q(Node);
+        emit q->monitoringStatusChanged(attr, items, param.statusCode());
+    });
+    m_connections[6] = QObject::connect(impl, &NodeImpl::methodCallFinished,
+            [this](QString methodNodeId, QVariant result, QOpcUa::UaStatusCode statusCode) {
+        Q_Q(Node);
+        emit q->methodCallFinished(methodNodeId, result, statusCode);
+    });
+    m_connections[7] = QObject::connect(impl, &NodeImpl::browseFinished,
+            [this](QVector<QOpcUaReferenceDescription> children, QOpcUa::UaStatusCode statusCode) {
+        Q_Q(Node);
+        emit q->browseFinished(children, statusCode);
+    });
+    m_connections[8] = QObject::connect(impl, &NodeImpl::resolveBrowsePathFinished,
+            [this](QVector<QOpcUaBrowsePathTarget> targets, QVector<QOpcUaRelativePathElement> path,
+                   QOpcUa::UaStatusCode statusCode) {
+        Q_Q(Node);
+        emit q->resolveBrowsePathFinished(targets, path, statusCode);
+    });
+    m_connections[9] = QObject::connect(impl, &NodeImpl::eventOccurred, [this](QVariantList eventFields) {
+        Q_Q(Node);
+        emit q->eventOccurred(eventFields);
+    });
+}
+
+NodePrivate::~NodePrivate()
+{
+    for (const auto &connection : m_connections)
+        QObject::disconnect(connection);
+}
+
+// The client kept a guarded pointer to the backend part of each node
+class Client
+{
+public:
+    Node *node(quint64 handle)
+    {
+        auto impl = new NodeImpl;
+        m_handles.insert(handle, impl);
+        return new Node(impl);
+    }
+
+    void removeNode(Node *node, quint64 handle)
+    {
+        m_handles.remove(handle);
+        delete node;
+    }
+
+    NodeImpl *impl(quint64 handle) const
+    {
+        return m_handles.value(handle);
+    }
+
+private:
+    QHash<quint64, QPointer<NodeImpl>> m_handles;
+};
+
+} // namespace Legacy
+
+class StubClientImpl : public QOpcUaClientImpl
+{
+public:
+    void connectToEndpoint(const QOpcUaEndpointDescription &) override {}
+    void disconnectFromEndpoint() override {}
+    QOpcUaNode *node(const QString &) override { return nullptr; }
+    QString backend() const override { return QStringLiteral("stub"); }
+    bool requestEndpoints(const QUrl &) override { return false; }
+    bool findServers(const QUrl &, const QStringList &, const QStringList &) override { return false; }
+    bool readNodeAttributes(const QVector<QOpcUaReadItem> &, double) override { return false; }
+    bool writeNodeAttributes(const QVector<QOpcUaWriteItem> &) override { return false; }
+    bool addNode(const QOpcUaAddNodeItem &) override { return false; }
+    bool deleteNode(const QString &, bool) override { return false; }
+    bool addReference(const QOpcUaAddReferenceItem &) override { return false; }
+    bool deleteReference(const QOpcUaDeleteReferenceItem &) override { return false; }
+    QStringList supportedSecurityPolicies() const override { return {}; }
+    QVector<QOpcUaUserTokenPolicy::TokenType> supportedUserTokenTypes() const override { return {}; }
+};
+
+// Registers with the client like the nodes of the real backends
+class StubNodeImpl : public QOpcUaNodeImpl
+{
+public:
+    StubNodeImpl(QOpcUaClientImpl *client, const QString &nodeId)
+        : m_client(client)
+        , m_nodeId(nodeId)
+    {
+        setRegistered(m_client->registerNode(this));
+    }
+
+    ~StubNodeImpl() override
+    {
+        m_client->unregisterNode(this);
+    }
+
+    bool readAttributes(QOpcUa::NodeAttributes, const QString &, double) override { return false; }
+    bool enableMonitoring(QOpcUa::NodeAttributes, const QOpcUaMonitoringParameters &) override { return false; }
+    bool disableMonitoring(QOpcUa::NodeAttributes) override { return false; }
+    bool browse(const QOpcUaBrowseRequest &) override { return false; }
+    QString nodeId() const override { return m_nodeId; }
+    bool writeAttribute(QOpcUa::NodeAttribute, const QVariant &, QOpcUa::Types, const QString &) override { return false; }
+    bool writeAttributes(const QOpcUaNode::AttributeMap &, QOpcUa::Types) override { return false; }
+    bool modifyMonitoring(QOpcUa::NodeAttribute, QOpcUaMonitoringParameters::Parameter, const QVariant &) override { return false; }
+    bool callMethod(const QString &, const QVector<QOpcUa::TypedVariant> &) override { return false; }
+    bool resolveBrowsePath(const QVector<QOpcUaRelativePathElement> &) override { return false; }
+
+private:
+    QOpcUaClientImpl *m_client;
+    QString m_nodeId;
+};
+
+class NodeFootprintBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    NodeFootprintBenchmark();
+
+private Q_SLOTS:
+    void createAndDestroy_data();
+    void createAndDestroy();
+    void memory_data();
+    void memory();
+
+private:
+    static const int nodeCount = 10000;
+
+    void addLayouts();
+    static qint64 allocatedBytes();
+    static QVector<QOpcUaReadResult> baseAttributes(const QString &nodeId);
+
+    StubClientImpl *m_clientImpl;
+    QOpcUaClient m_client;
+    Legacy::Client m_legacyClient;
+    QStringList m_nodeIds;
+};
+
+NodeFootprintBenchmark::NodeFootprintBenchmark()
+    : m_clientImpl(new StubClientImpl)
+    , m_client(m_clientImpl)
+{
+    m_nodeIds.reserve(nodeCount);
+    for (int i = 0; i < nodeCount; ++i)
+        m_nodeIds.push_back(QStringLiteral("ns=2;s=Gateway.Tag%1").arg(i));
+}
+
+void NodeFootprintBenchmark::addLayouts()
+{
+    QTest::addColumn<bool>("legacy");
+
+    QTest::newRow("legacy") << true;
+    QTest::newRow("current") << false;
+}
+
+qint64 NodeFootprintBenchmark::allocatedBytes()
+{
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+    return qint64(mallinfo2().uordblks);
+#else
+    return qint64(mallinfo().uordblks);
+#endif
+#else
+    return -1;
+#endif
+}
+
+QVector<QOpcUaReadResult> NodeFootprintBenchmark::baseAttributes(const QString &nodeId)
+{
+    QVector<QOpcUaReadResult> results(4);
+    results[0].setAttribute(QOpcUa::NodeAttribute::NodeId);
+    results[0].setValue(nodeId);
+    results[1].setAttribute(QOpcUa::NodeAttribute::NodeClass);
+    results[1].setValue(QVariant::fromValue(QOpcUa::NodeClass::Variable));
+    results[2].setAttribute(QOpcUa::NodeAttribute::BrowseName);
+    results[2].setValue(QVariant::fromValue(QOpcUaQualifiedName(2, nodeId.mid(5))));
+    results[3].setAttribute(QOpcUa::NodeAttribute::DisplayName);
+    results[3].setValue(QVariant::fromValue(QOpcUaLocalizedText(QStringLiteral("en"), nodeId.mid(5))));
+    for (auto &result : results)
+        result.setStatusCode(QOpcUa::UaStatusCode::Good);
+    return results;
+}
+
+void NodeFootprintBenchmark::createAndDestroy_data()
+{
+    addLayouts();
+}
+
+void NodeFootprintBenchmark::createAndDestroy()
+{
+    QFETCH(bool, legacy);
+
+    if (legacy) {
+        QVector<Legacy::Node *> nodes(nodeCount);
+        QBENCHMARK {
+            for (int i = 0; i < nodeCount; ++i)
+                nodes[i] = m_legacyClient.node(i);
+            for (int i = 0; i < nodeCount; ++i)
+                m_legacyClient.removeNode(nodes.at(i), i);
+        }
+    } else {
+        QVector<QOpcUaNode *> nodes(nodeCount);
+        QBENCHMARK {
+            for (int i = 0; i < nodeCount; ++i)
+                nodes[i] = new QOpcUaNode(new StubNodeImpl(m_clientImpl, m_nodeIds.at(i)), &m_client);
+            qDeleteAll(nodes);
+        }
+    }
+}
+
+void NodeFootprintBenchmark::memory_data()
+{
+    addLayouts();
+}
+
+void NodeFootprintBenchmark::memory()
+{
+    QFETCH(bool, legacy);
+
+    if (allocatedBytes() < 0)
+        QSKIP("Heap statistics are only available with glibc");
+
+    // The attribute values are created in advance, only the storage in the nodes is measured
+    QVector<QVector<QOpcUaReadResult>> attributes;
+    attributes.reserve(nodeCount);
+    for (const auto &nodeId : qAsConst(m_nodeIds))
+        attributes.push_back(baseAttributes(nodeId));
+
+    qint64 bytes = 0;
+
+    if (legacy) {
+        QVector<Legacy::Node *> nodes(nodeCount);
+        const qint64 before = allocatedBytes();
+        for (int i = 0; i < nodeCount; ++i) {
+            nodes[i] = m_legacyClient.node(i);
+            emit m_legacyClient.impl(i)->attributesRead(attributes.at(i), QOpcUa::UaStatusCode::Good);
+        }
+        bytes = allocatedBytes() - before;
+
+        for (int i = 0; i < nodeCount; ++i) {
+            QCOMPARE(nodes.at(i)->attributeCount(), 4);
+            m_legacyClient.removeNode(nodes.at(i), i);
+        }
+    } else {
+        QVector<QOpcUaNode *> nodes(nodeCount);
+        const qint64 before = allocatedBytes();
+        for (int i = 0; i < nodeCount; ++i) {
+            auto impl = new StubNodeImpl(m_clientImpl, m_nodeIds.at(i));
+            nodes[i] = new QOpcUaNode(impl, &m_client);
+            impl->node()->handleAttributesRead(attributes.at(i), QOpcUa::UaStatusCode::Good, false);
+        }
+        bytes = allocatedBytes() - before;
+
+        for (int i = 0; i < nodeCount; ++i)
+            QCOMPARE(nodes.at(i)->attribute(QOpcUa::NodeAttribute::NodeId).toString(), m_nodeIds.at(i));
+        qDeleteAll(nodes);
+    }
+
+    QTest::setBenchmarkResult(qreal(bytes) / nodeCount, QTest::BytesAllocated);
+}
+
+QTEST_MAIN(NodeFootprintBenchmark)
+
+#include "tst_nodefootprint.moc"
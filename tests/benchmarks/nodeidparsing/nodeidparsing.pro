@@ -0,0 +1,25 @@
+QT       += testlib opcua opcua-private
+QT       -= gui
+
+TARGET = tst_nodeidparsing
+CONFIG   -= app_bundle
+CONFIG   += release
+
+TEMPLATE = app
+
+INCLUDEPATH += \
+               $$PWD/../../../src/plugins/opcua/open62541
+
+qtConfig(open62541):!qtConfig(system-open62541) {
+    qtConfig(mbedtls):{
+        QMAKE_USE_PRIVATE += mbedtls
+        DEFINES += UA_ENABLE_ENCRYPTION
+    }
+    include($$PWD/../../../src/3rdparty/open62541.pri)
+} else {
+    QMAKE_USE_PRIVATE += open62541
+}
+
+SOURCES += \
+        tst_nodeidparsing.cpp \
+        $$PWD/../../../src/plugins/opcua/open62541/qopen62541utils.cpp
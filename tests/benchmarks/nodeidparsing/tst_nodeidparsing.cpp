@@ -0,0 +1,317 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopen62541utils.h"
+
+#include <QtOpcUa/qopcuatype.h>
+#include <QtTest>
+
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QUuid>
+
+#include <cstring>
+
+Q_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541, "qt.opcua.benchmark")
+
+/*
+    This benchmark compares the conversion of node id strings to and from UA_NodeId
+    with the previous implementation based on QString::split(), regular expressions
+    and QString::arg(), which is kept here as reference.
+*/
+
+namespace Legacy {
+
+bool nodeIdStringSplit(const QString &nodeIdString, quint16 *nsIndex, QString *identifier, char *identifierType)
+{
+    quint16 namespaceIndex = 0;
+
+    QStringList components = nodeIdString.split(QLatin1String(";"));
+
+    if (components.size() > 2)
+        return false;
+
+    if (components.size() == 2 && components.at(0).contains(QRegularExpression(QLatin1String("^ns=[0-9]+")))) {
+        bool success = false;
+        uint ns = components.at(0).midRef(3).toString().toUInt(&success);
+        if (!success || ns > (std::numeric_limits<quint16>::max)())
+            return false;
+        namespaceIndex = ns;
+    }
+
+    if (components.last().size() < 3)
+        return false;
+
+    if (!components.last().contains(QRegularExpression(QLatin1String("^[isgb]="))))
+        return false;
+
+    if (nsIndex)
+        *nsIndex = namespaceIndex;
+    if (identifier)
+        *identifier = components.last().midRef(2).toString();
+    if (identifierType)
+        *identifierType = components.last().at(0).toLatin1();
+
+    return true;
+}
+
+UA_NodeId nodeIdFromQString(const QString &name)
+{
+    quint16 namespaceIndex;
+    QString identifierString;
+    char identifierType;
+    if (!nodeIdStringSplit(name, &namespaceIndex, &identifierString, &identifierType))
+        return UA_NODEID_NULL;
+
+    switch (identifierType) {
+    case 'i': {
+        bool isNumber;
+        uint identifier = identifierString.toUInt(&isNumber);
+        if (isNumber)
+            return UA_NODEID_NUMERIC(namespaceIndex, static_cast<UA_UInt32>(identifier));
+        break;
+    }
+    case 's':
+        if (identifierString.length() > 0)
+            return UA_NODEID_STRING_ALLOC(namespaceIndex, identifierString.toUtf8().constData());
+        break;
+    case 'g': {
+        QUuid uuid(identifierString);
+        if (uuid.isNull())
+            break;
+        UA_Guid guid;
+        guid.data1 = uuid.data1;
+        guid.data2 = uuid.data2;
+        guid.data3 = uuid.data3;
+        std::memcpy(guid.data4, uuid.data4, sizeof(uuid.data4));
+        return UA_NODEID_GUID(namespaceIndex, guid);
+    }
+    case 'b': {
+        const QByteArray temp = QByteArray::fromBase64(identifierString.toLatin1());
+        if (temp.size() > 0)
+            return UA_NODEID_BYTESTRING_ALLOC(namespaceIndex, temp.constData());
+        break;
+    }
+    }
+    return UA_NODEID_NULL;
+}
+
+QString nodeIdToQString(UA_NodeId id)
+{
+    QString result = QString::fromLatin1("ns=%1;").arg(id.namespaceIndex);
+
+    switch (id.identifierType) {
+    case UA_NODEIDTYPE_NUMERIC:
+        result.append(QString::fromLatin1("i=%1").arg(id.identifier.numeric));
+        break;
+    case UA_NODEIDTYPE_STRING:
+        result.append(QLatin1String("s="));
+        result.append(QString::fromLocal8Bit(reinterpret_cast<char *>(id.identifier.string.data),
+                                             id.identifier.string.length));
+        break;
+    case UA_NODEIDTYPE_GUID: {
+        const UA_Guid &src = id.identifier.guid;
+        const QUuid uuid(src.data1, src.data2, src.data3, src.data4[0], src.data4[1], src.data4[2],
+                src.data4[3], src.data4[4], src.data4[5], src.data4[6], src.data4[7]);
+        result.append(QStringLiteral("g=")).append(uuid.toString().midRef(1, 36));
+        break;
+    }
+    case UA_NODEIDTYPE_BYTESTRING: {
+        const QByteArray temp(reinterpret_cast<char *>(id.identifier.byteString.data), id.identifier.byteString.length);
+        result.append(QStringLiteral("b=")).append(temp.toBase64());
+        break;
+    }
+    default:
+        result.clear();
+    }
+    return result;
+}
+
+} // namespace Legacy
+
+class NodeIdParsingBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void split_data();
+    void split();
+    void fromQString_data();
+    void fromQString();
+    void cachedFromQString_data();
+    void cachedFromQString();
+    void toQString_data();
+    void toQString();
+
+private:
+    void addNodeIds();
+};
+
+void NodeIdParsingBenchmark::addNodeIds()
+{
+    QTest::addColumn<QString>("nodeId");
+    QTest::addColumn<bool>("legacy");
+
+    const QVector<QPair<const char *, QString>> nodeIds = {
+        {"numeric", QStringLiteral("ns=0;i=2255")},
+        {"numeric without namespace", QStringLiteral("i=85")},
+        {"string", QStringLiteral("ns=3;s=Demo.Static.Arrays.Int32")},
+        {"guid", QStringLiteral("ns=2;g=08081e75-8e5e-319b-954f-f3a7613dc29b")},
+        {"bytestring", QStringLiteral("ns=2;b=UXQgZnR3IQ==")}
+    };
+
+    for (const auto &nodeId : nodeIds) {
+        QTest::addRow("%s legacy", nodeId.first) << nodeId.second << true;
+        QTest::addRow("%s", nodeId.first) << nodeId.second << false;
+    }
+}
+
+void NodeIdParsingBenchmark::split_data()
+{
+    addNodeIds();
+}
+
+void NodeIdParsingBenchmark::split()
+{
+    QFETCH(QString, nodeId);
+    QFETCH(bool, legacy);
+
+    quint16 legacyNs = 0, ns = 0;
+    QString legacyIdentifier, identifier;
+    char legacyType = 0, type = 0;
+    QVERIFY(Legacy::nodeIdStringSplit(nodeId, &legacyNs, &legacyIdentifier, &legacyType));
+    QVERIFY(QOpcUa::nodeIdStringSplit(nodeId, &ns, &identifier, &type));
+    QCOMPARE(ns, legacyNs);
+    QCOMPARE(identifier, legacyIdentifier);
+    QCOMPARE(type, legacyType);
+
+    if (legacy) {
+        QBENCHMARK {
+            Legacy::nodeIdStringSplit(nodeId, &ns, &identifier, &type);
+        }
+    } else {
+        QBENCHMARK {
+            QOpcUa::nodeIdStringSplit(nodeId, &ns, &identifier, &type);
+        }
+    }
+}
+
+void NodeIdParsingBenchmark::fromQString_data()
+{
+    addNodeIds();
+}
+
+void NodeIdParsingBenchmark::fromQString()
+{
+    QFETCH(QString, nodeId);
+    QFETCH(bool, legacy);
+
+    UA_NodeId legacyId = Legacy::nodeIdFromQString(nodeId);
+    UA_NodeId id = Open62541Utils::nodeIdFromQString(nodeId);
+    QVERIFY(!UA_NodeId_isNull(&id));
+    QVERIFY(UA_NodeId_equal(&id, &legacyId));
+    UA_NodeId_deleteMembers(&legacyId);
+    UA_NodeId_deleteMembers(&id);
+
+    if (legacy) {
+        QBENCHMARK {
+            id = Legacy::nodeIdFromQString(nodeId);
+            UA_NodeId_deleteMembers(&id);
+        }
+    } else {
+        QBENCHMARK {
+            id = Open62541Utils::nodeIdFromQString(nodeId);
+            UA_NodeId_deleteMembers(&id);
+        }
+    }
+}
+
+void NodeIdParsingBenchmark::cachedFromQString_data()
+{
+    addNodeIds();
+}
+
+void NodeIdParsingBenchmark::cachedFromQString()
+{
+    QFETCH(QString, nodeId);
+    QFETCH(bool, legacy);
+
+    if (legacy)
+        QSKIP("There is no cache in the previous implementation");
+
+    QOpen62541NodeIdCache cache(100);
+
+    UA_NodeId legacyId = Legacy::nodeIdFromQString(nodeId);
+    UA_NodeId id = cache.nodeId(nodeId);
+    QVERIFY(UA_NodeId_equal(&id, &legacyId));
+    UA_NodeId_deleteMembers(&legacyId);
+    UA_NodeId_deleteMembers(&id);
+
+    QBENCHMARK {
+        id = cache.nodeId(nodeId);
+        UA_NodeId_deleteMembers(&id);
+    }
+}
+
+void NodeIdParsingBenchmark::toQString_data()
+{
+    addNodeIds();
+}
+
+void NodeIdParsingBenchmark::toQString()
+{
+    QFETCH(QString, nodeId);
+    QFETCH(bool, legacy);
+
+    UA_NodeId id = Open62541Utils::nodeIdFromQString(nodeId);
+    UaDeleter<UA_NodeId> nodeIdDeleter(&id, UA_NodeId_deleteMembers);
+    QCOMPARE(Open62541Utils::nodeIdToQString(id), Legacy::nodeIdToQString(id));
+
+    QString result;
+    if (legacy) {
+        QBENCHMARK {
+            result = Legacy::nodeIdToQString(id);
+        }
+    } else {
+        QBENCHMARK {
+            result = Open62541Utils::nodeIdToQString(id);
+        }
+    }
+}
+
+QTEST_MAIN(NodeIdParsingBenchmark)
+
+#include "tst_nodeidparsing.moc"
@@ -1,6 +1,6 @@
 TEMPLATE = subdirs
 
-SUBDIRS += eventsubscription
+SUBDIRS += eventsubscription subscriptioncpuload
 
 QT_FOR_CONFIG += opcua-private core-private
 qtConfig(ssl):!darwin:!winrt: SUBDIRS += gds
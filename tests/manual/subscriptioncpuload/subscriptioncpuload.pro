@@ -0,0 +1,10 @@
+QT       += testlib opcua
+QT       -= gui
+
+TARGET = tst_subscriptioncpuload
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+SOURCES += \
+        tst_subscriptioncpuload.cpp
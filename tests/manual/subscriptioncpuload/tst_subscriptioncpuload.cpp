@@ -0,0 +1,175 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtOpcUa>
+#include <QtTest>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QSharedPointer>
+
+#include <ctime>
+
+const int signalSpyTimeout = 10000;
+
+/*
+    This manual test measures the CPU time used by an idle client while
+    a number of subscriptions is active. Each subscription monitors the
+    CurrentTime variable of the server, which changes once per second.
+
+    The server can be selected using the TESTSERVER_URL environment variable,
+    the default is the open62541 based test server of the auto tests.
+    The duration of each measurement in milliseconds can be set using
+    the MEASUREMENT_DURATION environment variable.
+*/
+class SubscriptionCpuLoadTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SubscriptionCpuLoadTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cpuLoad_data();
+    void cpuLoad();
+
+private:
+    QOpcUaProvider m_provider;
+    QString m_serverUrl;
+    int m_measurementDuration;
+    QOpcUaEndpointDescription m_endpoint;
+};
+
+SubscriptionCpuLoadTest::SubscriptionCpuLoadTest()
+{
+    m_serverUrl = qEnvironmentVariable("TESTSERVER_URL", QStringLiteral("opc.tcp://127.0.0.1:43344"));
+    m_measurementDuration = qEnvironmentVariableIntValue("MEASUREMENT_DURATION");
+    if (m_measurementDuration <= 0)
+        m_measurementDuration = 5000;
+}
+
+void SubscriptionCpuLoadTest::initTestCase()
+{
+    const QStringList backends = m_provider.availableBackends();
+    QVERIFY(!backends.isEmpty());
+
+    QScopedPointer<QOpcUaClient> client(m_provider.createClient(backends.first()));
+    QVERIFY(client != nullptr);
+
+    QSignalSpy endpointSpy(client.data(), &QOpcUaClient::endpointsRequestFinished);
+    client->requestEndpoints(m_serverUrl);
+    endpointSpy.wait(signalSpyTimeout);
+    QCOMPARE(endpointSpy.size(), 1);
+
+    const QVector<QOpcUaEndpointDescription> desc = endpointSpy.at(0).at(0).value<QVector<QOpcUaEndpointDescription>>();
+    QVERIFY(desc.size() > 0);
+
+    for (const auto &endpoint : desc) {
+        if (endpoint.securityMode() == QOpcUaEndpointDescription::MessageSecurityMode::None) {
+            m_endpoint = endpoint;
+            break;
+        }
+    }
+    QVERIFY2(!m_endpoint.endpointUrl().isEmpty(), "The server has no endpoint without security");
+}
+
+void SubscriptionCpuLoadTest::cpuLoad_data()
+{
+    QTest::addColumn<QString>("backend");
+    QTest::addColumn<int>("subscriptionCount");
+
+    const QVector<int> subscriptionCounts = {0, 1, 10, 50, 100};
+    for (const auto &backend : m_provider.availableBackends()) {
+        for (int count : subscriptionCounts)
+            QTest::newRow(QStringLiteral("%1, %2 subscriptions").arg(backend).arg(count).toLatin1().constData())
+                    << backend << count;
+    }
+}
+
+void SubscriptionCpuLoadTest::cpuLoad()
+{
+    QFETCH(QString, backend);
+    QFETCH(int, subscriptionCount);
+
+    QScopedPointer<QOpcUaClient> client(m_provider.createClient(backend));
+    QVERIFY(client != nullptr);
+
+    client->connectToEndpoint(m_endpoint);
+    QTRY_VERIFY2_WITH_TIMEOUT(client->state() == QOpcUaClient::Connected, "Could not connect to server", signalSpyTimeout);
+
+    QVector<QSharedPointer<QOpcUaNode>> nodes;
+    for (int i = 0; i < subscriptionCount; ++i) {
+        QSharedPointer<QOpcUaNode> node(client->node(QOpcUa::namespace0Id(QOpcUa::NodeIds::Namespace0::Server_ServerStatus_CurrentTime)));
+        QVERIFY(node != nullptr);
+
+        QSignalSpy monitoringEnabledSpy(node.data(), &QOpcUaNode::enableMonitoringFinished);
+        // Exclusive subscriptions make sure that each node gets its own subscription
+        node->enableMonitoring(QOpcUa::NodeAttribute::Value,
+                               QOpcUaMonitoringParameters(1000, QOpcUaMonitoringParameters::SubscriptionType::Exclusive));
+        monitoringEnabledSpy.wait(signalSpyTimeout);
+        QCOMPARE(monitoringEnabledSpy.size(), 1);
+        QCOMPARE(monitoringEnabledSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+        nodes.push_back(node);
+    }
+
+    // Let the subscriptions settle before measuring
+    QTest::qWait(1000);
+
+    // std::clock() returns the CPU time of the whole process, the main thread is idle in qWait()
+    QElapsedTimer wallTime;
+    const std::clock_t cpuStart = std::clock();
+    wallTime.start();
+
+    QTest::qWait(m_measurementDuration);
+
+    const double cpuTimeMs = 1000.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    const qint64 wallTimeMs = wallTime.elapsed();
+
+    qInfo().noquote() << QStringLiteral("%1: %2 subscriptions, %3 ms CPU time in %4 ms (%5 %)")
+                         .arg(backend).arg(subscriptionCount).arg(cpuTimeMs, 0, 'f', 1).arg(wallTimeMs)
+                         .arg(100.0 * cpuTimeMs / wallTimeMs, 0, 'f', 2);
+
+    nodes.clear();
+
+    client->disconnectFromEndpoint();
+    QTRY_VERIFY_WITH_TIMEOUT(client->state() == QOpcUaClient::Disconnected, signalSpyTimeout);
+}
+
+QTEST_MAIN(SubscriptionCpuLoadTest)
+
+#include "tst_subscriptioncpuload.moc"
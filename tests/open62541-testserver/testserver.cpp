@@ -56,6 +56,7 @@ static UA_UsernamePasswordLogin usernamePasswords[2] = {
 #endif
 
 const UA_UInt16 portNumber = 43344;
+const UA_UInt32 maxNodesPerRequest = 100;
 
 // Node ID conversion is included from the open62541 plugin but warnings from there should be logged
 // using qt.opcua.testserver instead of qt.opcua.plugins.open62541 for usage in the test server
@@ -244,6 +245,22 @@ bool TestServer::init()
     if (!success || !m_config)
         return false;
 
+    // Small operation limits make clients split large batch requests
+    m_config->maxNodesPerRead = maxNodesPerRequest;
+    m_config->maxNodesPerWrite = maxNodesPerRequest;
+    m_config->maxNodesPerBrowse = maxNodesPerRequest;
+
+    // The operation limit variables are initialized when the server is created, update them to the configured values
+    const UA_UInt32 limitNodes[] = {UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERREAD,
+                                    UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERWRITE,
+                                    UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERBROWSE};
+    for (const UA_UInt32 limitNode : limitNodes) {
+        UA_Variant value;
+        UA_Variant_setScalar(&value, const_cast<UA_UInt32 *>(&maxNodesPerRequest), &UA_TYPES[UA_TYPES_UINT32]);
+        if (UA_Server_writeValue(m_server, UA_NODEID_NUMERIC(0, limitNode), value) != UA_STATUSCODE_GOOD)
+            return false;
+    }
+
     return true;
 }
 
@@ -1,5 +1,5 @@
 TEMPLATE = subdirs
-SUBDIRS += auto
+SUBDIRS += auto benchmarks
 
 QT_FOR_CONFIG += opcua-private
 